@@ -29,6 +29,7 @@
 #include <dtEntity/entitymanager.h>
 #include <dtEntityOSG/initosgviewer.h>
 #include <dtEntityOSG/layerattachpointcomponent.h>
+#include <dtEntityOSG/osgsysteminterface.h>
 #include <dtEntity/mapcomponent.h>
 #include <dtEntityOSG/positionattitudetransformcomponent.h>
 #include <dtEntity/spawner.h>
@@ -103,9 +104,9 @@ private:
    dtEntity::Vec2Property mForce;
 };
 
-const dtEntity::StringId MovementComponent::TYPE(dtEntity::SID("MovementComponent"));
-const dtEntity::StringId MovementComponent::SpeedId(dtEntity::SID("Speed"));
-const dtEntity::StringId MovementComponent::ForceId(dtEntity::SID("Force"));
+const dtEntity::StringId MovementComponent::TYPE(SID_LITERAL("MovementComponent"));
+const dtEntity::StringId MovementComponent::SpeedId(SID_LITERAL("Speed"));
+const dtEntity::StringId MovementComponent::ForceId(SID_LITERAL("Force"));
 
 
 ///////////////////////////////////////////////
@@ -185,8 +186,8 @@ private:
    dtEntity::IntProperty mTarget;
 };
 
-const dtEntity::StringId SteeringComponent::TYPE(dtEntity::SID("SteeringComponent")); 
-const dtEntity::StringId SteeringComponent::TargetId(dtEntity::SID("Target"));
+const dtEntity::StringId SteeringComponent::TYPE(SID_LITERAL("SteeringComponent")); 
+const dtEntity::StringId SteeringComponent::TargetId(SID_LITERAL("Target"));
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -335,6 +336,12 @@ int main(int argc, char** argv)
    viewer.getCameraManipulator()->setHomePosition(osg::Vec3(0, -50, 5), osg::Vec3(), osg::Vec3(0,0,1),false);
    viewer.getCameraManipulator()->home(0);
 
+   // simulate next frame while current frame is drawn
+   if(arguments.read("--pipelined"))
+   {
+      dtEntityOSG::GetOSGSystemInterface()->SetPipelined(true);
+   }
+
    dtEntity::SystemInterface* iface = dtEntity::GetSystemInterface();
    while (!viewer.done())
    {
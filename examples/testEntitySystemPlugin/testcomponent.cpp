@@ -14,16 +14,16 @@
   Define the component type. dtEntity::SID takes a string and
   hashes it to an unsigned int.
 */
-const dtEntity::StringId TestComponent::TYPE(dtEntity::SID("Test"));
+const dtEntity::StringId TestComponent::TYPE(SID_LITERAL("Test"));
 
 /*
   Define the property names
 */
-const dtEntity::StringId TestComponent::ArrayTestId(dtEntity::SID("ArrayTest"));
-const dtEntity::StringId TestComponent::DateTimeId(dtEntity::SID("DateTime"));
-const dtEntity::StringId TestComponent::EnumId(dtEntity::SID("Enum"));
-const dtEntity::StringId TestComponent::PathId(dtEntity::SID("Path"));
-const dtEntity::StringId TestComponent::ColorId(dtEntity::SID("Color"));
+const dtEntity::StringId TestComponent::ArrayTestId(SID_LITERAL("ArrayTest"));
+const dtEntity::StringId TestComponent::DateTimeId(SID_LITERAL("DateTime"));
+const dtEntity::StringId TestComponent::EnumId(SID_LITERAL("Enum"));
+const dtEntity::StringId TestComponent::PathId(SID_LITERAL("Path"));
+const dtEntity::StringId TestComponent::ColorId(SID_LITERAL("Color"));
 
 ////////////////////////////////////////////////////////////////////////////
 TestComponent::TestComponent()
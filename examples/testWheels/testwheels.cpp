@@ -156,11 +156,11 @@ public:
          Property* prop = *i;
          assert(prop->GetDataType() == DataType::GROUP);
          PropertyGroup pg = prop->GroupValue();
-         assert(pg.find(SID("NodeName")) != pg.end());
-         assert(pg.find(SID("Radius")) != pg.end());
-         std::string nodeName = pg[SID("NodeName")]->StringValue();
+         assert(pg.find(SID_LITERAL("NodeName")) != pg.end());
+         assert(pg.find(SID_LITERAL("Radius")) != pg.end());
+         std::string nodeName = pg[SID_LITERAL("NodeName")]->StringValue();
          
-         float radius = pg[SID("Radius")]->FloatValue();
+         float radius = pg[SID_LITERAL("Radius")]->FloatValue();
          
          osg::ref_ptr<FindNamedNodeVisitor> v = new FindNamedNodeVisitor(nodeName);
          smc->GetNode()->accept(*v);
@@ -177,9 +177,9 @@ public:
    }
 };
 
-const dtEntity::StringId WheelComponent::TYPE(dtEntity::SID("Wheel"));
-const dtEntity::StringId WheelComponent::SpeedId(dtEntity::SID("Speed"));
-const dtEntity::StringId WheelComponent::WheelsId(dtEntity::SID("Wheels"));
+const dtEntity::StringId WheelComponent::TYPE(SID_LITERAL("Wheel"));
+const dtEntity::StringId WheelComponent::SpeedId(SID_LITERAL("Speed"));
+const dtEntity::StringId WheelComponent::WheelsId(SID_LITERAL("Wheels"));
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/logmanager.h>
+#include <OpenThreads/Atomic>
+#include <iosfwd>
+#include <string>
+
+namespace dtEntity
+{
+   class AsyncLogWriterThread;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Log listener that writes messages to a stream from a background thread.
+    * LogMessage claims a slot of a fixed size ring buffer with compare and swap
+    * and formats the message into it, so logging threads never take a lock and
+    * never wait for the writer thread or the stream. When the ring buffer is
+    * full new messages are dropped and counted.
+    *
+    * Output format is "LEVEL File: name Line: number Message: text".
+    */
+   class DT_ENTITY_EXPORT AsyncLogListener
+      : public LogListener
+   {
+   public:
+
+      /**
+       * Starts the writer thread.
+       * @param stream Stream to write to. Has to outlive the listener and
+       *               must not be written to by other threads
+       * @param capacity Number of messages that can be queued, rounded up
+       *                 to a power of two
+       */
+      AsyncLogListener(std::ostream& stream, unsigned int capacity = 4096);
+
+      /**
+       * @threadsafe
+       */
+      virtual void LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
+                      const std::string& msg);
+
+      /**
+       * Wait until all messages logged before this call are written
+       * and the stream is flushed
+       */
+      void Flush();
+
+      unsigned int GetCapacity() const { return mMask + 1; }
+
+      /**
+       * @return number of messages dropped because the ring buffer was full
+       */
+      unsigned int GetNumDropped() const { return mNumDropped; }
+
+   protected:
+
+      // writes remaining messages and stops writer thread
+      ~AsyncLogListener();
+
+   private:
+
+      friend class AsyncLogWriterThread;
+
+      /**
+       * A ring buffer slot is free for writing the message with index i
+       * if mSequence is i and holds a message if mSequence is i + 1.
+       */
+      struct Slot
+      {
+         OpenThreads::Atomic mSequence;
+         std::string mText;
+      };
+
+      // write all published messages to the stream, called by writer thread
+      bool Drain();
+
+      unsigned int GetHead() const
+      {
+         return static_cast<unsigned int>(reinterpret_cast<size_t>(mHead.get()));
+      }
+
+      // no copy ctor
+      AsyncLogListener(const AsyncLogListener&);
+      AsyncLogListener& operator=(const AsyncLogListener&);
+
+      Slot* mSlots;
+      unsigned int mMask;
+
+      // index of next message to push, claimed by logging threads with
+      // compare and swap. Stored as pointer because OpenThreads::Atomic has no CAS
+      OpenThreads::AtomicPtr mHead;
+
+      // index of next message to write, only used by writer thread
+      unsigned int mTail;
+
+      // messages before this index are written and flushed
+      OpenThreads::Atomic mFlushed;
+
+      OpenThreads::Atomic mNumDropped;
+
+      std::ostream* mStream;
+      AsyncLogWriterThread* mThread;
+   };
+}
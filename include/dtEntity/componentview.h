@@ -0,0 +1,310 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/component.h>
+#include <dtEntity/entityid.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/entitysystem.h>
+#include <vector>
+
+namespace dtEntity
+{
+   // fetch component of type T for view, void means unused slot
+   template<class T>
+   struct ComponentViewSlot
+   {
+      static bool IsUsed() { return true; }
+      static bool Matches(const EntityManager& em, ComponentType t) { return em.IsComponentTypeOf(t, T::TYPE); }
+      static void Resolve(EntityManager& em, EntitySystem*& es, bool& derived)
+      {
+         es = em.GetEntitySystem(T::TYPE);
+         derived = em.HasDerivedTypes(T::TYPE);
+      }
+
+      static bool Fetch(EntityManager& em, EntitySystem* es, bool derived, EntityId eid, T*& comp)
+      {
+         Component* c;
+         if(es != NULL && es->GetComponent(eid, c))
+         {
+            comp = static_cast<T*>(c);
+            return true;
+         }
+         return derived && em.GetComponent(eid, comp, true);
+      }
+
+      static EntitySystem* GetDriver(EntityManager& em)
+      {
+         // a type with derived systems cannot drive iteration, its
+         // system does not hold the derived components
+         if(em.HasDerivedTypes(T::TYPE))
+         {
+            return NULL;
+         }
+         return em.GetEntitySystem(T::TYPE);
+      }
+   };
+
+   template<>
+   struct ComponentViewSlot<void>
+   {
+      static bool IsUsed() { return false; }
+      static bool Matches(const EntityManager&, ComponentType) { return false; }
+      static void Resolve(EntityManager&, EntitySystem*& es, bool& derived) { es = NULL; derived = false; }
+      static bool Fetch(EntityManager&, EntitySystem*, bool, EntityId, void*& comp) { comp = NULL; return true; }
+      static EntitySystem* GetDriver(EntityManager&) { return NULL; }
+   };
+
+   /**
+    * Query for all entities that have a component of each of the given types.
+    * Components of derived types (see EntitySystem::GetBaseType) also match.
+    * Up to four component types are supported, unused types are void.
+    *
+    * Uncached view: Call Update() to collect matches. Iteration is driven by
+    * the smallest entity system of the given types, the other components
+    * are looked up per entity.
+    *
+    * Cached view: Matches are collected once on construction and then kept up
+    * to date as components are created and deleted. Update() is a no-op.
+    * Use for queries that are executed every frame.
+    *
+    * ComponentView<TransformComponent, DynamicsComponent> view(em, true);
+    * for(ComponentView<TransformComponent, DynamicsComponent>::iterator i = view.begin(); i != view.end(); ++i)
+    * {
+    *    i->mFirst->SetTranslation(i->mSecond->GetVelocity() * dt);
+    * }
+    *
+    * Warning: Iterators are invalidated when components are added or removed
+    * while iterating over a cached view.
+    */
+   template<class A, class B, class C = void, class D = void>
+   class ComponentView
+      : public EntityManager::ComponentObserver
+   {
+   public:
+
+      struct Entry
+      {
+         EntityId mEntityId;
+         A* mFirst;
+         B* mSecond;
+         C* mThird;
+         D* mFourth;
+      };
+
+      typedef std::vector<Entry> Entries;
+      typedef typename Entries::iterator iterator;
+      typedef typename Entries::const_iterator const_iterator;
+
+      /**
+       * @param em Query entities of this entity manager
+       * @param cached If true, keep matches up to date incrementally
+       */
+      ComponentView(EntityManager& em, bool cached = false)
+         : mEntityManager(&em)
+         , mCached(cached)
+      {
+         if(mCached)
+         {
+            Collect();
+            em.AddComponentObserver(this);
+         }
+      }
+
+      ~ComponentView()
+      {
+         if(mCached)
+         {
+            mEntityManager->RemoveComponentObserver(this);
+         }
+      }
+
+      /**
+       * Collect matching entities. Does nothing for cached views.
+       */
+      void Update()
+      {
+         if(!mCached)
+         {
+            Collect();
+         }
+      }
+
+      iterator begin() { return mEntries.begin(); }
+      const_iterator begin() const { return mEntries.begin(); }
+      iterator end() { return mEntries.end(); }
+      const_iterator end() const { return mEntries.end(); }
+
+      std::size_t size() const { return mEntries.size(); }
+      bool empty() const { return mEntries.empty(); }
+
+      bool IsCached() const { return mCached; }
+
+      virtual void ComponentAdded(EntityId eid, EntitySystem& es)
+      {
+         if(!Matches(es.GetComponentType()) || Find(eid) != 0)
+         {
+            return;
+         }
+         Resolve();
+         Entry e;
+         if(Fetch(eid, e))
+         {
+            mEntries.push_back(e);
+            SetSlot(eid, static_cast<unsigned int>(mEntries.size()));
+         }
+      }
+
+      virtual void ComponentRemoved(EntityId eid, EntitySystem& es)
+      {
+         if(!Matches(es.GetComponentType()))
+         {
+            return;
+         }
+         unsigned int slot = Find(eid);
+         if(slot == 0)
+         {
+            return;
+         }
+         // swap and pop
+         if(slot != mEntries.size())
+         {
+            mEntries[slot - 1] = mEntries.back();
+            SetSlot(mEntries[slot - 1].mEntityId, slot);
+         }
+         mEntries.pop_back();
+         SetSlot(eid, 0);
+      }
+
+   private:
+
+      bool Matches(ComponentType t) const
+      {
+         return ComponentViewSlot<A>::Matches(*mEntityManager, t) ||
+                ComponentViewSlot<B>::Matches(*mEntityManager, t) ||
+                ComponentViewSlot<C>::Matches(*mEntityManager, t) ||
+                ComponentViewSlot<D>::Matches(*mEntityManager, t);
+      }
+
+      // look up entity systems once instead of for each entity
+      void Resolve()
+      {
+         ComponentViewSlot<A>::Resolve(*mEntityManager, mSystems[0], mDerived[0]);
+         ComponentViewSlot<B>::Resolve(*mEntityManager, mSystems[1], mDerived[1]);
+         ComponentViewSlot<C>::Resolve(*mEntityManager, mSystems[2], mDerived[2]);
+         ComponentViewSlot<D>::Resolve(*mEntityManager, mSystems[3], mDerived[3]);
+      }
+
+      bool Fetch(EntityId eid, Entry& e) const
+      {
+         e.mEntityId = eid;
+         return ComponentViewSlot<A>::Fetch(*mEntityManager, mSystems[0], mDerived[0], eid, e.mFirst) &&
+                ComponentViewSlot<B>::Fetch(*mEntityManager, mSystems[1], mDerived[1], eid, e.mSecond) &&
+                ComponentViewSlot<C>::Fetch(*mEntityManager, mSystems[2], mDerived[2], eid, e.mThird) &&
+                ComponentViewSlot<D>::Fetch(*mEntityManager, mSystems[3], mDerived[3], eid, e.mFourth);
+      }
+
+      // selects system with fewest components that can drive iteration
+      static void SelectDriver(EntitySystem* candidate, EntitySystem*& driver)
+      {
+         if(candidate != NULL && (driver == NULL || candidate->GetNumComponents() < driver->GetNumComponents()))
+         {
+            driver = candidate;
+         }
+      }
+
+      void Collect()
+      {
+         mEntries.clear();
+         mSlots.clear();
+         mCandidates.clear();
+         Resolve();
+
+         EntitySystem* driver = NULL;
+         SelectDriver(ComponentViewSlot<A>::GetDriver(*mEntityManager), driver);
+         SelectDriver(ComponentViewSlot<B>::GetDriver(*mEntityManager), driver);
+         SelectDriver(ComponentViewSlot<C>::GetDriver(*mEntityManager), driver);
+         SelectDriver(ComponentViewSlot<D>::GetDriver(*mEntityManager), driver);
+
+         if(driver != NULL)
+         {
+            driver->GetEntitiesInSystem(mCandidates);
+         }
+         else
+         {
+            mEntityManager->GetEntityIds(mCandidates);
+         }
+
+         Entry e;
+         for(std::vector<EntityId>::const_iterator i = mCandidates.begin(); i != mCandidates.end(); ++i)
+         {
+            if(Fetch(*i, e))
+            {
+               mEntries.push_back(e);
+               if(mCached)
+               {
+                  SetSlot(*i, static_cast<unsigned int>(mEntries.size()));
+               }
+            }
+         }
+      }
+
+      // returns entry index + 1, 0 if entity is not in view
+      unsigned int Find(EntityId eid) const
+      {
+         unsigned int index = GetEntityIndex(eid);
+         if(index >= mSlots.size())
+         {
+            return 0;
+         }
+         unsigned int slot = mSlots[index];
+         return (slot != 0 && mEntries[slot - 1].mEntityId == eid) ? slot : 0;
+      }
+
+      void SetSlot(EntityId eid, unsigned int slot)
+      {
+         unsigned int index = GetEntityIndex(eid);
+         if(index >= mSlots.size())
+         {
+            mSlots.resize(index + 1, 0);
+         }
+         mSlots[index] = slot;
+      }
+
+      // no copy ctor
+      ComponentView(const ComponentView&);
+      ComponentView& operator=(const ComponentView&);
+
+      EntityManager* mEntityManager;
+      bool mCached;
+      Entries mEntries;
+
+      // maps entity index to entry index + 1, only used by cached views
+      std::vector<unsigned int> mSlots;
+
+      // reused buffer for entity ids of driving system
+      std::vector<EntityId> mCandidates;
+
+      EntitySystem* mSystems[4];
+      bool mDerived[4];
+   };
+}
@@ -26,9 +26,13 @@
 #include <dtEntity/entitysystem.h>
 #include <dtEntity/dtentity_config.h>
 
+#include <dtEntity/dynamicproperty.h>
 #include <dtEntity/entitymanager.h>
 #include <dtEntity/log.h>
+#include <dtEntity/slaballocator.h>
+#include <dtEntity/sparsecomponentstore.h>
 #include <assert.h>
+#include <new>
 
 #if USE_BOOST_POOL
 #include <boost/pool/object_pool.hpp>
@@ -92,14 +96,21 @@ namespace dtEntity
          delete t;
       }
 
-      static void DestroyAll(ComponentStoreMap<T>& components)
+      template<class Store>
+      static void DestroyAll(Store& components)
       {
-         for(typename ComponentStoreMap<T>::iterator i = components.begin(); i != components.end(); ++i)
+         for(typename Store::iterator i = components.begin(); i != components.end(); ++i)
          {
             delete i->second;
          }
       }
 
+      /**
+       * Add properties describing allocator state to props.
+       * They get registered as properties of the entity system.
+       */
+      static void GetAllocatorProperties(PropertyGroup& props) {}
+
    protected:
       ~MemAllocPolicyNew() {}
    };
@@ -110,49 +121,154 @@ namespace dtEntity
    template<class T>
    struct MemAllocPolicyBoostPool
    {
-      static T* Create()
+      T* Create()
       {
-         return mComponentPool->construct();
+         return mComponentPool.construct();
       }
 
-      static void Destroy(T* t)
+      void Destroy(T* t)
       {
-         mComponentPool->destroy(t);
+         mComponentPool.destroy(t);
       }
 
-      static void DestroyAll(ComponentStoreMap<T>& components)
+      template<class Store>
+      void DestroyAll(Store& components)
       {
-         delete mComponentPool;
+         for(typename Store::iterator i = components.begin(); i != components.end(); ++i)
+         {
+            mComponentPool.destroy(i->second);
+         }
       }
 
+      static void GetAllocatorProperties(PropertyGroup& props) {}
+
    protected:
       ~MemAllocPolicyBoostPool() {}
 
    private:
-      boost::object_pool<T>* mComponentPool;
+      boost::object_pool<T> mComponentPool;
    };
 #endif
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Allocates components from per-system slabs of cache line aligned
+    * blocks, see SlabAllocator. Registers the read-only properties
+    * AllocLiveCount, AllocPeakCount, AllocBytesReserved and AllocFragmentation
+    * on the entity system.
+    */
+   template<class T>
+   class MemAllocPolicySlab
+   {
+   public:
+
+      MemAllocPolicySlab()
+         : mSlab(sizeof(T))
+         , mLiveCountProp(
+              DynamicUIntProperty::SetValueCB(this, &MemAllocPolicySlab::SetReadOnlyUInt),
+              DynamicUIntProperty::GetValueCB(this, &MemAllocPolicySlab::GetLiveCount)
+           )
+         , mPeakCountProp(
+              DynamicUIntProperty::SetValueCB(this, &MemAllocPolicySlab::SetReadOnlyUInt),
+              DynamicUIntProperty::GetValueCB(this, &MemAllocPolicySlab::GetPeakCount)
+           )
+         , mBytesReservedProp(
+              DynamicUIntProperty::SetValueCB(this, &MemAllocPolicySlab::SetReadOnlyUInt),
+              DynamicUIntProperty::GetValueCB(this, &MemAllocPolicySlab::GetBytesReserved)
+           )
+         , mFragmentationProp(
+              DynamicFloatProperty::SetValueCB(this, &MemAllocPolicySlab::SetReadOnlyFloat),
+              DynamicFloatProperty::GetValueCB(this, &MemAllocPolicySlab::GetFragmentation)
+           )
+      {
+      }
+
+      T* Create()
+      {
+         void* mem = mSlab.Allocate();
+         if(mem == NULL)
+         {
+            return NULL;
+         }
+         return new(mem) T;
+      }
+
+      void Destroy(T* t)
+      {
+         t->~T();
+         mSlab.Free(t);
+      }
+
+      template<class Store>
+      void DestroyAll(Store& components)
+      {
+         for(typename Store::iterator i = components.begin(); i != components.end(); ++i)
+         {
+            i->second->~T();
+         }
+         mSlab.FreeAll();
+      }
+
+      void GetAllocatorProperties(PropertyGroup& props)
+      {
+         props[SlabAllocator::AllocLiveCountId] = &mLiveCountProp;
+         props[SlabAllocator::AllocPeakCountId] = &mPeakCountProp;
+         props[SlabAllocator::AllocBytesReservedId] = &mBytesReservedProp;
+         props[SlabAllocator::AllocFragmentationId] = &mFragmentationProp;
+      }
+
+      const SlabAllocator& GetSlabAllocator() const { return mSlab; }
+
+   protected:
+      ~MemAllocPolicySlab() {}
+
+   private:
+
+      unsigned int GetLiveCount() const { return mSlab.GetLiveCount(); }
+      unsigned int GetPeakCount() const { return mSlab.GetPeakCount(); }
+      unsigned int GetBytesReserved() const { return static_cast<unsigned int>(mSlab.GetBytesReserved()); }
+      float GetFragmentation() const { return mSlab.GetFragmentation(); }
+      void SetReadOnlyUInt(unsigned int) {}
+      void SetReadOnlyFloat(float) {}
+
+      SlabAllocator mSlab;
+      DynamicUIntProperty mLiveCountProp;
+      DynamicUIntProperty mPeakCountProp;
+      DynamicUIntProperty mBytesReservedProp;
+      DynamicFloatProperty mFragmentationProp;
+   };
+
    ////////////////////////////////////////////////////////////////////////////////
    /**
     * A simple base for an entity system that handles component allocation
     * and deletion.
-    * Uses an unordered map for component storage
+    * Uses an unordered map for component storage by default. Pass
+    * ComponentStoreSparseSet as StorePolicy to keep components in a dense
+    * array instead, which is faster to iterate in Tick loops.
+    * Pass MemAllocPolicySlab as MemAllocPolicy to allocate components
+    * from a per-system slab allocator.
     */
-   template<typename T, template<class> class MemAllocPolicy = MemAllocPolicyNew>
+   template<typename T, template<class> class MemAllocPolicy = MemAllocPolicyNew,
+            template<class> class StorePolicy = ComponentStoreMap>
    class DefaultEntitySystem
       : public EntitySystem
       , public MemAllocPolicy<T>
    {
    public:
 
-      typedef ComponentStoreMap<T> ComponentStore;
-      typedef typename ComponentStoreMap<T>::size_type size_type;
+      typedef StorePolicy<T> ComponentStore;
+      typedef typename ComponentStore::size_type size_type;
 
       DefaultEntitySystem(EntityManager& em, ComponentType baseType = StringId())
          : EntitySystem(em, baseType)
          , mComponentType(T::TYPE)
       {
+         PropertyGroup allocProps;
+         MemAllocPolicy<T>::GetAllocatorProperties(allocProps);
+         for(PropertyGroup::iterator i = allocProps.begin(); i != allocProps.end(); ++i)
+         {
+            Register(i->first, i->second);
+         }
       }
 
       ~DefaultEntitySystem()
@@ -174,8 +290,9 @@ namespace dtEntity
       virtual bool DeleteComponent(EntityId eid);
 
       virtual void GetEntitiesInSystem(std::list<EntityId>& toFill) const;
+      virtual void GetEntitiesInSystem(std::vector<EntityId>& toFill) const;
 
-      size_type GetNumComponents() const;
+      virtual size_type GetNumComponents() const;
 
       virtual GroupProperty GetComponentProperties() const;
 
@@ -194,23 +311,23 @@ namespace dtEntity
 
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      ComponentType DefaultEntitySystem<T, MemAllocPolicy>::GetComponentType() const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      ComponentType DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponentType() const
    {
       return mComponentType;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      bool DefaultEntitySystem<T, MemAllocPolicy>::HasComponent(EntityId eid) const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      bool DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::HasComponent(EntityId eid) const
    {
       typename ComponentStore::const_iterator i = mComponents.find(eid);
       return(i != mComponents.end());
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      T* DefaultEntitySystem<T, MemAllocPolicy>::GetComponent(EntityId eid)
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      T* DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponent(EntityId eid)
    {
       typename ComponentStore::iterator i = mComponents.find(eid);
       if(i != mComponents.end())
@@ -221,8 +338,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      const T* DefaultEntitySystem<T, MemAllocPolicy>::GetComponent(EntityId eid) const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      const T* DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponent(EntityId eid) const
    {
       typename ComponentStore::const_iterator i = mComponents.find(eid);
       if(i != mComponents.end())
@@ -233,8 +350,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      bool DefaultEntitySystem<T, MemAllocPolicy>::GetComponent(EntityId eid, Component*& c)
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      bool DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponent(EntityId eid, Component*& c)
    {
       typename ComponentStore::iterator i = mComponents.find(eid);
       if(i != mComponents.end())
@@ -246,8 +363,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      bool DefaultEntitySystem<T, MemAllocPolicy>::GetComponent(EntityId eid, const Component*& c) const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      bool DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponent(EntityId eid, const Component*& c) const
    {
       typename ComponentStore::const_iterator i = mComponents.find(eid);
       if(i != mComponents.end())
@@ -259,8 +376,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      bool DefaultEntitySystem<T, MemAllocPolicy>::CreateComponent(EntityId eid, Component*& component)
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      bool DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::CreateComponent(EntityId eid, Component*& component)
    {
       if(HasComponent(eid))
       {
@@ -285,13 +402,14 @@ namespace dtEntity
          LOG_ERROR("Can't add component to entity: entity does not exist!");
          return false;
       }
+      e->AddComponentSystem(*this);
       component->OnAddedToEntity(*e);
       return true;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      bool DefaultEntitySystem<T, MemAllocPolicy>::DeleteComponent(EntityId eid)
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      bool DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::DeleteComponent(EntityId eid)
    {
       typename ComponentStore::iterator i = mComponents.find(eid);
       if(i == mComponents.end())
@@ -301,15 +419,28 @@ namespace dtEntity
       bool found = GetEntityManager().GetEntity(eid, e);
       assert(found);
       component->OnRemovedFromEntity(*e);
+      e->RemoveComponentSystem(*this);
       mComponents.erase(i);
       MemAllocPolicy<T>::Destroy(component);
       return true;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      void DefaultEntitySystem<T, MemAllocPolicy>::GetEntitiesInSystem(std::list<EntityId>& toFill) const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      void DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetEntitiesInSystem(std::list<EntityId>& toFill) const
+   {
+      typename ComponentStore::const_iterator i = mComponents.begin();
+      for(;i != mComponents.end(); ++i)
+      {
+         toFill.push_back(i->first);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      void DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetEntitiesInSystem(std::vector<EntityId>& toFill) const
    {
+      toFill.reserve(toFill.size() + mComponents.size());
       typename ComponentStore::const_iterator i = mComponents.begin();
       for(;i != mComponents.end(); ++i)
       {
@@ -318,44 +449,44 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-   typename DefaultEntitySystem<T, MemAllocPolicy>::size_type DefaultEntitySystem<T, MemAllocPolicy>::GetNumComponents() const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+   typename DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::size_type DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetNumComponents() const
    {
       return mComponents.size();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      GroupProperty DefaultEntitySystem<T, MemAllocPolicy>::GetComponentProperties() const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      GroupProperty DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::GetComponentProperties() const
    {
       T t;
       return t;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      typename ComponentStoreMap<T>::iterator DefaultEntitySystem<T, MemAllocPolicy>::begin()
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      typename StorePolicy<T>::iterator DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::begin()
    {
       return mComponents.begin();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      typename ComponentStoreMap<T>::const_iterator DefaultEntitySystem<T, MemAllocPolicy>::begin() const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      typename StorePolicy<T>::const_iterator DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::begin() const
    {
       return mComponents.begin();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      typename ComponentStoreMap<T>::iterator DefaultEntitySystem<T, MemAllocPolicy>::end()
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      typename StorePolicy<T>::iterator DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::end()
    {
       return mComponents.end();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   template<typename T, template<class> class MemAllocPolicy>
-      typename ComponentStoreMap<T>::const_iterator DefaultEntitySystem<T, MemAllocPolicy>::end() const
+   template<typename T, template<class> class MemAllocPolicy, template<class> class StorePolicy>
+      typename StorePolicy<T>::const_iterator DefaultEntitySystem<T, MemAllocPolicy, StorePolicy>::end() const
    {
       return mComponents.end();
    }
@@ -52,6 +52,10 @@ namespace dtEntity
       void OnAddedToEntity(Entity &entity) { mEntity = &entity; }
 
       Vec3f GetVelocity() const { return mVelocityVal; }
+      /**
+       * Sends EntityVelocityNotNullMessage when entity starts or stops moving.
+       * The message is enqueued if called from a concurrent tick handler.
+       */
       void SetVelocity(const Vec3f& v);
 
       const Quat& GetAngularVelocity() const { return mAngularVelocity.GetAsQuat(); }
@@ -62,6 +66,8 @@ namespace dtEntity
 
    protected:
       Entity* mEntity;
+
+      static PropertySchema sPropertySchema;
      
       // path to loaded script file
       DynamicVec3Property mVelocity;
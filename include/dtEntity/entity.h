@@ -96,6 +96,23 @@ namespace dtEntity
        */
       EntityManager& GetEntityManager() const;
 
+      typedef std::vector<EntitySystem*> ComponentSystems;
+
+      /**
+       * Entity systems holding a component of this entity, in order of
+       * component creation. Used by the entity manager to visit only
+       * the systems concerned when killing, cloning or listing components.
+       */
+      const ComponentSystems& GetComponentSystems() const { return mComponentSystems; }
+
+      /**
+       * Entity system implementations have to call these when they
+       * create or delete a component for this entity.
+       * DefaultEntitySystem does this automatically.
+       */
+      void AddComponentSystem(EntitySystem& es);
+      bool RemoveComponentSystem(EntitySystem& es);
+
    private:
 
       // internal ID
@@ -103,6 +120,9 @@ namespace dtEntity
 
       // The entity manager that holds this entity
       EntityManager* mEntityManager;
+
+      // systems holding a component of this entity
+      ComponentSystems mComponentSystems;
    };
 
 
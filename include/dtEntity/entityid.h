@@ -23,7 +23,40 @@
 
 namespace dtEntity
 {
-   // serial ID for entities
+   /**
+    * Handle for entities. The lower ENTITY_INDEX_BITS bits hold the index of
+    * the entity's slot in the entity table, the upper bits hold a generation
+    * counter that is incremented each time the slot is reused.
+    * A handle to a killed entity therefore never matches the entity that
+    * later takes over its slot.
+    * Index 0 is never used, so 0 is never a valid entity id.
+    */
    typedef unsigned int EntityId;
-   
+
+   enum
+   {
+      ENTITY_INDEX_BITS = 22,
+      ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS
+   };
+
+   const unsigned int ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+   const unsigned int ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+
+   // slot index part of entity id
+   inline unsigned int GetEntityIndex(EntityId id)
+   {
+      return id & ENTITY_INDEX_MASK;
+   }
+
+   // generation part of entity id
+   inline unsigned int GetEntityGeneration(EntityId id)
+   {
+      return (id >> ENTITY_INDEX_BITS) & ENTITY_GENERATION_MASK;
+   }
+
+   inline EntityId MakeEntityId(unsigned int index, unsigned int generation)
+   {
+      return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+   }
+
 }
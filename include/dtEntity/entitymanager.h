@@ -23,12 +23,13 @@
 
 #include <osg/ref_ptr>
 #include <dtEntity/entityid.h>
+#include <dtEntity/entitytable.h>
 #include <dtEntity/export.h>
 #include <dtEntity/messagepump.h>
 #include <map>
 #include <vector>
 #include <assert.h>
-#include <OpenThreads/ReadWriteMutex>
+#include <OpenThreads/Mutex>
 
 namespace dtEntity
 {
@@ -36,6 +37,9 @@ namespace dtEntity
    class Entity;
    class EntitySystem;
    class Message;
+   class SystemScheduler;
+   struct EndOfFrameData;
+   struct TickData;
 
    /**
     * Entity manager is a container for entity systems. 
@@ -73,6 +77,23 @@ namespace dtEntity
 
       typedef std::vector<ComponentDeletedCallback*> ComponentDeletedCallbacks;
 
+      /**
+       * Is informed whenever an entity system adds a component to or removes
+       * a component from an entity, no matter if this is done through the
+       * entity manager or directly on the entity system.
+       * Called while the component is still in the entity system.
+       * Used by cached component views, see componentview.h
+       */
+      class ComponentObserver
+      {
+      public:
+         virtual void ComponentAdded(EntityId id, EntitySystem& es) = 0;
+         virtual void ComponentRemoved(EntityId id, EntitySystem& es) = 0;
+         virtual ~ComponentObserver() {}
+      };
+
+      typedef std::vector<ComponentObserver*> ComponentObservers;
+
 
       /**
        * If user executes CreateComponent and no entity system with given component
@@ -90,16 +111,18 @@ namespace dtEntity
       typedef std::vector<EntitySystemRequestCallback*> EntitySystemRequestCallbacks;
 
       /**
-       * Get entity object for entity ID.
+       * Get entity object for entity ID. Lock-free, O(1).
        * @param id Unique id of the entity to retrieve
 	   * @param entity Will receive pointer to entity object
-	   * @return true if entity with this id was found
+	   * @return true if entity with this id was found, false if
+       *         id belongs to an entity that was killed
        * @threadsafe
        */
       bool GetEntity(EntityId id, Entity*& entity);
 
       /**
        * return true if entity with this ID exists
+       * @threadsafe
        */
       bool EntityExists(EntityId id) const;
 
@@ -109,14 +132,38 @@ namespace dtEntity
       void GetEntityIds(std::vector<EntityId>& toFill);
 
       /**
-       * delete entity object and tell all entity systems to delete their
-       * components for this entity
+       * delete entity object and tell all entity systems holding a
+       * component of this entity to delete it (see Entity::GetComponentSystems)
        * @param id id of the entity to delete
        * @return true if success
        * @threadsafe
        */
       bool KillEntity(EntityId id);
 
+      /**
+       * Kill many entities at once. The component deleted callbacks are
+       * called first, grouped by component type. Then the components of
+       * each entity are deleted in the same order as KillEntity does.
+       * Invalid and duplicate ids are ignored.
+       * @param ids ids of the entities to delete
+       * @return true if all ids belonged to existing entities
+       */
+      bool KillEntities(const std::vector<EntityId>& ids);
+
+      /**
+       * Queue entity for deletion. All queued entities are killed with
+       * KillEntities when the EndOfFrameMessage is emitted, after all other
+       * EndOfFrameMessage handlers (or when calling FlushDeferredKills).
+       * The entity stays valid until then.
+       * @threadsafe
+       */
+      void KillEntityDeferred(EntityId id);
+
+      /**
+       * Kill all entities queued with KillEntityDeferred.
+       */
+      void FlushDeferredKills();
+
       /**
        * Create a new entity with a new unique EntityId
        * All entities are deleted when entity manager is deleted.
@@ -130,6 +177,15 @@ namespace dtEntity
        */
       bool CreateEntity(Entity*& entity);
 
+      /**
+       * Create count new entities, taking the creation lock only once.
+       * @param count Number of entities to create
+       * @param entities New entities are appended to this vector
+       * @return true if all entities were created
+       * @threadsafe
+       */
+      bool CreateEntities(unsigned int count, std::vector<Entity*>& entities);
+
       /**
        * Loops through all components of origin and creates them on target entity
        * @param target ID of an existing entity with no components
@@ -159,6 +215,18 @@ namespace dtEntity
        */
       bool RemoveFromScene(EntityId eid);
 
+      /**
+       * @return true if t equals baseType or if the entity system of t
+       *         derives from baseType, directly or indirectly.
+       *         See EntitySystem::GetBaseType
+       */
+      bool IsComponentTypeOf(ComponentType t, ComponentType baseType) const;
+
+      /**
+       * @return true if an entity system derived from given type is registered
+       */
+      bool HasDerivedTypes(ComponentType t) const;
+
       /**
        * @param id Check if an entity system of this component type is active
        * @return true if such a system exists
@@ -221,8 +289,7 @@ namespace dtEntity
       bool GetComponent(EntityId eid, T*& component, bool searchDerived = false);
 
       /**
-       * Get all components of given entity
-       * Warning: slow. Iterates over all entity systems.
+       * Get all components of given entity, in order of creation
        * @param eid Get components of this entity
        * @param toFill receives components
        */
@@ -293,6 +360,18 @@ namespace dtEntity
          return mMessagePump.UnregisterForMessages(msgtype, ftr);
       }
 
+      // See messagepump.h for documentation
+      inline void RegisterForMessages(MessageType msgtype, EntityId about, MessageFunctor& ftr, unsigned int options = FilterOptions::DEFAULT, const std::string& funcname = "")
+      {
+         mMessagePump.RegisterForMessages(msgtype, about, ftr, options, funcname);
+      }
+
+      // See messagepump.h for documentation
+      inline bool UnregisterForMessages(MessageType msgtype, EntityId about, MessageFunctor& ftr)
+      {
+         return mMessagePump.UnregisterForMessages(msgtype, about, ftr);
+      }
+
       // See messagepump.h for documentation
       inline void EmitMessage(const Message& msg)
       {
@@ -300,9 +379,43 @@ namespace dtEntity
       }
 
       // See messagepump.h for documentation
-      inline void EnqueueMessage(const Message& msg, double time = 0)
+      template<class T>
+      void RegisterForTypedMessages(const typename TypedMessageFunctor<T>::type& ftr,
+         unsigned int options = FilterOptions::DEFAULT, const std::string& funcname = "")
       {
-         mMessagePump.EnqueueMessage(msg, time);
+         mMessagePump.RegisterForTypedMessages<T>(ftr, options, funcname);
+      }
+
+      // See messagepump.h for documentation
+      template<class T>
+      bool UnregisterForTypedMessages(const typename TypedMessageFunctor<T>::type& ftr)
+      {
+         return mMessagePump.UnregisterForTypedMessages<T>(ftr);
+      }
+
+      // See messagepump.h for documentation
+      template<class T>
+      void EmitTypedMessage(const T& msg)
+      {
+         mMessagePump.EmitTypedMessage(msg);
+      }
+
+      // See messagepump.h for documentation
+      inline unsigned int EnqueueMessage(const Message& msg, double time = 0)
+      {
+         return mMessagePump.EnqueueMessage(msg, time);
+      }
+
+      // See messagepump.h for documentation
+      inline void EnqueueMessageCoalesced(const Message& msg, unsigned int key)
+      {
+         mMessagePump.EnqueueMessageCoalesced(msg, key);
+      }
+
+      // See messagepump.h for documentation
+      inline bool CancelMessage(unsigned int handle)
+      {
+         return mMessagePump.CancelMessage(handle);
       }
 
       // See messagepump.h for documentation
@@ -311,31 +424,68 @@ namespace dtEntity
          mMessagePump.EmitQueuedMessages(simtime);
       }
 
+      /**
+       * Register tick handler of an entity system. If a SystemScheduler is
+       * attached the handler runs on it, with the component access that the
+       * system declares in EntitySystem::GetComponentAccess. Else it is
+       * registered for TickData messages with default filter options.
+       */
+      void RegisterForTick(EntitySystem& es, const TypedMessageFunctor<TickData>::type& ftr, const std::string& funcname);
+
+      /**
+       * @return false if functor was not registered with RegisterForTick
+       */
+      bool UnregisterForTick(const TypedMessageFunctor<TickData>::type& ftr);
+
+      /**
+       * Called by SystemScheduler::Attach and Detach. Moves the handlers
+       * registered with RegisterForTick to the scheduler or back to the
+       * message pump. Pass NULL to remove scheduler.
+       */
+      void SetSystemScheduler(SystemScheduler* scheduler);
+      SystemScheduler* GetSystemScheduler() const { return mSystemScheduler; }
+
       void AddDeletedCallback(ComponentDeletedCallback* cb);
       bool RemoveDeletedCallback(ComponentDeletedCallback* cb);
 
       void AddEntitySystemRequestCallback(EntitySystemRequestCallback* cb);
       bool RemoveEntitySystemRequestCallback(EntitySystemRequestCallback* cb);
 
+      void AddComponentObserver(ComponentObserver* obs);
+      bool RemoveComponentObserver(ComponentObserver* obs);
+
 
    private:
 
-      // Returns next id and increments internal counter
-      EntityId GetNextAvailableID();
+      friend class Entity;
+
+      void OnEndOfFrame(const EndOfFrameData& msg);
+
+      // delete components of entity, calling the component deleted callbacks
+      void DeleteAllComponents(Entity& entity);
 
-      unsigned int mNextAvailableId;
+      // called by Entity::AddComponentSystem / RemoveComponentSystem
+      void NotifyComponentAdded(EntityId id, EntitySystem& es);
+      void NotifyComponentRemoved(EntityId id, EntitySystem& es);
 
       /**
        * Look in type hierarchy map if a component derived from type exists
        */
       bool GetDerived(EntityId eid, ComponentType ctype, Component*& comp) const;
 
-      // storage for entity objects.
-      typedef std::map<EntityId,Entity*> EntityMap;
-      EntityMap mEntities;
+      struct TickRegistration
+      {
+         EntitySystem* mSystem;
+         TypedMessageFunctor<TickData>::type mFunctor;
+         std::string mName;
+      };
 
-      // controls access to mEntities.
-      mutable OpenThreads::ReadWriteMutex mEntityMutex;
+      // add handler to scheduler or message pump
+      void AddTickHandler(const TickRegistration& reg);
+      void RemoveTickHandler(const TickRegistration& reg);
+
+      // storage for entity objects.
+      EntityTable mEntities;
 
       // Storage for entity systems
       typedef std::map<ComponentType, EntitySystem*> EntitySystemStore;
@@ -352,6 +502,18 @@ namespace dtEntity
 
       EntitySystemRequestCallbacks mEntitySystemRequestCallbacks;
 
+      ComponentObservers mComponentObservers;
+
+      // entities queued with KillEntityDeferred
+      std::vector<EntityId> mDeferredKills;
+      OpenThreads::Mutex mDeferredKillsMutex;
+
+      TypedMessageFunctor<EndOfFrameData>::type mEndOfFrameFunctor;
+
+      // handlers registered with RegisterForTick, in order of registration
+      std::vector<TickRegistration> mTickRegistrations;
+      SystemScheduler* mSystemScheduler;
+
    };
 
 
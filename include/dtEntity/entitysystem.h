@@ -26,6 +26,7 @@
 #include <dtEntity/entityid.h>
 #include <dtEntity/stringid.h>
 #include <list>
+#include <vector>
 
 namespace dtEntity
 {
@@ -88,6 +89,10 @@ namespace dtEntity
       virtual bool GetComponent(EntityId eid, const Component*& component) { return false; }
       
       /**
+       * Implementations have to call Entity::AddComponentSystem on success
+       * and Entity::RemoveComponentSystem in DeleteComponent, otherwise
+       * the entity manager will not find the component when the
+       * entity is killed or cloned.
        * @param eid Create a component for the entity with this id.
        * @param component Receives the component if it was succesfully created
        * @return true if success
@@ -110,6 +115,30 @@ namespace dtEntity
        */
       virtual void GetEntitiesInSystem(std::list<EntityId>& toFill) const { }
 
+      /**
+       * Put ids of all entities registered with this system into toFill.
+       * Default implementation copies result of list version, override
+       * for speed.
+       */
+      virtual void GetEntitiesInSystem(std::vector<EntityId>& toFill) const
+      {
+         std::list<EntityId> l;
+         GetEntitiesInSystem(l);
+         toFill.insert(toFill.end(), l.begin(), l.end());
+      }
+
+      /**
+       * @return number of components held by this system.
+       * Default implementation counts result of GetEntitiesInSystem, override
+       * for speed.
+       */
+      virtual std::size_t GetNumComponents() const
+      {
+         std::list<EntityId> l;
+         GetEntitiesInSystem(l);
+         return l.size();
+      }
+
       /**
        * Get property names and default property values of component. Used
        * for spawner creation
@@ -145,6 +174,21 @@ namespace dtEntity
        */
       virtual bool StorePropertiesToScene() const { return false; }
 
+      /**
+       * Override to declare the component types that the tick handler
+       * registered with EntityManager::RegisterForTick reads and writes.
+       * A SystemScheduler runs handlers concurrently if their sets do not
+       * conflict. Components of derived types are declared with their
+       * base type too, for example Camera and Transform, so that handlers
+       * accessing them through the base type conflict. A handler with
+       * declared sets must not emit messages, see MessagePump::IsEmitAllowed.
+       * @return false if access is not declared, handler then runs alone
+       */
+      virtual bool GetComponentAccess(std::vector<ComponentType>& reads, std::vector<ComponentType>& writes) const
+      {
+         return false;
+      }
+
    private:
 
       // no copy ctor
@@ -0,0 +1,168 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/entityid.h>
+#include <dtEntity/export.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <deque>
+#include <vector>
+
+namespace dtEntity
+{
+   class Entity;
+   class EntityManager;
+
+   /**
+    * Storage for entity objects, owned by the entity manager.
+    * Entities live in fixed-size chunks that are allocated on demand
+    * and never moved or freed before the table is destroyed, so entity
+    * pointers stay valid and lookups need no lock.
+    * Slots of killed entities are recycled with an incremented
+    * generation, see entityid.h.
+    *
+    * Create and Destroy are serialized by a mutex, Get and Contains are
+    * lock-free and O(1).
+    */
+   class DT_ENTITY_EXPORT EntityTable
+   {
+   public:
+
+      EntityTable();
+
+      // Destroys all remaining entities
+      ~EntityTable();
+
+      /**
+       * Create a new entity in a free slot.
+       * @return new entity or NULL if maximum number of entities is reached
+       * @threadsafe
+       */
+      Entity* Create(EntityManager& em);
+
+      /**
+       * Create count entities while holding the lock only once.
+       * New entities are appended to toFill.
+       * @return number of entities created
+       * @threadsafe
+       */
+      unsigned int Create(EntityManager& em, unsigned int count, std::vector<Entity*>& toFill);
+
+      /**
+       * Destroy entity and release its slot for reuse.
+       * @return false if id does not belong to a living entity
+       * @threadsafe
+       */
+      bool Destroy(EntityId id);
+
+      /**
+       * Destroy all given entities while holding the lock only once.
+       * @return number of entities destroyed
+       * @threadsafe
+       */
+      unsigned int Destroy(const std::vector<EntityId>& ids);
+
+      /**
+       * @return entity with given id or NULL if entity does not exist
+       *         or id is a stale handle
+       * @threadsafe
+       */
+      Entity* Get(EntityId id) const;
+
+      /**
+       * @return true if entity with given id exists
+       * @threadsafe
+       */
+      bool Contains(EntityId id) const;
+
+      /**
+       * @return number of living entities
+       * @threadsafe
+       */
+      unsigned int GetNumEntities() const { return mNumEntities; }
+
+      /**
+       * Append ids of all living entities, in slot order
+       */
+      void GetEntityIds(std::vector<EntityId>& toFill) const;
+
+      /**
+       * Destroy all entities. Generations are kept so that
+       * handles created before are still detected as stale.
+       */
+      void Clear();
+
+   private:
+
+      enum
+      {
+         CHUNK_BITS = 12,
+         CHUNK_SIZE = 1 << CHUNK_BITS,
+         MAX_CHUNKS = 1 << (ENTITY_INDEX_BITS - CHUNK_BITS),
+
+         // freed slots are only reused when at least this many are free.
+         // Spreads reuse over many slots so that generations wrap slowly.
+         MIN_FREE_SLOTS = 1024
+      };
+
+      struct Chunk
+      {
+         Chunk();
+         ~Chunk();
+
+         // raw storage for entity objects, constructed in place on creation
+         Entity* mEntities;
+
+         // id of living entity in slot or 0 if slot is free.
+         OpenThreads::Atomic mIds[CHUNK_SIZE];
+
+         // generation to use for next entity created in slot
+         unsigned int mGenerations[CHUNK_SIZE];
+      };
+
+      Chunk* GetChunk(unsigned int index) const
+      {
+         return static_cast<Chunk*>(mChunks[index >> CHUNK_BITS].get());
+      }
+
+      Entity* CreateUnlocked(EntityManager& em);
+      bool DestroyUnlocked(EntityId id);
+
+      // no copy ctor
+      EntityTable(const EntityTable&);
+      EntityTable& operator=(const EntityTable&);
+
+      // chunk pointers are written once under mutex, read without lock
+      OpenThreads::AtomicPtr mChunks[MAX_CHUNKS];
+
+      // number of slots ever handed out, including reserved slot 0
+      unsigned int mNumSlots;
+
+      OpenThreads::Atomic mNumEntities;
+
+      std::deque<unsigned int> mFreeSlots;
+
+      // serializes Create, Destroy and Clear
+      mutable OpenThreads::Mutex mMutex;
+   };
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/systeminterface.h>
+#include <string>
+#include <vector>
+
+namespace dtEntity
+{
+   class MessagePump;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * System interface for servers and batch simulations without a window.
+    * Simulation advances in fixed time steps, independent of the frame rate
+    * of a viewer.
+    *
+    * With real time pacing enabled, Step() sleeps until the next tick is due.
+    * If the simulation falls behind, Step() runs up to MaxCatchUpTicks ticks
+    * to catch up and drops the rest of the backlog.
+    * Without pacing, every Step() runs one tick as fast as possible.
+    *
+    * Usage:
+    * HeadlessSystemInterface* iface = new HeadlessSystemInterface(em.GetMessagePump(), argc, argv);
+    * SetSystemInterface(iface);
+    * iface->SetFixedTimeStep(1.0f / 30.0f);
+    * while(running) iface->Step();
+    */
+   class DT_ENTITY_EXPORT HeadlessSystemInterface : public SystemInterface
+   {
+   public:
+
+      HeadlessSystemInterface(MessagePump& pump, int argc, const char** argv);
+
+      /**
+       * Simulation time advanced per tick in seconds, before time scale
+       * is applied. Default is 1/60 s.
+       */
+      void SetFixedTimeStep(float v);
+      float GetFixedTimeStep() const { return mFixedTimeStep; }
+
+      /**
+       * If true, Step() keeps ticks in sync with wall clock time.
+       * If false, Step() runs one tick immediately. Default is true.
+       */
+      void SetRealTimePacing(bool v);
+      bool GetRealTimePacing() const { return mRealTimePacing; }
+
+      /**
+       * Maximum number of ticks a single Step() runs to catch up
+       * with real time. Default is 5.
+       */
+      void SetMaxCatchUpTicks(unsigned int v) { mMaxCatchUpTicks = v; }
+      unsigned int GetMaxCatchUpTicks() const { return mMaxCatchUpTicks; }
+
+      /**
+       * Run ticks that are due, see class description
+       * @return number of ticks run
+       */
+      unsigned int Step();
+
+      /**
+       * Advance time by one fixed time step and emit tick, queued, end of frame
+       * and post update messages, ignoring pacing
+       */
+      void Tick();
+
+      /** Number of ticks run since construction */
+      unsigned int GetNumTicks() const { return mNumTicks; }
+
+      /** Number of ticks dropped because catch up limit was reached */
+      unsigned int GetNumDroppedTicks() const { return mNumDroppedTicks; }
+
+      virtual void EmitTickMessagesAndQueuedMessages();
+      virtual void EmitPostUpdateMessage();
+
+      virtual float GetDeltaSimTime() const { return mDeltaSimTime; }
+      virtual float GetDeltaRealTime() const { return mDeltaRealTime; }
+
+      virtual float GetTimeScale() const { return mTimeScale; }
+      virtual void SetTimeScale(float v);
+
+      virtual double GetSimulationTime() const { return mSimulationTime; }
+      virtual void SetSimulationTime(double v);
+
+      virtual Timer_t GetSimulationClockTime() const { return mSimulationClockTime; }
+      virtual void SetSimulationClockTime(Timer_t t);
+
+      virtual Timer_t GetRealClockTime() const;
+
+      virtual void AddDataFilePath(const std::string& path);
+      virtual std::string GetDataFilePathFromFilePath(const std::string& path) const;
+      virtual std::string FindDataFile(const std::string& filename) const;
+      virtual std::string FindLibraryFile(const std::string& filename) const;
+      virtual bool FileExists(const std::string& filename) const;
+      virtual DirectoryContents GetDirectoryContents(const std::string& dirName) const;
+
+      /**
+       * Writes warnings and errors to stderr, everything else to stdout
+       */
+      virtual void LogMessage(unsigned int level, const std::string& filename,
+         const std::string& methodname, int linenumber, const std::string& msg) const;
+
+      virtual int GetArgC() { return mArgC; }
+      virtual std::vector<std::string> GetArgV() { return mArgV; }
+
+   private:
+
+      void EmitTimeChanged();
+
+      MessagePump* mMessagePump;
+
+      float mFixedTimeStep;
+      bool mRealTimePacing;
+      unsigned int mMaxCatchUpTicks;
+
+      float mDeltaSimTime;
+      float mDeltaRealTime;
+      float mTimeScale;
+      double mSimulationTime;
+      Timer_t mSimulationClockTime;
+
+      // real time of last tick
+      Timer_t mLastTickTime;
+
+      // real time in seconds since mPacingStart at which next tick is due
+      double mNextTickTime;
+      Timer_t mPacingStart;
+      bool mPacingStarted;
+
+      unsigned int mNumTicks;
+      unsigned int mNumDroppedTicks;
+
+      int mArgC;
+      std::vector<std::string> mArgV;
+   };
+}
@@ -43,6 +43,28 @@ namespace dtEntity
          LVL_WARNING,
          LVL_INFO         
       };
+
+      // bit masks for filtering log levels, see LogListener::SetLevelMask
+      enum Mask
+      {
+         MASK_ALWAYS  = 1 << LVL_ALWAYS,
+         MASK_ERROR   = 1 << LVL_ERROR,
+         MASK_DEBUG   = 1 << LVL_DEBUG,
+         MASK_WARNING = 1 << LVL_WARNING,
+         MASK_INFO    = 1 << LVL_INFO,
+         MASK_ALL     = MASK_ALWAYS | MASK_ERROR | MASK_DEBUG | MASK_WARNING | MASK_INFO
+      };
+
+      /**
+       * @return upper case name of level, for example "WARNING"
+       */
+      DT_ENTITY_EXPORT const char* GetName(e level);
+
+      /**
+       * Parse level name as returned by GetName, case insensitive
+       * @return false if name is not a log level
+       */
+      bool DT_ENTITY_EXPORT FromName(const std::string& name, e& level);
    }
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -50,14 +72,37 @@ namespace dtEntity
          : public osg::Referenced
    {
    public:
+      LogListener()
+         : mLevelMask(LogLevel::MASK_ALL)
+      {
+      }
+
       virtual void LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
                       const std::string& msg) = 0;
 
+      /**
+       * Bit mask of LogLevel::Mask values, only messages of these levels
+       * are passed to LogMessage. Default is LogLevel::MASK_ALL
+       */
+      inline void SetLevelMask(unsigned int mask);
+      unsigned int GetLevelMask() const { return mLevelMask; }
+
    protected:
       virtual ~LogListener() { }
+
+   private:
+      // read by logging threads while SetLevelMask may write it
+      volatile unsigned int mLevelMask;
    };
 
    ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Distributes log messages to log listeners.
+    * A message is only formatted if its level passes the global log level
+    * and at least one listener accepts it. The LOG_XXX macros in log.h check
+    * IsLevelEnabled before building the message, so disabled levels cost a
+    * single memory read.
+    */
    class DT_ENTITY_EXPORT LogManager
          : public dtEntity::Singleton<LogManager>
    {
@@ -65,18 +110,66 @@ namespace dtEntity
 
       typedef std::vector<osg::ref_ptr<LogListener> > Listeners;
 
+      LogManager();
+
+      /**
+       * @return true if a message of given level would reach a listener
+       * @threadsafe
+       */
+      static bool IsLevelEnabled(LogLevel::e level)
+      {
+         return (sEnabledLevels & (1u << level)) != 0;
+      }
+
+      /**
+       * Pass message to all listeners that accept its level.
+       * Does not copy the listener list.
+       * @threadsafe
+       */
       void LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
                       const std::string& msg) const;
 
+      /**
+       * Only log messages of given level and more severe levels.
+       * Severity from high to low is ALWAYS, ERROR, WARNING, INFO, DEBUG.
+       * Default is LVL_DEBUG, which lets all messages pass.
+       * @threadsafe
+       */
+      void SetLogLevel(LogLevel::e level);
+      LogLevel::e GetLogLevel() const;
+
       void AddListener(LogListener* l);
       void RemoveListener(LogListener* l);
 
       Listeners::size_type GetNumListeners() const;
       LogListener* GetListener(Listeners::size_type index) const;
 
+      /**
+       * Recompute which levels are enabled. Called when log level or
+       * a listener level mask changes
+       */
+      void UpdateEnabledLevels();
+
    private:
-      Listeners mListeners;
+
+      // immutable copy of listener list, replaced when listeners change
+      struct ListenerList : public osg::Referenced
+      {
+         Listeners mListeners;
+      };
+
+      // bit mask of levels that pass log level and at least one listener mask
+      static volatile unsigned int sEnabledLevels;
+
+      osg::ref_ptr<const ListenerList> mListeners;
+      LogLevel::e mLogLevel;
       mutable OpenThreads::Mutex mMutex;
    };
 
+   ////////////////////////////////////////////////////////////////////////////////
+   inline void LogListener::SetLevelMask(unsigned int mask)
+   {
+      mLevelMask = mask;
+      LogManager::GetInstance().UpdateEnabledLevels();
+   }
 }
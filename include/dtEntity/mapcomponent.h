@@ -123,6 +123,8 @@ namespace dtEntity
       bool GetVisibleInEntityList() const { return mVisibleInEntityList.Get(); }
 
    private:
+      static PropertySchema sPropertySchema;
+
       DynamicStringProperty mEntityName;
       DynamicStringProperty mEntityDescription;
       StringProperty mMapName;
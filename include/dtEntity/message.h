@@ -88,4 +88,15 @@ namespace dtEntity
    // Functors of this type can be registered to receive messages of a specific type.
    typedef fastdelegate::FastDelegate1< const Message&, void> MessageFunctor;
 
+   /**
+    * Functors of this type can be registered to receive typed messages,
+    * see MessagePump::RegisterForTypedMessages.
+    * Usage: TypedMessageFunctor<TickData>::type(this, &MySystem::Tick)
+    */
+   template<class T>
+   struct TypedMessageFunctor
+   {
+      typedef fastdelegate::FastDelegate1<const T&, void> type;
+   };
+
 }
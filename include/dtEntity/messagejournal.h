@@ -0,0 +1,202 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/messagepump.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dtEntity
+{
+   class EntityManager;
+
+   /**
+    * Binary message journal format. All values are stored in host byte order.
+    *
+    * header: char[4] "DTMJ", uint32 version
+    * record: uint32 record size in bytes, excluding this field
+    *         double simulation time
+    *         uint8  flags, see RecordFlags
+    *         uint32 message type hash
+    *         uint32 number of properties, then per property:
+    *         uint32 property name hash, uint8 DataType, value
+    *
+    * Arrays store uint32 count followed by DataType and value per element,
+    * groups store uint32 count followed by name, DataType and value.
+    */
+   namespace MessageJournal
+   {
+      enum { VERSION = 1 };
+
+      enum RecordFlags
+      {
+         // message was emitted or enqueued by a message handler
+         NESTED = 1 << 0
+      };
+
+      /**
+       * Append a record for msg to buffer
+       * @return false if message contains a property that cannot be encoded
+       */
+      bool DT_ENTITY_EXPORT EncodeRecord(const Message& msg, double simTime, unsigned char flags, std::string& buffer);
+   }
+
+   class JournalWriterThread;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Records all messages emitted through the message pump of an entity manager
+    * to a journal file. Simulation time of the records is taken from the
+    * last tick message.
+    *
+    * Messages are encoded in the emitting thread into chunks of memory.
+    * Full chunks are handed to a background thread through a lock-free
+    * queue and written to disk there.
+    * Written chunks are recycled, so recording does not allocate once
+    * it runs.
+    */
+   class DT_ENTITY_EXPORT MessageJournalRecorder
+      : public MessageReceiver
+   {
+   public:
+
+      MessageJournalRecorder(EntityManager& em);
+
+      // stops recording
+      ~MessageJournalRecorder();
+
+      /**
+       * Create journal file and start recording.
+       * Replaces other emit observer of message pump.
+       * @return false if file could not be opened
+       */
+      bool Start(const std::string& path);
+
+      /**
+       * Stop recording, write remaining records and close file
+       */
+      void Stop();
+
+      bool IsRecording() const { return mWriter != NULL; }
+
+      /** Number of records written since Start */
+      unsigned int GetNumRecords() const { return mNumRecords; }
+
+      // implement MessageReceiver interface, called by message pump.
+      // Not thread safe, messages have to be emitted from one thread at a time.
+      virtual void Receive(const Message& msg);
+
+   private:
+
+      enum { CHUNK_SIZE = 64 * 1024 };
+
+      // hand current chunk to writer thread and continue with a recycled one
+      void SubmitChunk();
+
+      // no copy ctor
+      MessageJournalRecorder(const MessageJournalRecorder&);
+      MessageJournalRecorder& operator=(const MessageJournalRecorder&);
+
+      EntityManager* mEntityManager;
+      JournalWriterThread* mWriter;
+
+      // chunk that records are appended to and chunks ready for reuse
+      std::string* mChunk;
+      std::vector<std::string*> mSpareChunks;
+
+      double mSimTime;
+      unsigned int mNumRecords;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Emits the messages of a journal file through an entity manager.
+    * Playback is not bound to real time, PlayAll emits the whole journal
+    * as fast as possible.
+    *
+    * By default only messages that were emitted from outside of message
+    * handlers are played back. Handlers of the entity manager emit the
+    * nested messages again, so a session is reproduced as it was recorded.
+    * Use SetPlayNested(true) to also emit nested messages, for example when
+    * replaying into an entity manager without the systems that emitted them.
+    */
+   class DT_ENTITY_EXPORT MessageJournalPlayer
+   {
+   public:
+
+      MessageJournalPlayer(EntityManager& em);
+      ~MessageJournalPlayer();
+
+      /**
+       * Read journal file into memory and rewind
+       * @return false if file could not be read or is not a message journal
+       */
+      bool Open(const std::string& path);
+
+      /**
+       * Emit all pending records with simulation time <= simTime
+       * @return number of emitted messages
+       */
+      unsigned int PlayUntil(double simTime);
+
+      /**
+       * Emit all pending records
+       * @return number of emitted messages
+       */
+      unsigned int PlayAll();
+
+      /** Start playback from first record again */
+      void Rewind() { mReadPos = mDataStart; }
+
+      bool AtEnd() const { return mReadPos >= mData.size(); }
+
+      /** Simulation time of next pending record, -1 if at end */
+      double GetNextTime() const;
+
+      void SetPlayNested(bool v) { mPlayNested = v; }
+      bool GetPlayNested() const { return mPlayNested; }
+
+   private:
+
+      // decode record at read position and advance. Returns NULL for skipped records
+      Message* DecodeRecord();
+
+      // get or create reusable message instance of given type
+      Message* GetCachedMessage(MessageType t);
+
+      // no copy ctor
+      MessageJournalPlayer(const MessageJournalPlayer&);
+      MessageJournalPlayer& operator=(const MessageJournalPlayer&);
+
+      EntityManager* mEntityManager;
+      std::string mData;
+      size_t mDataStart;
+      size_t mReadPos;
+      bool mPlayNested;
+
+      // decoded messages are reused for records of the same type
+      typedef std::map<MessageType, Message*> MessageCache;
+      MessageCache mMessageCache;
+   };
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/message.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <utility>
+#include <vector>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Keeps messages that were emitted from the message queue for reuse,
+    * sorted by message type. Acquire copies a message into a recycled
+    * instance of the same class, so that a queued message costs no heap
+    * allocation once the pool is filled.
+    *
+    * Acquire does not wait for the pool lock: if another thread holds it
+    * the message is cloned and counted as miss.
+    */
+   class DT_ENTITY_EXPORT MessagePool
+   {
+   public:
+
+      /**
+       * @param maxPerType Maximum number of messages kept per message type
+       */
+      MessagePool(unsigned int maxPerType = 64);
+      ~MessagePool();
+
+      /**
+       * Get a heap copy of msg. Recycles a pooled message of the same
+       * class if there is one, else calls msg.Clone().
+       * @threadsafe
+       */
+      Message* Acquire(const Message& msg);
+
+      /**
+       * Put message back to pool or delete it if pool of its type is full.
+       * Message must have been created with Acquire or Clone.
+       * @threadsafe
+       */
+      void Release(const Message* msg);
+
+      /**
+       * Release all messages in vector with a single lock
+       * @threadsafe
+       */
+      void Release(const std::vector<const Message*>& msgs);
+
+      /**
+       * Delete all pooled messages
+       */
+      void Clear();
+
+      /** Number of Acquire calls that recycled a pooled message */
+      unsigned int GetNumHits() const { return mHits; }
+
+      /** Number of Acquire calls that had to clone */
+      unsigned int GetNumMisses() const { return mMisses; }
+
+      void ResetCounters();
+
+      unsigned int GetMaxPerType() const { return mMaxPerType; }
+      void SetMaxPerType(unsigned int v) { mMaxPerType = v; }
+
+   private:
+
+      typedef std::vector<Message*> FreeList;
+      typedef std::vector<std::pair<MessageType, FreeList*> > TypePools;
+
+      FreeList& GetFreeList(MessageType t);
+
+      // returns message that has to be deleted or NULL if it was pooled
+      Message* ReleaseUnlocked(const Message* msg);
+
+      // no copy ctor
+      MessagePool(const MessagePool&);
+      MessagePool& operator=(const MessagePool&);
+
+      TypePools mPools;
+      unsigned int mMaxPerType;
+      OpenThreads::Mutex mMutex;
+      OpenThreads::Atomic mHits;
+      OpenThreads::Atomic mMisses;
+   };
+}
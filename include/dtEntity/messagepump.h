@@ -21,12 +21,19 @@
 *
 */
 
+#include <dtEntity/dtentity_config.h>
 #include <dtEntity/entityid.h>
 #include <dtEntity/export.h>
 #include <dtEntity/message.h>
-#include <dtEntity/threadsafequeue.h>
+#include <dtEntity/messagepool.h>
+#include <dtEntity/messagescheduler.h>
+#include <dtEntity/mpscqueue.h>
+#include <dtEntity/profiler.h>
+#include <dtEntity/sparsecomponentstore.h>
 #include <map>
 #include <list>
+#include <vector>
+#include <assert.h>
 
 namespace dtEntity
 {
@@ -44,6 +51,8 @@ namespace dtEntity
        * The UNREGISTERED bit has to be set to false. It is used internally to mark
        * deregistered functors for removal.
        *
+       * TYPED is also set internally, it marks functors registered with RegisterForTypedMessages.
+       *
        * If SINGLE_SHOT is set then the functor is unregistered after it is called the first time.
        * Registrants can register for local messages, network messages, or both.
        * Message senders can send a message to local or network or both.
@@ -60,6 +69,7 @@ namespace dtEntity
          ORDER_EARLIEST                  = 3,
          UNREGISTERED                    = (1<<3),    
          SINGLE_SHOT                     = (1<<4),
+         TYPED                           = (1<<5),
          
          DEFAULT  = ORDER_DEFAULT
       };
@@ -75,16 +85,12 @@ namespace dtEntity
    struct MsgRegistryEntry
    {
       unsigned int mOptions;
+
+      // if TYPED option is set this holds the memento of a TypedMessageFunctor
       MessageFunctor mFunctor;    
       StringId mFuncName;
    };
 
-   struct FutureMessageEntry
-   {
-      double mTimeToPost;
-      Message* mMessage;
-   };
-
 
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +102,16 @@ namespace dtEntity
       virtual void Receive(const dtEntity::Message& msg) = 0;
    };
 
+   ////////////////////////////////////////////////////////////////////////////////
+   // entry of the message queue of MessagePump
+   struct QueuedMessageEntry
+   {
+      const Message* mMessage;
+
+      // enqueued by a message handler, see MessagePump::IsEmittingNested
+      bool mNested;
+   };
+
    ////////////////////////////////////////////////////////////////////////////////
 
 
@@ -104,9 +120,9 @@ namespace dtEntity
    {
    public:
 
-      // thread safe message queue. The int stores the sending options.
-      typedef ThreadSafeQueue<const Message*> MessageQueue;
-      typedef ThreadSafeQueue<FutureMessageEntry> FutureMessageQueue;
+      // lock-free message queues, filled from any thread and drained in EmitQueuedMessages
+      typedef MPSCQueue<QueuedMessageEntry> MessageQueue;
+      typedef MPSCQueue<FutureMessageEntry> FutureMessageQueue;
 
       /**
        * CTor
@@ -141,6 +157,37 @@ namespace dtEntity
       */
       virtual bool IsRegistered(MessageType msgtype, const MessageFunctor& ftr);
 
+      /**
+      * Register a functor to be called only for messages of given type that
+      * name the given entity in their AboutEntity property.
+      * These functors are looked up by entity id, they are not visited
+      * for messages about other entities. They are called after the functors
+      * registered for all messages of the type.
+      * Typed messages are not delivered to these functors.
+      */
+      void RegisterForMessages(MessageType msgtype, EntityId about, MessageFunctor ftr,
+         unsigned int options = FilterOptions::DEFAULT, const std::string& funcname = "");
+
+      /**
+      * Unregister functor registered for messages about an entity
+      * @return true if success
+      */
+      bool UnregisterForMessages(MessageType msgtype, EntityId about, MessageFunctor& ftr);
+
+      /**
+      * returns true if functor is registered to messages about entity
+      */
+      bool IsRegistered(MessageType msgtype, EntityId about, const MessageFunctor& ftr);
+
+      /**
+      * Unregister all functors registered for messages about entity.
+      * Called by the entity manager when the entity is killed.
+      */
+      void UnregisterForEntity(EntityId about);
+
+      // name of the property holding the entity id a message is about
+      static const StringId AboutEntityId;
+
       /**
       * Immediately send a message to all registered functors
       * Warning: beware of circular dependencies!
@@ -148,13 +195,165 @@ namespace dtEntity
       */
       void EmitMessage(const Message& msg);
 
+      /**
+       * Observer receives every message passed to EmitMessage or
+       * EmitTypedMessage before the handlers are called, also if no
+       * handler is registered. Typed messages are passed in property form.
+       * IsEmittingNested tells observer if message was emitted by a handler.
+       * Observer is not owned, set NULL to remove it.
+       */
+      void SetEmitObserver(MessageReceiver* o) { mEmitObserver = o; }
+      MessageReceiver* GetEmitObserver() const { return mEmitObserver; }
+
+      /**
+       * Number of messages currently being emitted, 0 when not called
+       * from a message handler
+       */
+      unsigned int GetEmitDepth() const { return mEmitDepth; }
+
+      /**
+       * @return true if the message being emitted was emitted by a message
+       *         handler or was enqueued while a message was emitted.
+       *         Handlers enqueue these messages again when the messages
+       *         that triggered them are replayed.
+       */
+      bool IsEmittingNested() const { return mEmitDepth > 0 || mEmittingQueuedNested; }
+
+      /**
+       * EmitMessage and EmitTypedMessage are not thread safe. SystemScheduler
+       * brackets tick handlers that may run concurrently with these calls,
+       * emitting in between fails an assertion in debug builds.
+       * Such handlers have to use EnqueueMessage instead.
+       * @threadsafe
+       */
+      void BeginNoEmitSection() { ++mNoEmitSections; }
+      void EndNoEmitSection() { --mNoEmitSections; }
+
+      /**
+       * @return false while a concurrent tick handler may be running
+       * @threadsafe
+       */
+      bool IsEmitAllowed() const { return mNoEmitSections == 0; }
+
+      /**
+       * Register a functor for typed messages. A typed message is a plain struct
+       * that is passed to its handlers without building a property container.
+       * T has to define a typedef PropertyMessage naming the property based
+       * message class with methods SetData(const T&) and GetData(T&) const,
+       * see TickData in systemmessages.h.
+       * Typed and property functors for the same message share one
+       * list and are called in the order of their priority.
+       * Property based messages of type T::PropertyMessage::TYPE are
+       * delivered to typed functors too if they are of class T::PropertyMessage,
+       * messages of other classes only reach the property functors.
+       */
+      template<class T>
+      void RegisterForTypedMessages(const typename TypedMessageFunctor<T>::type& ftr,
+         unsigned int options = FilterOptions::DEFAULT, const std::string& funcname = "")
+      {
+         HandlerList& handlers = RegisterEntry(T::PropertyMessage::TYPE, ToMessageFunctor<T>(ftr),
+            options | FilterOptions::TYPED, funcname);
+         handlers.mBridge = &BridgeTyped<T>;
+      }
+
+      template<class T>
+      bool UnregisterForTypedMessages(const typename TypedMessageFunctor<T>::type& ftr)
+      {
+         MessageFunctor f = ToMessageFunctor<T>(ftr);
+         return UnregisterForMessages(T::PropertyMessage::TYPE, f);
+      }
+
+      template<class T>
+      bool IsRegisteredForTypedMessages(const typename TypedMessageFunctor<T>::type& ftr)
+      {
+         return IsRegistered(T::PropertyMessage::TYPE, ToMessageFunctor<T>(ftr));
+      }
+
+      /**
+       * Immediately send a typed message to all registered functors.
+       * A T::PropertyMessage is only constructed if property based
+       * functors (scripts, network, ...) are registered for it.
+       */
+      template<class T>
+      void EmitTypedMessage(const T& msg)
+      {
+         assert(IsEmitAllowed() && "Cannot emit from concurrent tick handler, use EnqueueMessage");
+         if(mEmitObserver != NULL)
+         {
+            ObserveTyped(msg);
+         }
+         unsigned int index = TypedMessageIndex<T>();
+         HandlerList* handlers = (index < mTypedHandlers.size()) ? mTypedHandlers[index] : NULL;
+         if(handlers == NULL)
+         {
+            handlers = &GetTypedHandlers(index, T::PropertyMessage::TYPE);
+         }
+         if(handlers->mEntries.empty())
+         {
+            return;
+         }
+         ++mEmitDepth;
+         if(handlers->mNumPropertyEntries == 0)
+         {
+            DispatchTyped(*handlers, msg, NULL);
+         }
+         else
+         {
+            typename T::PropertyMessage propmsg;
+            propmsg.SetData(msg);
+            DispatchTyped(*handlers, msg, &propmsg);
+         }
+         --mEmitDepth;
+      }
+
       /**
       * Enqueue message and emit it on next PreFrame event
       * @param when Future simulation time that event should be emitted at 
       * ( 0 means emit immediately) 
+      * Messages enqueued while emit depth is above 0 are marked as nested,
+      * see IsEmittingNested.
+      * @return Handle for CancelMessage if message was scheduled for
+      *         future time, else 0
       */
       void EnqueueMessage(const Message& msg);
-      void EnqueueMessage(const Message& msg, double when);
+      unsigned int EnqueueMessage(const Message& msg, double when);
+
+      /**
+       * Enqueue message, replacing a queued message of the same type
+       * that was enqueued with the same key and was not yet emitted.
+       * The replaced message keeps its place in the queue and gets the
+       * property values of msg. For bursty producers that only care about
+       * the latest state, for example one message per entity id.
+       * @param key User defined key, usually an entity id
+       * @threadsafe
+       */
+      void EnqueueMessageCoalesced(const Message& msg, unsigned int key);
+
+      /**
+       * Number of messages dropped by EnqueueMessageCoalesced because
+       * a queued message was replaced
+       */
+      unsigned int GetNumCoalescedDrops() const { return mNumCoalescedDrops; }
+
+      /**
+       * Number of dropped messages of given type
+       */
+      unsigned int GetNumCoalescedDrops(MessageType t);
+
+      void ResetCoalescedDrops();
+
+      /**
+       * Revoke a message scheduled for future time.
+       * Has to be called from the thread that calls EmitQueuedMessages.
+       * @param handle Handle returned by EnqueueMessage
+       * @return true if message was pending and is now removed
+       */
+      bool CancelMessage(unsigned int handle);
+
+      /**
+       * Number of messages scheduled for future time
+       */
+      unsigned int GetNumFutureMessages();
 
       // implement MessageReceiver interface
       virtual void Receive(const dtEntity::Message& msg)
@@ -177,19 +376,250 @@ namespace dtEntity
        */
       void UnregisterAll();
 
+      /**
+       * Queued messages are copied into recycled messages from this pool.
+       * Use its hit and miss counters to size it.
+       */
+      MessagePool& GetMessagePool() { return mMessagePool; }
+      const MessagePool& GetMessagePool() const { return mMessagePool; }
+
    protected:
 
-      // Registry for message functors
-      typedef std::multimap<MessageType, MsgRegistryEntry> MessageFunctorRegistry;
+      /*
+       * Functors registered for one message type, ordered by priority.
+       * While the list is being emitted mEntries is not resized: new
+       * registrations go to mPending and unregistered or single shot
+       * entries are only flagged. Flagged entries are removed and pending
+       * ones merged in after the outermost emit is done.
+       */
+      struct HandlerList;
+
+      // converts a property message to typed form and emits it to all functors
+      typedef void (*TypedBridge)(MessagePump&, HandlerList&, const Message&);
+
+      struct HandlerList
+      {
+         HandlerList()
+            : mEmitDepth(0)
+            , mNeedsCompaction(false)
+            , mNumTypedEntries(0)
+            , mNumPropertyEntries(0)
+            , mBridge(NULL)
+            , mEntityHandlers(NULL)
+         {
+         }
+
+         ~HandlerList();
+
+         std::vector<MsgRegistryEntry> mEntries;
+         std::vector<MsgRegistryEntry> mPending;
+         unsigned int mEmitDepth;
+         bool mNeedsCompaction;
+
+         // number of typed and property functors in mEntries,
+         // updated when mEntries is resized
+         unsigned int mNumTypedEntries;
+         unsigned int mNumPropertyEntries;
+
+         // set when typed functors are registered
+         TypedBridge mBridge;
+
+         // functors registered for messages about a single entity.
+         // Created on first entity registration
+         ComponentStoreSparseSet<HandlerList>* mEntityHandlers;
+      };
+
+      /**
+       * Dense index of a typed message class, used to look up
+       * its handler list without searching.
+       */
+      static unsigned int GetTypedMessageIndex(MessageType msgtype);
+
+      template<class T>
+      static unsigned int TypedMessageIndex()
+      {
+         static const unsigned int index = GetTypedMessageIndex(T::PropertyMessage::TYPE);
+         return index;
+      }
+
+      template<class T>
+      static MessageFunctor ToMessageFunctor(const typename TypedMessageFunctor<T>::type& ftr)
+      {
+         // GetMemento is not const
+         typename TypedMessageFunctor<T>::type copy(ftr);
+         MessageFunctor f;
+         f.SetMemento(copy.GetMemento());
+         return f;
+      }
+
+      template<class T>
+      static void BridgeTyped(MessagePump& pump, HandlerList& handlers, const Message& msg)
+      {
+         const typename T::PropertyMessage* propmsg = dynamic_cast<const typename T::PropertyMessage*>(&msg);
+         if(propmsg == NULL)
+         {
+            // typed functors cannot get the data, property functors still can
+            LogWrongMessageClass(msg);
+            pump.EmitToPropertyHandlers(handlers, msg);
+            return;
+         }
+         T data;
+         propmsg->GetData(data);
+         pump.DispatchTyped(handlers, data, &msg);
+      }
+
+      // call typed functors with data and property functors with msg
+      template<class T>
+      void DispatchTyped(HandlerList& handlers, const T& data, const Message* msg)
+      {
+         ++handlers.mEmitDepth;
+         typename TypedMessageFunctor<T>::type typedftr;
+         size_t numEntries = handlers.mEntries.size();
+         for(size_t i = 0; i < numEntries; ++i)
+         {
+            MsgRegistryEntry& entry = handlers.mEntries[i];
+            if(!BeginCall(handlers, entry))
+            {
+               continue;
+            }
+#if DTENTITY_PROFILING_ENABLED
+            ProfileScope profile(entry.mFuncName);
+#endif
+            if((entry.mOptions & FilterOptions::TYPED) != 0)
+            {
+               typedftr.SetMemento(entry.mFunctor.GetMemento());
+               typedftr(data);
+            }
+            else if(msg != NULL)
+            {
+               entry.mFunctor(*msg);
+            }
+         }
+         EndEmit(handlers);
+      }
+
+      // returns false if entry is not to be called
+      static bool BeginCall(HandlerList& handlers, MsgRegistryEntry& entry)
+      {
+         if((entry.mOptions & FilterOptions::UNREGISTERED) != 0)
+         {
+            return false;
+         }
+         if((entry.mOptions & FilterOptions::SINGLE_SHOT) != 0)
+         {
+            entry.mOptions |= FilterOptions::UNREGISTERED;
+            handlers.mNeedsCompaction = true;
+         }
+         return true;
+      }
+
+      void EndEmit(HandlerList& handlers)
+      {
+         if(--handlers.mEmitDepth == 0 && (handlers.mNeedsCompaction || !handlers.mPending.empty()))
+         {
+            Compact(handlers);
+         }
+      }
+
+      static void LogWrongMessageClass(const Message& msg);
+
+      HandlerList& RegisterEntry(MessageType msgtype, const MessageFunctor& ftr, unsigned int options, const std::string& funcname);
+
+      // add entry to list, respecting a running emit
+      void AddEntry(HandlerList& handlers, const MsgRegistryEntry& e);
+      static bool RemoveEntry(HandlerList& handlers, const MessageFunctor& ftr);
+      static bool ContainsEntry(const HandlerList& handlers, const MessageFunctor& ftr);
+
+      // call all functors in list
+      void EmitToHandlers(HandlerList& handlers, const Message& msg);
+
+      // call functors in list that were not registered as typed functors
+      void EmitToPropertyHandlers(HandlerList& handlers, const Message& msg);
+
+      // call functors registered for the entity the message is about
+      void EmitToEntityHandlers(HandlerList& handlers, const Message& msg);
+
+      HandlerList* FindEntityHandlers(MessageType msgtype, EntityId about) const;
+
+      // delete list of entity functors if it is not used anymore
+      void ReleaseEntityHandlers(HandlerList& handlers, EntityId about);
+
+      // unregister all functors in list, lazily if list is being emitted
+      static void ClearHandlers(HandlerList& handlers);
+
+      // handler list for typed message index, created if not yet existing
+      HandlerList& GetTypedHandlers(unsigned int index, MessageType msgtype);
+
+      // move future messages from thread safe queue to scheduler
+      void ScheduleFutureMessages();
+
+      // pass typed message to emit observer in property form
+      template<class T>
+      void ObserveTyped(const T& msg)
+      {
+         typename T::PropertyMessage propmsg;
+         propmsg.SetData(msg);
+         mEmitObserver->Receive(propmsg);
+      }
+
+      // forget queued messages of EnqueueMessageCoalesced, called after taking them from queue
+      void ReleaseCoalescedMessages();
+
+      // emit message taken from queue, marked nested if a handler enqueued it
+      void EmitQueuedMessage(const Message& msg, bool nested);
+
+      HandlerList* FindHandlers(MessageType msgtype) const;
+      HandlerList& GetOrCreateHandlers(MessageType msgtype);
+      void Compact(HandlerList& handlers);
+      static void CountEntries(HandlerList& handlers);
+
+      // Registry for message functors, sorted by message type
+      typedef std::vector<std::pair<MessageType, HandlerList*> > MessageFunctorRegistry;
       MessageFunctorRegistry mMessageFunctors;
 
+      // handler lists of mMessageFunctors indexed by typed message index
+      std::vector<HandlerList*> mTypedHandlers;
+
+      // number of entity handler lists in all HandlerList::mEntityHandlers
+      unsigned int mNumEntityHandlerLists;
+
+      MessageReceiver* mEmitObserver;
+      unsigned int mEmitDepth;
+
+      // set while EmitQueuedMessages emits a message enqueued by a handler
+      bool mEmittingQueuedNested;
+
+      // number of running tick handlers that must not emit
+      OpenThreads::Atomic mNoEmitSections;
+
+
+      // recycles queued messages after they were emitted
+      MessagePool mMessagePool;
 
       // stores messages til next tick
       MessageQueue mMessageQueue;
 
+      // messages taken from mMessageQueue and emitted messages to release,
+      // kept as members to reuse their memory
+      std::vector<QueuedMessageEntry> mQueuedBatch;
+      std::vector<const Message*> mReleaseBatch;
+
+      // queued messages that EnqueueMessageCoalesced may still overwrite,
+      // by message type and key. Cleared when messages are taken from queue.
+      typedef std::map<std::pair<MessageType, unsigned int>, Message*> CoalescedMessages;
+      CoalescedMessages mCoalescedMessages;
+      std::map<MessageType, unsigned int> mCoalescedDropsByType;
+      OpenThreads::Mutex mCoalesceMutex;
+      OpenThreads::Atomic mNumCoalescedDrops;
+
       FutureMessageQueue mFutureMessageQueue;
+      std::vector<FutureMessageEntry> mFutureBatch;
+
       // stores messages until their time to post has come
-      std::list<FutureMessageEntry> mFutureMessages;
+      MessageScheduler mFutureMessages;
+
+      // source of future message handles
+      OpenThreads::Atomic mNextFutureId;
 
    };
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/message.h>
+#include <vector>
+
+namespace dtEntity
+{
+   /*
+    * A message to be emitted at a future simulation time
+    */
+   struct FutureMessageEntry
+   {
+      double mTimeToPost;
+      Message* mMessage;
+
+      // unique id, used as cancellation handle and to order
+      // entries with same time by enqueue order
+      unsigned int mId;
+
+      // enqueued by a message handler, see MessagePump::IsEmittingNested
+      bool mNested;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Priority queue of future messages, ordered by post time.
+    * A binary heap over slot indices: insertion, removal by id and popping
+    * the next due entry are O(log n), checking for due entries is O(1).
+    * Storage is reused, scheduling does not allocate once capacity is reached.
+    * Does not own the messages. Not thread safe.
+    */
+   class DT_ENTITY_EXPORT MessageScheduler
+   {
+   public:
+
+      void Insert(const FutureMessageEntry& entry);
+
+      /**
+       * Remove entry with given id.
+       * @param removed Receives the removed entry
+       * @return false if no entry with that id is scheduled
+       */
+      bool Remove(unsigned int id, FutureMessageEntry& removed);
+
+      /**
+       * Remove earliest entry if its post time is less or equal to now
+       * @return true if an entry was removed
+       */
+      bool PopDue(double now, FutureMessageEntry& popped);
+
+      bool Empty() const { return mHeap.empty(); }
+      unsigned int GetSize() const { return static_cast<unsigned int>(mHeap.size()); }
+
+      /**
+       * Post time of earliest entry. Queue must not be empty.
+       */
+      double GetNextTime() const { return mSlots[mHeap.front()].mEntry.mTimeToPost; }
+
+      /**
+       * Append all entries to toFill in no particular order and empty queue
+       */
+      void TakeAll(std::vector<FutureMessageEntry>& toFill);
+
+   private:
+
+      struct Slot
+      {
+         FutureMessageEntry mEntry;
+         unsigned int mHeapPos;
+      };
+
+      bool IsEarlier(unsigned int slotA, unsigned int slotB) const
+      {
+         const FutureMessageEntry& a = mSlots[slotA].mEntry;
+         const FutureMessageEntry& b = mSlots[slotB].mEntry;
+         return a.mTimeToPost < b.mTimeToPost ||
+               (a.mTimeToPost == b.mTimeToPost && a.mId < b.mId);
+      }
+
+      void SetHeapPos(unsigned int pos, unsigned int slot)
+      {
+         mHeap[pos] = slot;
+         mSlots[slot].mHeapPos = pos;
+      }
+
+      void SiftUp(unsigned int pos);
+      void SiftDown(unsigned int pos);
+      void RemoveAt(unsigned int pos, FutureMessageEntry& removed);
+
+      // bucket holding id or free bucket where it would be inserted
+      unsigned int FindBucket(unsigned int id) const;
+      void InsertId(unsigned int slot);
+      void EraseBucket(unsigned int bucket);
+      void ResizeIdTable(unsigned int numBuckets);
+
+      // entry storage, slots do not move while entry is scheduled
+      std::vector<Slot> mSlots;
+      std::vector<unsigned int> mFreeSlots;
+
+      // slot indices, earliest entry first
+      std::vector<unsigned int> mHeap;
+
+      // open addressing table of slot index + 1 by entry id, 0 marks a free
+      // bucket. Size is a power of two. Ids are handed out sequentially, so
+      // id modulo table size spreads them evenly.
+      std::vector<unsigned int> mSlotById;
+   };
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <assert.h>
+#include <vector>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Unbounded multi producer single consumer queue.
+    * Push may be called from any thread. PopAll takes all queued
+    * elements with a single atomic swap and must only be called from
+    * one thread at a time.
+    * Elements pushed by the same thread are popped in push order.
+    *
+    * Nodes are recycled: PopAll puts them on a free list that Push takes
+    * them from, so the queue does not allocate once it has seen its
+    * largest batch. The free list is guarded by a mutex that Push only
+    * try-locks, if it is taken Push allocates a new node instead of waiting.
+    */
+   template<class T>
+   class MPSCQueue
+   {
+   public:
+
+      MPSCQueue()
+         : mFreeNodes(NULL)
+      {
+      }
+
+      ~MPSCQueue()
+      {
+         DeleteNodes(Take());
+         DeleteNodes(mFreeNodes);
+      }
+
+      /**
+       * Add element to queue.
+       * @threadsafe
+       */
+      void Push(const T& t)
+      {
+         Node* n = NULL;
+         if(mFreeMutex.trylock() == 0)
+         {
+            n = mFreeNodes;
+            if(n != NULL)
+            {
+               mFreeNodes = n->mNext;
+            }
+            mFreeMutex.unlock();
+         }
+         if(n == NULL)
+         {
+            n = new Node(t);
+         }
+         else
+         {
+            n->mValue = t;
+         }
+
+         void* head;
+         do
+         {
+            head = mHead.get();
+            n->mNext = static_cast<Node*>(head);
+         }
+         while(!mHead.assign(n, head));
+      }
+
+      /**
+       * Append all queued elements to toFill in push order and empty queue.
+       * @return true if any elements were appended
+       */
+      bool PopAll(std::vector<T>& toFill)
+      {
+         Node* n = Take();
+         if(n == NULL)
+         {
+            return false;
+         }
+
+         // nodes are linked newest first, reverse
+         Node* reversed = NULL;
+         while(n != NULL)
+         {
+            Node* next = n->mNext;
+            n->mNext = reversed;
+            reversed = n;
+            n = next;
+         }
+
+         Node* last = reversed;
+         for(Node* i = reversed; i != NULL; i = i->mNext)
+         {
+            toFill.push_back(i->mValue);
+            i->mValue = T();
+            last = i;
+         }
+
+         // put nodes on free list
+         mFreeMutex.lock();
+         last->mNext = mFreeNodes;
+         mFreeNodes = reversed;
+         mFreeMutex.unlock();
+         return true;
+      }
+
+      /**
+       * @threadsafe
+       */
+      bool Empty() const { return mHead.get() == NULL; }
+
+   private:
+
+      struct Node
+      {
+         Node(const T& t) : mValue(t), mNext(NULL) {}
+         T mValue;
+         Node* mNext;
+      };
+
+      // atomically detach list. Does not read from the head node before
+      // swapping, so it does not matter if head was popped and pushed
+      // again in between (no ABA).
+      Node* Take()
+      {
+         void* head;
+         do
+         {
+            head = mHead.get();
+            if(head == NULL)
+            {
+               return NULL;
+            }
+         }
+         while(!mHead.assign(NULL, head));
+         return static_cast<Node*>(head);
+      }
+
+      static void DeleteNodes(Node* n)
+      {
+         while(n != NULL)
+         {
+            Node* next = n->mNext;
+            delete n;
+            n = next;
+         }
+      }
+
+      // no copy ctor
+      MPSCQueue(const MPSCQueue&);
+      MPSCQueue& operator=(const MPSCQueue&);
+
+      // most recently pushed node
+      OpenThreads::AtomicPtr mHead;
+
+      // recycled nodes, guarded by mFreeMutex
+      OpenThreads::Mutex mFreeMutex;
+      Node* mFreeNodes;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Bounded lock-free multi producer single consumer queue on a ring buffer.
+    * Does not allocate after construction. Push fails when the queue is full.
+    * PopAll must only be called from one thread at a time.
+    */
+   template<class T>
+   class BoundedMPSCQueue
+   {
+   public:
+
+      /**
+       * @param capacity Maximum number of queued elements, rounded up to a power of two
+       */
+      BoundedMPSCQueue(unsigned int capacity)
+         : mHead(0)
+      {
+         mCapacity = 1;
+         while(mCapacity < capacity)
+         {
+            mCapacity <<= 1;
+         }
+         mSlots = new Slot[mCapacity];
+      }
+
+      ~BoundedMPSCQueue()
+      {
+         delete[] mSlots;
+      }
+
+      /**
+       * Add element to queue.
+       * @threadsafe
+       * @return false if queue is full
+       */
+      bool Push(const T& t)
+      {
+         // reserve a slot before claiming a position, this guarantees
+         // that the slot of the claimed position was already consumed
+         if(++mCount > mCapacity)
+         {
+            --mCount;
+            return false;
+         }
+         unsigned int pos = ++mTail - 1;
+         Slot& slot = mSlots[pos & (mCapacity - 1)];
+         slot.mValue = t;
+         // publish
+         slot.mSequence.exchange(pos + 1);
+         return true;
+      }
+
+      /**
+       * Append all published elements to toFill in push order.
+       * @return true if any elements were appended
+       */
+      bool PopAll(std::vector<T>& toFill)
+      {
+         bool found = false;
+         for(;;)
+         {
+            Slot& slot = mSlots[mHead & (mCapacity - 1)];
+            if(static_cast<unsigned int>(slot.mSequence) != mHead + 1)
+            {
+               break;
+            }
+            toFill.push_back(slot.mValue);
+            slot.mValue = T();
+            ++mHead;
+            --mCount;
+            found = true;
+         }
+         return found;
+      }
+
+      /**
+       * @threadsafe
+       */
+      bool Empty() const { return static_cast<unsigned int>(mCount) == 0; }
+
+      unsigned int GetCapacity() const { return mCapacity; }
+
+   private:
+
+      struct Slot
+      {
+         Slot() : mSequence(0), mValue() {}
+
+         // position + 1 of element stored in slot, set when element is published
+         OpenThreads::Atomic mSequence;
+         T mValue;
+      };
+
+      // no copy ctor
+      BoundedMPSCQueue(const BoundedMPSCQueue&);
+      BoundedMPSCQueue& operator=(const BoundedMPSCQueue&);
+
+      Slot* mSlots;
+      unsigned int mCapacity;
+
+      // number of reserved or unconsumed slots
+      OpenThreads::Atomic mCount;
+
+      // next position to claim, written by producers
+      OpenThreads::Atomic mTail;
+
+      // keep consumer position on its own cache line
+      char mPadding[64];
+
+      // next position to consume, only accessed by consumer
+      unsigned int mHead;
+   };
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/export.h>
+#include <dtEntity/stringid.h>
+#include <string>
+#include <vector>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Hierarchical profiler for all threads.
+    *
+    * Each thread keeps its own stack of open zones and writes finished zones
+    * to its own fixed size ring buffer, so recording takes no lock. When
+    * a ring buffer is full, events are dropped and counted.
+    * The buffer of a thread is created on its first zone and deleted by the
+    * first EndFrame() after the thread exited.
+    * EndFrame() collects the events of all threads, updates the zone statistics
+    * and, while a trace is running, keeps the events for export to the
+    * Chrome trace event format (load in chrome://tracing or Perfetto).
+    *
+    * Recording is off by default. When disabled, ProfileScope costs a
+    * single branch.
+    *
+    * If DTENTITY_PROFILING_ENABLED is set, each message handler call is a zone
+    * named after the function name given when registering it.
+    */
+   class DT_ENTITY_EXPORT Profiler
+   {
+   public:
+
+      struct ZoneStats
+      {
+         StringId mName;
+
+         // number of calls since last ResetStats
+         unsigned int mNumCalls;
+
+         // call durations since last ResetStats, in milliseconds
+         double mMin;
+         double mAvg;
+         double mMax;
+
+         // 99th percentile of the last 1024 call durations, in milliseconds
+         double mP99;
+
+         // calls and summed duration of the zone in last frame
+         unsigned int mLastFrameCalls;
+         double mLastFrameTime;
+      };
+
+      /**
+       * Switch recording on or off. Zones that are open when recording
+       * is switched off are still closed correctly.
+       * @threadsafe
+       */
+      static void SetEnabled(bool enabled);
+      static bool IsEnabled() { return sEnabled; }
+
+      /**
+       * Open a zone in calling thread. Prefer ProfileScope.
+       * Zones nested deeper than 64 levels are ignored.
+       */
+      static void BeginZone(StringId name);
+
+      /**
+       * Close the innermost zone of calling thread. Ignored if no zone is open.
+       */
+      static void EndZone();
+
+      /**
+       * Name shown for calling thread in trace output
+       */
+      static void SetThreadName(const std::string& name);
+
+      /**
+       * Collect the events of all threads and update statistics.
+       * Call once per frame, ProfilerSystem does this on EndOfFrameMessage.
+       */
+      static void EndFrame();
+
+      /**
+       * Get statistics of all zones, sorted by total time, most expensive first
+       */
+      static void GetZoneStats(std::vector<ZoneStats>& toFill);
+
+      /**
+       * Clear statistics and frame counter
+       */
+      static void ResetStats();
+
+      /**
+       * Write statistics of all zones to log
+       */
+      static void LogStats();
+
+      /**
+       * @return number of EndFrame calls since last ResetStats
+       */
+      static unsigned int GetNumFrames();
+
+      /**
+       * @return number of events lost because a ring buffer or trace was full
+       */
+      static unsigned int GetNumDroppedEvents();
+
+      /**
+       * Start keeping events for trace export. Also enables recording.
+       * @param maxEvents Number of events to keep, later events are dropped
+       */
+      static void StartTrace(unsigned int maxEvents = 1000000);
+
+      /**
+       * Stop keeping events. Kept events are not cleared.
+       */
+      static void StopTrace();
+
+      static bool IsTracing();
+
+      /**
+       * Write kept events to a file in Chrome trace event JSON format
+       * and clear them.
+       * @return false if file could not be written
+       */
+      static bool WriteChromeTrace(const std::string& path);
+
+   private:
+      static volatile bool sEnabled;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Records a zone from construction to end of scope if profiler is enabled
+    */
+   class ProfileScope
+   {
+   public:
+      ProfileScope(StringId name)
+         : mActive(Profiler::IsEnabled())
+      {
+         if(mActive)
+         {
+            Profiler::BeginZone(name);
+         }
+      }
+
+      ~ProfileScope()
+      {
+         if(mActive)
+         {
+            Profiler::EndZone();
+         }
+      }
+
+   private:
+      bool mActive;
+   };
+}
+
+#define PROFILE(name) dtEntity::ProfileScope __profile(name)
@@ -0,0 +1,74 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/export.h>
+#include <dtEntity/entitysystem.h>
+#include <dtEntity/messagepump.h>
+#include <dtEntity/scriptaccessor.h>
+
+namespace dtEntity
+{
+   struct EndOfFrameData;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Collects profiler data at end of each frame and gives scripts access
+    * to the profiler (see profiler.h):
+    *
+    * setEnabled(bool), isEnabled()
+    * getStats(): array of {name, calls, min, avg, max, p99, lastFrameCalls, lastFrameTime}, times in ms
+    * resetStats(), logStats()
+    * startTrace([maxEvents]), stopTrace(), writeTrace(path)
+    */
+   class DT_ENTITY_EXPORT ProfilerSystem
+      : public EntitySystem
+      , public ScriptAccessor
+   {
+      typedef EntitySystem BaseClass;
+
+   public:
+
+      static const ComponentType TYPE;
+
+      ProfilerSystem(EntityManager& em);
+      ~ProfilerSystem();
+
+      ComponentType GetComponentType() const { return TYPE; }
+
+      void OnEndOfFrame(const EndOfFrameData& msg);
+
+   private:
+
+      Property* ScriptSetEnabled(const PropertyArgs& args);
+      Property* ScriptIsEnabled(const PropertyArgs& args);
+      Property* ScriptGetStats(const PropertyArgs& args);
+      Property* ScriptResetStats(const PropertyArgs& args);
+      Property* ScriptLogStats(const PropertyArgs& args);
+      Property* ScriptStartTrace(const PropertyArgs& args);
+      Property* ScriptStopTrace(const PropertyArgs& args);
+      Property* ScriptWriteTrace(const PropertyArgs& args);
+
+      TypedMessageFunctor<EndOfFrameData>::type mEndOfFrameFunctor;
+   };
+}
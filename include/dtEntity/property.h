@@ -24,6 +24,7 @@
 #include <dtEntity/export.h>
 #include <dtEntity/entityid.h>
 #include <dtEntity/log.h>
+#include <dtEntity/propertygroup.h>
 #include <dtEntity/stringid.h>
 #include <string>
 #include <osg/Matrix>
@@ -92,12 +93,12 @@ namespace dtEntity
 
    // Fwd declaration
    class Property;
+   class PropertyValue;
 
    // value type of array property
    typedef std::vector<Property*> PropertyArray;
 
-   // value type of group property
-   typedef std::map<StringId, Property*> PropertyGroup;
+   // value type of group property is PropertyGroup, see propertygroup.h
 
    /**
     * Base class for properties. Implementations have to set the mDataType
@@ -140,6 +141,22 @@ namespace dtEntity
       virtual const std::string StringValue() const = 0;
       virtual void SetString(const std::string&) = 0;
 
+      /**
+       * Copy value of this property to a PropertyValue.
+       * The default implementation reads the value through the
+       * XValue() getter matching the data type, so properties
+       * with getter callbacks need no own implementation.
+       */
+      virtual void GetValue(PropertyValue& v) const;
+
+      /**
+       * Set value of this property from a PropertyValue, converting
+       * between compatible types. The default implementation
+       * uses the SetX() setter matching the data type.
+       * @return false if value cannot be converted to data type of property
+       */
+      virtual bool SetValue(const PropertyValue& v);
+
       /**
        * Get value of property interpreted as various types.
        * These default implementations cause an assertion error in debug mode
@@ -381,6 +398,8 @@ namespace dtEntity
       virtual void SetVec4D(const Vec4d&);
 
       virtual bool SetFrom(const Property& other);
+      virtual void GetValue(PropertyValue& v) const;
+      virtual bool SetValue(const PropertyValue& v);
 
       /**
        * Add to array. Ownership is taken by ArrayProperty -
@@ -515,7 +534,8 @@ namespace dtEntity
       virtual void SetGroup(const PropertyGroup& v) { Set(v); }
       virtual const std::string StringValue() const;
 
-      const PropertyGroup& Get() const { return mValue; }
+      // virtual so that PropertyContainer can add properties described by a schema
+      virtual const PropertyGroup& Get() const { return mValue; }
 
       // add prop and take ownership
       void Add(StringId name, Property* prop);
@@ -526,10 +546,12 @@ namespace dtEntity
       void Set(const PropertyGroup& v);
       virtual void SetString(const std::string&);
       virtual bool SetFrom(const Property& other);
+      virtual void GetValue(PropertyValue& v) const;
+      virtual bool SetValue(const PropertyValue& v);
       bool Empty() const;
-      Property* Get(StringId);
-      const Property* Get(StringId) const;
-      bool Has(StringId) const;
+      virtual Property* Get(StringId);
+      virtual const Property* Get(StringId) const;
+      virtual bool Has(StringId) const;
 
    protected:
      PropertyGroup mValue;
@@ -657,6 +679,10 @@ namespace dtEntity
       virtual void SetString(const std::string&);
       virtual bool SetFrom(const Property& other);
 
+      // avoid temporary string copies
+      virtual void GetValue(PropertyValue& v) const;
+      virtual bool SetValue(const PropertyValue& v);
+
    private:
 
       std::string mValue;
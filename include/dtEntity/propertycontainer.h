@@ -23,10 +23,12 @@
 
 #include <dtEntity/export.h>
 #include <dtEntity/property.h>
+#include <dtEntity/propertyschema.h>
 #include <dtEntity/stringid.h>
 #include <vector>
 #include <map>
 #include <dtEntity/dtentity_config.h>
+#include <OpenThreads/Atomic>
 
 namespace dtEntity
 {
@@ -35,18 +37,93 @@ namespace dtEntity
    /**
     * Holds a number of properties. This container does NOT take ownership
     * of properties, they are not deleted in the constructor.
+    * Properties can be registered per instance or through a static
+    * PropertySchema shared by all instances of a class.
     */
    class DT_ENTITY_EXPORT PropertyContainer : public GroupProperty
    {
    public:
 
-      PropertyContainer() {}
-
-      virtual ~PropertyContainer() 
+      PropertyContainer()
+         : mSchema(NULL)
+         , mAllProperties(NULL)
       {
-         // don't delete properties, they are not on heap
-         mValue.clear();
       }
+
+      virtual ~PropertyContainer();
+
+      /**
+       * Iterates over all properties without modifying the container,
+       * schema properties first. Unlike Get() it does not build a property
+       * group holding the schema entries, use it in code that runs per
+       * message or per frame.
+       *
+       * for(PropertyContainer::ConstIterator i(container); !i.AtEnd(); i.Next())
+       * {
+       *    Write(i.GetName(), *i.GetProperty());
+       * }
+       *
+       * Registering properties while iterating is not allowed.
+       */
+      class DT_ENTITY_EXPORT ConstIterator
+      {
+      public:
+         ConstIterator(const PropertyContainer& container);
+
+         // iterate group property that is not a property container
+         ConstIterator(const GroupProperty& group);
+
+         bool AtEnd() const { return mSchema == NULL && mGroupIter == mGroupEnd; }
+         void Next();
+
+         StringId GetName() const;
+         const Property* GetProperty() const;
+
+      private:
+         // skip schemas without entries
+         void Settle();
+
+         const PropertyContainer* mContainer;
+         const PropertySchema* mSchema;
+         unsigned int mEntry;
+         PropertyGroup::const_iterator mGroupIter;
+         PropertyGroup::const_iterator mGroupEnd;
+      };
+
+      /**
+       * Returns all properties, including those described by the schema.
+       * For containers with schema the group is built on first call,
+       * prefer Get(StringId) for single properties and ConstIterator
+       * for iterating. Threads calling it concurrently may each build
+       * the group once, only one of them is kept.
+       * @threadsafe
+       */
+      virtual const PropertyGroup& Get() const;
+
+      /**
+       * @return number of properties, including those described by the schema.
+       * Does not modify the container.
+       */
+      unsigned int GetNumProperties() const;
+
+      /**
+       * Add property without schema, replacing and deleting property with same name
+       */
+      void Add(StringId name, Property* prop);
+
+      /**
+       * Get property by name. Looks up schema first, then properties
+       * registered without schema.
+       */
+      virtual Property* Get(StringId name);
+      virtual const Property* Get(StringId name) const;
+      virtual bool Has(StringId name) const;
+
+      /**
+       * @return schema of this container, NULL if all properties are
+       * registered per instance
+       */
+      const PropertySchema* GetSchema() const { return mSchema; }
       
 #if CALL_ONPROPERTYCHANGED_METHOD == 0
       // hide when compiling with new property system
@@ -80,6 +157,13 @@ namespace dtEntity
        */
       void InitFrom(const PropertyContainer& other);
 
+      /**
+       * Set values of registered properties from a group value.
+       * Properties not contained in the group keep their values.
+       * @return false if group contains values for unknown properties
+       */
+      virtual bool SetValue(const PropertyValue& v);
+
       /**
        * Set value of property registered with given string id.
        * In debug mode this throws an assertion when a component
@@ -89,7 +173,7 @@ namespace dtEntity
       void SetBool(StringId name, bool val);
       void SetDouble(StringId name, double val);
       void SetFloat(StringId name, float val);
-      void SetGroup(StringId name, const std::map<StringId, Property*>& val);
+      void SetGroup(StringId name, const PropertyGroup& val);
       void SetInt(StringId name, int val);
       void SetMatrix(StringId name, const Matrix& val);
       void SetQuat(StringId name, const Quat& val);
@@ -110,7 +194,7 @@ namespace dtEntity
       bool GetBool(StringId name) const;
       double GetDouble(StringId name) const;
       float GetFloat(StringId name) const;
-      std::map<StringId, Property*> GetGroup(StringId name) const;
+      PropertyGroup GetGroup(StringId name) const;
       int GetInt(StringId name) const;
       Matrix GetMatrix(StringId name) const;
       Quat GetQuat(StringId name) const;
@@ -130,11 +214,37 @@ namespace dtEntity
        * Register a property under the given string id
        */
       void Register(StringId name, Property* prop);
+
+      /**
+       * Register a member property in the static schema of the class.
+       * See PropertySchema for restrictions.
+       */
+      void Register(PropertySchema& schema, StringId name, Property* prop);
       
    private:
 
+      Property* FindInSchema(StringId name) const
+      {
+         for(const PropertySchema* schema = mSchema; schema != NULL; schema = schema->GetParent())
+         {
+            const PropertySchema::Entry* e = schema->Find(name);
+            if(e != NULL)
+            {
+               return reinterpret_cast<Property*>(
+                  const_cast<char*>(reinterpret_cast<const char*>(this)) + e->mOffset);
+            }
+         }
+         return NULL;
+      }
+
       // no copy constructor
       PropertyContainer(const PropertyContainer& other);
+
+      const PropertySchema* mSchema;
+
+      // PropertyGroup holding properties registered without schema plus
+      // the schema entries, created by first call to Get()
+      mutable OpenThreads::AtomicPtr mAllProperties;
    };
 
    template <class T>
@@ -0,0 +1,276 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/stringid.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dtEntity
+{
+   class Property;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Flat map from StringId to Property*, value type of GroupProperty.
+    *
+    * Entries are kept in a vector sorted by key, so iteration order is the same
+    * as with a std::map. Very small groups are searched linearly, larger ones
+    * by binary search. When the group grows beyond INDEX_THRESHOLD entries an
+    * open addressing hash index over the entry positions is built, keyed by
+    * the StringId hash.
+    *
+    * Offers the subset of the std::map interface used for property groups.
+    * Unlike std::map, inserting or erasing invalidates iterators and references
+    * to entries. Inserting into a large group is O(n).
+    */
+   class PropertyGroup
+   {
+   public:
+
+      typedef StringId key_type;
+      typedef Property* mapped_type;
+      typedef std::pair<StringId, Property*> value_type;
+      typedef std::vector<value_type> Entries;
+      typedef Entries::iterator iterator;
+      typedef Entries::const_iterator const_iterator;
+      typedef Entries::size_type size_type;
+
+      // groups with more entries than this are searched by binary search
+      enum { LINEAR_SEARCH_THRESHOLD = 8 };
+
+      // groups with more entries than this get a hash index
+      enum { INDEX_THRESHOLD = 16 };
+
+      PropertyGroup() {}
+
+      iterator begin() { return mEntries.begin(); }
+      const_iterator begin() const { return mEntries.begin(); }
+      iterator end() { return mEntries.end(); }
+      const_iterator end() const { return mEntries.end(); }
+
+      size_type size() const { return mEntries.size(); }
+      bool empty() const { return mEntries.empty(); }
+
+      void reserve(size_type s) { mEntries.reserve(s); }
+
+      void clear()
+      {
+         mEntries.clear();
+         mIndex.clear();
+      }
+
+      void swap(PropertyGroup& other)
+      {
+         mEntries.swap(other.mEntries);
+         mIndex.swap(other.mIndex);
+      }
+
+      iterator find(const StringId& key)
+      {
+         return mEntries.begin() + FindPos(key);
+      }
+
+      const_iterator find(const StringId& key) const
+      {
+         return mEntries.begin() + FindPos(key);
+      }
+
+      size_type count(const StringId& key) const
+      {
+         return (FindPos(key) == mEntries.size()) ? 0 : 1;
+      }
+
+      /**
+       * Like std::map, inserts a NULL entry if key is not yet in group
+       */
+      Property*& operator[](const StringId& key)
+      {
+         size_type pos = FindPos(key);
+         if(pos == mEntries.size())
+         {
+            pos = InsertPos(value_type(key, (Property*)NULL));
+         }
+         return mEntries[pos].second;
+      }
+
+      std::pair<iterator, bool> insert(const value_type& v)
+      {
+         size_type pos = FindPos(v.first);
+         if(pos != mEntries.size())
+         {
+            return std::make_pair(mEntries.begin() + pos, false);
+         }
+         pos = InsertPos(v);
+         return std::make_pair(mEntries.begin() + pos, true);
+      }
+
+      void erase(iterator i)
+      {
+         mEntries.erase(i);
+         RebuildIndex();
+      }
+
+      size_type erase(const StringId& key)
+      {
+         size_type pos = FindPos(key);
+         if(pos == mEntries.size())
+         {
+            return 0;
+         }
+         erase(mEntries.begin() + pos);
+         return 1;
+      }
+
+      bool operator==(const PropertyGroup& other) const { return mEntries == other.mEntries; }
+      bool operator!=(const PropertyGroup& other) const { return mEntries != other.mEntries; }
+
+   private:
+
+      struct KeyLess
+      {
+         bool operator()(const value_type& v, const StringId& key) const { return v.first < key; }
+      };
+
+      static unsigned int HashKey(unsigned int key)
+      {
+         // string ids are hashes already, mix bits so that low bits are well distributed
+         key ^= key >> 16;
+         key *= 0x85ebca6b;
+         key ^= key >> 13;
+         key *= 0xc2b2ae35;
+         key ^= key >> 16;
+         return key;
+      }
+
+      static unsigned int HashKey(const std::string& key)
+      {
+         unsigned int h = 2166136261u;
+         for(std::string::const_iterator i = key.begin(); i != key.end(); ++i)
+         {
+            h = (h ^ static_cast<unsigned char>(*i)) * 16777619u;
+         }
+         return h;
+      }
+
+      // returns position of entry with key, size() if not found
+      size_type FindPos(const StringId& key) const
+      {
+         size_type s = mEntries.size();
+         if(s <= LINEAR_SEARCH_THRESHOLD)
+         {
+            for(size_type i = 0; i < s; ++i)
+            {
+               if(mEntries[i].first == key)
+               {
+                  return i;
+               }
+            }
+            return s;
+         }
+
+         if(mIndex.empty())
+         {
+            const_iterator i = std::lower_bound(mEntries.begin(), mEntries.end(), key, KeyLess());
+            return (i != mEntries.end() && i->first == key) ? (i - mEntries.begin()) : s;
+         }
+
+         size_type mask = mIndex.size() - 1;
+         for(size_type slot = HashKey(key) & mask; mIndex[slot] != 0; slot = (slot + 1) & mask)
+         {
+            size_type pos = mIndex[slot] - 1;
+            if(mEntries[pos].first == key)
+            {
+               return pos;
+            }
+         }
+         return s;
+      }
+
+      // insert entry that is not yet in group, return its position
+      size_type InsertPos(const value_type& v)
+      {
+         iterator i = std::lower_bound(mEntries.begin(), mEntries.end(), v.first, KeyLess());
+         size_type pos = i - mEntries.begin();
+         mEntries.insert(i, v);
+
+         if(mIndex.empty() || mEntries.size() * 2 > mIndex.size())
+         {
+            RebuildIndex();
+            return pos;
+         }
+
+         // entries behind the inserted one moved up by one, then add new entry to index
+         size_type mask = mIndex.size() - 1;
+         for(std::vector<unsigned int>::iterator j = mIndex.begin(); j != mIndex.end(); ++j)
+         {
+            if(*j > pos)
+            {
+               ++*j;
+            }
+         }
+         size_type slot = HashKey(v.first) & mask;
+         while(mIndex[slot] != 0)
+         {
+            slot = (slot + 1) & mask;
+         }
+         mIndex[slot] = static_cast<unsigned int>(pos + 1);
+         return pos;
+      }
+
+      void RebuildIndex()
+      {
+         size_type s = mEntries.size();
+         if(s <= INDEX_THRESHOLD)
+         {
+            mIndex.clear();
+            return;
+         }
+
+         // keep load factor below 0.5
+         size_type tablesize = 64;
+         while(tablesize < s * 2)
+         {
+            tablesize *= 2;
+         }
+         mIndex.assign(tablesize, 0);
+         size_type mask = tablesize - 1;
+         for(size_type pos = 0; pos < s; ++pos)
+         {
+            size_type slot = HashKey(mEntries[pos].first) & mask;
+            while(mIndex[slot] != 0)
+            {
+               slot = (slot + 1) & mask;
+            }
+            mIndex[slot] = static_cast<unsigned int>(pos + 1);
+         }
+      }
+
+      Entries mEntries;
+
+      // open addressing table of entry positions + 1, 0 marks a free slot.
+      // Empty for small groups.
+      std::vector<unsigned int> mIndex;
+   };
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/property.h>
+#include <dtEntity/stringid.h>
+#include <cstddef>
+#include <vector>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Static description of the properties of a PropertyContainer class:
+    * A sorted table mapping property names to data type and offset of the
+    * property member relative to the PropertyContainer base of the object.
+    *
+    * A class that holds a fixed set of property members declares one static
+    * schema and passes it to PropertyContainer::Register. The schema is filled
+    * from the registrations of the first constructed instance, all other instances
+    * only store a pointer to it. This saves the allocation of one map node per
+    * property per instance and makes lookup by name a binary search
+    * in a small contiguous array.
+    *
+    * class MyComponent : public Component
+    * {
+    *    static PropertySchema sPropertySchema;
+    *    ...
+    * };
+    *
+    * MyComponent::MyComponent()
+    * {
+    *    Register(sPropertySchema, ValueId, &mValue);
+    * }
+    *
+    * Properties registered with a schema have to be plain members of the class,
+    * registered unconditionally in the constructor. Properties that depend on
+    * constructor arguments or are added at runtime have to be registered without
+    * schema. Classes using virtual inheritance cannot use a schema.
+    *
+    * Not thread safe: Instances of a class using a schema should
+    * not be constructed concurrently before the first one was completely constructed.
+    */
+   class DT_ENTITY_EXPORT PropertySchema
+   {
+   public:
+
+      struct Entry
+      {
+         StringId mName;
+         DataType::e mDataType;
+         std::ptrdiff_t mOffset;
+      };
+
+      typedef std::vector<Entry> Entries;
+
+      PropertySchema();
+
+      /**
+       * Entries sorted by name
+       */
+      const Entries& GetEntries() const { return mEntries; }
+
+      /**
+       * Schema of the base class, if base class also uses a schema
+       */
+      const PropertySchema* GetParent() const { return mParent; }
+
+      /**
+       * @return Entry with given name or NULL. Does not search parent schema.
+       */
+      const Entry* Find(StringId name) const;
+
+      /**
+       * @return true if the first instance has finished registering properties
+       */
+      bool IsComplete() const { return mComplete; }
+
+   private:
+
+      friend class PropertyContainer;
+
+      // called by PropertyContainer::Register
+      void Register(const void* container, const PropertySchema* parent, StringId name,
+                    DataType::e datatype, std::ptrdiff_t offset);
+
+      // called from destructor of container
+      void Release(const void* container);
+
+      Entries mEntries;
+      const PropertySchema* mParent;
+      const void* mBuilder;
+      bool mComplete;
+
+      // no copy constructor
+      PropertySchema(const PropertySchema&);
+      PropertySchema& operator=(const PropertySchema&);
+   };
+}
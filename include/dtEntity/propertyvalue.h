@@ -0,0 +1,195 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/property.h>
+#include <dtEntity/stringid.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dtEntity
+{
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Value type holding the value of a property of any data type.
+    * Unlike Property objects, PropertyValues can be copied and stored in
+    * containers without heap allocations for scalar values:
+    * Numbers, vectors and quats are stored inline, strings of up to
+    * INLINE_STRING_CAPACITY characters are stored inline as well.
+    * Matrices and longer strings are stored on the heap, so the inline
+    * payload stays at the size of a Vec4d.
+    * Arrays and groups hold their elements as PropertyValues in a single
+    * vector, so a nested array costs one allocation instead of one per element.
+    *
+    * Use Property::GetValue and Property::SetValue to read and write
+    * the value of a property.
+    */
+   class DT_ENTITY_EXPORT PropertyValue
+   {
+   public:
+
+      typedef std::vector<PropertyValue> Array;
+
+      // group entries, sorted by key
+      typedef std::vector<std::pair<StringId, PropertyValue> > Group;
+
+      // longer strings are allocated on the heap
+      enum { INLINE_STRING_CAPACITY = 4 * sizeof(double) - 1 };
+
+      /**
+       * Creates an empty value with data type UNKNOWN_ID
+       */
+      PropertyValue();
+      PropertyValue(const PropertyValue& other);
+      ~PropertyValue();
+
+      PropertyValue& operator=(const PropertyValue& other);
+      void swap(PropertyValue& other);
+
+      DataType::e GetDataType() const { return mType; }
+
+      /**
+       * Reset to data type UNKNOWN_ID, release held memory
+       */
+      void Clear();
+
+      /**
+       * Get value as various types. Numeric types (bool, int, uint, float, double)
+       * are converted into each other, float and double vectors are
+       * converted into each other, strings and string ids are converted into
+       * each other. Other conversions log an error and return a null value.
+       */
+      bool BoolValue() const;
+      int IntValue() const;
+      unsigned int UIntValue() const;
+      float FloatValue() const;
+      double DoubleValue() const;
+      Vec2f Vec2Value() const;
+      Vec3f Vec3Value() const;
+      Vec4f Vec4Value() const;
+      Vec2d Vec2dValue() const;
+      Vec3d Vec3dValue() const;
+      Vec4d Vec4dValue() const;
+      Quat QuatValue() const;
+      Matrix MatrixValue() const;
+      std::string StringValue() const;
+      StringId StringIdValue() const;
+
+      /**
+       * Access string data without copying. Data type has to be STRING.
+       */
+      const char* CStringValue() const;
+      std::size_t StringSize() const { return mStringSize; }
+
+      /**
+       * Set value and data type
+       */
+      void SetBool(bool v);
+      void SetInt(int v);
+      void SetUInt(unsigned int v);
+      void SetFloat(float v);
+      void SetDouble(double v);
+      void SetVec2(const Vec2f& v);
+      void SetVec3(const Vec3f& v);
+      void SetVec4(const Vec4f& v);
+      void SetVec2d(const Vec2d& v);
+      void SetVec3d(const Vec3d& v);
+      void SetVec4d(const Vec4d& v);
+      void SetQuat(const Quat& v);
+      void SetMatrix(const Matrix& v);
+      void SetString(const std::string& v);
+      void SetString(const char* v, std::size_t size);
+      void SetStringId(StringId v);
+
+      /**
+       * Change data type to an empty array or group and return it
+       */
+      Array& SetArray();
+      Group& SetGroup();
+
+      /**
+       * Access array elements. Data type has to be ARRAY.
+       */
+      const Array& ArrayValue() const;
+      Array& ArrayValue();
+
+      /**
+       * Access group entries. Data type has to be GROUP.
+       */
+      const Group& GroupValue() const;
+
+      /**
+       * @return group entry with given name or NULL
+       */
+      const PropertyValue* GetGroupEntry(StringId name) const;
+
+      /**
+       * @return group entry with given name, entry is added if it does not exist
+       */
+      PropertyValue& GetOrAddGroupEntry(StringId name);
+
+      bool operator==(const PropertyValue& other) const;
+      bool operator!=(const PropertyValue& other) const { return !(*this == other); }
+
+      /**
+       * Create a heap allocated property of matching type holding this value.
+       * Returns NULL if data type is UNKNOWN_ID.
+       */
+      Property* CreateProperty() const;
+
+      /**
+       * @return true if value can be converted to given data type
+       */
+      bool IsConvertibleTo(DataType::e type) const;
+
+   private:
+
+      void CopyFrom(const PropertyValue& other);
+      void SetNumbers(DataType::e type, const float* v, unsigned int count);
+      void SetNumbers(DataType::e type, const double* v, unsigned int count);
+      void GetNumbers(double* v, unsigned int count) const;
+      double NumericValue(const char* typeName) const;
+      bool IsHeapString() const { return mStringSize > INLINE_STRING_CAPACITY; }
+
+      DataType::e mType;
+      unsigned int mStringSize;
+
+      union
+      {
+         bool mBool;
+         int mInt;
+         unsigned int mUInt;
+         float mFloat;
+         double mDouble;
+         float mFloats[4];
+         double mDoubles[4];
+         char mChars[INLINE_STRING_CAPACITY + 1];
+         char* mHeapChars;
+         double* mMatrix;
+         Array* mArray;
+         Group* mGroup;
+      } mData;
+   };
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/stringid.h>
+#include <cstddef>
+#include <vector>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Fixed size block allocator. Memory is reserved in slabs of
+    * many blocks, free blocks are kept in an intrusive free list.
+    * Block size is rounded up to a multiple of the cache line size and
+    * every block starts on a cache line boundary, so two objects never
+    * share a cache line.
+    *
+    * Slabs are only released on destruction or by calling FreeAll.
+    * Not thread safe.
+    */
+   class DT_ENTITY_EXPORT SlabAllocator
+   {
+   public:
+
+      enum { CACHE_LINE_SIZE = 64 };
+
+      // names of the statistics properties registered by MemAllocPolicySlab
+      static const StringId AllocLiveCountId;
+      static const StringId AllocPeakCountId;
+      static const StringId AllocBytesReservedId;
+      static const StringId AllocFragmentationId;
+
+      /**
+       * @param objectSize Size of the allocated objects in bytes
+       * @param blocksPerSlab Number of blocks reserved at once, 0 selects
+       *                      a slab size of about 16 KB
+       */
+      SlabAllocator(size_t objectSize, unsigned int blocksPerSlab = 0);
+      ~SlabAllocator();
+
+      /**
+       * Get an uninitialized, cache line aligned block of GetBlockSize() bytes.
+       * Returns NULL if out of memory.
+       */
+      void* Allocate()
+      {
+         if(mFreeList == NULL)
+         {
+            AddSlab();
+            if(mFreeList == NULL)
+            {
+               return NULL;
+            }
+         }
+         FreeBlock* b = mFreeList;
+         mFreeList = b->mNext;
+         if(++mLiveCount > mPeakCount)
+         {
+            mPeakCount = mLiveCount;
+         }
+         return b;
+      }
+
+      /**
+       * Return a block to the free list. Does not call a destructor.
+       */
+      void Free(void* p)
+      {
+         FreeBlock* b = static_cast<FreeBlock*>(p);
+         b->mNext = mFreeList;
+         mFreeList = b;
+         --mLiveCount;
+      }
+
+      /**
+       * Release all slabs. Objects living in them have to be destroyed before.
+       */
+      void FreeAll();
+
+      size_t GetBlockSize() const { return mBlockSize; }
+      unsigned int GetBlocksPerSlab() const { return mBlocksPerSlab; }
+      unsigned int GetNumSlabs() const { return static_cast<unsigned int>(mSlabs.size()); }
+
+      /** Number of blocks currently in use */
+      unsigned int GetLiveCount() const { return mLiveCount; }
+
+      /** Highest number of blocks in use at once */
+      unsigned int GetPeakCount() const { return mPeakCount; }
+
+      /** Bytes reserved for block storage */
+      size_t GetBytesReserved() const { return mSlabs.size() * mBlocksPerSlab * mBlockSize; }
+
+      /**
+       * Fraction of reserved blocks that are not in use,
+       * 0 if no memory is reserved
+       */
+      float GetFragmentation() const;
+
+   private:
+
+      struct FreeBlock
+      {
+         FreeBlock* mNext;
+      };
+
+      void AddSlab();
+
+      // no copy ctor
+      SlabAllocator(const SlabAllocator&);
+      SlabAllocator& operator=(const SlabAllocator&);
+
+      size_t mBlockSize;
+      unsigned int mBlocksPerSlab;
+      FreeBlock* mFreeList;
+      unsigned int mLiveCount;
+      unsigned int mPeakCount;
+
+      // pointers returned by malloc, slab memory starts at next cache line boundary
+      std::vector<void*> mSlabs;
+   };
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/entityid.h>
+#include <assert.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+namespace dtEntity
+{
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Component store that keeps (EntityId, component) pairs in a dense array
+    * and maps entity ids to array slots through a paged sparse index.
+    * Lookup, insertion and deletion are O(1), iteration is a linear walk
+    * over the dense array.
+    *
+    * Offers the subset of the std::map interface that DefaultEntitySystem and
+    * its subclasses use, so it can be selected as the store policy of
+    * a DefaultEntitySystem without changing the system code:
+    *
+    * class MySystem : public DefaultEntitySystem<MyComponent, MemAllocPolicyNew, ComponentStoreSparseSet>
+    *
+    * The sparse index is addressed by the slot index part of the entity id
+    * (see entityid.h), so its size is bounded by the number of entity slots.
+    * The dense array stores the full id, lookups with a stale handle fail.
+    *
+    * Components are held by pointer: PropertyContainers register pointers to their
+    * own members, so component objects must not be moved around in memory.
+    *
+    * Warning: erase() moves the last element into the erased slot
+    * (swap and pop). Iteration order is not stable and erasing while iterating
+    * skips the element that was moved into the erased slot.
+    */
+   template<class T>
+   class ComponentStoreSparseSet
+   {
+   public:
+
+      typedef std::pair<EntityId, T*> value_type;
+      typedef std::vector<value_type> DenseArray;
+      typedef typename DenseArray::iterator iterator;
+      typedef typename DenseArray::const_iterator const_iterator;
+      typedef typename DenseArray::size_type size_type;
+
+      ComponentStoreSparseSet() {}
+
+      ~ComponentStoreSparseSet()
+      {
+         for(typename SparsePages::iterator i = mSparsePages.begin(); i != mSparsePages.end(); ++i)
+         {
+            delete[] *i;
+         }
+      }
+
+      iterator begin() { return mDense.begin(); }
+      const_iterator begin() const { return mDense.begin(); }
+      iterator end() { return mDense.end(); }
+      const_iterator end() const { return mDense.end(); }
+
+      size_type size() const { return mDense.size(); }
+      bool empty() const { return mDense.empty(); }
+
+      /**
+       * Pre-allocate dense storage for given number of components
+       */
+      void reserve(size_type s) { mDense.reserve(s); }
+
+      iterator find(EntityId eid)
+      {
+         unsigned int slot = GetSlot(eid);
+         return (slot == 0) ? mDense.end() : mDense.begin() + (slot - 1);
+      }
+
+      const_iterator find(EntityId eid) const
+      {
+         unsigned int slot = GetSlot(eid);
+         return (slot == 0) ? mDense.end() : mDense.begin() + (slot - 1);
+      }
+
+      size_type count(EntityId eid) const
+      {
+         return (GetSlot(eid) == 0) ? 0 : 1;
+      }
+
+      /**
+       * Access component pointer for entity. Like std::map, inserts
+       * a NULL entry if entity is not yet in store.
+       */
+      T*& operator[](EntityId eid)
+      {
+         unsigned int& slot = GetOrCreateSlot(eid);
+         if(slot == 0)
+         {
+            mDense.push_back(value_type(eid, (T*)NULL));
+            slot = static_cast<unsigned int>(mDense.size());
+         }
+         else if(mDense[slot - 1].first != eid)
+         {
+            // entry of an older entity in same slot was not erased
+            assert(false && "Component of killed entity still in store");
+            mDense[slot - 1] = value_type(eid, (T*)NULL);
+         }
+         return mDense[slot - 1].second;
+      }
+
+      /**
+       * Remove entry by moving last entry into its slot
+       */
+      void erase(iterator i)
+      {
+         assert(i != mDense.end());
+         size_type idx = i - mDense.begin();
+         EntityId erased = i->first;
+         if(idx + 1 != mDense.size())
+         {
+            mDense[idx] = mDense.back();
+            GetOrCreateSlot(mDense[idx].first) = static_cast<unsigned int>(idx + 1);
+         }
+         mDense.pop_back();
+         GetOrCreateSlot(erased) = 0;
+      }
+
+      size_type erase(EntityId eid)
+      {
+         iterator i = find(eid);
+         if(i == mDense.end())
+         {
+            return 0;
+         }
+         erase(i);
+         return 1;
+      }
+
+      void clear()
+      {
+         for(typename SparsePages::iterator i = mSparsePages.begin(); i != mSparsePages.end(); ++i)
+         {
+            if(*i != NULL)
+            {
+               memset(*i, 0, sizeof(unsigned int) * PAGE_SIZE);
+            }
+         }
+         mDense.clear();
+      }
+
+   private:
+
+      // sparse index is allocated in pages so that large entity ids
+      // do not cause a huge allocation
+      enum { PAGE_BITS = 12, PAGE_SIZE = 1 << PAGE_BITS };
+
+      // returns dense index + 1, 0 if not in store
+      unsigned int GetSlot(EntityId eid) const
+      {
+         unsigned int index = GetEntityIndex(eid);
+         size_type page = index >> PAGE_BITS;
+         if(page >= mSparsePages.size() || mSparsePages[page] == NULL)
+         {
+            return 0;
+         }
+         unsigned int slot = mSparsePages[page][index & (PAGE_SIZE - 1)];
+         return (slot != 0 && mDense[slot - 1].first == eid) ? slot : 0;
+      }
+
+      unsigned int& GetOrCreateSlot(EntityId eid)
+      {
+         unsigned int index = GetEntityIndex(eid);
+         size_type page = index >> PAGE_BITS;
+         if(page >= mSparsePages.size())
+         {
+            mSparsePages.resize(page + 1, NULL);
+         }
+         if(mSparsePages[page] == NULL)
+         {
+            mSparsePages[page] = new unsigned int[PAGE_SIZE];
+            memset(mSparsePages[page], 0, sizeof(unsigned int) * PAGE_SIZE);
+         }
+         return mSparsePages[page][index & (PAGE_SIZE - 1)];
+      }
+
+      // no copy ctor
+      ComponentStoreSparseSet(const ComponentStoreSparseSet&);
+      ComponentStoreSparseSet& operator=(const ComponentStoreSparseSet&);
+
+      typedef std::vector<unsigned int*> SparsePages;
+      SparsePages mSparsePages;
+      DenseArray mDense;
+   };
+}
@@ -24,6 +24,7 @@
 #include <dtEntity/export.h>
 #include <dtEntity/entityid.h>
 #include <dtEntity/property.h>
+#include <dtEntity/propertyvalue.h>
 #include <dtEntity/stringid.h>
 #include <osg/Referenced>
 #include <osg/ref_ptr>
@@ -47,6 +48,9 @@ namespace dtEntity
       
       typedef std::map<ComponentType, GroupProperty> ComponentProperties;
 
+      // component values as group values
+      typedef std::map<ComponentType, PropertyValue> ComponentValues;
+
       /** 
        * Constructor 
        */
@@ -146,6 +150,13 @@ namespace dtEntity
        */
       void GetAllComponentPropertiesRecursive(ComponentProperties& props) const;
 
+      /**
+       * Get component values of spawner hierarchy, children values overwrite
+       * parent values. Unlike GetAllComponentPropertiesRecursive this does
+       * not clone the properties.
+       */
+      void GetAllComponentValuesRecursive(ComponentValues& values) const;
+
    protected:
 
       virtual ~Spawner();
@@ -75,4 +75,135 @@ namespace dtEntity
 
    unsigned int SIDToUInt(StringId);
 
+   /**
+    * Remember a string for reverse lookup without hashing or copying it.
+    * The string is added to the reverse lookup table when GetStringFromSID
+    * is called next. str has to stay valid until then, use for string literals only.
+    * Called by SID_LITERAL, there should be no need to call this directly.
+    * @threadsafe
+    */
+   void DT_ENTITY_EXPORT AddStringIdLiteral(unsigned int hash, const char* str);
+
+   /**
+    * Copy strings given to AddStringIdLiteral into the reverse lookup table.
+    * Call before unloading a library that used SID_LITERAL.
+    * @threadsafe
+    */
+   void DT_ENTITY_EXPORT FlushStringIdLiterals();
+
+   /**
+    * Memory map a binary string id database as written by hash_sids
+    * (see stringidfile.h) and add its strings to the reverse lookup table.
+    * The file is mapped until program exit, strings are not copied.
+    * sids.bin in the current directory is loaded automatically on first use.
+    * @return false if file could not be opened or is not a valid database
+    * @threadsafe
+    */
+   bool DT_ENTITY_EXPORT LoadStringIdFile(const std::string& path);
+
+#if !DTENTITY_USE_STRINGS_AS_STRINGIDS && (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900))
+   #define DTENTITY_CONSTEXPR_SIDS 1
+#else
+   #define DTENTITY_CONSTEXPR_SIDS 0
+#endif
+
+#if DTENTITY_CONSTEXPR_SIDS
+
+   /**
+    * Compile time version of MurmurHash3_x86_32 with seed 0, gives the same
+    * results as SIDHash on little endian machines.
+    * Written as single expression functions so that C++11 compilers accept it.
+    */
+   namespace ConstHashImpl
+   {
+      constexpr unsigned int Byte(const char* s, int i)
+      {
+         return static_cast<unsigned int>(static_cast<unsigned char>(s[i]));
+      }
+
+      constexpr unsigned int Rotl(unsigned int x, int r)
+      {
+         return (x << r) | (x >> (32 - r));
+      }
+
+      constexpr unsigned int MixK(unsigned int k)
+      {
+         return Rotl(k * 0xcc9e2d51u, 15) * 0x1b873593u;
+      }
+
+      constexpr unsigned int Block(const char* s, int i)
+      {
+         return Byte(s, i) | (Byte(s, i + 1) << 8) | (Byte(s, i + 2) << 16) | (Byte(s, i + 3) << 24);
+      }
+
+      constexpr unsigned int Body(const char* s, int numBlocks, int i, unsigned int h)
+      {
+         return i == numBlocks ? h : Body(s, numBlocks, i + 1, Rotl(h ^ MixK(Block(s, i * 4)), 13) * 5 + 0xe6546b64u);
+      }
+
+      constexpr unsigned int TailK(const char* t, int n)
+      {
+         return (n > 2 ? Byte(t, 2) << 16 : 0) ^ (n > 1 ? Byte(t, 1) << 8 : 0) ^ Byte(t, 0);
+      }
+
+      constexpr unsigned int Tail(const char* s, int len, unsigned int h)
+      {
+         return (len & 3) == 0 ? h : h ^ MixK(TailK(s + (len & ~3), len & 3));
+      }
+
+      constexpr unsigned int FMix3(unsigned int h) { return h ^ (h >> 16); }
+      constexpr unsigned int FMix2(unsigned int h) { return FMix3((h ^ (h >> 13)) * 0xc2b2ae35u); }
+      constexpr unsigned int FMix1(unsigned int h) { return FMix2((h ^ (h >> 16)) * 0x85ebca6bu); }
+
+      constexpr unsigned int Hash(const char* s, int len)
+      {
+         return FMix1(Tail(s, len, Body(s, len / 4, 0, 0)) ^ static_cast<unsigned int>(len));
+      }
+   }
+
+   /**
+    * Hash of a string literal, computed at compile time
+    */
+   template<int N>
+   constexpr unsigned int ConstHash(const char (&str)[N])
+   {
+      return ConstHashImpl::Hash(str, N - 1);
+   }
+
+   /**
+    * Registers string of a compile time hash for reverse lookup,
+    * once per hash value.
+    */
+   template<unsigned int Hash>
+   struct StringIdLiteral
+   {
+      static StringId Get(const char* str)
+      {
+         static const bool registered = (AddStringIdLiteral(Hash, str), true);
+         (void)registered;
+         return Hash;
+      }
+   };
+
+   /**
+    * StringId of a string literal. Hash is computed at compile time, the string
+    * is registered for reverse lookup on first evaluation only (this takes the
+    * lock of the reverse lookup shard), later evaluations neither hash nor lock.
+    * Use instead of SID for string literals.
+    */
+   #define SID_LITERAL(str) (dtEntity::StringIdLiteral<dtEntity::ConstHash(str)>::Get(str))
+
+   /**
+    * StringId of a string literal as compile time constant, for switch
+    * cases and constant expressions. Not registered for reverse lookup.
+    */
+   #define SID_HASH(str) (dtEntity::ConstHash(str))
+
+#else
+
+   #define SID_LITERAL(str) (dtEntity::SID(str))
+   #define SID_HASH(str) (dtEntity::SIDHash(str))
+
+#endif
+
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+namespace dtEntity
+{
+   /**
+    * Layout of the binary string id database (sids.bin) that is written by
+    * hash_sids and memory mapped by the string id manager at startup:
+    *
+    * StringIdFileHeader
+    * mNumEntries x StringIdFileEntry, sorted by hash
+    * mStringBytes bytes of zero terminated strings
+    *
+    * All numbers are stored in native byte order.
+    */
+   struct StringIdFileHeader
+   {
+      char mMagic[4];
+      unsigned int mVersion;
+      unsigned int mNumEntries;
+      unsigned int mStringBytes;
+   };
+
+   struct StringIdFileEntry
+   {
+      unsigned int mHash;
+
+      // offset of string from start of string block
+      unsigned int mOffset;
+   };
+
+   // magic bytes at start of file
+   static const char STRINGID_FILE_MAGIC[4] = { 'S', 'I', 'D', 'B' };
+   enum { STRINGID_FILE_VERSION = 1 };
+}
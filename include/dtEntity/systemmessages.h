@@ -45,6 +45,47 @@ namespace dtEntity
    */
    void DT_ENTITY_EXPORT RegisterSystemMessages(MessageFactory&);
 
+   class TickMessage;
+   class EndOfFrameMessage;
+   class PostUpdateMessage;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Typed form of TickMessage. Sent each frame with MessagePump::EmitTypedMessage,
+    * handlers registered with RegisterForTypedMessages<TickData> get the struct
+    * directly. Handlers registered for TickMessage::TYPE (scripts etc.)
+    * still receive a TickMessage.
+    */
+   struct TickData
+   {
+      typedef TickMessage PropertyMessage;
+
+      TickData()
+         : mDeltaSimTime(0)
+         , mDeltaRealTime(0)
+         , mSimTimeScale(1)
+         , mSimulationTime(0)
+      {
+      }
+
+      float mDeltaSimTime;
+      float mDeltaRealTime;
+      float mSimTimeScale;
+      double mSimulationTime;
+   };
+
+   // Typed form of EndOfFrameMessage
+   struct EndOfFrameData : public TickData
+   {
+      typedef EndOfFrameMessage PropertyMessage;
+   };
+
+   // Typed form of PostUpdateMessage
+   struct PostUpdateData : public TickData
+   {
+      typedef PostUpdateMessage PropertyMessage;
+   };
+
    ////////////////////////////////////////////////////////////////////////////////
    /**
     * Tick message gets sent each frame by the system.
@@ -83,8 +124,14 @@ namespace dtEntity
       void SetSimTimeScale(float v) { mSimTimeScale.Set(v); }
       void SetSimulationTime(double v) { mSimulationTime.Set(v); }
 
+      // conversion from and to typed form
+      void SetData(const TickData& d);
+      void GetData(TickData& d) const;
+
    private:
 
+      static PropertySchema sPropertySchema;
+
       FloatProperty mDeltaSimTime;
       FloatProperty mDeltaRealTime;
       FloatProperty mSimTimeScale;
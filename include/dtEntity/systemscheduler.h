@@ -0,0 +1,176 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <dtEntity/messagepump.h>
+#include <dtEntity/stringid.h>
+#include <dtEntity/systemmessages.h>
+#include <dtEntity/workstealingpool.h>
+#include <string>
+#include <vector>
+
+namespace dtEntity
+{
+   class EntityManager;
+   class EntitySystem;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Runs the tick handlers of entity systems in parallel.
+    *
+    * Each tick handler is added with the component types it reads and
+    * writes. Two handlers conflict if one writes a component type that the
+    * other reads or writes. Conflicting handlers run in the order they were
+    * added, handlers that do not conflict run concurrently on a work
+    * stealing thread pool. Handlers added with AddExclusiveTask conflict
+    * with all others. They run alone on the thread that emitted the tick,
+    * after all handlers added before them are done.
+    *
+    * Handlers must only touch data covered by their declared sets. The
+    * message pump is not thread safe, so handlers with declared sets must
+    * not call EmitMessage or EmitTypedMessage of the attached entity
+    * manager. Debug builds assert this, see MessagePump::IsEmitAllowed.
+    * Use EnqueueMessage instead, queued messages are emitted on the
+    * main thread. Exclusive handlers may emit.
+    *
+    * Entity systems register their tick handlers with
+    * EntityManager::RegisterForTick. Attaching the scheduler moves
+    * these handlers to the scheduler, see EntitySystem::GetComponentAccess.
+    *
+    * Usage:
+    * SystemScheduler scheduler;
+    * scheduler.Attach(em);
+    */
+   class DT_ENTITY_EXPORT SystemScheduler
+   {
+   public:
+
+      typedef TypedMessageFunctor<TickData>::type TickFunctor;
+
+      /**
+       * @param numThreads Number of threads running tasks, including the
+       *                   thread emitting the tick. 0 selects number of processors.
+       */
+      SystemScheduler(unsigned int numThreads = 0);
+
+      // detaches from entity manager
+      ~SystemScheduler();
+
+      /**
+       * Add tick handler that reads and writes given component types
+       */
+      void AddTask(const std::string& name, const TickFunctor& ftr,
+         const std::vector<ComponentType>& reads, const std::vector<ComponentType>& writes);
+
+      /**
+       * Add tick handler that runs alone on the thread emitting the tick,
+       * after all handlers added before and before all handlers added later.
+       * Use for systems that did not declare what they access.
+       */
+      void AddExclusiveTask(const std::string& name, const TickFunctor& ftr);
+
+      /**
+       * Add tick handler of entity system. Added with AddTask if the system
+       * declares its component access, with AddExclusiveTask if not.
+       */
+      void AddSystemTask(const EntitySystem& es, const std::string& name, const TickFunctor& ftr);
+
+      /**
+       * @return false if no task with this functor exists
+       */
+      bool RemoveTask(const TickFunctor& ftr);
+
+      unsigned int GetNumTasks() const { return static_cast<unsigned int>(mTasks.size()); }
+
+      unsigned int GetNumThreads() const { return mPool.GetNumThreads(); }
+
+      /**
+       * Number of tasks in the longest chain of conflicting tasks,
+       * a lower bound for the number of tasks that run one after another
+       */
+      unsigned int GetCriticalPathLength();
+
+      /**
+       * Run all tasks and return when they are done
+       */
+      void Tick(const TickData& data);
+
+      /**
+       * Register Tick as typed tick handler of entity manager and take over
+       * the handlers registered with EntityManager::RegisterForTick
+       * @param options Filter options for registration, see MessagePump
+       */
+      void Attach(EntityManager& em, unsigned int options = FilterOptions::DEFAULT);
+
+      // unregister from entity manager, returning the system tick handlers to it
+      void Detach();
+
+   private:
+
+      class Task;
+
+      // tasks that may run concurrently, followed by an exclusive task
+      struct Phase
+      {
+         std::vector<Task*> mTasks;
+
+         // tasks without predecessors, started at beginning of phase
+         std::vector<PoolTask*> mRoots;
+
+         // length of longest chain of conflicting tasks in phase
+         unsigned int mCriticalPathLength;
+
+         // run on calling thread after mTasks are done, may be NULL
+         Task* mExclusive;
+      };
+
+      // split tasks into phases at exclusive tasks and create dependency edges
+      void BuildGraph();
+
+      static bool Conflicts(const Task& a, const Task& b);
+
+      // no copy ctor
+      SystemScheduler(const SystemScheduler&);
+      SystemScheduler& operator=(const SystemScheduler&);
+
+      // tasks in order they were added
+      std::vector<Task*> mTasks;
+      bool mGraphDirty;
+
+      std::vector<Phase> mPhases;
+
+      // length of longest chain of conflicting tasks
+      unsigned int mCriticalPathLength;
+
+      // data of tick that is running
+      const TickData* mTickData;
+
+      // pump of attached entity manager, NULL if not attached
+      MessagePump* mMessagePump;
+
+      WorkStealingPool mPool;
+
+      EntityManager* mEntityManager;
+      TickFunctor mTickFunctor;
+   };
+}
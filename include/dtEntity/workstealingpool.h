@@ -0,0 +1,133 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/export.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <deque>
+#include <vector>
+
+namespace dtEntity
+{
+   class WorkStealingPool;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Unit of work executed by WorkStealingPool. Tasks are not owned by the pool.
+    */
+   class PoolTask
+   {
+   public:
+      virtual ~PoolTask() {}
+
+      /**
+       * Called by one of the pool threads.
+       * @param workerIndex Index of executing thread, pass it to
+       *                    WorkStealingPool::Push when spawning follow-up tasks
+       */
+      virtual void Execute(WorkStealingPool& pool, unsigned int workerIndex) = 0;
+   };
+
+   class PoolWorkerThread;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Thread pool in which every thread has its own task queue.
+    * Threads take tasks from the back of their own queue and steal from
+    * the front of other queues when their queue is empty, so tasks spawned
+    * by a task usually run on the same thread while idle threads
+    * still help out.
+    *
+    * The thread calling Run is worker 0 and executes tasks too. Between
+    * calls to Run the worker threads sleep.
+    */
+   class DT_ENTITY_EXPORT WorkStealingPool
+   {
+   public:
+
+      /**
+       * @param numThreads Number of threads executing tasks, including
+       *                   the thread calling Run. 0 selects number of processors.
+       */
+      WorkStealingPool(unsigned int numThreads = 0);
+
+      // stops worker threads
+      ~WorkStealingPool();
+
+      /** Number of threads executing tasks, including the calling thread */
+      unsigned int GetNumThreads() const { return static_cast<unsigned int>(mQueues.size()); }
+
+      /**
+       * Add task to queue of given worker. Only call from inside Run,
+       * either from the thread calling Run before or from a task.
+       * @threadsafe
+       */
+      void Push(PoolTask* task, unsigned int workerIndex);
+
+      /**
+       * Execute given tasks and all tasks pushed by them,
+       * return when all are done. Not reentrant.
+       */
+      void Run(const std::vector<PoolTask*>& tasks);
+
+   private:
+
+      friend class PoolWorkerThread;
+
+      struct TaskQueue
+      {
+         OpenThreads::Mutex mMutex;
+         std::deque<PoolTask*> mTasks;
+      };
+
+      // take task from own queue or steal one. Returns NULL if all queues are empty
+      PoolTask* TakeTask(unsigned int workerIndex);
+
+      // execute one task if there is one
+      bool ExecuteTask(unsigned int workerIndex);
+
+      // called by worker threads, returns false when pool shuts down
+      bool WaitForWork();
+
+      bool IsRunning() const { return mRunning != 0; }
+
+      // no copy ctor
+      WorkStealingPool(const WorkStealingPool&);
+      WorkStealingPool& operator=(const WorkStealingPool&);
+
+      std::vector<TaskQueue*> mQueues;
+      std::vector<PoolWorkerThread*> mThreads;
+
+      // tasks pushed but not yet finished
+      OpenThreads::Atomic mPending;
+
+      // set while Run executes tasks
+      OpenThreads::Atomic mRunning;
+
+      // workers sleep on condition between runs
+      OpenThreads::Mutex mWakeMutex;
+      OpenThreads::Condition mWakeCondition;
+      bool mQuit;
+   };
+}
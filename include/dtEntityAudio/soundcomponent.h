@@ -29,6 +29,7 @@
 #include <dtEntity/component.h>
 #include <dtEntity/message.h>
 #include <dtEntity/stringid.h>
+#include <dtEntity/systemmessages.h>
 #include <dtEntityAudio/sound.h>
 
 
@@ -165,7 +166,9 @@ namespace dtEntityAudio
       void OnRemoveFromEntityManager(dtEntity::EntityManager& em);
       void OnEnterWorld(const dtEntity::Message&);
       void OnLeaveWorld(const dtEntity::Message&);
-      void OnTick(const dtEntity::Message& msg);
+      void OnTick(const dtEntity::TickData& msg);
+
+      bool GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const;
 
       /// Override base class behavior to save system properties to file
       virtual bool StorePropertiesToScene() const { return true; }
@@ -187,7 +190,7 @@ namespace dtEntityAudio
 
       dtEntity::MessageFunctor mEnterWorldFunctor;
       dtEntity::MessageFunctor mLeaveWorldFunctor;
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::MessageFunctor mWindowClosedFunctor;
       dtEntity::FloatProperty mListenerGain;
       dtEntity::DynamicUIntProperty mListenerEntity;
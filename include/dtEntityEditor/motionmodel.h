@@ -24,6 +24,7 @@
 #include <dtEntity/defaultentitysystem.h>
 #include <dtEntityOSG/cameracomponent.h>
 #include <dtEntity/inputinterface.h>
+#include <dtEntity/systemmessages.h>
 
 namespace dtEntityEditor
 {   
@@ -93,13 +94,15 @@ namespace dtEntityEditor
       MotionModelSystem(dtEntity::EntityManager& em);
       ~MotionModelSystem();
 
+      bool GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const;
+
    private:
 
-      void Tick(const dtEntity::Message& m);
+      void Tick(const dtEntity::TickData& msg);
       void MoveToPos(const dtEntity::Message& m);
       void MoveToEntity(const dtEntity::Message& m);
 
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::MessageFunctor mMoveToPosFunctor;
       dtEntity::MessageFunctor mMoveToEntityFunctor;
    };
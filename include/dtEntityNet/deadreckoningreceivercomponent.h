@@ -25,6 +25,7 @@
 #include <dtEntity/defaultentitysystem.h>
 #include <dtEntity/messagepump.h>
 #include <dtEntity/scriptaccessor.h>
+#include <dtEntity/systemmessages.h>
 #include <dtEntityNet/deadreckoning.h>
 #include <dtEntityNet/export.h>
 #include <osg/Timer>
@@ -42,7 +43,7 @@ namespace dtEntityOSG
 
 namespace dtEntityNet
 {
-   class UpdateTransformMessage;
+   struct UpdateTransformData;
    class DeadReckoningReceiverSystem;
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -95,7 +96,9 @@ namespace dtEntityNet
       void OnAddedToEntityManager(dtEntity::EntityManager&);
       void OnRemovedFromEntityManager(dtEntity::EntityManager&);
 
-      void OnUpdateTransform(const dtEntity::Message& msg);
+      bool GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const;
+
+      void OnUpdateTransform(const UpdateTransformData& msg);
       void OnJoin(const dtEntity::Message& msg);
       void OnResign(const dtEntity::Message& msg);
 
@@ -112,10 +115,10 @@ namespace dtEntityNet
    private:
 
       dtEntity::Property* ScriptConnect(const dtEntity::PropertyArgs& args);
-      void Tick(const dtEntity::Message& m);
+      void Tick(const dtEntity::TickData& msg);
 
       dtEntity::MapSystem* mMapSystem;
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::BoolProperty mSpawnFromEntityType;
 
    };
@@ -26,6 +26,7 @@
 #include <dtEntity/dynamicproperty.h>
 #include <dtEntity/dynamicscomponent.h>
 #include <dtEntity/messagepump.h>
+#include <dtEntity/systemmessages.h>
 #include <dtEntityOSG/transformcomponent.h>
 #include <dtEntityNet/deadreckoning.h>
 #include <dtEntityNet/export.h>
@@ -38,7 +39,7 @@ namespace dtEntityNet
 {
 
    class DeadReckoningSenderSystem;
-   class UpdateTransformMessage;
+   struct UpdateTransformData;
 
    ////////////////////////////////////////////////////////////////////////////////
    class DTENTITY_NET_EXPORT DeadReckoningSenderComponent
@@ -71,7 +72,7 @@ namespace dtEntityNet
       void SetUniqueId(const std::string& v) { mUniqueId = v; }
       std::string GetUniqueId() const { return mUniqueId; }
 
-      void FillMessage(UpdateTransformMessage& msg);
+      void FillMessage(UpdateTransformData& msg);
 
       bool IsInScene() const { return mIsInScene; }
 
@@ -93,9 +94,9 @@ namespace dtEntityNet
 
    ////////////////////////////////////////////////////////////////////////////////
    class DTENTITY_NET_EXPORT DeadReckoningSenderSystem
-      : public dtEntity::DefaultEntitySystem<DeadReckoningSenderComponent>
+      : public dtEntity::DefaultEntitySystem<DeadReckoningSenderComponent, dtEntity::MemAllocPolicyNew, dtEntity::ComponentStoreSparseSet>
    {
-      typedef dtEntity::DefaultEntitySystem<DeadReckoningSenderComponent> BaseClass;
+      typedef dtEntity::DefaultEntitySystem<DeadReckoningSenderComponent, dtEntity::MemAllocPolicyNew, dtEntity::ComponentStoreSparseSet> BaseClass;
 
    public:
 
@@ -110,6 +111,8 @@ namespace dtEntityNet
 
       dtEntity::ComponentType GetComponentType() const { return TYPE; }  
 
+      bool GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const;
+
       float GetMinUpdateInterval() const { return mMinUpdateInterval.Get(); }
       void SetMinUpdateInterval(float v) { mMinUpdateInterval.Set(v); }
 
@@ -128,11 +131,11 @@ namespace dtEntityNet
 
    private:
 
-      void Tick(const dtEntity::Message& m);
+      void Tick(const dtEntity::TickData& msg);
       void OnAddedToScene(const dtEntity::Message& m);
       void OnRemovedFromScene(const dtEntity::Message& m);
 
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::MessageFunctor mEnterWorldFunctor;
       dtEntity::MessageFunctor mLeaveWorldFunctor;
 
@@ -35,6 +35,32 @@ namespace dtEntityNet
 
    void DTENTITY_NET_EXPORT RegisterMessageTypes(dtEntity::MessageFactory&);
 
+   class UpdateTransformMessage;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Typed form of UpdateTransformMessage, emitted with MessagePump::EmitTypedMessage.
+    * Network encoder and scripts receive it as UpdateTransformMessage.
+    */
+   struct UpdateTransformData
+   {
+      typedef UpdateTransformMessage PropertyMessage;
+
+      UpdateTransformData()
+         : mDeadReckoning(DeadReckoningAlgorithm::DISABLED)
+         , mSimTime(0)
+      {
+      }
+
+      DeadReckoningAlgorithm::e mDeadReckoning;
+      osg::Vec3d mPosition;
+      osg::Vec3f mVelocity;
+      osg::Vec3f mOrientation;
+      osg::Vec3f mAngularVelocity;
+      double mSimTime;
+      std::string mUniqueId;
+   };
+
    ////////////////////////////////////////////////////////////////////////////////
    class DTENTITY_NET_EXPORT JoinMessage
       : public dtEntity::Message
@@ -173,6 +199,10 @@ namespace dtEntityNet
       void SetUniqueId(const std::string& v) { mUniqueId.Set(v); }
       std::string GetUniqueId() const { return mUniqueId.Get(); }
 
+      // conversion from and to typed form
+      void SetData(const UpdateTransformData& d);
+      void GetData(UpdateTransformData& d) const;
+
    private:
 
       dtEntity::UIntProperty mDeadReckoningAlgorithm;
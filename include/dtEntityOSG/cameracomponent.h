@@ -119,7 +119,8 @@ namespace dtEntityOSG
       osg::Vec3d GetEyeDirection() const;
 
 	  /**
-	   * Re-calculate osg camera view matrix from up, pos and eye dir vectors
+	   * Re-calculate osg camera view matrix from up, pos and eye dir vectors.
+	   * Deferred to next TransformSystem::SwapBuffers while double buffered.
 	   */
       void UpdateViewMatrix();
 
@@ -188,6 +189,10 @@ namespace dtEntityOSG
 
       void TryAssignContext();
       
+   protected:
+
+      virtual void ApplyBackBuffer();
+
    private:
 
 
@@ -26,6 +26,7 @@
 #include <dtEntity/message.h>
 #include <dtEntity/dynamicproperty.h>
 #include <dtEntity/scriptaccessor.h>
+#include <dtEntity/systemmessages.h>
 #include <osgUtil/IntersectionVisitor>
 #include <osgUtil/LineSegmentIntersector>
 #include <osgSim/LineOfSight>
@@ -123,10 +124,10 @@ namespace dtEntityOSG
 
 
    class GroundClampingSystem
-      : public dtEntity::DefaultEntitySystem<GroundClampingComponent>
+      : public dtEntity::DefaultEntitySystem<GroundClampingComponent, dtEntity::MemAllocPolicyNew, dtEntity::ComponentStoreSparseSet>
       , public dtEntity::ScriptAccessor
    {
-      typedef dtEntity::DefaultEntitySystem<GroundClampingComponent> BaseClass;
+      typedef dtEntity::DefaultEntitySystem<GroundClampingComponent, dtEntity::MemAllocPolicyNew, dtEntity::ComponentStoreSparseSet> BaseClass;
       
    public:
      
@@ -140,7 +141,7 @@ namespace dtEntityOSG
 
       void OnRemoveFromEntityManager(dtEntity::EntityManager& em);
 
-      void Tick(const dtEntity::Message& msg);
+      void Tick(const dtEntity::EndOfFrameData& tick);
       void CameraAdded(const dtEntity::Message& msg);
       void CameraRemoved(const dtEntity::Message& msg);
       void MapLoaded(const dtEntity::Message& msg);
@@ -164,7 +165,7 @@ namespace dtEntityOSG
       void HandleIntersection(GroundClampingComponent* component,
          const osgUtil::LineSegmentIntersector::Intersection& intersection, float dt, double simTime);
 
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::EndOfFrameData>::type mTickFunctor;
       dtEntity::MessageFunctor mCameraAddedFunctor;
       dtEntity::MessageFunctor mCameraRemovedFunctor;
 	   dtEntity::MessageFunctor mMapLoadedFunctor;
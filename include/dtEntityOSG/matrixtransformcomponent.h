@@ -106,9 +106,16 @@ namespace dtEntityOSG
          SetMatrix(m);
       }
 
+   protected:
+
+      virtual void ApplyBackBuffer();
+
    private:
 
       dtEntity::DynamicMatrixProperty mMatrix;
+
+      // written instead of node while double buffered
+      dtEntity::Matrix mBackMatrix;
    };
 
    
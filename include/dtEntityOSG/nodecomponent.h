@@ -31,6 +31,62 @@
 namespace dtEntityOSG
 {
 
+   ///////////////////////////////////////////////////////////////////////////
+   /**
+    * Structural changes to the scene graph. Applied immediately unless
+    * deferred. In pipelined mode (see OSGSystemInterface::SetPipelined)
+    * changes are deferred, because message handlers run while the scene
+    * graph is culled. Deferred changes are applied in order by
+    * ApplyChanges at the frame sync point. Until then the scene graph
+    * still shows the old state, do not check it for a change just made.
+    */
+   class DTENTITY_OSG_EXPORT SceneGraphChanges
+   {
+   public:
+
+      /**
+       * @return false if child could not be added. Deferred changes
+       *         only fail if child is NULL
+       */
+      static bool AddChild(osg::Group* parent, osg::Node* child);
+      static void RemoveChild(osg::Group* parent, osg::Node* child);
+      static void RemoveChildren(osg::Group* parent);
+
+      // set bits of set, then clear bits of clear
+      static void ChangeNodeMask(osg::Node* node, unsigned int set, unsigned int clear);
+
+      // recursive sets mask of all groups below node, see NodeMaskVisitor
+      static void SetNodeMask(osg::Node* node, unsigned int mask, bool recursive = false);
+
+      /**
+       * Switching deferral off applies pending changes.
+       * Must not be called while cull or simulation are running.
+       */
+      static void SetDeferred(bool v);
+      static bool IsDeferred() { return s_deferred; }
+
+      /**
+       * Apply deferred changes. Must not be called while cull or
+       * simulation are running.
+       */
+      static void ApplyChanges();
+
+      /**
+       * Entity systems that change the scene graph without this class
+       * register while they exist. Pipelined mode is refused while any
+       * is registered.
+       * @threadsafe
+       */
+      static void AddDirectWriter();
+      static void RemoveDirectWriter();
+      static unsigned int GetNumDirectWriters();
+
+   private:
+
+      static bool s_deferred;
+   };
+
+   ///////////////////////////////////////////////////////////////////////////
    class DTENTITY_OSG_EXPORT NodeStore
    {
    public:
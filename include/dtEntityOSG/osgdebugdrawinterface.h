@@ -24,6 +24,7 @@
 #include <dtEntity/debugdrawinterface.h>
 #include <dtEntityOSG/export.h>
 #include <dtEntity/entitymanager.h>
+#include <dtEntity/systemmessages.h>
 #include <dtEntityOSG/layerattachpointcomponent.h>
 #include <osg/ref_ptr>
 #include <osg/Group>
@@ -61,7 +62,7 @@ namespace dtEntityOSG
       /**
        * message functors, don't call directly
        */
-      void Tick(const dtEntity::Message& msg);
+      void Tick(const dtEntity::TickData& msg);
       void OnEnable(const dtEntity::Message& m);
 
       /**
@@ -278,7 +279,7 @@ namespace dtEntityOSG
       double mCurrentTime;
       dtEntity::EntityManager* mEntityManager;
       dtEntity::MessageFunctor mEnableFunctor;
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::StringId mLayerName;
       int mContextId;
       bool mContextIdSet;
@@ -28,6 +28,7 @@
 
 namespace dtEntity
 {
+   class EntityManager;
    class MessagePump;
 }
 
@@ -38,6 +39,11 @@ namespace dtEntityOSG
    {
    public:
 
+      OSGSystemInterface(dtEntity::EntityManager&, int argc, const char** argv);
+
+      /**
+       * Without an entity manager pipelined mode is not available
+       */
       OSGSystemInterface(dtEntity::MessagePump&, int argc, const char** argv);
       ~OSGSystemInterface();
 
@@ -50,10 +56,54 @@ namespace dtEntityOSG
       osgViewer::GraphicsWindow* GetPrimaryWindow() const;
       osg::Camera* GetPrimaryCamera() const;
 
+      /**
+       * In serial mode, emits tick, queued and end of frame messages.
+       * In pipelined mode, waits for the simulation of the previous frame,
+       * writes buffered transforms to the scene graph and starts
+       * simulating the next frame on the simulation thread.
+       */
       virtual void EmitTickMessagesAndQueuedMessages();
 
+      /**
+       * Does nothing in pipelined mode, the simulation thread emits
+       * PostUpdate after EndOfFrame.
+       */
       virtual void EmitPostUpdateMessage();
 
+      /**
+       * Pipelined mode: frame N+1 is simulated on a separate thread while the
+       * viewer traverses and draws frame N, so frame time is bounded by the
+       * slower of the two instead of their sum. Rendering lags simulation by
+       * one frame.
+       *
+       * Transform and camera components are double buffered while pipelined,
+       * see TransformSystem::SetDoubleBuffered. Adding and removing
+       * nodes and changing node masks is deferred to the frame sync point,
+       * see SceneGraphChanges. Pipelined mode is refused while entity
+       * systems exist that change the scene graph directly, for example
+       * particles or text labels. Create windows and cameras and set camera
+       * properties other than the view before switching to pipelined mode.
+       *
+       * Message handlers run on the simulation thread. Code outside of
+       * message handlers, like event handlers and update callbacks, must
+       * call WaitForSimulation before touching entities or components,
+       * or use EnqueueMessage.
+       *
+       * The viewer loop stays the same:
+       * advance, eventTraversal, EmitTickMessagesAndQueuedMessages,
+       * updateTraversal, EmitPostUpdateMessage, renderingTraversals.
+       * Requires construction with an entity manager.
+       * @return false if pipelined mode was refused
+       */
+      bool SetPipelined(bool v);
+      bool IsPipelined() const;
+
+      /**
+       * Block until simulation of current frame is done.
+       * Returns immediately when not pipelined.
+       */
+      void WaitForSimulation();
+
       virtual float GetDeltaSimTime() const;
       virtual float GetDeltaRealTime() const;
       virtual dtEntity::Timer_t GetRealClockTime() const;
@@ -103,6 +153,7 @@ namespace dtEntityOSG
 
    private:
       osg::observer_ptr<osgViewer::ViewerBase> mViewer;      
+      dtEntity::EntityManager* mEntityManager;
       dtEntity::MessagePump* mMessagePump;
       class Impl;
       Impl* mImpl;
@@ -82,11 +82,23 @@ namespace dtEntityOSG
       virtual dtEntity::Matrix GetMatrix() const;
       virtual void SetMatrix(const dtEntity::Matrix& mat);
 
+   protected:
+
+      virtual void ApplyBackBuffer();
+
    private:
 
+      // copy node values to back buffer before first write of a frame
+      void PrepareBackBuffer();
+
       dtEntity::DynamicVec3dProperty mPosition;
       dtEntity::DynamicVec3dProperty mScale;
       dtEntity::DynamicQuatProperty mAttitude;
+
+      // written instead of node while double buffered
+      dtEntity::Vec3d mBackPosition;
+      dtEntity::Quat mBackAttitude;
+      dtEntity::Vec3d mBackScale;
    };
 
    ///////////////////////////////////////////////////////////////////////////
@@ -78,6 +78,7 @@ namespace dtEntityOSG
    public:
       static const dtEntity::ComponentType TYPE;
       SkyBoxSystem(dtEntity::EntityManager& em);
+      ~SkyBoxSystem();
    };
 
 }
@@ -136,6 +136,7 @@ namespace dtEntityOSG
       static const dtEntity::ComponentType TYPE;
 
       TextLabelSystem(dtEntity::EntityManager& em);
+      ~TextLabelSystem();
 
       void SetEnabled(bool v);
       bool GetEnabled() const;
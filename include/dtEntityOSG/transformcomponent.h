@@ -21,16 +21,69 @@
 */
 
 #include <osg/ref_ptr>
+#include <osg/Referenced>
+#include <OpenThreads/Mutex>
 #include <dtEntityOSG/export.h>
 #include <dtEntity/defaultentitysystem.h>
 #include <dtEntity/component.h>
 #include <dtEntityOSG/groupcomponent.h>
 #include <dtEntity/property.h>
 #include <dtEntity/stringid.h>
+#include <vector>
 
 namespace dtEntityOSG
 {
 
+   class TransformComponent;
+
+   ///////////////////////////////////////////////////////////////////////////
+   /**
+    * Back buffer bookkeeping of the transform components of one entity manager.
+    * Owned by the TransformSystem and referenced by its components, so
+    * components may outlive the system during entity manager shutdown.
+    */
+   class DTENTITY_OSG_EXPORT TransformBuffers
+      : public osg::Referenced
+   {
+   public:
+
+      TransformBuffers();
+
+      /**
+       * When double buffering is on, setters of transform components write to
+       * a back buffer instead of the scene graph node and getters return the
+       * buffered values. SwapBuffers writes the buffered values to the nodes.
+       * Switching double buffering off swaps buffers once.
+       */
+      void SetDoubleBuffered(bool v);
+      bool IsDoubleBuffered() const { return mDoubleBuffered; }
+
+      /**
+       * Write back buffers of all dirty transform components to their nodes.
+       * Must not be called while cull or simulation are running.
+       */
+      void SwapBuffers();
+
+      // queue component for next SwapBuffers
+      void MarkDirty(TransformComponent& c);
+
+      // remove component from queue, called on component destruction
+      void Remove(TransformComponent& c);
+
+   protected:
+
+      ~TransformBuffers();
+
+   private:
+
+      bool mDoubleBuffered;
+
+      // components with a dirty back buffer. Guarded by mutex because
+      // systems run by the scheduler may write transforms concurrently.
+      std::vector<TransformComponent*> mDirty;
+      OpenThreads::Mutex mMutex;
+   };
+
    ///////////////////////////////////////////////////////////////////////////
    /**
     * abstract base class for transform components
@@ -76,9 +129,35 @@ namespace dtEntityOSG
          SetRotation(mat.getRotate());
       }
 
+      /**
+       * Fetches back buffer bookkeeping from the TransformSystem
+       * of the entity manager, creating the system if necessary
+       */
+      virtual void OnAddedToEntity(dtEntity::Entity& entity);
+
+      /**
+       * True if the TransformSystem of this component's entity manager
+       * is double buffered, see TransformSystem::SetDoubleBuffered
+       */
+      bool IsDoubleBuffered() const { return mBuffers.valid() && mBuffers->IsDoubleBuffered(); }
+
+   protected:
+
+      // true if back buffer holds values that were not yet written to node
+      bool IsBackBufferDirty() const { return mBackBufferDirty; }
+
+      // call after writing to back buffer, queues component for next SwapBuffers
+      void MarkBackBufferDirty();
+
+      // write back buffer to node
+      virtual void ApplyBackBuffer() {}
 
    private:
 
+      friend class TransformBuffers;
+
+      bool mBackBufferDirty;
+      osg::ref_ptr<TransformBuffers> mBuffers;
    };
 
    ///////////////////////////////////////////////////////////////////////////
@@ -86,12 +165,33 @@ namespace dtEntityOSG
       : public dtEntity::EntitySystem
    {
    public:
-      TransformSystem(dtEntity::EntityManager& em)
-         : dtEntity::EntitySystem(em)
-      {
-      }
+      TransformSystem(dtEntity::EntityManager& em);
 
       dtEntity::ComponentType GetComponentType() const { return TransformComponent::TYPE; }
+
+      /**
+       * Returns transform system of entity manager, adds one if none exists
+       */
+      static TransformSystem& GetOrCreate(dtEntity::EntityManager& em);
+
+      /**
+       * Double buffer transform and camera components of this entity manager.
+       * Lets the simulation run while the scene graph is culled,
+       * see OSGSystemInterface::SetPipelined and TransformBuffers::SetDoubleBuffered.
+       */
+      void SetDoubleBuffered(bool v) { mBuffers->SetDoubleBuffered(v); }
+      bool IsDoubleBuffered() const { return mBuffers->IsDoubleBuffered(); }
+
+      /**
+       * Write back buffers of all dirty transform components to their nodes.
+       * Must not be called while cull or simulation are running.
+       */
+      void SwapBuffers() { mBuffers->SwapBuffers(); }
+
+      TransformBuffers* GetBuffers() const { return mBuffers.get(); }
+
+   private:
+      osg::ref_ptr<TransformBuffers> mBuffers;
    };
 
 }
@@ -27,6 +27,7 @@
 #include <dtEntity/component.h>
 #include <dtEntity/defaultentitysystem.h>
 #include <dtEntity/property.h>
+#include <dtEntity/systemmessages.h>
 #include <set>
 
 namespace dtEntityWrappers
@@ -59,7 +60,7 @@ namespace dtEntityWrappers
       
       void OnSceneLoaded(const dtEntity::Message& msg);
       void OnLoadScript(const dtEntity::Message& msg);
-      void Tick(const dtEntity::Message& msg);
+      void Tick(const dtEntity::TickData& msg);
 
       
 
@@ -106,7 +107,7 @@ namespace dtEntityWrappers
       void FetchGlobalTickFunction();
       
       dtEntity::MessageFunctor mSceneLoadedFunctor;
-      dtEntity::MessageFunctor mTickFunctor;
+      dtEntity::TypedMessageFunctor<dtEntity::TickData>::type mTickFunctor;
       dtEntity::MessageFunctor mLoadScriptFunctor;
       
       dtEntity::BoolProperty mDebugEnabled;
@@ -0,0 +1,193 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <dtEntity/asyncloglistener.h>
+
+#include <OpenThreads/Thread>
+#include <ostream>
+#include <stdio.h>
+
+namespace dtEntity
+{
+   namespace
+   {
+      // how long the writer thread sleeps when there is nothing to write
+      const unsigned int WRITER_SLEEP_MICROSECONDS = 1000;
+
+      void* IndexToPtr(unsigned int index)
+      {
+         return reinterpret_cast<void*>(static_cast<size_t>(index));
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   class AsyncLogWriterThread : public OpenThreads::Thread
+   {
+   public:
+
+      AsyncLogWriterThread(AsyncLogListener& listener)
+         : mListener(&listener)
+      {
+      }
+
+      virtual void run()
+      {
+         for(;;)
+         {
+            // read before draining so that messages logged before Quit are written
+            bool quit = mQuit != 0;
+            if(!mListener->Drain())
+            {
+               if(quit)
+               {
+                  return;
+               }
+               OpenThreads::Thread::microSleep(WRITER_SLEEP_MICROSECONDS);
+            }
+         }
+      }
+
+      void Quit()
+      {
+         mQuit.exchange(1);
+      }
+
+   private:
+      AsyncLogListener* mListener;
+      OpenThreads::Atomic mQuit;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   AsyncLogListener::AsyncLogListener(std::ostream& stream, unsigned int capacity)
+      : mHead(NULL)
+      , mTail(0)
+      , mStream(&stream)
+   {
+      unsigned int size = 2;
+      while(size < capacity)
+      {
+         size <<= 1;
+      }
+      mMask = size - 1;
+      mSlots = new Slot[size];
+      for(unsigned int i = 0; i < size; ++i)
+      {
+         mSlots[i].mSequence.exchange(i);
+      }
+
+      mThread = new AsyncLogWriterThread(*this);
+      mThread->start();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   AsyncLogListener::~AsyncLogListener()
+   {
+      mThread->Quit();
+      mThread->join();
+      delete mThread;
+      delete[] mSlots;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void AsyncLogListener::LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
+                   const std::string& msg)
+   {
+      unsigned int pos = GetHead();
+      Slot* slot;
+      for(;;)
+      {
+         slot = &mSlots[pos & mMask];
+         int diff = static_cast<int>(static_cast<unsigned int>(slot->mSequence) - pos);
+         if(diff == 0)
+         {
+            // slot is free, claim it unless another thread was faster
+            if(mHead.assign(IndexToPtr(pos + 1), IndexToPtr(pos)))
+            {
+               break;
+            }
+         }
+         else if(diff < 0)
+         {
+            // slot still holds a message from last round: ring buffer is full
+            ++mNumDropped;
+            return;
+         }
+         // pos was claimed by another thread, retry with current head
+         pos = GetHead();
+      }
+
+      // format into the slot string to reuse its memory
+      char line[16];
+      sprintf(line, "%d", linenumber);
+      std::string::size_type fnStart = filename.size() < 30 ? 0 : filename.size() - 30;
+      std::string& text = slot->mText;
+      text.assign(LogLevel::GetName(level));
+      text.append(" File: ");
+      text.append(filename, fnStart, std::string::npos);
+      text.append(" Line: ");
+      text.append(line);
+      text.append(" Message: ");
+      text.append(msg);
+      text.push_back('\n');
+
+      slot->mSequence.exchange(pos + 1);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool AsyncLogListener::Drain()
+   {
+      unsigned int tail = mTail;
+      bool wrote = false;
+      for(;;)
+      {
+         Slot& slot = mSlots[tail & mMask];
+         if(slot.mSequence != tail + 1)
+         {
+            break;
+         }
+         *mStream << slot.mText;
+
+         // keep string capacity for next message in this slot
+         slot.mText.clear();
+         slot.mSequence.exchange(tail + mMask + 1);
+         ++tail;
+         mTail = tail;
+         wrote = true;
+      }
+
+      if(wrote)
+      {
+         mStream->flush();
+         mFlushed.exchange(tail);
+      }
+      return wrote;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void AsyncLogListener::Flush()
+   {
+      unsigned int target = GetHead();
+      while(static_cast<int>(target - mFlushed) > 0)
+      {
+         OpenThreads::Thread::microSleep(WRITER_SLEEP_MICROSECONDS / 10);
+      }
+   }
+}
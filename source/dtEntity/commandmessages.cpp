@@ -45,8 +45,8 @@ namespace dtEntity
 
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType DeleteEntityMessage::TYPE(dtEntity::SID("DeleteEntityMessage"));
-   const StringId DeleteEntityMessage::UniqueIdId(dtEntity::SID("UniqueId"));
+   const MessageType DeleteEntityMessage::TYPE(SID_LITERAL("DeleteEntityMessage"));
+   const StringId DeleteEntityMessage::UniqueIdId(SID_LITERAL("UniqueId"));
 
    DeleteEntityMessage::DeleteEntityMessage()
       : Message(TYPE)
@@ -55,8 +55,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EnableDebugDrawingMessage::TYPE(dtEntity::SID("EnableDebugDrawingMessage"));
-   const StringId EnableDebugDrawingMessage::EnableId(dtEntity::SID("Enable"));
+   const MessageType EnableDebugDrawingMessage::TYPE(SID_LITERAL("EnableDebugDrawingMessage"));
+   const StringId EnableDebugDrawingMessage::EnableId(SID_LITERAL("Enable"));
    
    EnableDebugDrawingMessage::EnableDebugDrawingMessage() 
       : Message(TYPE)
@@ -65,11 +65,11 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MoveCameraToEntityMessage::TYPE(dtEntity::SID("MoveCameraToEntityMessage"));
-   const StringId MoveCameraToEntityMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId MoveCameraToEntityMessage::KeepCameraDirectionId(dtEntity::SID("KeepCameraDirection"));
-   const StringId MoveCameraToEntityMessage::DistanceId(dtEntity::SID("Distance"));
-   const StringId MoveCameraToEntityMessage::ContextIdId(dtEntity::SID("ContextId"));
+   const MessageType MoveCameraToEntityMessage::TYPE(SID_LITERAL("MoveCameraToEntityMessage"));
+   const StringId MoveCameraToEntityMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId MoveCameraToEntityMessage::KeepCameraDirectionId(SID_LITERAL("KeepCameraDirection"));
+   const StringId MoveCameraToEntityMessage::DistanceId(SID_LITERAL("Distance"));
+   const StringId MoveCameraToEntityMessage::ContextIdId(SID_LITERAL("ContextId"));
 
    MoveCameraToEntityMessage::MoveCameraToEntityMessage()
       : Message(TYPE)
@@ -84,11 +84,11 @@ namespace dtEntity
 
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MoveCameraToPositionMessage::TYPE(dtEntity::SID("MoveCameraToPositionMessage"));
-   const StringId MoveCameraToPositionMessage::PositionId(dtEntity::SID("Position"));
-   const StringId MoveCameraToPositionMessage::LookAtId(dtEntity::SID("LookAt"));
-   const StringId MoveCameraToPositionMessage::UpId(dtEntity::SID("Up"));
-   const StringId MoveCameraToPositionMessage::ContextIdId(dtEntity::SID("ContextId"));
+   const MessageType MoveCameraToPositionMessage::TYPE(SID_LITERAL("MoveCameraToPositionMessage"));
+   const StringId MoveCameraToPositionMessage::PositionId(SID_LITERAL("Position"));
+   const StringId MoveCameraToPositionMessage::LookAtId(SID_LITERAL("LookAt"));
+   const StringId MoveCameraToPositionMessage::UpId(SID_LITERAL("Up"));
+   const StringId MoveCameraToPositionMessage::ContextIdId(SID_LITERAL("ContextId"));
 
    MoveCameraToPositionMessage::MoveCameraToPositionMessage()
       : Message(TYPE)
@@ -101,9 +101,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType PlayAnimationMessage::TYPE(dtEntity::SID("PlayAnimationMessage"));
-   const StringId PlayAnimationMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId PlayAnimationMessage::AnimationNameId(dtEntity::SID("AnimationName"));
+   const MessageType PlayAnimationMessage::TYPE(SID_LITERAL("PlayAnimationMessage"));
+   const StringId PlayAnimationMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId PlayAnimationMessage::AnimationNameId(SID_LITERAL("AnimationName"));
 
    PlayAnimationMessage::PlayAnimationMessage()
       : Message(TYPE)
@@ -113,8 +113,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType RequestEntityDeselectMessage::TYPE(dtEntity::SID("RequestEntityDeselectMessage"));
-   const StringId RequestEntityDeselectMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const MessageType RequestEntityDeselectMessage::TYPE(SID_LITERAL("RequestEntityDeselectMessage"));
+   const StringId RequestEntityDeselectMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    RequestEntityDeselectMessage::RequestEntityDeselectMessage()
       : Message(TYPE)
@@ -123,9 +123,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType RequestEntitySelectMessage::TYPE(dtEntity::SID("RequestEntitySelectMessage"));
-   const StringId RequestEntitySelectMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId RequestEntitySelectMessage::UseMultiSelectId(dtEntity::SID("UseMultiSelect"));
+   const MessageType RequestEntitySelectMessage::TYPE(SID_LITERAL("RequestEntitySelectMessage"));
+   const StringId RequestEntitySelectMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId RequestEntitySelectMessage::UseMultiSelectId(SID_LITERAL("UseMultiSelect"));
 
    RequestEntitySelectMessage::RequestEntitySelectMessage()
       : Message(TYPE)
@@ -135,8 +135,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType RequestToggleEntitySelectionMessage::TYPE(dtEntity::SID("RequestToggleEntitySelectionMessage"));
-   const StringId RequestToggleEntitySelectionMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const MessageType RequestToggleEntitySelectionMessage::TYPE(SID_LITERAL("RequestToggleEntitySelectionMessage"));
+   const StringId RequestToggleEntitySelectionMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    RequestToggleEntitySelectionMessage::RequestToggleEntitySelectionMessage()
       : Message(TYPE)
@@ -145,10 +145,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SetComponentPropertiesMessage::TYPE(dtEntity::SID("SetComponentPropertiesMessage"));
-   const StringId SetComponentPropertiesMessage::ComponentTypeId(dtEntity::SID("ComponentType"));
-   const StringId SetComponentPropertiesMessage::EntityUniqueIdId(dtEntity::SID("EntityUniqueId"));
-   const StringId SetComponentPropertiesMessage::PropertiesId(dtEntity::SID("Properties"));
+   const MessageType SetComponentPropertiesMessage::TYPE(SID_LITERAL("SetComponentPropertiesMessage"));
+   const StringId SetComponentPropertiesMessage::ComponentTypeId(SID_LITERAL("ComponentType"));
+   const StringId SetComponentPropertiesMessage::EntityUniqueIdId(SID_LITERAL("EntityUniqueId"));
+   const StringId SetComponentPropertiesMessage::PropertiesId(SID_LITERAL("Properties"));
 
    SetComponentPropertiesMessage::SetComponentPropertiesMessage()
       : Message(TYPE)
@@ -173,9 +173,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SetSystemPropertiesMessage::TYPE(dtEntity::SID("SetSystemPropertiesMessage"));
-   const StringId SetSystemPropertiesMessage::ComponentTypeId(dtEntity::SID("ComponentType"));
-   const StringId SetSystemPropertiesMessage::PropertiesId(dtEntity::SID("Properties"));
+   const MessageType SetSystemPropertiesMessage::TYPE(SID_LITERAL("SetSystemPropertiesMessage"));
+   const StringId SetSystemPropertiesMessage::ComponentTypeId(SID_LITERAL("ComponentType"));
+   const StringId SetSystemPropertiesMessage::PropertiesId(SID_LITERAL("Properties"));
 
    SetSystemPropertiesMessage::SetSystemPropertiesMessage()
       : Message(TYPE)
@@ -197,11 +197,11 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SpawnEntityMessage::TYPE(dtEntity::SID("SpawnEntityMessage"));
-   const StringId SpawnEntityMessage::UniqueIdId(dtEntity::SID("UniqueId"));
-   const StringId SpawnEntityMessage::SpawnerNameId(dtEntity::SID("SpawnerName"));
-   const StringId SpawnEntityMessage::EntityNameId(dtEntity::SID("EntityName"));
-   const StringId SpawnEntityMessage::AddToSceneId(dtEntity::SID("AddToScene"));
+   const MessageType SpawnEntityMessage::TYPE(SID_LITERAL("SpawnEntityMessage"));
+   const StringId SpawnEntityMessage::UniqueIdId(SID_LITERAL("UniqueId"));
+   const StringId SpawnEntityMessage::SpawnerNameId(SID_LITERAL("SpawnerName"));
+   const StringId SpawnEntityMessage::EntityNameId(SID_LITERAL("EntityName"));
+   const StringId SpawnEntityMessage::AddToSceneId(SID_LITERAL("AddToScene"));
 
    SpawnEntityMessage::SpawnEntityMessage()
       : Message(TYPE)
@@ -213,8 +213,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType ToolActivatedMessage::TYPE(dtEntity::SID("ToolActivatedMessage"));
-   const StringId ToolActivatedMessage::ToolNameId(dtEntity::SID("ToolName"));
+   const MessageType ToolActivatedMessage::TYPE(SID_LITERAL("ToolActivatedMessage"));
+   const StringId ToolActivatedMessage::ToolNameId(SID_LITERAL("ToolName"));
 
    ToolActivatedMessage::ToolActivatedMessage()
       : Message(TYPE)
@@ -223,11 +223,11 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType ToolsUpdatedMessage::TYPE(dtEntity::SID("ToolsUpdatedMessage"));
-   const StringId ToolsUpdatedMessage::ToolsId(dtEntity::SID("Tools"));
-   const StringId ToolsUpdatedMessage::ToolNameId(dtEntity::SID("ToolName"));
-   const StringId ToolsUpdatedMessage::IconPathId(dtEntity::SID("IconPath"));
-   const StringId ToolsUpdatedMessage::ShortcutId(dtEntity::SID("Shortcut"));
+   const MessageType ToolsUpdatedMessage::TYPE(SID_LITERAL("ToolsUpdatedMessage"));
+   const StringId ToolsUpdatedMessage::ToolsId(SID_LITERAL("Tools"));
+   const StringId ToolsUpdatedMessage::ToolNameId(SID_LITERAL("ToolName"));
+   const StringId ToolsUpdatedMessage::IconPathId(SID_LITERAL("IconPath"));
+   const StringId ToolsUpdatedMessage::ShortcutId(SID_LITERAL("Shortcut"));
 
    ToolsUpdatedMessage::ToolsUpdatedMessage()
       : Message(TYPE)
@@ -25,6 +25,7 @@
 #include <dtEntity/componentplugin.h>
 #include <dtEntity/componentpluginmanager.h>
 #include <dtEntity/dynamicscomponent.h>
+#include <dtEntity/profilersystem.h>
 
 
 namespace dtEntity
@@ -33,6 +34,7 @@ namespace dtEntity
    void RegisterStandardFactories(ComponentPluginManager& pluginManager)
    {
       pluginManager.AddFactory(new ComponentPluginFactoryImpl<DynamicsSystem>("Dynamics"));
+      pluginManager.AddFactory(new ComponentPluginFactoryImpl<ProfilerSystem>("Profiler"));
 
    }
 }
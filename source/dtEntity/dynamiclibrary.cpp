@@ -26,6 +26,7 @@
 
 #include <dtEntity/core.h>
 #include <dtEntity/log.h>
+#include <dtEntity/stringid.h>
 #include <dtEntity/systeminterface.h>
 #include <dtEntity/dynamiclibrary.h>
 
@@ -60,6 +61,8 @@ namespace dtEntity
         if (_handle)
         {
             LOG_INFO("Closing DynamicLibrary "<<_name);
+            // string literals of library are about to be unmapped
+            FlushStringIdLiterals();
     #if defined(WIN32) && !defined(__CYGWIN__)
             FreeLibrary((HMODULE)_handle);
     #elif defined(__APPLE__) && defined(APPLE_PRE_10_3)
@@ -26,10 +26,11 @@ namespace dtEntity
 {
 
    ////////////////////////////////////////////////////////////////////////////
-   const StringId DynamicsComponent::TYPE(dtEntity::SID("Dynamics"));
-   const StringId DynamicsComponent::VelocityId(dtEntity::SID("Velocity"));
-   const StringId DynamicsComponent::AngularVelocityId(dtEntity::SID("AngularVelocity"));
-   const StringId DynamicsComponent::AccelerationId(dtEntity::SID("Acceleration"));
+   const StringId DynamicsComponent::TYPE(SID_LITERAL("Dynamics"));
+   const StringId DynamicsComponent::VelocityId(SID_LITERAL("Velocity"));
+   const StringId DynamicsComponent::AngularVelocityId(SID_LITERAL("AngularVelocity"));
+   const StringId DynamicsComponent::AccelerationId(SID_LITERAL("Acceleration"));
+   PropertySchema DynamicsComponent::sPropertySchema;
 
    ////////////////////////////////////////////////////////////////////////////
    DynamicsComponent::DynamicsComponent()
@@ -41,9 +42,9 @@ namespace dtEntity
       , mAngularVelocity(Quat(0,0,0,1))
       , mIsMoving(false)
    {
-      Register(VelocityId, &mVelocity);
-      Register(AngularVelocityId, &mAngularVelocity);
-      Register(AccelerationId, &mAcceleration);
+      Register(sPropertySchema, VelocityId, &mVelocity);
+      Register(sPropertySchema, AngularVelocityId, &mAngularVelocity);
+      Register(sPropertySchema, AccelerationId, &mAcceleration);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -66,14 +67,23 @@ namespace dtEntity
             EntityVelocityNotNullMessage msg;
             msg.SetAboutEntityId(mEntity->GetId());
             msg.SetIsNull(!isMoving);
-            mEntity->GetEntityManager().EmitMessage(msg);
+            MessagePump& pump = mEntity->GetEntityManager().GetMessagePump();
+            // called from concurrent tick handlers by dead reckoning
+            if(pump.IsEmitAllowed())
+            {
+               pump.EmitMessage(msg);
+            }
+            else
+            {
+               pump.EnqueueMessage(msg);
+            }
          }
       }
    }
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const StringId DynamicsSystem::TYPE(dtEntity::SID("Dynamics"));
+   const StringId DynamicsSystem::TYPE(SID_LITERAL("Dynamics"));
 
    ////////////////////////////////////////////////////////////////////////////
    DynamicsSystem::DynamicsSystem(EntityManager& em)
@@ -22,6 +22,7 @@
 #include <dtEntity/entity.h>
 
 #include <dtEntity/entitymanager.h>
+#include <algorithm>
 
 namespace dtEntity
 {
@@ -45,6 +46,29 @@ namespace dtEntity
       return *mEntityManager;
    }
 
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void Entity::AddComponentSystem(EntitySystem& es)
+   {
+      if(std::find(mComponentSystems.begin(), mComponentSystems.end(), &es) == mComponentSystems.end())
+      {
+         mComponentSystems.push_back(&es);
+         mEntityManager->NotifyComponentAdded(mId, es);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   bool Entity::RemoveComponentSystem(EntitySystem& es)
+   {
+      ComponentSystems::iterator i = std::find(mComponentSystems.begin(), mComponentSystems.end(), &es);
+      if(i == mComponentSystems.end())
+      {
+         return false;
+      }
+      mComponentSystems.erase(i);
+      mEntityManager->NotifyComponentRemoved(mId, es);
+      return true;
+   }
+
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
    bool Entity::CreateComponent(ComponentType t, Component*& component)
    {
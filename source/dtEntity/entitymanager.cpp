@@ -29,6 +29,9 @@
 #include <dtEntity/mapcomponent.h>
 #include <dtEntity/message.h>
 #include <dtEntity/systemmessages.h>
+#include <dtEntity/systemscheduler.h>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
 #include <float.h>
 
 namespace dtEntity
@@ -36,13 +39,22 @@ namespace dtEntity
 
    ////////////////////////////////////////////////////////////////////////////////
    EntityManager::EntityManager()
-      : mNextAvailableId(0)
+      : mSystemScheduler(NULL)
    {     
+      mEndOfFrameFunctor = TypedMessageFunctor<EndOfFrameData>::type(this, &EntityManager::OnEndOfFrame);
+      mMessagePump.RegisterForTypedMessages<EndOfFrameData>(mEndOfFrameFunctor,
+         FilterOptions::ORDER_LATE, "EntityManager::OnEndOfFrame");
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    EntityManager::~EntityManager() 
    {
+      if(mSystemScheduler != NULL)
+      {
+         mSystemScheduler->Detach();
+      }
+      mMessagePump.UnregisterForTypedMessages<EndOfFrameData>(mEndOfFrameFunctor);
+
       // send and delete all outstanding messages
       EmitQueuedMessages(FLT_MAX);
 	  
@@ -57,10 +69,7 @@ namespace dtEntity
          i->second->OnRemoveFromEntityManager(*this);
       }
       // delete all entity objects
-      while(HasEntities())
-      {
-         mEntities.erase(mEntities.begin());
-      }
+      mEntities.Clear();
 
       for(EntitySystemStore::iterator i = mEntitySystemStore.begin();
          i != mEntitySystemStore.end(); ++i)
@@ -72,11 +81,23 @@ namespace dtEntity
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::CreateEntity(Entity*& entity)
    {
-      dtEntity::EntityId eid = this->GetNextAvailableID();
-      entity = new dtEntity::Entity(*this, eid);
+      entity = mEntities.Create(*this);
+      if(entity == NULL)
+      {
+         LOG_ERROR("Cannot create entity, maximum number of entities reached");
+         return false;
+      }
+      return true;
+   }
 
-      OpenThreads::ScopedWriteLock lock(mEntityMutex);
-      mEntities[eid] = entity;
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::CreateEntities(unsigned int count, std::vector<Entity*>& entities)
+   {
+      if(mEntities.Create(*this, count, entities) != count)
+      {
+         LOG_ERROR("Cannot create entities, maximum number of entities reached");
+         return false;
+      }
       return true;
    }
 
@@ -86,10 +107,17 @@ namespace dtEntity
       bool success = true;
       std::vector<Component*> comps;
 
-      for(EntitySystemStore::iterator i = mEntitySystemStore.begin();
-          i != mEntitySystemStore.end(); ++i)
+      Entity* originEntity = mEntities.Get(origin);
+      if(originEntity == NULL)
+      {
+         LOG_ERROR("Cannot clone entity: origin entity does not exist");
+         return false;
+      }
+
+      const Entity::ComponentSystems& systems = originEntity->GetComponentSystems();
+      for(Entity::ComponentSystems::const_iterator i = systems.begin(); i != systems.end(); ++i)
       {
-         EntitySystem* sys = i->second;
+         EntitySystem* sys = *i;
 
          if(sys->AllowComponentCreationBySpawner())
          {
@@ -125,16 +153,14 @@ namespace dtEntity
             continue;
          }
 
-         const PropertyGroup& props = origincomp->Get();
-
-         for(PropertyGroup::const_iterator i = props.begin(); i != props.end(); ++i)
+         for(PropertyContainer::ConstIterator i(*origincomp); !i.AtEnd(); i.Next())
          {
-            Property* prp = clonecomp->Get(i->first);
+            Property* prp = clonecomp->Get(i.GetName());
             if(prp)
             {
-               prp->SetFrom(*i->second);
+               prp->SetFrom(*i.GetProperty());
 #if CALL_ONPROPERTYCHANGED_METHOD
-               clonecomp->OnPropertyChanged(i->first, *prp);
+               clonecomp->OnPropertyChanged(i.GetName(), *prp);
 #endif
             }
             else
@@ -166,15 +192,13 @@ namespace dtEntity
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::HasEntity(EntityId id) const
    {
-      OpenThreads::ScopedReadLock lock(mEntityMutex);
-      return mEntities.find(id) != mEntities.end();
+      return mEntities.Contains(id);
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::HasEntities() const
    {
-      OpenThreads::ScopedReadLock lock(mEntityMutex);
-      return (!mEntities.empty());
+      return mEntities.GetNumEntities() != 0;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -199,71 +223,191 @@ namespace dtEntity
       return false;
    }
 
-   ////////////////////////////////////////////////////////////////////////////////
-   EntityId EntityManager::GetNextAvailableID() 
-   {
-      return ++mNextAvailableId;
-   }
-
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::GetEntity(EntityId id, Entity*& entity)
    {
-      OpenThreads::ScopedReadLock lock(mEntityMutex);
-      EntityMap::const_iterator it = mEntities.find(id);
-      if(it == mEntities.end()) return false;
-      entity = it->second;
+      Entity* e = mEntities.Get(id);
+      if(e == NULL) return false;
+      entity = e;
       return true;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::EntityExists(EntityId id) const
    {
-      OpenThreads::ScopedReadLock lock(mEntityMutex);
-      EntityMap::const_iterator it = mEntities.find(id);
-      if(it == mEntities.end()) return false;
-      return true;
+      return mEntities.Contains(id);
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    void EntityManager::GetEntityIds(std::vector<EntityId>& toFill)
    {
-      OpenThreads::ScopedReadLock lock(mEntityMutex);
-      EntityMap::const_iterator it = mEntities.begin();
-      for(; it != mEntities.end(); ++it)
-      {
-         toFill.push_back(it->first);
-      }
+      mEntities.GetEntityIds(toFill);
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    bool EntityManager::KillEntity(EntityId id) 
    {      
-      EntitySystemStore::iterator i = mEntitySystemStore.begin();
-      for(; i != mEntitySystemStore.end(); ++i)
+      Entity* entity = mEntities.Get(id);
+      if(entity == NULL)
+      {
+         return false;
+      }
+
+      DeleteAllComponents(*entity);
+      mMessagePump.UnregisterForEntity(id);
+      return mEntities.Destroy(id);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityManager::DeleteAllComponents(Entity& entity)
+   {
+      EntityId id = entity.GetId();
+
+      // delete components in reverse order of creation. Only visits the
+      // systems that actually hold a component of this entity
+      while(!entity.GetComponentSystems().empty())
       {
-         if(i->second->HasComponent(id))
+         EntitySystem* es = entity.GetComponentSystems().back();
+         if(!mDeletedCallbacks.empty())
          {
-            if(!mDeletedCallbacks.empty())
+            for(ComponentDeletedCallbacks::iterator j = mDeletedCallbacks.begin(); j != mDeletedCallbacks.end(); ++j)
             {
-               for(ComponentDeletedCallbacks::iterator j = mDeletedCallbacks.begin(); j != mDeletedCallbacks.end(); ++j)
-               {
-                  (*j)->ComponentDeleted(i->first, id);
-               }
+               (*j)->ComponentDeleted(es->GetComponentType(), id);
             }
-            i->second->DeleteComponent(id);            
          }
+         es->DeleteComponent(id);
+
+         // in case entity system did not unregister itself
+         entity.RemoveComponentSystem(*es);
       }
-      
-      OpenThreads::ScopedWriteLock lock(mEntityMutex);
-      EntityMap::iterator it = mEntities.find(id);
-      if(it == mEntities.end())
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::KillEntities(const std::vector<EntityId>& ids)
+   {
+      bool success = true;
+
+      // grouping is only needed for the callbacks, without callbacks
+      // deleting entity by entity is faster
+      if(mDeletedCallbacks.empty())
       {
-         return false;
+         for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+         {
+            Entity* entity = mEntities.Get(*i);
+            if(entity == NULL)
+            {
+               success = false;
+               continue;
+            }
+            DeleteAllComponents(*entity);
+            mMessagePump.UnregisterForEntity(*i);
+         }
+         mEntities.Destroy(ids);
+         return success;
       }
-      dtEntity::Entity* e = it->second;
-      mEntities.erase(it);
-      delete e;
-      return true;
+
+      // collect (system, entity) pairs and group them by system. Groups are
+      // ordered by first occurrence, so the order does not depend on
+      // where the systems are in memory
+      typedef std::vector<std::pair<unsigned int, EntityId> > SystemEntityPairs;
+      std::vector<EntitySystem*> systemOrder;
+      SystemEntityPairs pairs;
+      pairs.reserve(ids.size() * 2);
+      for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+      {
+         Entity* entity = mEntities.Get(*i);
+         if(entity == NULL)
+         {
+            success = false;
+            continue;
+         }
+         const Entity::ComponentSystems& systems = entity->GetComponentSystems();
+         for(Entity::ComponentSystems::const_iterator j = systems.begin(); j != systems.end(); ++j)
+         {
+            unsigned int index = static_cast<unsigned int>(
+               std::find(systemOrder.begin(), systemOrder.end(), *j) - systemOrder.begin());
+            if(index == systemOrder.size())
+            {
+               systemOrder.push_back(*j);
+            }
+            pairs.push_back(std::make_pair(index, *i));
+         }
+      }
+      std::sort(pairs.begin(), pairs.end());
+
+      // remove duplicate ids
+      pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+      for(SystemEntityPairs::const_iterator k = pairs.begin(); k != pairs.end(); ++k)
+      {
+         ComponentType ctype = systemOrder[k->first]->GetComponentType();
+         for(ComponentDeletedCallbacks::iterator j = mDeletedCallbacks.begin(); j != mDeletedCallbacks.end(); ++j)
+         {
+            (*j)->ComponentDeleted(ctype, k->second);
+         }
+      }
+
+      // delete components in the same order as KillEntity, in reverse order
+      // of creation per entity. Only the components that callbacks were
+      // called for, work on a copy of the system list.
+      std::vector<EntitySystem*> systems;
+      for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+      {
+         Entity* entity = mEntities.Get(*i);
+         if(entity == NULL)
+         {
+            continue;
+         }
+         systems.assign(entity->GetComponentSystems().begin(), entity->GetComponentSystems().end());
+         for(std::vector<EntitySystem*>::reverse_iterator j = systems.rbegin(); j != systems.rend(); ++j)
+         {
+            (*j)->DeleteComponent(*i);
+            entity->RemoveComponentSystem(**j);
+         }
+      }
+
+      // components may have been added while deleting
+      for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+      {
+         Entity* entity = mEntities.Get(*i);
+         if(entity != NULL)
+         {
+            DeleteAllComponents(*entity);
+            mMessagePump.UnregisterForEntity(*i);
+         }
+      }
+
+      mEntities.Destroy(ids);
+      return success;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityManager::KillEntityDeferred(EntityId id)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mDeferredKillsMutex);
+      mDeferredKills.push_back(id);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityManager::FlushDeferredKills()
+   {
+      std::vector<EntityId> toKill;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mDeferredKillsMutex);
+         if(mDeferredKills.empty())
+         {
+            return;
+         }
+         // entities queued while killing are handled in next flush
+         toKill.swap(mDeferredKills);
+      }
+      KillEntities(toKill);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityManager::OnEndOfFrame(const EndOfFrameData& msg)
+   {
+      FlushDeferredKills();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -306,6 +450,19 @@ namespace dtEntity
       }
       ComponentType baseType = s.GetBaseType();
       s.OnRemoveFromEntityManager(*this);
+
+      // entities must not reference the removed system
+      std::vector<EntityId> ids;
+      mEntities.GetEntityIds(ids);
+      for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+      {
+         Entity* entity = mEntities.Get(*i);
+         if(entity != NULL)
+         {
+            entity->RemoveComponentSystem(s);
+         }
+      }
+
       EntitySystemRemovedMessage msg;
       msg.SetComponentType(componentType);
       msg.SetComponentTypeString(GetStringFromSID(componentType));
@@ -331,6 +488,27 @@ namespace dtEntity
       return true;
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::IsComponentTypeOf(ComponentType t, ComponentType baseType) const
+   {
+      while(t != baseType)
+      {
+         EntitySystem* es = GetEntitySystem(t);
+         if(es == NULL || es->GetBaseType() == StringId())
+         {
+            return false;
+         }
+         t = es->GetBaseType();
+      }
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::HasDerivedTypes(ComponentType t) const
+   {
+      return mTypeHierarchy.find(t) != mTypeHierarchy.end();
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    EntitySystem* EntityManager::GetEntitySystem(ComponentType t) const
    {
@@ -413,12 +591,17 @@ namespace dtEntity
    ////////////////////////////////////////////////////////////////////////////////
    void EntityManager::GetComponents(EntityId eid, std::vector<Component*>& toFill)
    {
-      EntitySystemStore::iterator i;
-      for(i = mEntitySystemStore.begin(); i != mEntitySystemStore.end(); ++i)
+      Entity* entity = mEntities.Get(eid);
+      if(entity == NULL)
+      {
+         return;
+      }
+      const Entity::ComponentSystems& systems = entity->GetComponentSystems();
+      for(Entity::ComponentSystems::const_iterator i = systems.begin(); i != systems.end(); ++i)
       {
          Component* c;
          
-         if(i->second->GetComponent(eid, c))
+         if((*i)->GetComponent(eid, c))
          {
             toFill.push_back(c);
          }
@@ -428,12 +611,17 @@ namespace dtEntity
    ////////////////////////////////////////////////////////////////////////////////
    void EntityManager::GetComponents(EntityId eid, std::vector<const Component*>& toFill) const
    {
-      EntitySystemStore::const_iterator i;
-      for(i = mEntitySystemStore.begin(); i != mEntitySystemStore.end(); ++i)
+      const Entity* entity = mEntities.Get(eid);
+      if(entity == NULL)
+      {
+         return;
+      }
+      const Entity::ComponentSystems& systems = entity->GetComponentSystems();
+      for(Entity::ComponentSystems::const_iterator i = systems.begin(); i != systems.end(); ++i)
       {
          Component* c;
          
-         if(i->second->GetComponent(eid, c))
+         if((*i)->GetComponent(eid, c))
          {
             toFill.push_back(c);
          }
@@ -512,6 +700,77 @@ namespace dtEntity
       return true;
    }
 
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::RegisterForTick(EntitySystem& es, const TypedMessageFunctor<TickData>::type& ftr, const std::string& funcname)
+   {
+      TickRegistration reg;
+      reg.mSystem = &es;
+      reg.mFunctor = ftr;
+      reg.mName = funcname;
+      mTickRegistrations.push_back(reg);
+      AddTickHandler(reg);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::UnregisterForTick(const TypedMessageFunctor<TickData>::type& ftr)
+   {
+      for(std::vector<TickRegistration>::iterator i = mTickRegistrations.begin(); i != mTickRegistrations.end(); ++i)
+      {
+         if(i->mFunctor == ftr)
+         {
+            RemoveTickHandler(*i);
+            mTickRegistrations.erase(i);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::SetSystemScheduler(SystemScheduler* scheduler)
+   {
+      if(scheduler == mSystemScheduler)
+      {
+         return;
+      }
+      std::vector<TickRegistration>::iterator i;
+      for(i = mTickRegistrations.begin(); i != mTickRegistrations.end(); ++i)
+      {
+         RemoveTickHandler(*i);
+      }
+      mSystemScheduler = scheduler;
+      for(i = mTickRegistrations.begin(); i != mTickRegistrations.end(); ++i)
+      {
+         AddTickHandler(*i);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::AddTickHandler(const TickRegistration& reg)
+   {
+      if(mSystemScheduler != NULL)
+      {
+         mSystemScheduler->AddSystemTask(*reg.mSystem, reg.mName, reg.mFunctor);
+      }
+      else
+      {
+         mMessagePump.RegisterForTypedMessages<TickData>(reg.mFunctor, FilterOptions::DEFAULT, reg.mName);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::RemoveTickHandler(const TickRegistration& reg)
+   {
+      if(mSystemScheduler != NULL)
+      {
+         mSystemScheduler->RemoveTask(reg.mFunctor);
+      }
+      else
+      {
+         mMessagePump.UnregisterForTypedMessages<TickData>(reg.mFunctor);
+      }
+   }
+
    ///////////////////////////////////////////////////////////////////////////////
    void EntityManager::AddDeletedCallback(ComponentDeletedCallback* cb)
    {
@@ -533,6 +792,45 @@ namespace dtEntity
       return false;
    }
 
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::AddComponentObserver(ComponentObserver* obs)
+   {
+      mComponentObservers.push_back(obs);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   bool EntityManager::RemoveComponentObserver(ComponentObserver* obs)
+   {
+      ComponentObservers::iterator i;
+      for(i = mComponentObservers.begin(); i != mComponentObservers.end(); ++i)
+      {
+         if(*i == obs)
+         {
+            mComponentObservers.erase(i);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::NotifyComponentAdded(EntityId id, EntitySystem& es)
+   {
+      for(ComponentObservers::iterator i = mComponentObservers.begin(); i != mComponentObservers.end(); ++i)
+      {
+         (*i)->ComponentAdded(id, es);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void EntityManager::NotifyComponentRemoved(EntityId id, EntitySystem& es)
+   {
+      for(ComponentObservers::iterator i = mComponentObservers.begin(); i != mComponentObservers.end(); ++i)
+      {
+         (*i)->ComponentRemoved(id, es);
+      }
+   }
+
    ///////////////////////////////////////////////////////////////////////////////
    void EntityManager::AddEntitySystemRequestCallback(EntitySystemRequestCallback* cb)
    {
@@ -0,0 +1,211 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+#include <dtEntity/entitytable.h>
+
+#include <dtEntity/entity.h>
+#include <OpenThreads/ScopedLock>
+#include <new>
+
+namespace dtEntity
+{
+
+   ////////////////////////////////////////////////////////////////////////////////
+   EntityTable::Chunk::Chunk()
+      : mEntities(static_cast<Entity*>(::operator new(sizeof(Entity) * CHUNK_SIZE)))
+   {
+      for(unsigned int i = 0; i < CHUNK_SIZE; ++i)
+      {
+         mGenerations[i] = 0;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   EntityTable::Chunk::~Chunk()
+   {
+      ::operator delete(mEntities);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   EntityTable::EntityTable()
+      : mNumSlots(1) // slot 0 is reserved so that 0 is never a valid id
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   EntityTable::~EntityTable()
+   {
+      Clear();
+      for(unsigned int i = 0; i < MAX_CHUNKS; ++i)
+      {
+         delete static_cast<Chunk*>(mChunks[i].get());
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Entity* EntityTable::Create(EntityManager& em)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      return CreateUnlocked(em);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int EntityTable::Create(EntityManager& em, unsigned int count, std::vector<Entity*>& toFill)
+   {
+      toFill.reserve(toFill.size() + count);
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      for(unsigned int i = 0; i < count; ++i)
+      {
+         Entity* entity = CreateUnlocked(em);
+         if(entity == NULL)
+         {
+            return i;
+         }
+         toFill.push_back(entity);
+      }
+      return count;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Entity* EntityTable::CreateUnlocked(EntityManager& em)
+   {
+      unsigned int index;
+      if(mFreeSlots.size() > MIN_FREE_SLOTS || (mNumSlots > ENTITY_INDEX_MASK && !mFreeSlots.empty()))
+      {
+         index = mFreeSlots.front();
+         mFreeSlots.pop_front();
+      }
+      else if(mNumSlots <= ENTITY_INDEX_MASK)
+      {
+         index = mNumSlots++;
+         if(mChunks[index >> CHUNK_BITS].get() == NULL)
+         {
+            mChunks[index >> CHUNK_BITS].assign(new Chunk(), NULL);
+         }
+      }
+      else
+      {
+         return NULL;
+      }
+
+      Chunk* chunk = GetChunk(index);
+      unsigned int i = index & (CHUNK_SIZE - 1);
+      EntityId id = MakeEntityId(index, chunk->mGenerations[i]);
+      Entity* entity = new(&chunk->mEntities[i]) Entity(em, id);
+
+      // publish entity to readers only after it was constructed
+      chunk->mIds[i].exchange(id);
+      ++mNumEntities;
+      return entity;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityTable::Destroy(EntityId id)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      return DestroyUnlocked(id);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int EntityTable::Destroy(const std::vector<EntityId>& ids)
+   {
+      unsigned int count = 0;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      for(std::vector<EntityId>::const_iterator i = ids.begin(); i != ids.end(); ++i)
+      {
+         if(DestroyUnlocked(*i))
+         {
+            ++count;
+         }
+      }
+      return count;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityTable::DestroyUnlocked(EntityId id)
+   {
+      if(!Contains(id))
+      {
+         return false;
+      }
+      unsigned int index = GetEntityIndex(id);
+      Chunk* chunk = GetChunk(index);
+      unsigned int i = index & (CHUNK_SIZE - 1);
+
+      chunk->mIds[i].exchange(0);
+      chunk->mEntities[i].~Entity();
+      chunk->mGenerations[i] = (GetEntityGeneration(id) + 1) & ENTITY_GENERATION_MASK;
+      mFreeSlots.push_back(index);
+      --mNumEntities;
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Entity* EntityTable::Get(EntityId id) const
+   {
+      unsigned int index = GetEntityIndex(id);
+      Chunk* chunk = GetChunk(index);
+      if(chunk == NULL)
+      {
+         return NULL;
+      }
+      unsigned int i = index & (CHUNK_SIZE - 1);
+      if(id == 0 || chunk->mIds[i] != id)
+      {
+         return NULL;
+      }
+      return &chunk->mEntities[i];
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool EntityTable::Contains(EntityId id) const
+   {
+      return Get(id) != NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityTable::GetEntityIds(std::vector<EntityId>& toFill) const
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      toFill.reserve(toFill.size() + mNumEntities);
+      for(unsigned int index = 1; index < mNumSlots; ++index)
+      {
+         EntityId id = GetChunk(index)->mIds[index & (CHUNK_SIZE - 1)];
+         if(id != 0)
+         {
+            toFill.push_back(id);
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void EntityTable::Clear()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      for(unsigned int index = 1; index < mNumSlots; ++index)
+      {
+         EntityId id = GetChunk(index)->mIds[index & (CHUNK_SIZE - 1)];
+         if(id != 0)
+         {
+            DestroyUnlocked(id);
+         }
+      }
+   }
+}
@@ -0,0 +1,262 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/headlesssysteminterface.h>
+
+#include <dtEntity/log.h>
+#include <dtEntity/messagepump.h>
+#include <dtEntity/systemmessages.h>
+#include <OpenThreads/Thread>
+#include <osg/Timer>
+#include <osgDB/FileNameUtils>
+#include <osgDB/FileUtils>
+#include <algorithm>
+#include <iostream>
+#include <time.h>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   HeadlessSystemInterface::HeadlessSystemInterface(MessagePump& pump, int argc, const char** argv)
+      : mMessagePump(&pump)
+      , mFixedTimeStep(1.0f / 60.0f)
+      , mRealTimePacing(true)
+      , mMaxCatchUpTicks(5)
+      , mDeltaSimTime(0)
+      , mDeltaRealTime(0)
+      , mTimeScale(1)
+      , mSimulationTime(0)
+      , mSimulationClockTime(static_cast<Timer_t>(time(NULL)) * 1000000)
+      , mLastTickTime(osg::Timer::instance()->tick())
+      , mNextTickTime(0)
+      , mPacingStart(0)
+      , mPacingStarted(false)
+      , mNumTicks(0)
+      , mNumDroppedTicks(0)
+      , mArgC(argc)
+   {
+      for(int i = 0; i < mArgC; ++i)
+      {
+         mArgV.push_back(std::string(argv[i]));
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::SetFixedTimeStep(float v)
+   {
+      if(v <= 0)
+      {
+         LOG_ERROR("Fixed time step has to be greater than zero");
+         return;
+      }
+      mFixedTimeStep = v;
+      mPacingStarted = false;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::SetRealTimePacing(bool v)
+   {
+      mRealTimePacing = v;
+      mPacingStarted = false;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int HeadlessSystemInterface::Step()
+   {
+      if(!mRealTimePacing)
+      {
+         Tick();
+         return 1;
+      }
+
+      osg::Timer* timer = osg::Timer::instance();
+      if(!mPacingStarted)
+      {
+         mPacingStart = timer->tick();
+         mNextTickTime = 0;
+         mPacingStarted = true;
+      }
+
+      double now = timer->delta_s(mPacingStart, timer->tick());
+      if(now < mNextTickTime)
+      {
+         OpenThreads::Thread::microSleep(static_cast<unsigned int>((mNextTickTime - now) * 1000000));
+         now = timer->delta_s(mPacingStart, timer->tick());
+      }
+
+      unsigned int ticks = 0;
+      while(mNextTickTime <= now && ticks < mMaxCatchUpTicks)
+      {
+         Tick();
+         mNextTickTime += mFixedTimeStep;
+         ++ticks;
+      }
+
+      // too far behind, forget the backlog instead of running ever more ticks
+      if(mNextTickTime <= now)
+      {
+         unsigned int dropped = static_cast<unsigned int>((now - mNextTickTime) / mFixedTimeStep) + 1;
+         mNumDroppedTicks += dropped;
+         mNextTickTime += dropped * mFixedTimeStep;
+      }
+      return ticks;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::Tick()
+   {
+      Timer_t now = osg::Timer::instance()->tick();
+      mDeltaRealTime = static_cast<float>(osg::Timer::instance()->delta_s(mLastTickTime, now));
+      mLastTickTime = now;
+
+      mDeltaSimTime = mFixedTimeStep * mTimeScale;
+      mSimulationTime += mDeltaSimTime;
+      mSimulationClockTime += static_cast<Timer_t>(mDeltaSimTime * 1000000);
+      ++mNumTicks;
+
+      EmitTickMessagesAndQueuedMessages();
+      EmitPostUpdateMessage();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::EmitTickMessagesAndQueuedMessages()
+   {
+      TickData tick;
+      tick.mDeltaSimTime = mDeltaSimTime;
+      tick.mDeltaRealTime = mDeltaRealTime;
+      tick.mSimTimeScale = mTimeScale;
+      tick.mSimulationTime = mSimulationTime;
+      mMessagePump->EmitTypedMessage(tick);
+
+      mMessagePump->EmitQueuedMessages(tick.mSimulationTime);
+
+      EndOfFrameData endofframe;
+      static_cast<TickData&>(endofframe) = tick;
+      mMessagePump->EmitTypedMessage(endofframe);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::EmitPostUpdateMessage()
+   {
+      PostUpdateData msg;
+      msg.mDeltaSimTime = mDeltaSimTime;
+      msg.mDeltaRealTime = mDeltaRealTime;
+      msg.mSimTimeScale = mTimeScale;
+      msg.mSimulationTime = mSimulationTime;
+      mMessagePump->EmitTypedMessage(msg);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::EmitTimeChanged()
+   {
+      TimeChangedMessage msg;
+      msg.SetSimulationTime(mSimulationTime);
+      msg.SetSimulationClockTime(mSimulationClockTime);
+      msg.SetTimeScale(mTimeScale);
+      mMessagePump->EmitMessage(msg);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::SetTimeScale(float v)
+   {
+      mTimeScale = v;
+      EmitTimeChanged();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::SetSimulationTime(double v)
+   {
+      mSimulationTime = v;
+      EmitTimeChanged();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::SetSimulationClockTime(Timer_t t)
+   {
+      mSimulationClockTime = t;
+      EmitTimeChanged();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Timer_t HeadlessSystemInterface::GetRealClockTime() const
+   {
+      return osg::Timer::instance()->tick();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::AddDataFilePath(const std::string& path)
+   {
+      osgDB::FilePathList& paths = osgDB::getDataFilePathList();
+      if(std::find(paths.begin(), paths.end(), path) == paths.end())
+      {
+         paths.push_back(path);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   std::string HeadlessSystemInterface::GetDataFilePathFromFilePath(const std::string& path) const
+   {
+      osgDB::FilePathList& paths = osgDB::getDataFilePathList();
+      for(osgDB::FilePathList::const_iterator i = paths.begin(); i != paths.end(); ++i)
+      {
+         std::string datapath = osgDB::convertFileNameToNativeStyle(*i);
+         if(osgDB::equalCaseInsensitive(datapath, path.substr(0, datapath.length())))
+         {
+            return *i;
+         }
+      }
+      return "";
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   std::string HeadlessSystemInterface::FindDataFile(const std::string& filename) const
+   {
+      return osgDB::findDataFile(filename);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   std::string HeadlessSystemInterface::FindLibraryFile(const std::string& filename) const
+   {
+      return osgDB::findLibraryFile(filename);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool HeadlessSystemInterface::FileExists(const std::string& filename) const
+   {
+      return osgDB::fileExists(filename);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   SystemInterface::DirectoryContents HeadlessSystemInterface::GetDirectoryContents(const std::string& dirName) const
+   {
+      return osgDB::getDirectoryContents(dirName);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void HeadlessSystemInterface::LogMessage(unsigned int level, const std::string& filename,
+      const std::string& methodname, int linenumber, const std::string& msg) const
+   {
+      std::ostream& strm = (level == LogLevel::LVL_WARNING || level == LogLevel::LVL_ERROR) ? std::cerr : std::cout;
+      std::string fn = filename.size() < 30 ? filename : filename.substr(filename.size() - 30);
+      strm << "File: " << fn << " Line: " << linenumber << " Message: " << msg << std::endl;
+   }
+}
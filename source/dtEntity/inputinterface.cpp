@@ -39,13 +39,13 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const StringId InputInterface::MouseXId(dtEntity::SID("MouseX"));  
-   const StringId InputInterface::MouseYId(dtEntity::SID("MouseY"));  
-   const StringId InputInterface::MouseXRawId(dtEntity::SID("MouseXRaw"));
-   const StringId InputInterface::MouseYRawId(dtEntity::SID("MouseYRaw"));
-   const StringId InputInterface::MouseDeltaXId(dtEntity::SID("MouseDeltaX"));
-   const StringId InputInterface::MouseDeltaYId(dtEntity::SID("MouseDeltaY"));
-   const StringId InputInterface::MouseDeltaXRawId(dtEntity::SID("MouseDeltaXRaw"));
-   const StringId InputInterface::MouseDeltaYRawId(dtEntity::SID("MouseDeltaYRaw"));
+   const StringId InputInterface::MouseXId(SID_LITERAL("MouseX"));  
+   const StringId InputInterface::MouseYId(SID_LITERAL("MouseY"));  
+   const StringId InputInterface::MouseXRawId(SID_LITERAL("MouseXRaw"));
+   const StringId InputInterface::MouseYRawId(SID_LITERAL("MouseYRaw"));
+   const StringId InputInterface::MouseDeltaXId(SID_LITERAL("MouseDeltaX"));
+   const StringId InputInterface::MouseDeltaYId(SID_LITERAL("MouseDeltaY"));
+   const StringId InputInterface::MouseDeltaXRawId(SID_LITERAL("MouseDeltaXRaw"));
+   const StringId InputInterface::MouseDeltaYRawId(SID_LITERAL("MouseDeltaYRaw"));
 
 }
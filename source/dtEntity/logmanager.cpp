@@ -21,57 +21,167 @@
 
 #include <dtEntity/logmanager.h>
 
+#include <ctype.h>
 
 namespace dtEntity
 {
+   namespace LogLevel
+   {
+      ////////////////////////////////////////////////////////////////////////////////
+      const char* GetName(e level)
+      {
+         switch(level)
+         {
+         case LVL_ALWAYS:  return "ALWAYS";
+         case LVL_ERROR:   return "ERROR";
+         case LVL_DEBUG:   return "DEBUG";
+         case LVL_WARNING: return "WARNING";
+         case LVL_INFO:    return "INFO";
+         default:          return "UNKNOWN";
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      bool FromName(const std::string& name, e& level)
+      {
+         std::string upper(name);
+         for(std::string::iterator i = upper.begin(); i != upper.end(); ++i)
+         {
+            *i = static_cast<char>(toupper(static_cast<unsigned char>(*i)));
+         }
+         const e levels[] = { LVL_ALWAYS, LVL_ERROR, LVL_DEBUG, LVL_WARNING, LVL_INFO };
+         for(unsigned int i = 0; i < sizeof(levels) / sizeof(levels[0]); ++i)
+         {
+            if(upper == GetName(levels[i]))
+            {
+               level = levels[i];
+               return true;
+            }
+         }
+         return false;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // mask of given level and all more severe levels
+      static unsigned int GetThresholdMask(e level)
+      {
+         switch(level)
+         {
+         case LVL_ALWAYS:  return MASK_ALWAYS;
+         case LVL_ERROR:   return MASK_ALWAYS | MASK_ERROR;
+         case LVL_WARNING: return MASK_ALWAYS | MASK_ERROR | MASK_WARNING;
+         case LVL_INFO:    return MASK_ALWAYS | MASK_ERROR | MASK_WARNING | MASK_INFO;
+         default:          return MASK_ALL;
+         }
+      }
+   }
+
+   volatile unsigned int LogManager::sEnabledLevels = 0;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   LogManager::LogManager()
+      : mListeners(new ListenerList())
+      , mLogLevel(LogLevel::LVL_DEBUG)
+   {
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    void LogManager::LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
                    const std::string& msg) const
    {
-      Listeners listeners;
+      if(!IsLevelEnabled(level))
+      {
+         return;
+      }
+
+      // keep list alive while iterating, listeners may be removed concurrently
+      osg::ref_ptr<const ListenerList> listeners;
       {
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
          listeners = mListeners;
       }
-      for(Listeners::iterator i = listeners.begin(); i != listeners.end(); ++i)
+      unsigned int bit = 1u << level;
+      for(Listeners::const_iterator i = listeners->mListeners.begin(); i != listeners->mListeners.end(); ++i)
+      {
+         if((*i)->GetLevelMask() & bit)
+         {
+            (*i)->LogMessage(level, filename, methodname, linenumber, msg);
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void LogManager::SetLogLevel(LogLevel::e level)
+   {
       {
-         (*i)->LogMessage(level, filename, methodname, linenumber, msg);
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+         mLogLevel = level;
       }
+      UpdateEnabledLevels();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   void LogManager::AddListener(LogListener* l)
+   LogLevel::e LogManager::GetLogLevel() const
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-      mListeners.push_back(l);
+      return mLogLevel;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   void LogManager::RemoveListener(LogListener* l)
+   void LogManager::AddListener(LogListener* l)
    {
-      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+         ListenerList* list = new ListenerList(*mListeners);
+         list->mListeners.push_back(l);
+         mListeners = list;
+      }
+      UpdateEnabledLevels();
+   }
 
-      for(Listeners::iterator i = mListeners.begin(); i != mListeners.end(); ++i)
+   ////////////////////////////////////////////////////////////////////////////////
+   void LogManager::RemoveListener(LogListener* l)
+   {
       {
-         if(*i == l)
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+
+         ListenerList* list = new ListenerList(*mListeners);
+         for(Listeners::iterator i = list->mListeners.begin(); i != list->mListeners.end(); ++i)
          {
-            mListeners.erase(i);
-            return;
+            if(*i == l)
+            {
+               list->mListeners.erase(i);
+               break;
+            }
          }
+         mListeners = list;
       }
+      UpdateEnabledLevels();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    LogManager::Listeners::size_type LogManager::GetNumListeners() const
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-      return mListeners.size();
+      return mListeners->mListeners.size();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    LogListener* LogManager::GetListener(LogManager::Listeners::size_type index) const
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-      return mListeners[index];
+      return mListeners->mListeners[index];
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void LogManager::UpdateEnabledLevels()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      unsigned int listenerMask = 0;
+      for(Listeners::const_iterator i = mListeners->mListeners.begin(); i != mListeners->mListeners.end(); ++i)
+      {
+         listenerMask |= (*i)->GetLevelMask();
+      }
+      sEnabledLevels = LogLevel::GetThresholdMask(mLogLevel) & listenerMask;
    }
 }
@@ -43,14 +43,15 @@
 
 namespace dtEntity
 {
-   const StringId MapComponent::TYPE(dtEntity::SID("Map"));   
-   const StringId MapComponent::EntityNameId(dtEntity::SID("EntityName"));  
-   const StringId MapComponent::EntityDescriptionId(dtEntity::SID("EntityDescription"));  
-   const StringId MapComponent::MapNameId(dtEntity::SID("MapName"));  
-   const StringId MapComponent::SpawnerNameId(dtEntity::SID("SpawnerName"));  
-   const StringId MapComponent::UniqueIdId(dtEntity::SID("UniqueId"));  
-   const StringId MapComponent::SaveWithMapId(dtEntity::SID("SaveWithMap"));
-   const StringId MapComponent::VisibleInEntityListId(dtEntity::SID("VisibleInEntityList"));
+   const StringId MapComponent::TYPE(SID_LITERAL("Map"));   
+   const StringId MapComponent::EntityNameId(SID_LITERAL("EntityName"));  
+   const StringId MapComponent::EntityDescriptionId(SID_LITERAL("EntityDescription"));  
+   const StringId MapComponent::MapNameId(SID_LITERAL("MapName"));  
+   const StringId MapComponent::SpawnerNameId(SID_LITERAL("SpawnerName"));  
+   const StringId MapComponent::UniqueIdId(SID_LITERAL("UniqueId"));  
+   const StringId MapComponent::SaveWithMapId(SID_LITERAL("SaveWithMap"));
+   const StringId MapComponent::VisibleInEntityListId(SID_LITERAL("VisibleInEntityList"));
+   PropertySchema MapComponent::sPropertySchema;
    
    
    ////////////////////////////////////////////////////////////////////////////
@@ -74,13 +75,13 @@ namespace dtEntity
       , mSpawner(NULL)
       , mOwner(NULL)
    {
-      Register(EntityNameId, &mEntityName);
-      Register(EntityDescriptionId, &mEntityDescription);
-      Register(MapNameId, &mMapName);
-      Register(SpawnerNameId, &mSpawnerNameProp);
-      Register(UniqueIdId, &mUniqueId);
-      Register(SaveWithMapId, &mSaveWithMap);
-      Register(VisibleInEntityListId, &mVisibleInEntityList);
+      Register(sPropertySchema, EntityNameId, &mEntityName);
+      Register(sPropertySchema, EntityDescriptionId, &mEntityDescription);
+      Register(sPropertySchema, MapNameId, &mMapName);
+      Register(sPropertySchema, SpawnerNameId, &mSpawnerNameProp);
+      Register(sPropertySchema, UniqueIdId, &mUniqueId);
+      Register(sPropertySchema, SaveWithMapId, &mSaveWithMap);
+      Register(sPropertySchema, VisibleInEntityListId, &mVisibleInEntityList);
       mSaveWithMap.Set(true);
       mVisibleInEntityList.Set(true);
 
@@ -191,7 +192,7 @@ namespace dtEntity
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const StringId MapSystem::TYPE(dtEntity::SID("Map"));
+   const StringId MapSystem::TYPE(SID_LITERAL("Map"));
 
    ////////////////////////////////////////////////////////////////////////////
    MapSystem::MapSystem(EntityManager& em)
@@ -0,0 +1,731 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/messagejournal.h>
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/log.h>
+#include <dtEntity/messagefactory.h>
+#include <dtEntity/mpscqueue.h>
+#include <dtEntity/property.h>
+#include <dtEntity/systemmessages.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+
+namespace dtEntity
+{
+   namespace
+   {
+      const char JOURNAL_MAGIC[4] = { 'D', 'T', 'M', 'J' };
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // collects small values on the stack and appends them to the record
+      // buffer in blocks, appending every value on its own is much slower
+      class RecordWriter
+      {
+      public:
+         RecordWriter(std::string& buffer)
+            : mBuffer(&buffer)
+            , mLength(0)
+         {
+         }
+
+         template<class T>
+         void Write(const T& v)
+         {
+            if(mLength + sizeof(T) > sizeof(mBlock))
+            {
+               Flush();
+            }
+            memcpy(mBlock + mLength, &v, sizeof(T));
+            mLength += sizeof(T);
+         }
+
+         void WriteBytes(const char* data, size_t size)
+         {
+            Flush();
+            mBuffer->append(data, size);
+         }
+
+         template<class VEC>
+         void WriteVec(const VEC& v)
+         {
+            for(int i = 0; i < VEC::num_components; ++i)
+            {
+               Write(v[i]);
+            }
+         }
+
+         void Flush()
+         {
+            mBuffer->append(mBlock, mLength);
+            mLength = 0;
+         }
+
+      private:
+         std::string* mBuffer;
+         char mBlock[256];
+         size_t mLength;
+      };
+
+      bool WriteValue(RecordWriter& writer, const Property& prop);
+
+      ////////////////////////////////////////////////////////////////////////////////
+      bool WriteTypedValue(RecordWriter& writer, const Property& prop)
+      {
+         writer.Write(static_cast<unsigned char>(prop.GetDataType()));
+         return WriteValue(writer, prop);
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      bool WriteValue(RecordWriter& writer, const Property& prop)
+      {
+         switch(prop.GetDataType())
+         {
+         case DataType::ARRAY:
+         {
+            const PropertyArray& arr = static_cast<const ArrayProperty&>(prop).Get();
+            writer.Write(static_cast<unsigned int>(arr.size()));
+            for(PropertyArray::const_iterator i = arr.begin(); i != arr.end(); ++i)
+            {
+               if(!WriteTypedValue(writer, **i)) return false;
+            }
+            return true;
+         }
+         case DataType::BOOL:     writer.Write(static_cast<unsigned char>(prop.BoolValue() ? 1 : 0)); return true;
+         case DataType::DOUBLE:   writer.Write(prop.DoubleValue()); return true;
+         case DataType::FLOAT:    writer.Write(prop.FloatValue()); return true;
+         case DataType::GROUP:
+         {
+            const PropertyGroup& grp = static_cast<const GroupProperty&>(prop).Get();
+            writer.Write(static_cast<unsigned int>(grp.size()));
+            for(PropertyGroup::const_iterator i = grp.begin(); i != grp.end(); ++i)
+            {
+               writer.Write(SIDToUInt(i->first));
+               if(!WriteTypedValue(writer, *i->second)) return false;
+            }
+            return true;
+         }
+         case DataType::INT:      writer.Write(prop.IntValue()); return true;
+         case DataType::MATRIX:
+         {
+            Matrix m = prop.MatrixValue();
+            for(int i = 0; i < 4; ++i)
+            {
+               for(int j = 0; j < 4; ++j)
+               {
+                  writer.Write(static_cast<double>(m(i, j)));
+               }
+            }
+            return true;
+         }
+         case DataType::QUAT:
+         {
+            Quat q = prop.QuatValue();
+            for(int i = 0; i < 4; ++i)
+            {
+               writer.Write(static_cast<double>(q[i]));
+            }
+            return true;
+         }
+         case DataType::STRING:
+         {
+            std::string s = prop.StringValue();
+            writer.Write(static_cast<unsigned int>(s.size()));
+            writer.WriteBytes(s.data(), s.size());
+            return true;
+         }
+         case DataType::STRINGID: writer.Write(SIDToUInt(prop.StringIdValue())); return true;
+         case DataType::UINT:     writer.Write(prop.UIntValue()); return true;
+         case DataType::VEC2:     writer.WriteVec(prop.Vec2Value()); return true;
+         case DataType::VEC3:     writer.WriteVec(prop.Vec3Value()); return true;
+         case DataType::VEC4:     writer.WriteVec(prop.Vec4Value()); return true;
+         case DataType::VEC2D:    writer.WriteVec(prop.Vec2dValue()); return true;
+         case DataType::VEC3D:    writer.WriteVec(prop.Vec3dValue()); return true;
+         case DataType::VEC4D:    writer.WriteVec(prop.Vec4dValue()); return true;
+         default: return false;
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // bounds checked reading from journal data
+      class JournalReader
+      {
+      public:
+         JournalReader(const std::string& data, size_t pos, size_t end)
+            : mData(&data)
+            , mPos(pos)
+            , mEnd(end)
+            , mValid(true)
+         {
+         }
+
+         template<class T>
+         T Read()
+         {
+            T v = T();
+            if(mPos + sizeof(T) > mEnd)
+            {
+               mValid = false;
+               return v;
+            }
+            memcpy(&v, mData->data() + mPos, sizeof(T));
+            mPos += sizeof(T);
+            return v;
+         }
+
+         std::string ReadString()
+         {
+            unsigned int len = Read<unsigned int>();
+            if(mPos + len > mEnd)
+            {
+               mValid = false;
+               return std::string();
+            }
+            std::string s(mData->data() + mPos, len);
+            mPos += len;
+            return s;
+         }
+
+         template<class VEC>
+         VEC ReadVec()
+         {
+            VEC v;
+            for(int i = 0; i < VEC::num_components; ++i)
+            {
+               v[i] = Read<typename VEC::value_type>();
+            }
+            return v;
+         }
+
+         size_t GetPos() const { return mPos; }
+         bool IsValid() const { return mValid; }
+
+      private:
+         const std::string* mData;
+         size_t mPos;
+         size_t mEnd;
+         bool mValid;
+      };
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // returns new property or NULL if data is corrupt
+      Property* ReadValue(JournalReader& reader, unsigned char dataType)
+      {
+         switch(dataType)
+         {
+         case DataType::ARRAY:
+         {
+            ArrayProperty* arr = new ArrayProperty();
+            unsigned int count = reader.Read<unsigned int>();
+            for(unsigned int i = 0; i < count && reader.IsValid(); ++i)
+            {
+               Property* p = ReadValue(reader, reader.Read<unsigned char>());
+               if(p == NULL) { delete arr; return NULL; }
+               arr->Add(p);
+            }
+            return arr;
+         }
+         case DataType::BOOL:     return new BoolProperty(reader.Read<unsigned char>() != 0);
+         case DataType::DOUBLE:   return new DoubleProperty(reader.Read<double>());
+         case DataType::FLOAT:    return new FloatProperty(reader.Read<float>());
+         case DataType::GROUP:
+         {
+            GroupProperty* grp = new GroupProperty();
+            unsigned int count = reader.Read<unsigned int>();
+            for(unsigned int i = 0; i < count && reader.IsValid(); ++i)
+            {
+               StringId name = SID(reader.Read<unsigned int>());
+               Property* p = ReadValue(reader, reader.Read<unsigned char>());
+               if(p == NULL) { delete grp; return NULL; }
+               grp->Add(name, p);
+            }
+            return grp;
+         }
+         case DataType::INT:      return new IntProperty(reader.Read<int>());
+         case DataType::MATRIX:
+         {
+            Matrix m;
+            for(int i = 0; i < 4; ++i)
+            {
+               for(int j = 0; j < 4; ++j)
+               {
+                  m(i, j) = reader.Read<double>();
+               }
+            }
+            return new MatrixProperty(m);
+         }
+         case DataType::QUAT:
+         {
+            double v[4];
+            for(int i = 0; i < 4; ++i)
+            {
+               v[i] = reader.Read<double>();
+            }
+            return new QuatProperty(v);
+         }
+         case DataType::STRING:   return new StringProperty(reader.ReadString());
+         case DataType::STRINGID: return new StringIdProperty(SID(reader.Read<unsigned int>()));
+         case DataType::UINT:     return new UIntProperty(reader.Read<unsigned int>());
+         case DataType::VEC2:     return new Vec2Property(reader.ReadVec<Vec2f>());
+         case DataType::VEC3:     return new Vec3Property(reader.ReadVec<Vec3f>());
+         case DataType::VEC4:     return new Vec4Property(reader.ReadVec<Vec4f>());
+         case DataType::VEC2D:    return new Vec2dProperty(reader.ReadVec<Vec2d>());
+         case DataType::VEC3D:    return new Vec3dProperty(reader.ReadVec<Vec3d>());
+         case DataType::VEC4D:    return new Vec4dProperty(reader.ReadVec<Vec4d>());
+         default: return NULL;
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool MessageJournal::EncodeRecord(const Message& msg, double simTime, unsigned char flags, std::string& buffer)
+   {
+      size_t start = buffer.size();
+      RecordWriter writer(buffer);
+
+      // record size is written when record is complete
+      writer.Write(static_cast<unsigned int>(0));
+      writer.Write(simTime);
+      writer.Write(flags);
+      writer.Write(SIDToUInt(msg.GetType()));
+
+      writer.Write(msg.GetNumProperties());
+      for(PropertyContainer::ConstIterator i(msg); !i.AtEnd(); i.Next())
+      {
+         writer.Write(SIDToUInt(i.GetName()));
+         if(!WriteTypedValue(writer, *i.GetProperty()))
+         {
+            LOG_ERROR("Cannot write message to journal, unsupported property type in message "
+               << GetStringFromSID(msg.GetType()));
+            buffer.resize(start);
+            return false;
+         }
+      }
+      writer.Flush();
+
+      unsigned int size = static_cast<unsigned int>(buffer.size() - start - sizeof(unsigned int));
+      memcpy(&buffer[start], &size, sizeof(unsigned int));
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   ////////////////////////////////////////////////////////////////////////////////
+   class JournalWriterThread : public OpenThreads::Thread
+   {
+   public:
+
+      JournalWriterThread()
+         : mStop(false)
+         , mWake(false)
+      {
+      }
+
+      ~JournalWriterThread()
+      {
+         std::vector<std::string*> remaining;
+         mQueue.PopAll(remaining);
+         mFreeChunks.PopAll(remaining);
+         for(std::vector<std::string*>::iterator i = remaining.begin(); i != remaining.end(); ++i)
+         {
+            delete *i;
+         }
+      }
+
+      bool Open(const std::string& path)
+      {
+         mStream.open(path.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+         if(!mStream.is_open())
+         {
+            return false;
+         }
+         mStream.write(JOURNAL_MAGIC, 4);
+         unsigned int version = MessageJournal::VERSION;
+         mStream.write(reinterpret_cast<const char*>(&version), sizeof(unsigned int));
+         return mStream.good();
+      }
+
+      // @threadsafe
+      void Push(std::string* chunk)
+      {
+         mQueue.Push(chunk);
+
+         // called once per full chunk, locking here is cheap
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWakeMutex);
+         mWake = true;
+         mWakeCondition.signal();
+      }
+
+      // get chunks that were written, for reuse. Only called by one thread.
+      void TakeFreeChunks(std::vector<std::string*>& toFill)
+      {
+         mFreeChunks.PopAll(toFill);
+      }
+
+      // stop thread, then write what is still queued
+      void Finish()
+      {
+         {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWakeMutex);
+            mStop = true;
+            mWakeCondition.signal();
+         }
+         join();
+         WritePending();
+         mStream.close();
+      }
+
+      virtual void run()
+      {
+         for(;;)
+         {
+            {
+               OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWakeMutex);
+               while(!mWake && !mStop)
+               {
+                  mWakeCondition.wait(&mWakeMutex);
+               }
+               if(mStop)
+               {
+                  // Finish writes the rest
+                  return;
+               }
+               mWake = false;
+            }
+            WritePending();
+         }
+      }
+
+   private:
+
+      bool WritePending()
+      {
+         if(!mQueue.PopAll(mBatch))
+         {
+            return false;
+         }
+         for(std::vector<std::string*>::iterator i = mBatch.begin(); i != mBatch.end(); ++i)
+         {
+            mStream.write((*i)->data(), (*i)->size());
+            (*i)->clear();
+            mFreeChunks.Push(*i);
+         }
+         mBatch.clear();
+         return true;
+      }
+
+      MPSCQueue<std::string*> mQueue;
+      MPSCQueue<std::string*> mFreeChunks;
+      std::vector<std::string*> mBatch;
+      std::ofstream mStream;
+
+      // writer sleeps on condition until a chunk is pushed or it is stopped
+      OpenThreads::Mutex mWakeMutex;
+      OpenThreads::Condition mWakeCondition;
+      bool mStop;
+      bool mWake;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessageJournalRecorder::MessageJournalRecorder(EntityManager& em)
+      : mEntityManager(&em)
+      , mWriter(NULL)
+      , mChunk(NULL)
+      , mSimTime(0)
+      , mNumRecords(0)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessageJournalRecorder::~MessageJournalRecorder()
+   {
+      Stop();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool MessageJournalRecorder::Start(const std::string& path)
+   {
+      Stop();
+
+      JournalWriterThread* writer = new JournalWriterThread();
+      if(!writer->Open(path))
+      {
+         LOG_ERROR("Cannot open message journal for writing: " << path);
+         delete writer;
+         return false;
+      }
+      writer->start();
+
+      mWriter = writer;
+      mChunk = new std::string();
+      mChunk->reserve(CHUNK_SIZE);
+      mSimTime = 0;
+      mNumRecords = 0;
+      mEntityManager->GetMessagePump().SetEmitObserver(this);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageJournalRecorder::Stop()
+   {
+      if(mWriter == NULL)
+      {
+         return;
+      }
+      MessagePump& pump = mEntityManager->GetMessagePump();
+      if(pump.GetEmitObserver() == this)
+      {
+         pump.SetEmitObserver(NULL);
+      }
+
+      mWriter->Push(mChunk);
+      mChunk = NULL;
+      mWriter->Finish();
+      delete mWriter;
+      mWriter = NULL;
+
+      for(std::vector<std::string*>::iterator i = mSpareChunks.begin(); i != mSpareChunks.end(); ++i)
+      {
+         delete *i;
+      }
+      mSpareChunks.clear();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageJournalRecorder::SubmitChunk()
+   {
+      mWriter->Push(mChunk);
+      if(mSpareChunks.empty())
+      {
+         mWriter->TakeFreeChunks(mSpareChunks);
+      }
+      if(mSpareChunks.empty())
+      {
+         mChunk = new std::string();
+         mChunk->reserve(CHUNK_SIZE);
+      }
+      else
+      {
+         mChunk = mSpareChunks.back();
+         mSpareChunks.pop_back();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageJournalRecorder::Receive(const Message& msg)
+   {
+      if(msg.GetType() == TickMessage::TYPE)
+      {
+         const Property* simTime = msg.Get(TickMessage::SimulationTimeId);
+         if(simTime != NULL)
+         {
+            mSimTime = simTime->DoubleValue();
+         }
+      }
+
+      unsigned char flags = mEntityManager->GetMessagePump().IsEmittingNested() ? MessageJournal::NESTED : 0;
+      if(MessageJournal::EncodeRecord(msg, mSimTime, flags, *mChunk))
+      {
+         ++mNumRecords;
+      }
+      if(mChunk->size() >= CHUNK_SIZE)
+      {
+         SubmitChunk();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   ////////////////////////////////////////////////////////////////////////////////
+   MessageJournalPlayer::MessageJournalPlayer(EntityManager& em)
+      : mEntityManager(&em)
+      , mDataStart(0)
+      , mReadPos(0)
+      , mPlayNested(false)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessageJournalPlayer::~MessageJournalPlayer()
+   {
+      for(MessageCache::iterator i = mMessageCache.begin(); i != mMessageCache.end(); ++i)
+      {
+         delete i->second;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool MessageJournalPlayer::Open(const std::string& path)
+   {
+      mData.clear();
+      mDataStart = mReadPos = 0;
+
+      std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+      if(!input.is_open())
+      {
+         LOG_ERROR("Cannot open message journal: " << path);
+         return false;
+      }
+      std::ostringstream os;
+      os << input.rdbuf();
+      std::string data = os.str();
+
+      JournalReader reader(data, 0, data.size());
+      char magic[4];
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         magic[i] = reader.Read<char>();
+      }
+      unsigned int version = reader.Read<unsigned int>();
+      if(!reader.IsValid() || memcmp(magic, JOURNAL_MAGIC, 4) != 0)
+      {
+         LOG_ERROR("Not a message journal: " << path);
+         return false;
+      }
+      if(version != MessageJournal::VERSION)
+      {
+         LOG_ERROR("Unsupported message journal version " << version << ": " << path);
+         return false;
+      }
+
+      mData.swap(data);
+      mDataStart = mReadPos = reader.GetPos();
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   double MessageJournalPlayer::GetNextTime() const
+   {
+      JournalReader reader(mData, mReadPos + sizeof(unsigned int), mData.size());
+      double t = reader.Read<double>();
+      return reader.IsValid() ? t : -1;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Message* MessageJournalPlayer::GetCachedMessage(MessageType t)
+   {
+      MessageCache::iterator i = mMessageCache.find(t);
+      if(i != mMessageCache.end())
+      {
+         return i->second;
+      }
+      Message* msg = NULL;
+      if(!MessageFactory::GetInstance().CreateMessage(t, msg))
+      {
+         LOG_WARNING("Message type in journal is not registered, skipping its messages: " << GetStringFromSID(t));
+         msg = NULL;
+      }
+      mMessageCache[t] = msg;
+      return msg;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Message* MessageJournalPlayer::DecodeRecord()
+   {
+      JournalReader header(mData, mReadPos, mData.size());
+      unsigned int size = header.Read<unsigned int>();
+      size_t end = header.GetPos() + size;
+      if(!header.IsValid() || end > mData.size())
+      {
+         LOG_ERROR("Message journal is truncated");
+         mReadPos = mData.size();
+         return NULL;
+      }
+      mReadPos = end;
+
+      JournalReader reader(mData, header.GetPos(), end);
+      reader.Read<double>();
+      unsigned char flags = reader.Read<unsigned char>();
+      MessageType type = SID(reader.Read<unsigned int>());
+      if((flags & MessageJournal::NESTED) != 0 && !mPlayNested)
+      {
+         return NULL;
+      }
+
+      Message* msg = GetCachedMessage(type);
+      if(msg == NULL)
+      {
+         return NULL;
+      }
+
+      unsigned int numProps = reader.Read<unsigned int>();
+      for(unsigned int i = 0; i < numProps; ++i)
+      {
+         StringId name = SID(reader.Read<unsigned int>());
+         Property* value = ReadValue(reader, reader.Read<unsigned char>());
+         if(value == NULL || !reader.IsValid())
+         {
+            LOG_ERROR("Corrupt message journal record of type " << GetStringFromSID(type));
+            delete value;
+            return NULL;
+         }
+         Property* toset = msg->Get(name);
+         if(toset == NULL)
+         {
+            LOG_WARNING("Error decoding journal: Property " << GetStringFromSID(name)
+               << " does not exist in message " << GetStringFromSID(type));
+         }
+         else if(!toset->SetFrom(*value))
+         {
+            LOG_ERROR("Error decoding journal: " << GetStringFromSID(type) << " Property type mismatch!");
+         }
+         delete value;
+      }
+      return msg;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int MessageJournalPlayer::PlayUntil(double simTime)
+   {
+      unsigned int count = 0;
+      while(!AtEnd() && GetNextTime() <= simTime)
+      {
+         Message* msg = DecodeRecord();
+         if(msg != NULL)
+         {
+            mEntityManager->EmitMessage(*msg);
+            ++count;
+         }
+      }
+      return count;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int MessageJournalPlayer::PlayAll()
+   {
+      unsigned int count = 0;
+      while(!AtEnd())
+      {
+         Message* msg = DecodeRecord();
+         if(msg != NULL)
+         {
+            mEntityManager->EmitMessage(*msg);
+            ++count;
+         }
+      }
+      return count;
+   }
+}
@@ -0,0 +1,169 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/messagepool.h>
+
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <typeinfo>
+
+namespace dtEntity
+{
+   namespace
+   {
+      struct PoolTypeLess
+      {
+         template<class Entry>
+         bool operator()(const Entry& e, MessageType t) const
+         {
+            return e.first < t;
+         }
+      };
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessagePool::MessagePool(unsigned int maxPerType)
+      : mMaxPerType(maxPerType)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessagePool::~MessagePool()
+   {
+      Clear();
+      for(TypePools::iterator i = mPools.begin(); i != mPools.end(); ++i)
+      {
+         delete i->second;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   MessagePool::FreeList& MessagePool::GetFreeList(MessageType t)
+   {
+      TypePools::iterator i = std::lower_bound(mPools.begin(), mPools.end(), t, PoolTypeLess());
+      if(i == mPools.end() || i->first != t)
+      {
+         i = mPools.insert(i, std::make_pair(t, new FreeList()));
+         i->second->reserve(mMaxPerType);
+      }
+      return *i->second;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Message* MessagePool::Acquire(const Message& msg)
+   {
+      Message* recycled = NULL;
+      if(mMutex.trylock() == 0)
+      {
+         TypePools::iterator i = std::lower_bound(mPools.begin(), mPools.end(), msg.GetType(), PoolTypeLess());
+         if(i != mPools.end() && i->first == msg.GetType() && !i->second->empty())
+         {
+            // different classes may use the same message type
+            if(typeid(*i->second->back()) == typeid(msg))
+            {
+               recycled = i->second->back();
+               i->second->pop_back();
+            }
+         }
+         mMutex.unlock();
+      }
+
+      if(recycled == NULL)
+      {
+         ++mMisses;
+         return msg.Clone();
+      }
+      ++mHits;
+      recycled->InitFrom(msg);
+      return recycled;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Message* MessagePool::ReleaseUnlocked(const Message* msg)
+   {
+      Message* m = const_cast<Message*>(msg);
+      FreeList& freeList = GetFreeList(m->GetType());
+      if(freeList.size() >= mMaxPerType)
+      {
+         return m;
+      }
+      freeList.push_back(m);
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessagePool::Release(const Message* msg)
+   {
+      Message* toDelete;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+         toDelete = ReleaseUnlocked(msg);
+      }
+      delete toDelete;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessagePool::Release(const std::vector<const Message*>& msgs)
+   {
+      if(msgs.empty())
+      {
+         return;
+      }
+      std::vector<Message*> toDelete;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+         for(std::vector<const Message*>::const_iterator i = msgs.begin(); i != msgs.end(); ++i)
+         {
+            Message* m = ReleaseUnlocked(*i);
+            if(m != NULL)
+            {
+               toDelete.push_back(m);
+            }
+         }
+      }
+      for(std::vector<Message*>::iterator i = toDelete.begin(); i != toDelete.end(); ++i)
+      {
+         delete *i;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessagePool::Clear()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      for(TypePools::iterator i = mPools.begin(); i != mPools.end(); ++i)
+      {
+         for(FreeList::iterator j = i->second->begin(); j != i->second->end(); ++j)
+         {
+            delete *j;
+         }
+         i->second->clear();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessagePool::ResetCounters()
+   {
+      mHits.exchange(0);
+      mMisses.exchange(0);
+   }
+}
@@ -23,229 +23,695 @@
 
 #include <dtEntity/dtentity_config.h>
 #include <dtEntity/log.h>
-
-#if DTENTITY_PROFILING_ENABLED
-#include <dtEntity/profile.h>
-#endif
+#include <dtEntity/property.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <assert.h>
+#include <typeinfo>
 
 namespace dtEntity
 {
 
+   namespace
+   {
+      struct RegistryTypeLess
+      {
+         template<class Entry>
+         bool operator()(const Entry& e, MessageType t) const
+         {
+            return e.first < t;
+         }
+      };
+
+      bool IsUnregistered(const MsgRegistryEntry& e)
+      {
+         return (e.mOptions & FilterOptions::UNREGISTERED) != 0;
+      }
+
+      // insert in front of all entries with same or lower priority
+      void InsertByPriority(std::vector<MsgRegistryEntry>& entries, const MsgRegistryEntry& e)
+      {
+         unsigned int priority = e.mOptions & 3;
+         std::vector<MsgRegistryEntry>::iterator it = entries.begin();
+         while(it != entries.end() && (it->mOptions & 3) > priority)
+         {
+            ++it;
+         }
+         entries.insert(it, e);
+      }
+
+      // message types of typed messages, position is the typed message index
+      OpenThreads::Mutex s_typedMessagesMutex;
+      std::vector<MessageType> s_typedMessages;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   unsigned int MessagePump::GetTypedMessageIndex(MessageType msgtype)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(s_typedMessagesMutex);
+      std::vector<MessageType>::iterator i = std::find(s_typedMessages.begin(), s_typedMessages.end(), msgtype);
+      if(i != s_typedMessages.end())
+      {
+         return static_cast<unsigned int>(i - s_typedMessages.begin());
+      }
+      s_typedMessages.push_back(msgtype);
+      return static_cast<unsigned int>(s_typedMessages.size() - 1);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::LogWrongMessageClass(const Message& msg)
+   {
+      LOG_ERROR("Cannot convert message to typed message, wrong message class: " << GetStringFromSID(msg.GetType()));
+   }
+
    MessagePump::MessagePump() 
+      : mNumEntityHandlerLists(0)
+      , mEmitObserver(NULL)
+      , mEmitDepth(0)
+      , mEmittingQueuedNested(false)
    {     
    }
 
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   const StringId MessagePump::AboutEntityId(SID_LITERAL("AboutEntity"));
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList::~HandlerList()
+   {
+      if(mEntityHandlers != NULL)
+      {
+         for(ComponentStoreSparseSet<HandlerList>::iterator i = mEntityHandlers->begin(); i != mEntityHandlers->end(); ++i)
+         {
+            delete i->second;
+         }
+         delete mEntityHandlers;
+      }
+   }
+
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
    MessagePump::~MessagePump() 
    {
       ClearQueue();
+      for(MessageFunctorRegistry::iterator i = mMessageFunctors.begin(); i != mMessageFunctors.end(); ++i)
+      {
+         delete i->second;
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList* MessagePump::FindHandlers(MessageType msgtype) const
+   {
+      MessageFunctorRegistry::const_iterator i = std::lower_bound(mMessageFunctors.begin(),
+         mMessageFunctors.end(), msgtype, RegistryTypeLess());
+      if(i == mMessageFunctors.end() || i->first != msgtype)
+      {
+         return NULL;
+      }
+      return i->second;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList& MessagePump::GetOrCreateHandlers(MessageType msgtype)
+   {
+      MessageFunctorRegistry::iterator i = std::lower_bound(mMessageFunctors.begin(),
+         mMessageFunctors.end(), msgtype, RegistryTypeLess());
+      if(i == mMessageFunctors.end() || i->first != msgtype)
+      {
+         i = mMessageFunctors.insert(i, std::make_pair(msgtype, new HandlerList()));
+      }
+      return *i->second;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList& MessagePump::GetTypedHandlers(unsigned int index, MessageType msgtype)
+   {
+      if(index >= mTypedHandlers.size())
+      {
+         mTypedHandlers.resize(index + 1, NULL);
+      }
+      if(mTypedHandlers[index] == NULL)
+      {
+         mTypedHandlers[index] = &GetOrCreateHandlers(msgtype);
+      }
+      return *mTypedHandlers[index];
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::Compact(HandlerList& handlers)
+   {
+      assert(handlers.mEmitDepth == 0);
+      if(handlers.mNeedsCompaction)
+      {
+         handlers.mEntries.erase(std::remove_if(handlers.mEntries.begin(), handlers.mEntries.end(), IsUnregistered),
+                                 handlers.mEntries.end());
+         handlers.mNeedsCompaction = false;
+      }
+      for(std::vector<MsgRegistryEntry>::iterator i = handlers.mPending.begin(); i != handlers.mPending.end(); ++i)
+      {
+         InsertByPriority(handlers.mEntries, *i);
+      }
+      handlers.mPending.clear();
+      CountEntries(handlers);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::CountEntries(HandlerList& handlers)
+   {
+      handlers.mNumTypedEntries = 0;
+      handlers.mNumPropertyEntries = 0;
+      for(std::vector<MsgRegistryEntry>::const_iterator i = handlers.mEntries.begin(); i != handlers.mEntries.end(); ++i)
+      {
+         if((i->mOptions & FilterOptions::TYPED) != 0)
+         {
+            ++handlers.mNumTypedEntries;
+         }
+         else
+         {
+            ++handlers.mNumPropertyEntries;
+         }
+      }
    }
   
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
    void MessagePump::RegisterForMessages(MessageType msgtype, MessageFunctor ftr, unsigned int options, const std::string& funcname)
+   {
+      RegisterEntry(msgtype, ftr, options & ~FilterOptions::TYPED, funcname);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList& MessagePump::RegisterEntry(MessageType msgtype, const MessageFunctor& ftr, unsigned int options, const std::string& funcname)
    {
       MsgRegistryEntry e;
       e.mOptions = options;
       e.mFunctor = ftr;
       e.mFuncName = funcname.empty() ? msgtype : dtEntity::SID(funcname);
-     
-      unsigned int priority = options & 3;
-     
-      std::pair<MessageFunctorRegistry::iterator, MessageFunctorRegistry::iterator> keyRange;
-      keyRange = mMessageFunctors.equal_range(msgtype);
 
-      MessageFunctorRegistry::iterator it = keyRange.first;
-      while(it != keyRange.second)
+      HandlerList& handlers = GetOrCreateHandlers(msgtype);
+      if(ContainsEntry(handlers, ftr))
       {
-         unsigned int otherpriority = it->second.mOptions & 3;
+         LOG_ERROR("Trying to register a functor twice for same message: " << GetStringFromSID(msgtype));
+      }
+      AddEntry(handlers, e);
+      return handlers;
+   }
 
-         if(it->second.mFunctor == ftr && ((it->second.mOptions & FilterOptions::UNREGISTERED) == 0))
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::AddEntry(HandlerList& handlers, const MsgRegistryEntry& e)
+   {
+      if(handlers.mEmitDepth > 0)
+      {
+         // do not resize entry vector while it is iterated
+         handlers.mPending.push_back(e);
+      }
+      else
+      {
+         InsertByPriority(handlers.mEntries, e);
+         CountEntries(handlers);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   bool MessagePump::RemoveEntry(HandlerList& handlers, const MessageFunctor& ftr)
+   {
+      for(std::vector<MsgRegistryEntry>::iterator it = handlers.mEntries.begin(); it != handlers.mEntries.end(); ++it)
+      {
+         if(it->mFunctor == ftr && !IsUnregistered(*it))
          {
-           LOG_ERROR("Trying to register a functor twice for same message: " << GetStringFromSID(msgtype));
+            // removed lazily on next emit
+            it->mOptions |= FilterOptions::UNREGISTERED;
+            handlers.mNeedsCompaction = true;
+            return true;
          }
-
-         if(otherpriority <= priority)
+      }
+      for(std::vector<MsgRegistryEntry>::iterator it = handlers.mPending.begin(); it != handlers.mPending.end(); ++it)
+      {
+         if(it->mFunctor == ftr)
          {
-            break;
+            handlers.mPending.erase(it);
+            return true;
          }
-
-         ++it;
       }
-      mMessageFunctors.insert(it, std::make_pair(msgtype, e));
-      assert(IsRegistered(msgtype, ftr));
+      return false;
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-   bool MessagePump::UnregisterForMessages(MessageType msgtype, MessageFunctor& ftr)
+   bool MessagePump::ContainsEntry(const HandlerList& handlers, const MessageFunctor& ftr)
    {
-      std::pair<MessageFunctorRegistry::iterator, MessageFunctorRegistry::iterator> keyRange;
-      keyRange = mMessageFunctors.equal_range(msgtype);
-      MessageFunctorRegistry::iterator it = keyRange.first;
-      for(; it != keyRange.second; ++it)
+      for(std::vector<MsgRegistryEntry>::const_iterator it = handlers.mEntries.begin(); it != handlers.mEntries.end(); ++it)
       {
-         if(it->second.mFunctor == ftr)
+         if(it->mFunctor == ftr && !IsUnregistered(*it))
+         {
+            return true;
+         }
+      }
+      for(std::vector<MsgRegistryEntry>::const_iterator it = handlers.mPending.begin(); it != handlers.mPending.end(); ++it)
+      {
+         if(it->mFunctor == ftr)
          {
-            it->second.mOptions |= FilterOptions::UNREGISTERED;
             return true;
          }
       }
       return false;
    }
 
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   bool MessagePump::UnregisterForMessages(MessageType msgtype, MessageFunctor& ftr)
+   {
+      HandlerList* handlers = FindHandlers(msgtype);
+      return handlers != NULL && RemoveEntry(*handlers, ftr);
+   }
+
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
    bool MessagePump::IsRegistered(MessageType msgtype, const MessageFunctor& ftr)
    {
-      std::pair<MessageFunctorRegistry::iterator, MessageFunctorRegistry::iterator> keyRange;
-      keyRange = mMessageFunctors.equal_range(msgtype);
-      MessageFunctorRegistry::iterator it = keyRange.first;
-      for(; it != keyRange.second; ++it)
+      HandlerList* handlers = FindHandlers(msgtype);
+      return handlers != NULL && ContainsEntry(*handlers, ftr);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::RegisterForMessages(MessageType msgtype, EntityId about, MessageFunctor ftr, unsigned int options, const std::string& funcname)
+   {
+      MsgRegistryEntry e;
+      e.mOptions = options & ~FilterOptions::TYPED;
+      e.mFunctor = ftr;
+      e.mFuncName = funcname.empty() ? msgtype : dtEntity::SID(funcname);
+
+      HandlerList& handlers = GetOrCreateHandlers(msgtype);
+      if(handlers.mEntityHandlers == NULL)
+      {
+         handlers.mEntityHandlers = new ComponentStoreSparseSet<HandlerList>();
+      }
+      HandlerList*& entityHandlers = (*handlers.mEntityHandlers)[about];
+      if(entityHandlers == NULL)
+      {
+         entityHandlers = new HandlerList();
+         ++mNumEntityHandlerLists;
+      }
+      else if(ContainsEntry(*entityHandlers, ftr))
+      {
+         LOG_ERROR("Trying to register a functor twice for same message and entity: " << GetStringFromSID(msgtype));
+      }
+      AddEntry(*entityHandlers, e);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   bool MessagePump::UnregisterForMessages(MessageType msgtype, EntityId about, MessageFunctor& ftr)
+   {
+      HandlerList* handlers = FindHandlers(msgtype);
+      if(handlers == NULL)
+      {
+         return false;
+      }
+      HandlerList* entityHandlers = FindEntityHandlers(msgtype, about);
+      if(entityHandlers == NULL || !RemoveEntry(*entityHandlers, ftr))
       {
-         if(it->second.mFunctor == ftr)
+         return false;
+      }
+      ReleaseEntityHandlers(*handlers, about);
+      return true;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   bool MessagePump::IsRegistered(MessageType msgtype, EntityId about, const MessageFunctor& ftr)
+   {
+      HandlerList* entityHandlers = FindEntityHandlers(msgtype, about);
+      return entityHandlers != NULL && ContainsEntry(*entityHandlers, ftr);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   MessagePump::HandlerList* MessagePump::FindEntityHandlers(MessageType msgtype, EntityId about) const
+   {
+      HandlerList* handlers = FindHandlers(msgtype);
+      if(handlers == NULL || handlers->mEntityHandlers == NULL)
+      {
+         return NULL;
+      }
+      ComponentStoreSparseSet<HandlerList>::const_iterator i = handlers->mEntityHandlers->find(about);
+      return (i == handlers->mEntityHandlers->end()) ? NULL : i->second;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::ReleaseEntityHandlers(HandlerList& handlers, EntityId about)
+   {
+      ComponentStoreSparseSet<HandlerList>::iterator i = handlers.mEntityHandlers->find(about);
+      if(i == handlers.mEntityHandlers->end())
+      {
+         return;
+      }
+      HandlerList* entityHandlers = i->second;
+      if(entityHandlers->mEmitDepth != 0)
+      {
+         // still being emitted, released when emit is done
+         return;
+      }
+      Compact(*entityHandlers);
+      if(entityHandlers->mEntries.empty())
+      {
+         handlers.mEntityHandlers->erase(i);
+         delete entityHandlers;
+         --mNumEntityHandlerLists;
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::UnregisterForEntity(EntityId about)
+   {
+      if(mNumEntityHandlerLists == 0)
+      {
+         return;
+      }
+      for(MessageFunctorRegistry::iterator i = mMessageFunctors.begin(); i != mMessageFunctors.end(); ++i)
+      {
+         HandlerList& handlers = *i->second;
+         if(handlers.mEntityHandlers == NULL)
          {
-            return true;
+            continue;
+         }
+         ComponentStoreSparseSet<HandlerList>::iterator j = handlers.mEntityHandlers->find(about);
+         if(j != handlers.mEntityHandlers->end())
+         {
+            ClearHandlers(*j->second);
+            ReleaseEntityHandlers(handlers, about);
          }
       }
-      return false;
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
    void MessagePump::EmitMessage(const Message& msg)
    {
+      assert(IsEmitAllowed() && "Cannot emit from concurrent tick handler, use EnqueueMessage");
+
       dtEntity::MessageType messageType = msg.GetType();
       if(messageType == MessageType())
       {
          LOG_ERROR("Trying to send a message with an empty type string!");
          return;
       }
-      std::pair<MessageFunctorRegistry::iterator, MessageFunctorRegistry::iterator> keyRange;
-      keyRange = mMessageFunctors.equal_range(messageType);
-      
-      // cannot call functors directly in loop because functors may call the
-      // RegisterForMessage function and invalidate the iterator.
-      typedef std::list<std::pair<MessageFunctor, StringId> > FunctorsToCall;
-      FunctorsToCall functorsToCall;
-      
 
-      MessageFunctorRegistry::iterator it = keyRange.first;
-      while(it != keyRange.second)
+      if(mEmitObserver != NULL)
       {
-         MsgRegistryEntry entry = it->second;
-         unsigned int regoptions = entry.mOptions;
+         mEmitObserver->Receive(msg);
+      }
 
-         if((regoptions & FilterOptions::UNREGISTERED) != 0)
-         {
-            mMessageFunctors.erase(it++);
-            continue;         
-         }
+      HandlerList* handlers = FindHandlers(messageType);
+      if(handlers == NULL)
+      {
+         return;
+      }
 
-         assert(messageType == it->first && "Something went wrong with message registration!");
-         
-         functorsToCall.push_back(std::make_pair(entry.mFunctor, entry.mFuncName));
+      ++mEmitDepth;
+      EmitToHandlers(*handlers, msg);
 
-         if((regoptions & FilterOptions::SINGLE_SHOT) != 0)
-         {
-            mMessageFunctors.erase(it++);
-            continue;    
-         }
-         ++it;
+      if(handlers->mEntityHandlers != NULL && !handlers->mEntityHandlers->empty())
+      {
+         EmitToEntityHandlers(*handlers, msg);
       }
+      --mEmitDepth;
+   }
 
-      FunctorsToCall::iterator j;
-      for(j = functorsToCall.begin(); j != functorsToCall.end(); ++j)
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::EmitToHandlers(HandlerList& handlers, const Message& msg)
+   {
+      if(handlers.mNumTypedEntries != 0 && handlers.mBridge != NULL)
       {
+         // typed functors need the message converted to typed form
+         handlers.mBridge(*this, handlers, msg);
+         return;
+      }
+      EmitToPropertyHandlers(handlers, msg);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::EmitToPropertyHandlers(HandlerList& handlers, const Message& msg)
+   {
+      // Functors may register and unregister functors while being called.
+      // Entry vector is not resized while mEmitDepth is set, so references
+      // into it stay valid. Functors registered during emit are not called.
+      ++handlers.mEmitDepth;
+      size_t numEntries = handlers.mEntries.size();
+      for(size_t i = 0; i < numEntries; ++i)
+      {
+         MsgRegistryEntry& entry = handlers.mEntries[i];
+         if((entry.mOptions & FilterOptions::TYPED) != 0 || !BeginCall(handlers, entry))
+         {
+            continue;
+         }
 #if DTENTITY_PROFILING_ENABLED
-         CProfileManager::Start_Profile(j->second);
-#endif
-         (j->first)(msg);
-#if DTENTITY_PROFILING_ENABLED
-         CProfileManager::Stop_Profile();
+         ProfileScope profile(entry.mFuncName);
 #endif
+         entry.mFunctor(msg);
+      }
+      EndEmit(handlers);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void MessagePump::EmitToEntityHandlers(HandlerList& handlers, const Message& msg)
+   {
+      const Property* prop = msg.Get(AboutEntityId);
+      if(prop == NULL)
+      {
+         return;
+      }
+      EntityId about = prop->UIntValue();
+      ComponentStoreSparseSet<HandlerList>::iterator i = handlers.mEntityHandlers->find(about);
+      if(i == handlers.mEntityHandlers->end())
+      {
+         return;
+      }
+
+      // list object stays valid while emitting, it is only deleted at depth 0
+      HandlerList* entityHandlers = i->second;
+      EmitToHandlers(*entityHandlers, msg);
+      if(entityHandlers->mEntries.empty())
+      {
+         ReleaseEntityHandlers(handlers, about);
       }
    }
 
    ///////////////////////////////////////////////////////////////////////////////
    void MessagePump::EnqueueMessage(const Message& msg)
    {
-      mMessageQueue.Push(msg.Clone());
+      QueuedMessageEntry entry;
+      entry.mMessage = mMessagePool.Acquire(msg);
+      entry.mNested = mEmitDepth > 0;
+      mMessageQueue.Push(entry);
    }
 
    ///////////////////////////////////////////////////////////////////////////////
-   void MessagePump::EnqueueMessage(const Message& msg, double when)
+   unsigned int MessagePump::EnqueueMessage(const Message& msg, double when)
    {
       if(when <= 0.001)
       {
-         mMessageQueue.Push(msg.Clone());
+         EnqueueMessage(msg);
+         return 0;
       }
-      else
+
+      FutureMessageEntry entry;
+      entry.mMessage = mMessagePool.Acquire(msg);
+      entry.mTimeToPost = when;
+      entry.mNested = mEmitDepth > 0;
+      entry.mId = ++mNextFutureId;
+      if(entry.mId == 0)
       {
-         FutureMessageEntry entry;
-         entry.mMessage = msg.Clone();
-         entry.mTimeToPost = when;
-         mFutureMessageQueue.Push(entry);
+         // wrapped around, 0 is not a valid handle
+         entry.mId = ++mNextFutureId;
       }
+      mFutureMessageQueue.Push(entry);
+      return entry.mId;
    }
 
    ///////////////////////////////////////////////////////////////////////////////
-   void MessagePump::EmitQueuedMessages(double now)
+   void MessagePump::EnqueueMessageCoalesced(const Message& msg, unsigned int key)
    {
-      
-      while(!mMessageQueue.Empty())
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mCoalesceMutex);
+
+      std::pair<MessageType, unsigned int> k(msg.GetType(), key);
+      CoalescedMessages::iterator i = mCoalescedMessages.find(k);
+
+      // different classes may use the same message type, only overwrite same class
+      if(i != mCoalescedMessages.end() && typeid(*i->second) == typeid(msg))
       {
-         const Message* entry = mMessageQueue.Pop();
-         EmitMessage(*entry);
-         delete entry;
+         i->second->InitFrom(msg);
+         ++mNumCoalescedDrops;
+         ++mCoalescedDropsByType[k.first];
+         return;
       }
 
-      while(!mFutureMessageQueue.Empty())
+      Message* queued = mMessagePool.Acquire(msg);
+      mCoalescedMessages[k] = queued;
+      QueuedMessageEntry entry;
+      entry.mMessage = queued;
+      entry.mNested = mEmitDepth > 0;
+      mMessageQueue.Push(entry);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   unsigned int MessagePump::GetNumCoalescedDrops(MessageType t)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mCoalesceMutex);
+      std::map<MessageType, unsigned int>::const_iterator i = mCoalescedDropsByType.find(t);
+      return (i == mCoalescedDropsByType.end()) ? 0 : i->second;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::ResetCoalescedDrops()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mCoalesceMutex);
+      mCoalescedDropsByType.clear();
+      mNumCoalescedDrops.exchange(0);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::ReleaseCoalescedMessages()
+   {
+      // messages taken from queue must not be overwritten anymore
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mCoalesceMutex);
+      mCoalescedMessages.clear();
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::ScheduleFutureMessages()
+   {
+      if(mFutureMessageQueue.PopAll(mFutureBatch))
       {
-         FutureMessageEntry entry = mFutureMessageQueue.Pop();
-         mFutureMessages.push_back(entry);
+         for(std::vector<FutureMessageEntry>::const_iterator i = mFutureBatch.begin(); i != mFutureBatch.end(); ++i)
+         {
+            mFutureMessages.Insert(*i);
+         }
+         mFutureBatch.clear();
       }
+   }
 
-      if(!mFutureMessages.empty())
+   ///////////////////////////////////////////////////////////////////////////////
+   bool MessagePump::CancelMessage(unsigned int handle)
+   {
+      // message may not have been moved to scheduler yet
+      ScheduleFutureMessages();
+
+      FutureMessageEntry entry;
+      if(!mFutureMessages.Remove(handle, entry))
       {
-         std::list<FutureMessageEntry>::iterator i = mFutureMessages.begin();
-         while(i != mFutureMessages.end())
-         {         
-            FutureMessageEntry entry = *i;
-            
-            if(entry.mTimeToPost <= now)
-            {
-               EmitMessage(*entry.mMessage);
-               delete entry.mMessage;
-               i = mFutureMessages.erase(i);               
-            }
-            else
-            {
-               ++i;
-            }
+         return false;
+      }
+      mMessagePool.Release(entry.mMessage);
+      return true;
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   unsigned int MessagePump::GetNumFutureMessages()
+   {
+      ScheduleFutureMessages();
+      return mFutureMessages.GetSize();
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::EmitQueuedMessages(double now)
+   {
+      // swap into local vectors, handlers may call EmitQueuedMessages recursively
+      std::vector<QueuedMessageEntry> batch;
+      batch.swap(mQueuedBatch);
+      std::vector<const Message*> release;
+      release.swap(mReleaseBatch);
+
+      // messages enqueued by handlers are emitted in the same call
+      while(mMessageQueue.PopAll(batch))
+      {
+         ReleaseCoalescedMessages();
+         for(std::vector<QueuedMessageEntry>::iterator i = batch.begin(); i != batch.end(); ++i)
+         {
+            EmitQueuedMessage(*i->mMessage, i->mNested);
+            release.push_back(i->mMessage);
          }
-      }  
+         mMessagePool.Release(release);
+         release.clear();
+         batch.clear();
+      }
+      batch.swap(mQueuedBatch);
+      release.swap(mReleaseBatch);
+
+      ScheduleFutureMessages();
+
+      // only touches due messages, in order of post time
+      FutureMessageEntry entry;
+      while(mFutureMessages.PopDue(now, entry))
+      {
+         EmitQueuedMessage(*entry.mMessage, entry.mNested);
+         mMessagePool.Release(entry.mMessage);
+      }
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::EmitQueuedMessage(const Message& msg, bool nested)
+   {
+      bool wasNested = mEmittingQueuedNested;
+      mEmittingQueuedNested = nested;
+      EmitMessage(msg);
+      mEmittingQueuedNested = wasNested;
    }
 
    ///////////////////////////////////////////////////////////////////////////////
    void MessagePump::ClearQueue()
    {
-      while(!mMessageQueue.Empty())
+      std::vector<QueuedMessageEntry> batch;
+      mMessageQueue.PopAll(batch);
+      ReleaseCoalescedMessages();
+      for(std::vector<QueuedMessageEntry>::iterator i = batch.begin(); i != batch.end(); ++i)
       {
-         delete mMessageQueue.Pop();
+         delete i->mMessage;
+      }
+      std::vector<FutureMessageEntry> futureBatch;
+      mFutureMessageQueue.PopAll(futureBatch);
+      mFutureMessages.TakeAll(futureBatch);
+      for(std::vector<FutureMessageEntry>::iterator i = futureBatch.begin(); i != futureBatch.end(); ++i)
+      {
+         delete i->mMessage;
       }
-      while(!mFutureMessageQueue.Empty())
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////
+   void MessagePump::ClearHandlers(HandlerList& handlers)
+   {
+      handlers.mPending.clear();
+      if(handlers.mEmitDepth == 0)
       {
-         delete mFutureMessageQueue.Pop().mMessage;
+         handlers.mEntries.clear();
+         handlers.mNeedsCompaction = false;
+         CountEntries(handlers);
       }
-      for(std::list<FutureMessageEntry>::iterator i = mFutureMessages.begin();
-          i != mFutureMessages.end(); ++i)
+      else
       {
-         delete i->mMessage;
+         for(std::vector<MsgRegistryEntry>::iterator j = handlers.mEntries.begin(); j != handlers.mEntries.end(); ++j)
+         {
+            j->mOptions |= FilterOptions::UNREGISTERED;
+         }
+         handlers.mNeedsCompaction = true;
       }
-      mFutureMessages.clear();
    }
 
    ///////////////////////////////////////////////////////////////////////////////
    void MessagePump::UnregisterAll()
    {
-      mMessageFunctors.clear();
+      // handler lists are kept alive, UnregisterAll may be called while emitting
+      for(MessageFunctorRegistry::iterator i = mMessageFunctors.begin(); i != mMessageFunctors.end(); ++i)
+      {
+         HandlerList& handlers = *i->second;
+         ClearHandlers(handlers);
+         if(handlers.mEntityHandlers == NULL)
+         {
+            continue;
+         }
+         std::vector<EntityId> ids;
+         for(ComponentStoreSparseSet<HandlerList>::iterator j = handlers.mEntityHandlers->begin();
+            j != handlers.mEntityHandlers->end(); ++j)
+         {
+            ClearHandlers(*j->second);
+            ids.push_back(j->first);
+         }
+         for(std::vector<EntityId>::const_iterator j = ids.begin(); j != ids.end(); ++j)
+         {
+            ReleaseEntityHandlers(handlers, *j);
+         }
+      }
    }
 }
-
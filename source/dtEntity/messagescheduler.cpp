@@ -0,0 +1,226 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/messagescheduler.h>
+
+#include <algorithm>
+#include <assert.h>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::Insert(const FutureMessageEntry& entry)
+   {
+      unsigned int slot;
+      if(mFreeSlots.empty())
+      {
+         slot = static_cast<unsigned int>(mSlots.size());
+         mSlots.push_back(Slot());
+      }
+      else
+      {
+         slot = mFreeSlots.back();
+         mFreeSlots.pop_back();
+      }
+      mSlots[slot].mEntry = entry;
+
+      // keep table at most half full
+      if((mHeap.size() + 1) * 2 > mSlotById.size())
+      {
+         ResizeIdTable(std::max<unsigned int>(16, static_cast<unsigned int>(mSlotById.size()) * 2));
+      }
+      InsertId(slot);
+
+      mHeap.push_back(slot);
+      SetHeapPos(static_cast<unsigned int>(mHeap.size() - 1), slot);
+      SiftUp(static_cast<unsigned int>(mHeap.size() - 1));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool MessageScheduler::Remove(unsigned int id, FutureMessageEntry& removed)
+   {
+      if(mSlotById.empty())
+      {
+         return false;
+      }
+      unsigned int bucket = FindBucket(id);
+      if(mSlotById[bucket] == 0)
+      {
+         return false;
+      }
+      RemoveAt(mSlots[mSlotById[bucket] - 1].mHeapPos, removed);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool MessageScheduler::PopDue(double now, FutureMessageEntry& popped)
+   {
+      if(mHeap.empty() || GetNextTime() > now)
+      {
+         return false;
+      }
+      RemoveAt(0, popped);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::TakeAll(std::vector<FutureMessageEntry>& toFill)
+   {
+      for(std::vector<unsigned int>::const_iterator i = mHeap.begin(); i != mHeap.end(); ++i)
+      {
+         toFill.push_back(mSlots[*i].mEntry);
+      }
+      mHeap.clear();
+      mSlots.clear();
+      mFreeSlots.clear();
+      std::fill(mSlotById.begin(), mSlotById.end(), 0);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::RemoveAt(unsigned int pos, FutureMessageEntry& removed)
+   {
+      unsigned int slot = mHeap[pos];
+      removed = mSlots[slot].mEntry;
+      EraseBucket(FindBucket(removed.mId));
+      mFreeSlots.push_back(slot);
+
+      unsigned int last = static_cast<unsigned int>(mHeap.size() - 1);
+      if(pos != last)
+      {
+         SetHeapPos(pos, mHeap[last]);
+         mHeap.pop_back();
+         // moved entry may belong above or below its new position
+         if(pos > 0 && IsEarlier(mHeap[pos], mHeap[(pos - 1) / 2]))
+         {
+            SiftUp(pos);
+         }
+         else
+         {
+            SiftDown(pos);
+         }
+      }
+      else
+      {
+         mHeap.pop_back();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::SiftUp(unsigned int pos)
+   {
+      unsigned int slot = mHeap[pos];
+      while(pos > 0)
+      {
+         unsigned int parent = (pos - 1) / 2;
+         if(!IsEarlier(slot, mHeap[parent]))
+         {
+            break;
+         }
+         SetHeapPos(pos, mHeap[parent]);
+         pos = parent;
+      }
+      SetHeapPos(pos, slot);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::SiftDown(unsigned int pos)
+   {
+      unsigned int slot = mHeap[pos];
+      unsigned int size = static_cast<unsigned int>(mHeap.size());
+      for(;;)
+      {
+         unsigned int child = 2 * pos + 1;
+         if(child >= size)
+         {
+            break;
+         }
+         if(child + 1 < size && IsEarlier(mHeap[child + 1], mHeap[child]))
+         {
+            ++child;
+         }
+         if(!IsEarlier(mHeap[child], slot))
+         {
+            break;
+         }
+         SetHeapPos(pos, mHeap[child]);
+         pos = child;
+      }
+      SetHeapPos(pos, slot);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int MessageScheduler::FindBucket(unsigned int id) const
+   {
+      unsigned int mask = static_cast<unsigned int>(mSlotById.size() - 1);
+      unsigned int bucket = id & mask;
+      while(mSlotById[bucket] != 0 && mSlots[mSlotById[bucket] - 1].mEntry.mId != id)
+      {
+         bucket = (bucket + 1) & mask;
+      }
+      return bucket;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::InsertId(unsigned int slot)
+   {
+      unsigned int bucket = FindBucket(mSlots[slot].mEntry.mId);
+      assert(mSlotById[bucket] == 0 && "Future message id is not unique");
+      mSlotById[bucket] = slot + 1;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::EraseBucket(unsigned int bucket)
+   {
+      // shift following entries of the probe sequence back into the gap
+      // so that lookups do not stop early
+      unsigned int mask = static_cast<unsigned int>(mSlotById.size() - 1);
+      unsigned int gap = bucket;
+      unsigned int next = bucket;
+      for(;;)
+      {
+         next = (next + 1) & mask;
+         if(mSlotById[next] == 0)
+         {
+            break;
+         }
+         unsigned int home = mSlots[mSlotById[next] - 1].mEntry.mId & mask;
+         // entry may move if its home bucket is not in (gap, next]
+         bool between = (gap < next) ? (home > gap && home <= next) : (home > gap || home <= next);
+         if(!between)
+         {
+            mSlotById[gap] = mSlotById[next];
+            gap = next;
+         }
+      }
+      mSlotById[gap] = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void MessageScheduler::ResizeIdTable(unsigned int numBuckets)
+   {
+      mSlotById.assign(numBuckets, 0);
+      for(std::vector<unsigned int>::const_iterator i = mHeap.begin(); i != mHeap.end(); ++i)
+      {
+         InsertId(*i);
+      }
+   }
+}
@@ -0,0 +1,597 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/profiler.h>
+
+#include <dtEntity/log.h>
+#include <dtEntity/systeminterface.h>
+#include <osg/Timer>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#if defined(_MSC_VER)
+   #define DTENTITY_THREAD_LOCAL __declspec(thread)
+#else
+   #define DTENTITY_THREAD_LOCAL __thread
+#endif
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+   #include <windows.h>
+#else
+   #include <pthread.h>
+#endif
+
+namespace dtEntity
+{
+   volatile bool Profiler::sEnabled = false;
+
+   namespace
+   {
+      enum
+      {
+         MAX_DEPTH = 64,
+         RING_SIZE = 1 << 14,
+         NUM_SAMPLES = 1024
+      };
+
+      struct ZoneEvent
+      {
+         StringId mName;
+         Timer_t mStart;
+         Timer_t mEnd;
+      };
+
+      /**
+       * Zone stack and event ring buffer of a thread. The ring buffer has a single
+       * writer (the owning thread) and a single reader (EndFrame).
+       * When the thread exits mExited is set, EndFrame collects the remaining
+       * events and deletes it.
+       */
+      struct ThreadData
+      {
+         ThreadData(unsigned int index)
+            : mDepth(0)
+            , mIndex(index)
+         {
+         }
+
+         StringId mZoneNames[MAX_DEPTH];
+         Timer_t mZoneStarts[MAX_DEPTH];
+
+         // number of open zones, can be larger than MAX_DEPTH
+         unsigned int mDepth;
+
+         ZoneEvent mEvents[RING_SIZE];
+
+         // next event to write, only incremented by owning thread
+         OpenThreads::Atomic mHead;
+
+         // next event to read, only changed by EndFrame
+         OpenThreads::Atomic mTail;
+
+         OpenThreads::Atomic mNumDropped;
+
+         // set by owning thread on exit, no events are written after that
+         OpenThreads::Atomic mExited;
+
+         // thread id in trace output
+         unsigned int mIndex;
+         std::string mName;
+      };
+
+      struct ZoneAccumulator
+      {
+         ZoneAccumulator()
+            : mNumCalls(0)
+            , mTotal(0)
+            , mMin(0)
+            , mMax(0)
+            , mLastFrameCalls(0)
+            , mLastFrameTime(0)
+            , mSamples(NUM_SAMPLES)
+         {
+         }
+
+         unsigned int mNumCalls;
+         double mTotal;
+         double mMin;
+         double mMax;
+         unsigned int mLastFrameCalls;
+         double mLastFrameTime;
+
+         // last call durations, written round robin
+         std::vector<float> mSamples;
+      };
+
+      struct TraceEvent
+      {
+         StringId mName;
+         unsigned int mThread;
+         Timer_t mStart;
+         Timer_t mEnd;
+      };
+
+      void OnThreadExit(void* data);
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+      VOID WINAPI OnFiberExit(PVOID data)
+      {
+         OnThreadExit(data);
+      }
+#endif
+
+      struct ProfilerState
+      {
+         ProfilerState()
+            : mNextThreadIndex(0)
+            , mNumFrames(0)
+            , mNumDroppedTrace(0)
+            , mTracing(false)
+            , mMaxTraceEvents(0)
+         {
+            // thread local storage with destructor, to be notified of thread exit
+#if defined(WIN32) && !defined(__CYGWIN__)
+            mExitKey = FlsAlloc(OnFiberExit);
+#else
+            pthread_key_create(&mExitKey, OnThreadExit);
+#endif
+         }
+
+         OpenThreads::Mutex mThreadsMutex;
+         std::vector<ThreadData*> mThreads;
+         unsigned int mNextThreadIndex;
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+         DWORD mExitKey;
+#else
+         pthread_key_t mExitKey;
+#endif
+
+         // guards all members below
+         OpenThreads::Mutex mStatsMutex;
+         typedef std::map<StringId, ZoneAccumulator> ZoneMap;
+         ZoneMap mZones;
+         unsigned int mNumFrames;
+
+         // dropped events of trace and of deleted thread data
+         unsigned int mNumDroppedTrace;
+         bool mTracing;
+         unsigned int mMaxTraceEvents;
+         std::vector<TraceEvent> mTrace;
+
+         // names of exited threads that may still appear in trace
+         std::map<unsigned int, std::string> mExitedThreadNames;
+      };
+
+      ProfilerState& GetState()
+      {
+         static ProfilerState s_state;
+         return s_state;
+      }
+
+      DTENTITY_THREAD_LOCAL ThreadData* s_threadData = NULL;
+
+      ThreadData* GetThreadData()
+      {
+         if(s_threadData == NULL)
+         {
+            ProfilerState& state = GetState();
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mThreadsMutex);
+            s_threadData = new ThreadData(state.mNextThreadIndex++);
+            state.mThreads.push_back(s_threadData);
+#if defined(WIN32) && !defined(__CYGWIN__)
+            FlsSetValue(state.mExitKey, s_threadData);
+#else
+            pthread_setspecific(state.mExitKey, s_threadData);
+#endif
+         }
+         return s_threadData;
+      }
+
+      void OnThreadExit(void* data)
+      {
+         ThreadData* t = static_cast<ThreadData*>(data);
+         if(t == s_threadData)
+         {
+            s_threadData = NULL;
+         }
+         // EndFrame deletes it
+         t->mExited.exchange(1);
+      }
+
+      std::string EscapeJson(const std::string& str)
+      {
+         std::ostringstream os;
+         for(std::string::const_iterator i = str.begin(); i != str.end(); ++i)
+         {
+            unsigned char c = static_cast<unsigned char>(*i);
+            if(c == '"' || c == '\\')
+            {
+               os << '\\' << *i;
+            }
+            else if(c < 0x20)
+            {
+               os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(c) << std::dec;
+            }
+            else
+            {
+               os << *i;
+            }
+         }
+         return os.str();
+      }
+
+      bool CompareTotalTime(const Profiler::ZoneStats& a, const Profiler::ZoneStats& b)
+      {
+         return a.mAvg * a.mNumCalls > b.mAvg * b.mNumCalls;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::SetEnabled(bool enabled)
+   {
+      sEnabled = enabled;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::BeginZone(StringId name)
+   {
+      ThreadData* t = GetThreadData();
+      if(t->mDepth < MAX_DEPTH)
+      {
+         t->mZoneNames[t->mDepth] = name;
+         t->mZoneStarts[t->mDepth] = osg::Timer::instance()->tick();
+      }
+      ++t->mDepth;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::EndZone()
+   {
+      ThreadData* t = s_threadData;
+      if(t == NULL || t->mDepth == 0)
+      {
+         return;
+      }
+      --t->mDepth;
+      if(t->mDepth >= MAX_DEPTH)
+      {
+         return;
+      }
+      Timer_t end = osg::Timer::instance()->tick();
+      unsigned int head = t->mHead;
+      if(head - static_cast<unsigned int>(t->mTail) >= static_cast<unsigned int>(RING_SIZE))
+      {
+         ++t->mNumDropped;
+         return;
+      }
+      ZoneEvent& e = t->mEvents[head & (RING_SIZE - 1)];
+      e.mName = t->mZoneNames[t->mDepth];
+      e.mStart = t->mZoneStarts[t->mDepth];
+      e.mEnd = end;
+      // publish event
+      ++t->mHead;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::SetThreadName(const std::string& name)
+   {
+      ThreadData* t = GetThreadData();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(GetState().mThreadsMutex);
+      t->mName = name;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::EndFrame()
+   {
+      ProfilerState& state = GetState();
+      osg::Timer* timer = osg::Timer::instance();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+
+      // thread data is only deleted here, while holding stats mutex
+      std::vector<ThreadData*> threads;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> threadsLock(state.mThreadsMutex);
+         threads = state.mThreads;
+      }
+
+      for(ProfilerState::ZoneMap::iterator i = state.mZones.begin(); i != state.mZones.end(); ++i)
+      {
+         i->second.mLastFrameCalls = 0;
+         i->second.mLastFrameTime = 0;
+      }
+
+      std::vector<ThreadData*> exited;
+      for(std::vector<ThreadData*>::iterator i = threads.begin(); i != threads.end(); ++i)
+      {
+         ThreadData* t = *i;
+         // check exit before reading head, so no events are written after head
+         if(static_cast<unsigned int>(t->mExited) != 0)
+         {
+            exited.push_back(t);
+         }
+         unsigned int head = t->mHead;
+
+         // same zone is often recorded many times in a row, skip map lookup then
+         ZoneAccumulator* last = NULL;
+         StringId lastName = StringId();
+
+         for(unsigned int j = t->mTail; j != head; ++j)
+         {
+            const ZoneEvent& e = t->mEvents[j & (RING_SIZE - 1)];
+            double ms = timer->delta_m(e.mStart, e.mEnd);
+
+            if(last == NULL || e.mName != lastName)
+            {
+               last = &state.mZones[e.mName];
+               lastName = e.mName;
+            }
+            ZoneAccumulator& zone = *last;
+            if(zone.mNumCalls == 0 || ms < zone.mMin) zone.mMin = ms;
+            if(zone.mNumCalls == 0 || ms > zone.mMax) zone.mMax = ms;
+            zone.mSamples[zone.mNumCalls % NUM_SAMPLES] = static_cast<float>(ms);
+            ++zone.mNumCalls;
+            zone.mTotal += ms;
+            ++zone.mLastFrameCalls;
+            zone.mLastFrameTime += ms;
+
+            if(state.mTracing)
+            {
+               if(state.mTrace.size() < state.mMaxTraceEvents)
+               {
+                  TraceEvent te;
+                  te.mName = e.mName;
+                  te.mThread = t->mIndex;
+                  te.mStart = e.mStart;
+                  te.mEnd = e.mEnd;
+                  state.mTrace.push_back(te);
+               }
+               else
+               {
+                  ++state.mNumDroppedTrace;
+               }
+            }
+         }
+         t->mTail.exchange(head);
+      }
+      ++state.mNumFrames;
+
+      if(!exited.empty())
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> threadsLock(state.mThreadsMutex);
+         for(std::vector<ThreadData*>::iterator i = exited.begin(); i != exited.end(); ++i)
+         {
+            ThreadData* t = *i;
+            state.mNumDroppedTrace += t->mNumDropped;
+            if(state.mTracing && !t->mName.empty())
+            {
+               state.mExitedThreadNames[t->mIndex] = t->mName;
+            }
+            state.mThreads.erase(std::find(state.mThreads.begin(), state.mThreads.end(), t));
+            delete t;
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::GetZoneStats(std::vector<ZoneStats>& toFill)
+   {
+      ProfilerState& state = GetState();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      std::vector<float> samples;
+      for(ProfilerState::ZoneMap::const_iterator i = state.mZones.begin(); i != state.mZones.end(); ++i)
+      {
+         const ZoneAccumulator& zone = i->second;
+         ZoneStats stats;
+         stats.mName = i->first;
+         stats.mNumCalls = zone.mNumCalls;
+         stats.mMin = zone.mMin;
+         stats.mAvg = zone.mNumCalls == 0 ? 0 : zone.mTotal / zone.mNumCalls;
+         stats.mMax = zone.mMax;
+         stats.mLastFrameCalls = zone.mLastFrameCalls;
+         stats.mLastFrameTime = zone.mLastFrameTime;
+
+         unsigned int numSamples = std::min(zone.mNumCalls, static_cast<unsigned int>(NUM_SAMPLES));
+         stats.mP99 = 0;
+         if(numSamples > 0)
+         {
+            samples.assign(zone.mSamples.begin(), zone.mSamples.begin() + numSamples);
+            // index of smallest sample that is not below 99% of samples
+            std::vector<float>::iterator nth = samples.begin() + (numSamples * 99 + 99) / 100 - 1;
+            std::nth_element(samples.begin(), nth, samples.end());
+            stats.mP99 = *nth;
+         }
+         toFill.push_back(stats);
+      }
+      std::sort(toFill.begin(), toFill.end(), CompareTotalTime);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::ResetStats()
+   {
+      ProfilerState& state = GetState();
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mThreadsMutex);
+         for(std::vector<ThreadData*>::iterator i = state.mThreads.begin(); i != state.mThreads.end(); ++i)
+         {
+            (*i)->mNumDropped.exchange(0);
+         }
+      }
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      state.mZones.clear();
+      state.mNumFrames = 0;
+      state.mNumDroppedTrace = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::LogStats()
+   {
+      std::vector<ZoneStats> stats;
+      GetZoneStats(stats);
+
+      std::ostringstream os;
+      os << "Profiler: " << GetNumFrames() << " frames, " << GetNumDroppedEvents() << " events dropped\n";
+      os << "calls       avg ms     min ms     max ms     p99 ms     zone\n";
+      os << std::fixed << std::setprecision(3);
+      for(std::vector<ZoneStats>::const_iterator i = stats.begin(); i != stats.end(); ++i)
+      {
+         os << std::setw(10) << std::left << i->mNumCalls << std::right
+            << std::setw(9) << i->mAvg << "  "
+            << std::setw(9) << i->mMin << "  "
+            << std::setw(9) << i->mMax << "  "
+            << std::setw(9) << i->mP99 << "  "
+            << GetStringFromSID(i->mName) << "\n";
+      }
+      LOG_ALWAYS(os.str());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int Profiler::GetNumFrames()
+   {
+      ProfilerState& state = GetState();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      return state.mNumFrames;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int Profiler::GetNumDroppedEvents()
+   {
+      ProfilerState& state = GetState();
+      unsigned int dropped = 0;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mThreadsMutex);
+         for(std::vector<ThreadData*>::iterator i = state.mThreads.begin(); i != state.mThreads.end(); ++i)
+         {
+            dropped += (*i)->mNumDropped;
+         }
+      }
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      return dropped + state.mNumDroppedTrace;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::StartTrace(unsigned int maxEvents)
+   {
+      ProfilerState& state = GetState();
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+         state.mTracing = true;
+         state.mMaxTraceEvents = maxEvents;
+         state.mTrace.clear();
+         state.mExitedThreadNames.clear();
+      }
+      SetEnabled(true);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Profiler::StopTrace()
+   {
+      ProfilerState& state = GetState();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      state.mTracing = false;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool Profiler::IsTracing()
+   {
+      ProfilerState& state = GetState();
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      return state.mTracing;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool Profiler::WriteChromeTrace(const std::string& path)
+   {
+      std::ofstream out(path.c_str());
+      if(out.fail())
+      {
+         LOG_ERROR("Cannot open trace file " << path);
+         return false;
+      }
+
+      ProfilerState& state = GetState();
+      out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      bool first = true;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(state.mStatsMutex);
+      {
+         std::map<unsigned int, std::string> threadNames;
+         threadNames.swap(state.mExitedThreadNames);
+         OpenThreads::ScopedLock<OpenThreads::Mutex> threadsLock(state.mThreadsMutex);
+         for(std::vector<ThreadData*>::const_iterator i = state.mThreads.begin(); i != state.mThreads.end(); ++i)
+         {
+            if(!(*i)->mName.empty())
+            {
+               threadNames[(*i)->mIndex] = (*i)->mName;
+            }
+         }
+         for(std::map<unsigned int, std::string>::const_iterator i = threadNames.begin(); i != threadNames.end(); ++i)
+         {
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i->first
+                << ",\"args\":{\"name\":\"" << EscapeJson(i->second) << "\"}}";
+            first = false;
+         }
+      }
+
+      if(!state.mTrace.empty())
+      {
+         // timestamps relative to earliest event
+         Timer_t origin = state.mTrace.front().mStart;
+         for(std::vector<TraceEvent>::const_iterator i = state.mTrace.begin(); i != state.mTrace.end(); ++i)
+         {
+            origin = std::min(origin, i->mStart);
+         }
+
+         osg::Timer* timer = osg::Timer::instance();
+         std::map<StringId, std::string> names;
+         out << std::fixed << std::setprecision(3);
+         for(std::vector<TraceEvent>::const_iterator i = state.mTrace.begin(); i != state.mTrace.end(); ++i)
+         {
+            std::map<StringId, std::string>::iterator name = names.find(i->mName);
+            if(name == names.end())
+            {
+               name = names.insert(std::make_pair(i->mName, EscapeJson(GetStringFromSID(i->mName)))).first;
+            }
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"" << name->second << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << i->mThread
+                << ",\"ts\":" << timer->delta_u(origin, i->mStart)
+                << ",\"dur\":" << timer->delta_u(i->mStart, i->mEnd) << "}";
+            first = false;
+         }
+      }
+      out << "\n]}\n";
+      state.mTrace.clear();
+
+      if(out.fail())
+      {
+         LOG_ERROR("Error writing trace file " << path);
+         return false;
+      }
+      return true;
+   }
+}
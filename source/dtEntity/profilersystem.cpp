@@ -0,0 +1,151 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/profilersystem.h>
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/profiler.h>
+#include <dtEntity/property.h>
+#include <dtEntity/systemmessages.h>
+#include <vector>
+
+namespace dtEntity
+{
+   const ComponentType ProfilerSystem::TYPE(SID_LITERAL("Profiler"));
+
+   ////////////////////////////////////////////////////////////////////////////////
+   ProfilerSystem::ProfilerSystem(EntityManager& em)
+      : BaseClass(em)
+   {
+      // collect after all other end of frame handlers have run
+      mEndOfFrameFunctor = TypedMessageFunctor<EndOfFrameData>::type(this, &ProfilerSystem::OnEndOfFrame);
+      em.RegisterForTypedMessages<EndOfFrameData>(mEndOfFrameFunctor, FilterOptions::ORDER_LATE, "ProfilerSystem::OnEndOfFrame");
+
+      AddScriptedMethod("setEnabled", ScriptMethodFunctor(this, &ProfilerSystem::ScriptSetEnabled));
+      AddScriptedMethod("isEnabled", ScriptMethodFunctor(this, &ProfilerSystem::ScriptIsEnabled));
+      AddScriptedMethod("getStats", ScriptMethodFunctor(this, &ProfilerSystem::ScriptGetStats));
+      AddScriptedMethod("resetStats", ScriptMethodFunctor(this, &ProfilerSystem::ScriptResetStats));
+      AddScriptedMethod("logStats", ScriptMethodFunctor(this, &ProfilerSystem::ScriptLogStats));
+      AddScriptedMethod("startTrace", ScriptMethodFunctor(this, &ProfilerSystem::ScriptStartTrace));
+      AddScriptedMethod("stopTrace", ScriptMethodFunctor(this, &ProfilerSystem::ScriptStopTrace));
+      AddScriptedMethod("writeTrace", ScriptMethodFunctor(this, &ProfilerSystem::ScriptWriteTrace));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   ProfilerSystem::~ProfilerSystem()
+   {
+      GetEntityManager().UnregisterForTypedMessages<EndOfFrameData>(mEndOfFrameFunctor);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void ProfilerSystem::OnEndOfFrame(const EndOfFrameData& msg)
+   {
+      Profiler::EndFrame();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptSetEnabled(const PropertyArgs& args)
+   {
+      if(args.size() < 1)
+      {
+         LOG_ERROR("Usage: setEnabled(bool)");
+         return NULL;
+      }
+      Profiler::SetEnabled(args[0]->BoolValue());
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptIsEnabled(const PropertyArgs& args)
+   {
+      return new BoolProperty(Profiler::IsEnabled());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptGetStats(const PropertyArgs& args)
+   {
+      std::vector<Profiler::ZoneStats> stats;
+      Profiler::GetZoneStats(stats);
+
+      ArrayProperty* arr = new ArrayProperty();
+      for(std::vector<Profiler::ZoneStats>::const_iterator i = stats.begin(); i != stats.end(); ++i)
+      {
+         GroupProperty* grp = new GroupProperty();
+         grp->Add(SID_LITERAL("name"), new StringProperty(GetStringFromSID(i->mName)));
+         grp->Add(SID_LITERAL("calls"), new UIntProperty(i->mNumCalls));
+         grp->Add(SID_LITERAL("min"), new DoubleProperty(i->mMin));
+         grp->Add(SID_LITERAL("avg"), new DoubleProperty(i->mAvg));
+         grp->Add(SID_LITERAL("max"), new DoubleProperty(i->mMax));
+         grp->Add(SID_LITERAL("p99"), new DoubleProperty(i->mP99));
+         grp->Add(SID_LITERAL("lastFrameCalls"), new UIntProperty(i->mLastFrameCalls));
+         grp->Add(SID_LITERAL("lastFrameTime"), new DoubleProperty(i->mLastFrameTime));
+         arr->Add(grp);
+      }
+      return arr;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptResetStats(const PropertyArgs& args)
+   {
+      Profiler::ResetStats();
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptLogStats(const PropertyArgs& args)
+   {
+      Profiler::LogStats();
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptStartTrace(const PropertyArgs& args)
+   {
+      if(args.empty())
+      {
+         Profiler::StartTrace();
+      }
+      else
+      {
+         Profiler::StartTrace(args[0]->UIntValue());
+      }
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptStopTrace(const PropertyArgs& args)
+   {
+      Profiler::StopTrace();
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* ProfilerSystem::ScriptWriteTrace(const PropertyArgs& args)
+   {
+      if(args.size() < 1)
+      {
+         LOG_ERROR("Usage: writeTrace(path)");
+         return NULL;
+      }
+      return new BoolProperty(Profiler::WriteChromeTrace(args[0]->StringValue()));
+   }
+}
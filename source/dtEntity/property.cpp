@@ -20,6 +20,7 @@
 */
 
 #include <dtEntity/property.h>
+#include <dtEntity/propertyvalue.h>
 #include <assert.h>
 #include <sstream>
 #include <dtEntity/log.h>
@@ -103,6 +104,118 @@ namespace dtEntity
      return !(iss >> f >> t).fail();
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   void Property::GetValue(PropertyValue& v) const
+   {
+      switch(GetDataType())
+      {
+      case DataType::ARRAY:
+      {
+         PropertyArray arr = ArrayValue();
+         PropertyValue::Array& target = v.SetArray();
+         target.resize(arr.size());
+         for(PropertyArray::size_type i = 0; i < arr.size(); ++i)
+         {
+            arr[i]->GetValue(target[i]);
+         }
+         break;
+      }
+      case DataType::GROUP:
+      {
+         PropertyGroup grp = GroupValue();
+         v.SetGroup();
+         for(PropertyGroup::const_iterator i = grp.begin(); i != grp.end(); ++i)
+         {
+            i->second->GetValue(v.GetOrAddGroupEntry(i->first));
+         }
+         break;
+      }
+      case DataType::BOOL: v.SetBool(BoolValue()); break;
+      case DataType::DOUBLE: v.SetDouble(DoubleValue()); break;
+      case DataType::FLOAT: v.SetFloat(FloatValue()); break;
+      case DataType::INT: v.SetInt(IntValue()); break;
+      case DataType::MATRIX: v.SetMatrix(MatrixValue()); break;
+      case DataType::QUAT: v.SetQuat(QuatValue()); break;
+      case DataType::STRING: v.SetString(StringValue()); break;
+      case DataType::STRINGID: v.SetStringId(StringIdValue()); break;
+      case DataType::UINT: v.SetUInt(UIntValue()); break;
+      case DataType::VEC2: v.SetVec2(Vec2Value()); break;
+      case DataType::VEC3: v.SetVec3(Vec3Value()); break;
+      case DataType::VEC4: v.SetVec4(Vec4Value()); break;
+      case DataType::VEC2D: v.SetVec2d(Vec2dValue()); break;
+      case DataType::VEC3D: v.SetVec3d(Vec3dValue()); break;
+      case DataType::VEC4D: v.SetVec4d(Vec4dValue()); break;
+      default: v.Clear(); break;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool Property::SetValue(const PropertyValue& v)
+   {
+      if(!v.IsConvertibleTo(GetDataType()))
+      {
+         return false;
+      }
+      switch(GetDataType())
+      {
+      case DataType::ARRAY:
+      {
+         const PropertyValue::Array& src = v.ArrayValue();
+         PropertyArray arr;
+         for(PropertyValue::Array::const_iterator i = src.begin(); i != src.end(); ++i)
+         {
+            Property* p = i->CreateProperty();
+            if(p != NULL)
+            {
+               arr.push_back(p);
+            }
+         }
+         SetArray(arr);
+         for(PropertyArray::iterator i = arr.begin(); i != arr.end(); ++i)
+         {
+            delete *i;
+         }
+         break;
+      }
+      case DataType::GROUP:
+      {
+         const PropertyValue::Group& src = v.GroupValue();
+         PropertyGroup grp;
+         for(PropertyValue::Group::const_iterator i = src.begin(); i != src.end(); ++i)
+         {
+            Property* p = i->second.CreateProperty();
+            if(p != NULL)
+            {
+               grp[i->first] = p;
+            }
+         }
+         SetGroup(grp);
+         for(PropertyGroup::iterator i = grp.begin(); i != grp.end(); ++i)
+         {
+            delete i->second;
+         }
+         break;
+      }
+      case DataType::BOOL: SetBool(v.BoolValue()); break;
+      case DataType::DOUBLE: SetDouble(v.DoubleValue()); break;
+      case DataType::FLOAT: SetFloat(v.FloatValue()); break;
+      case DataType::INT: SetInt(v.IntValue()); break;
+      case DataType::MATRIX: SetMatrix(v.MatrixValue()); break;
+      case DataType::QUAT: SetQuat(v.QuatValue()); break;
+      case DataType::STRING: SetString(v.StringValue()); break;
+      case DataType::STRINGID: SetStringId(v.StringIdValue()); break;
+      case DataType::UINT: SetUInt(v.UIntValue()); break;
+      case DataType::VEC2: SetVec2(v.Vec2Value()); break;
+      case DataType::VEC3: SetVec3(v.Vec3Value()); break;
+      case DataType::VEC4: SetVec4(v.Vec4Value()); break;
+      case DataType::VEC2D: SetVec2D(v.Vec2dValue()); break;
+      case DataType::VEC3D: SetVec3D(v.Vec3dValue()); break;
+      case DataType::VEC4D: SetVec4D(v.Vec4dValue()); break;
+      default: return false;
+      }
+      return true;
+   }
+
 
    ////////////////////////////////////////////////////////////////////////////////
    ArrayProperty::ArrayProperty(const PropertyArray& v)
@@ -333,6 +446,37 @@ namespace dtEntity
       return true;
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   void ArrayProperty::GetValue(PropertyValue& v) const
+   {
+      PropertyValue::Array& target = v.SetArray();
+      target.resize(mValue.size());
+      for(PropertyArray::size_type i = 0; i < mValue.size(); ++i)
+      {
+         mValue[i]->GetValue(target[i]);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool ArrayProperty::SetValue(const PropertyValue& v)
+   {
+      if(v.GetDataType() != DataType::ARRAY)
+      {
+         return false;
+      }
+      Clear();
+      const PropertyValue::Array& src = v.ArrayValue();
+      for(PropertyValue::Array::const_iterator i = src.begin(); i != src.end(); ++i)
+      {
+         Property* p = i->CreateProperty();
+         if(p != NULL)
+         {
+            Add(p);
+         }
+      }
+      return true;
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    void ArrayProperty::Clear()
    {
@@ -587,7 +731,7 @@ namespace dtEntity
    /////////////////////////////////////////////////////////////////////////////////
    PropertyGroup GroupProperty::GroupValue() const 
    { 
-      return mValue;
+      return Get();
    }
 
    /////////////////////////////////////////////////////////////////////////////////
@@ -599,7 +743,7 @@ namespace dtEntity
    /////////////////////////////////////////////////////////////////////////////////
    Property* GroupProperty::Clone() const 
    {
-      return new GroupProperty(mValue);
+      return new GroupProperty(Get());
    }
 
    /////////////////////////////////////////////////////////////////////////////////
@@ -615,7 +759,7 @@ namespace dtEntity
       {
          return false;
       }
-      return (mValue == other.GroupValue());
+      return (Get() == other.GroupValue());
    }
 
    /////////////////////////////////////////////////////////////////////////////////
@@ -634,7 +778,7 @@ namespace dtEntity
    /////////////////////////////////////////////////////////////////////////////////
    bool GroupProperty::Empty() const
    {
-      return mValue.empty();
+      return Get().empty();
    }
 
    /////////////////////////////////////////////////////////////////////////////////
@@ -673,14 +817,50 @@ namespace dtEntity
       return true;
    }
 
+   /////////////////////////////////////////////////////////////////////////////////
+   void GroupProperty::GetValue(PropertyValue& v) const
+   {
+      const PropertyGroup& props = Get();
+      PropertyValue::Group& target = v.SetGroup();
+      target.reserve(props.size());
+      for(PropertyGroup::const_iterator i = props.begin(); i != props.end(); ++i)
+      {
+         // property group is sorted by key, so is the target
+         target.push_back(PropertyValue::Group::value_type(i->first, PropertyValue()));
+         i->second->GetValue(target.back().second);
+      }
+   }
+
+   /////////////////////////////////////////////////////////////////////////////////
+   bool GroupProperty::SetValue(const PropertyValue& v)
+   {
+      if(v.GetDataType() != DataType::GROUP)
+      {
+         return false;
+      }
+      Clear();
+      const PropertyValue::Group& src = v.GroupValue();
+      mValue.reserve(src.size());
+      for(PropertyValue::Group::const_iterator i = src.begin(); i != src.end(); ++i)
+      {
+         Property* p = i->second.CreateProperty();
+         if(p != NULL)
+         {
+            Add(i->first, p);
+         }
+      }
+      return true;
+   }
+
    /////////////////////////////////////////////////////////////////////////////////
    void GroupProperty::Clear()
    {
-      while(!mValue.empty())
+      // detach properties from group before deleting them
+      PropertyGroup props;
+      props.swap(mValue);
+      for(PropertyGroup::iterator i = props.begin(); i != props.end(); ++i)
       {
-         std::pair<StringId, Property*> pair = *mValue.begin();
-         mValue.erase(mValue.begin());
-         delete pair.second;
+         delete i->second;
       }
    }
 
@@ -949,6 +1129,23 @@ namespace dtEntity
       }
    }
 
+   /////////////////////////////////////////////////////////////////////////////////
+   void StringProperty::GetValue(PropertyValue& v) const
+   {
+      v.SetString(mValue.c_str(), mValue.size());
+   }
+
+   /////////////////////////////////////////////////////////////////////////////////
+   bool StringProperty::SetValue(const PropertyValue& v)
+   {
+      if(v.GetDataType() == DataType::STRING)
+      {
+         mValue.assign(v.CStringValue(), v.StringSize());
+         return true;
+      }
+      return Property::SetValue(v);
+   }
+
    /////////////////////////////////////////////////////////////////////////////////
    /////////////////////////////////////////////////////////////////////////////////
    QuatProperty::QuatProperty()
@@ -22,27 +22,223 @@
 #include <dtEntity/propertycontainer.h>
 
 #include <dtEntity/property.h>
+#include <dtEntity/propertyvalue.h>
 #include <assert.h>
 
 namespace dtEntity
 {
-  
-  
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyContainer::ConstIterator::ConstIterator(const PropertyContainer& container)
+      : mContainer(&container)
+      , mSchema(container.mSchema)
+      , mEntry(0)
+      , mGroupIter(container.mValue.begin())
+      , mGroupEnd(container.mValue.end())
+   {
+      Settle();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyContainer::ConstIterator::ConstIterator(const GroupProperty& group)
+      : mContainer(NULL)
+      , mSchema(NULL)
+      , mEntry(0)
+      , mGroupIter(group.Get().begin())
+      , mGroupEnd(group.Get().end())
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyContainer::ConstIterator::Next()
+   {
+      if(mSchema != NULL)
+      {
+         ++mEntry;
+      }
+      else
+      {
+         ++mGroupIter;
+      }
+      Settle();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyContainer::ConstIterator::Settle()
+   {
+      while(mSchema != NULL && mEntry >= mSchema->GetEntries().size())
+      {
+         mSchema = mSchema->GetParent();
+         mEntry = 0;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   StringId PropertyContainer::ConstIterator::GetName() const
+   {
+      return mSchema != NULL ? mSchema->GetEntries()[mEntry].mName : mGroupIter->first;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const Property* PropertyContainer::ConstIterator::GetProperty() const
+   {
+      if(mSchema != NULL)
+      {
+         return reinterpret_cast<const Property*>(
+            reinterpret_cast<const char*>(mContainer) + mSchema->GetEntries()[mEntry].mOffset);
+      }
+      return mGroupIter->second;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyContainer::~PropertyContainer()
+   {
+      // don't delete properties, they are not on heap
+      mValue.clear();
+      delete static_cast<PropertyGroup*>(mAllProperties.get());
+
+      for(const PropertySchema* schema = mSchema; schema != NULL; schema = schema->GetParent())
+      {
+         const_cast<PropertySchema*>(schema)->Release(this);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const PropertyGroup& PropertyContainer::Get() const
+   {
+      if(mSchema == NULL)
+      {
+         return mValue;
+      }
+
+      PropertyGroup* existing = static_cast<PropertyGroup*>(mAllProperties.get());
+      if(existing != NULL)
+      {
+         return *existing;
+      }
+
+      PropertyGroup* group = new PropertyGroup(mValue);
+      for(const PropertySchema* schema = mSchema; schema != NULL; schema = schema->GetParent())
+      {
+         const PropertySchema::Entries& entries = schema->GetEntries();
+         for(PropertySchema::Entries::const_iterator i = entries.begin(); i != entries.end(); ++i)
+         {
+            (*group)[i->mName] = FindInSchema(i->mName);
+         }
+      }
+
+      // several threads may read a const container, keep the group published first
+      if(!mAllProperties.assign(group, NULL))
+      {
+         delete group;
+      }
+      return *static_cast<PropertyGroup*>(mAllProperties.get());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int PropertyContainer::GetNumProperties() const
+   {
+      unsigned int num = 0;
+      for(ConstIterator i(*this); !i.AtEnd(); i.Next())
+      {
+         ++num;
+      }
+      return num;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* PropertyContainer::Get(StringId name)
+   {
+      Property* prop = FindInSchema(name);
+      if(prop != NULL)
+      {
+         return prop;
+      }
+      return GroupProperty::Get(name);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const Property* PropertyContainer::Get(StringId name) const
+   {
+      const Property* prop = FindInSchema(name);
+      if(prop != NULL)
+      {
+         return prop;
+      }
+      return GroupProperty::Get(name);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool PropertyContainer::Has(StringId name) const
+   {
+      return FindInSchema(name) != NULL || GroupProperty::Has(name);
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    void PropertyContainer::InitFrom(const PropertyContainer& other)
    {
-      for(PropertyGroup::const_iterator i = other.mValue.begin(); i != other.mValue.end(); ++i)
+      // same schema means same class layout, copy values by offset
+      if(mSchema != NULL && mSchema == other.mSchema)
       {
-         Property* own = Get(i->first);
+         char* base = reinterpret_cast<char*>(this);
+         const char* otherbase = reinterpret_cast<const char*>(&other);
+         for(const PropertySchema* schema = mSchema; schema != NULL; schema = schema->GetParent())
+         {
+            const PropertySchema::Entries& entries = schema->GetEntries();
+            for(PropertySchema::Entries::const_iterator i = entries.begin(); i != entries.end(); ++i)
+            {
+               reinterpret_cast<Property*>(base + i->mOffset)->SetFrom(
+                  *reinterpret_cast<const Property*>(otherbase + i->mOffset));
+            }
+         }
+         // property group holds properties registered without schema
+         for(PropertyGroup::const_iterator i = other.mValue.begin(); i != other.mValue.end(); ++i)
+         {
+            Property* own = GroupProperty::Get(i->first);
+            if(own == NULL)
+            {
+               LOG_ERROR("Error in InitFrom: PropertyContainer has no property named " << GetStringFromSID(i->first));
+            }
+            else
+            {
+               own->SetFrom(*i->second);
+            }
+         }
+         return;
+      }
+
+      for(ConstIterator i(other); !i.AtEnd(); i.Next())
+      {
+         Property* own = Get(i.GetName());
          if(own == NULL)
          {
-            LOG_ERROR("Error in InitFrom: PropertyContainer has no property named " << GetStringFromSID(i->first));
+            LOG_ERROR("Error in InitFrom: PropertyContainer has no property named " << GetStringFromSID(i.GetName()));
          }
          else
          {
-            own->SetFrom(*i->second);
+            own->SetFrom(*i.GetProperty());
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool PropertyContainer::SetValue(const PropertyValue& v)
+   {
+      if(v.GetDataType() != DataType::GROUP)
+      {
+         return false;
+      }
+      bool success = true;
+      const PropertyValue::Group& values = v.GroupValue();
+      for(PropertyValue::Group::const_iterator i = values.begin(); i != values.end(); ++i)
+      {
+         Property* own = Get(i->first);
+         if(own == NULL || !own->SetValue(i->second))
+         {
+            LOG_ERROR("Error in SetValue: Cannot set property " << GetStringFromSID(i->first));
+            success = false;
          }
       }
+      return success;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +248,39 @@ namespace dtEntity
       Add(name, prop);
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyContainer::Register(PropertySchema& schema, StringId name, Property* prop)
+   {
+      assert(!GroupProperty::Has(name) && "Property already registered without schema!");
+
+      // schema of base class gets parent of schema of derived class
+      const PropertySchema* parent = mSchema;
+      if(parent == &schema)
+      {
+         parent = schema.GetParent();
+      }
+      std::ptrdiff_t offset = reinterpret_cast<const char*>(prop) - reinterpret_cast<const char*>(this);
+      schema.Register(this, parent, name, prop->GetDataType(), offset);
+      mSchema = &schema;
+
+      PropertyGroup* all = static_cast<PropertyGroup*>(mAllProperties.get());
+      if(all != NULL)
+      {
+         (*all)[name] = prop;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyContainer::Add(StringId name, Property* prop)
+   {
+      GroupProperty::Add(name, prop);
+      PropertyGroup* all = static_cast<PropertyGroup*>(mAllProperties.get());
+      if(all != NULL)
+      {
+         (*all)[name] = prop;
+      }
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    void PropertyContainer::SetArray(StringId name, const PropertyArray& val)
    {
@@ -0,0 +1,103 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/propertyschema.h>
+
+#include <algorithm>
+#include <assert.h>
+
+namespace dtEntity
+{
+   namespace
+   {
+      struct EntryNameLess
+      {
+         bool operator()(const PropertySchema::Entry& e, const StringId& name) const
+         {
+            return e.mName < name;
+         }
+      };
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertySchema::PropertySchema()
+      : mParent(NULL)
+      , mBuilder(NULL)
+      , mComplete(false)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const PropertySchema::Entry* PropertySchema::Find(StringId name) const
+   {
+      Entries::const_iterator i = std::lower_bound(mEntries.begin(), mEntries.end(), name, EntryNameLess());
+      if(i == mEntries.end() || i->mName != name)
+      {
+         return NULL;
+      }
+      return &*i;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertySchema::Register(const void* container, const PropertySchema* parent, StringId name,
+                                 DataType::e datatype, std::ptrdiff_t offset)
+   {
+      if(!mComplete)
+      {
+         if(mBuilder == NULL)
+         {
+            mBuilder = container;
+            mParent = parent;
+         }
+
+         if(mBuilder == container)
+         {
+            Entries::iterator i = std::lower_bound(mEntries.begin(), mEntries.end(), name, EntryNameLess());
+            assert((i == mEntries.end() || i->mName != name) && "Property already registered!");
+            Entry e;
+            e.mName = name;
+            e.mDataType = datatype;
+            e.mOffset = offset;
+            mEntries.insert(i, e);
+            return;
+         }
+
+         // a second instance registers, so first instance is fully constructed
+         mComplete = true;
+         mBuilder = NULL;
+      }
+
+      assert(mParent == parent && "Property schema used with different base class schemas!");
+      assert(Find(name) != NULL && Find(name)->mOffset == offset && Find(name)->mDataType == datatype &&
+             "Properties registered with schema differ between instances!");
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertySchema::Release(const void* container)
+   {
+      if(!mComplete && mBuilder == container)
+      {
+         mComplete = true;
+         mBuilder = NULL;
+      }
+   }
+}
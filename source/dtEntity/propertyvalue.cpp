@@ -0,0 +1,658 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/propertyvalue.h>
+
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+namespace dtEntity
+{
+   namespace
+   {
+      struct GroupEntryLess
+      {
+         bool operator()(const PropertyValue::Group::value_type& v, const StringId& name) const
+         {
+            return v.first < name;
+         }
+      };
+
+      bool IsNumeric(DataType::e t)
+      {
+         return t == DataType::BOOL || t == DataType::INT || t == DataType::UINT ||
+                t == DataType::FLOAT || t == DataType::DOUBLE;
+      }
+
+      // number of components of vector types, 0 for other types
+      unsigned int NumVectorComponents(DataType::e t)
+      {
+         switch(t)
+         {
+         case DataType::VEC2:
+         case DataType::VEC2D: return 2;
+         case DataType::VEC3:
+         case DataType::VEC3D: return 3;
+         case DataType::VEC4:
+         case DataType::VEC4D: return 4;
+         default: return 0;
+         }
+      }
+
+      bool IsFloatVector(DataType::e t)
+      {
+         return t == DataType::VEC2 || t == DataType::VEC3 || t == DataType::VEC4;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::PropertyValue()
+      : mType(DataType::UNKNOWN_ID)
+      , mStringSize(0)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::PropertyValue(const PropertyValue& other)
+      : mType(DataType::UNKNOWN_ID)
+      , mStringSize(0)
+   {
+      CopyFrom(other);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::~PropertyValue()
+   {
+      Clear();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue& PropertyValue::operator=(const PropertyValue& other)
+   {
+      if(this != &other)
+      {
+         // copy first, other may be contained in this
+         PropertyValue tmp(other);
+         swap(tmp);
+      }
+      return *this;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::swap(PropertyValue& other)
+   {
+      std::swap(mType, other.mType);
+      std::swap(mStringSize, other.mStringSize);
+      std::swap(mData, other.mData);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::Clear()
+   {
+      switch(mType)
+      {
+      case DataType::ARRAY: delete mData.mArray; break;
+      case DataType::GROUP: delete mData.mGroup; break;
+      case DataType::MATRIX: delete[] mData.mMatrix; break;
+#if DTENTITY_USE_STRINGS_AS_STRINGIDS
+      case DataType::STRINGID:
+#endif
+      case DataType::STRING:
+         if(IsHeapString())
+         {
+            delete[] mData.mHeapChars;
+         }
+         break;
+      default: break;
+      }
+      mType = DataType::UNKNOWN_ID;
+      mStringSize = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::CopyFrom(const PropertyValue& other)
+   {
+      assert(mType == DataType::UNKNOWN_ID);
+      switch(other.mType)
+      {
+      case DataType::ARRAY: mData.mArray = new Array(*other.mData.mArray); break;
+      case DataType::GROUP: mData.mGroup = new Group(*other.mData.mGroup); break;
+#if DTENTITY_USE_STRINGS_AS_STRINGIDS
+      case DataType::STRINGID:
+#endif
+      case DataType::STRING:
+         SetString(other.CStringValue(), other.mStringSize);
+         break;
+      case DataType::MATRIX:
+         mData.mMatrix = new double[16];
+         memcpy(mData.mMatrix, other.mData.mMatrix, 16 * sizeof(double));
+         break;
+      // copy only the active member
+      case DataType::BOOL: mData.mBool = other.mData.mBool; break;
+      case DataType::INT: mData.mInt = other.mData.mInt; break;
+      case DataType::FLOAT: mData.mFloat = other.mData.mFloat; break;
+      case DataType::DOUBLE: mData.mDouble = other.mData.mDouble; break;
+#if !DTENTITY_USE_STRINGS_AS_STRINGIDS
+      case DataType::STRINGID:
+#endif
+      case DataType::UINT: mData.mUInt = other.mData.mUInt; break;
+      case DataType::QUAT: memcpy(mData.mDoubles, other.mData.mDoubles, 4 * sizeof(double)); break;
+      default:
+      {
+         unsigned int components = NumVectorComponents(other.mType);
+         if(IsFloatVector(other.mType))
+         {
+            memcpy(mData.mFloats, other.mData.mFloats, components * sizeof(float));
+         }
+         else
+         {
+            memcpy(mData.mDoubles, other.mData.mDoubles, components * sizeof(double));
+         }
+         break;
+      }
+      }
+      mType = other.mType;
+      mStringSize = other.mStringSize;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool PropertyValue::IsConvertibleTo(DataType::e type) const
+   {
+      if(mType == type)
+      {
+         return mType != DataType::UNKNOWN_ID;
+      }
+      if(IsNumeric(mType) && IsNumeric(type))
+      {
+         return true;
+      }
+      unsigned int components = NumVectorComponents(mType);
+      if(components != 0 && components == NumVectorComponents(type))
+      {
+         return true;
+      }
+      return (mType == DataType::STRING && type == DataType::STRINGID) ||
+             (mType == DataType::STRINGID && type == DataType::STRING);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   double PropertyValue::NumericValue(const char* typeName) const
+   {
+      switch(mType)
+      {
+      case DataType::BOOL: return mData.mBool ? 1 : 0;
+      case DataType::INT: return mData.mInt;
+      case DataType::UINT: return mData.mUInt;
+      case DataType::FLOAT: return mData.mFloat;
+      case DataType::DOUBLE: return mData.mDouble;
+      default:
+         LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to " << typeName << " value!");
+         return 0;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool PropertyValue::BoolValue() const
+   {
+      return (mType == DataType::BOOL) ? mData.mBool : (NumericValue("a bool") != 0);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   int PropertyValue::IntValue() const
+   {
+      return (mType == DataType::INT) ? mData.mInt : static_cast<int>(NumericValue("an int"));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int PropertyValue::UIntValue() const
+   {
+      return (mType == DataType::UINT) ? mData.mUInt : static_cast<unsigned int>(NumericValue("a uint"));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   float PropertyValue::FloatValue() const
+   {
+      return (mType == DataType::FLOAT) ? mData.mFloat : static_cast<float>(NumericValue("a float"));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   double PropertyValue::DoubleValue() const
+   {
+      return NumericValue("a double");
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::GetNumbers(double* v, unsigned int count) const
+   {
+      if(NumVectorComponents(mType) != count)
+      {
+         LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to a vector of size " << count);
+         for(unsigned int i = 0; i < count; ++i)
+         {
+            v[i] = 0;
+         }
+         return;
+      }
+      for(unsigned int i = 0; i < count; ++i)
+      {
+         v[i] = IsFloatVector(mType) ? mData.mFloats[i] : mData.mDoubles[i];
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec2f PropertyValue::Vec2Value() const
+   {
+      double v[2];
+      GetNumbers(v, 2);
+      return Vec2f(v[0], v[1]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec3f PropertyValue::Vec3Value() const
+   {
+      double v[3];
+      GetNumbers(v, 3);
+      return Vec3f(v[0], v[1], v[2]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec4f PropertyValue::Vec4Value() const
+   {
+      double v[4];
+      GetNumbers(v, 4);
+      return Vec4f(v[0], v[1], v[2], v[3]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec2d PropertyValue::Vec2dValue() const
+   {
+      double v[2];
+      GetNumbers(v, 2);
+      return Vec2d(v[0], v[1]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec3d PropertyValue::Vec3dValue() const
+   {
+      double v[3];
+      GetNumbers(v, 3);
+      return Vec3d(v[0], v[1], v[2]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Vec4d PropertyValue::Vec4dValue() const
+   {
+      double v[4];
+      GetNumbers(v, 4);
+      return Vec4d(v[0], v[1], v[2], v[3]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Quat PropertyValue::QuatValue() const
+   {
+      if(mType != DataType::QUAT)
+      {
+         LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to a quat value!");
+         return Quat();
+      }
+      return Quat(mData.mDoubles[0], mData.mDoubles[1], mData.mDoubles[2], mData.mDoubles[3]);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Matrix PropertyValue::MatrixValue() const
+   {
+      if(mType != DataType::MATRIX)
+      {
+         LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to a matrix value!");
+         return Matrix();
+      }
+      return Matrix(mData.mMatrix);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const char* PropertyValue::CStringValue() const
+   {
+      assert(mType == DataType::STRING
+#if DTENTITY_USE_STRINGS_AS_STRINGIDS
+         || mType == DataType::STRINGID
+#endif
+      );
+      return IsHeapString() ? mData.mHeapChars : mData.mChars;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   std::string PropertyValue::StringValue() const
+   {
+      if(mType == DataType::STRING)
+      {
+         return std::string(CStringValue(), mStringSize);
+      }
+      if(mType == DataType::STRINGID)
+      {
+         return GetStringFromSID(StringIdValue());
+      }
+      LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to a string value!");
+      return std::string();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   StringId PropertyValue::StringIdValue() const
+   {
+      if(mType == DataType::STRINGID)
+      {
+#if DTENTITY_USE_STRINGS_AS_STRINGIDS
+         return std::string(CStringValue(), mStringSize);
+#else
+         return mData.mUInt;
+#endif
+      }
+      if(mType == DataType::STRING)
+      {
+         return SID(std::string(CStringValue(), mStringSize));
+      }
+      LOG_ERROR("Cannot convert " << DataType::ToString(mType) << " to a StringId value!");
+      return StringId();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetBool(bool v)
+   {
+      Clear();
+      mType = DataType::BOOL;
+      mData.mBool = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetInt(int v)
+   {
+      Clear();
+      mType = DataType::INT;
+      mData.mInt = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetUInt(unsigned int v)
+   {
+      Clear();
+      mType = DataType::UINT;
+      mData.mUInt = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetFloat(float v)
+   {
+      Clear();
+      mType = DataType::FLOAT;
+      mData.mFloat = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetDouble(double v)
+   {
+      Clear();
+      mType = DataType::DOUBLE;
+      mData.mDouble = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetNumbers(DataType::e type, const float* v, unsigned int count)
+   {
+      assert(count <= 4);
+      Clear();
+      mType = type;
+      for(unsigned int i = 0; i < count; ++i)
+      {
+         mData.mFloats[i] = v[i];
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetNumbers(DataType::e type, const double* v, unsigned int count)
+   {
+      assert(count <= 4);
+      Clear();
+      mType = type;
+      for(unsigned int i = 0; i < count; ++i)
+      {
+         mData.mDoubles[i] = v[i];
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetVec2(const Vec2f& v) { SetNumbers(DataType::VEC2, v.ptr(), 2); }
+   void PropertyValue::SetVec3(const Vec3f& v) { SetNumbers(DataType::VEC3, v.ptr(), 3); }
+   void PropertyValue::SetVec4(const Vec4f& v) { SetNumbers(DataType::VEC4, v.ptr(), 4); }
+   void PropertyValue::SetVec2d(const Vec2d& v) { SetNumbers(DataType::VEC2D, v.ptr(), 2); }
+   void PropertyValue::SetVec3d(const Vec3d& v) { SetNumbers(DataType::VEC3D, v.ptr(), 3); }
+   void PropertyValue::SetVec4d(const Vec4d& v) { SetNumbers(DataType::VEC4D, v.ptr(), 4); }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetQuat(const Quat& v)
+   {
+      double d[4] = { v[0], v[1], v[2], v[3] };
+      SetNumbers(DataType::QUAT, d, 4);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetMatrix(const Matrix& v)
+   {
+      double* m = new double[16];
+      for(unsigned int i = 0; i < 16; ++i)
+      {
+         m[i] = v.ptr()[i];
+      }
+      Clear();
+      mType = DataType::MATRIX;
+      mData.mMatrix = m;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetString(const std::string& v)
+   {
+      SetString(v.c_str(), v.size());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetString(const char* v, std::size_t size)
+   {
+      // v may point into own storage
+      PropertyValue tmp;
+      tmp.mType = DataType::STRING;
+      tmp.mStringSize = static_cast<unsigned int>(size);
+      char* target = tmp.mData.mChars;
+      if(tmp.IsHeapString())
+      {
+         target = tmp.mData.mHeapChars = new char[size + 1];
+      }
+      memcpy(target, v, size);
+      target[size] = '\0';
+      swap(tmp);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void PropertyValue::SetStringId(StringId v)
+   {
+#if DTENTITY_USE_STRINGS_AS_STRINGIDS
+      SetString(v);
+      mType = DataType::STRINGID;
+#else
+      Clear();
+      mType = DataType::STRINGID;
+      mData.mUInt = v;
+#endif
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::Array& PropertyValue::SetArray()
+   {
+      Array* arr = new Array();
+      Clear();
+      mType = DataType::ARRAY;
+      mData.mArray = arr;
+      return *arr;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::Group& PropertyValue::SetGroup()
+   {
+      Group* grp = new Group();
+      Clear();
+      mType = DataType::GROUP;
+      mData.mGroup = grp;
+      return *grp;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const PropertyValue::Array& PropertyValue::ArrayValue() const
+   {
+      assert(mType == DataType::ARRAY);
+      return *mData.mArray;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue::Array& PropertyValue::ArrayValue()
+   {
+      assert(mType == DataType::ARRAY);
+      return *mData.mArray;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const PropertyValue::Group& PropertyValue::GroupValue() const
+   {
+      assert(mType == DataType::GROUP);
+      return *mData.mGroup;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   const PropertyValue* PropertyValue::GetGroupEntry(StringId name) const
+   {
+      assert(mType == DataType::GROUP);
+      Group::const_iterator i = std::lower_bound(mData.mGroup->begin(), mData.mGroup->end(), name, GroupEntryLess());
+      if(i == mData.mGroup->end() || i->first != name)
+      {
+         return NULL;
+      }
+      return &i->second;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PropertyValue& PropertyValue::GetOrAddGroupEntry(StringId name)
+   {
+      assert(mType == DataType::GROUP);
+      Group::iterator i = std::lower_bound(mData.mGroup->begin(), mData.mGroup->end(), name, GroupEntryLess());
+      if(i == mData.mGroup->end() || i->first != name)
+      {
+         i = mData.mGroup->insert(i, Group::value_type(name, PropertyValue()));
+      }
+      return i->second;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool PropertyValue::operator==(const PropertyValue& other) const
+   {
+      if(mType != other.mType)
+      {
+         return false;
+      }
+      switch(mType)
+      {
+      case DataType::UNKNOWN_ID: return true;
+      case DataType::ARRAY: return *mData.mArray == *other.mData.mArray;
+      case DataType::GROUP: return *mData.mGroup == *other.mData.mGroup;
+      case DataType::BOOL: return mData.mBool == other.mData.mBool;
+      case DataType::INT: return mData.mInt == other.mData.mInt;
+      case DataType::UINT: return mData.mUInt == other.mData.mUInt;
+      case DataType::FLOAT: return mData.mFloat == other.mData.mFloat;
+      case DataType::DOUBLE: return mData.mDouble == other.mData.mDouble;
+      case DataType::MATRIX: return memcmp(mData.mMatrix, other.mData.mMatrix, 16 * sizeof(double)) == 0;
+      case DataType::QUAT: return memcmp(mData.mDoubles, other.mData.mDoubles, 4 * sizeof(double)) == 0;
+      case DataType::STRING:
+         return mStringSize == other.mStringSize && memcmp(CStringValue(), other.CStringValue(), mStringSize) == 0;
+      case DataType::STRINGID: return StringIdValue() == other.StringIdValue();
+      default:
+      {
+         unsigned int components = NumVectorComponents(mType);
+         for(unsigned int i = 0; i < components; ++i)
+         {
+            bool equal = IsFloatVector(mType) ? (mData.mFloats[i] == other.mData.mFloats[i]) :
+                                                (mData.mDoubles[i] == other.mData.mDoubles[i]);
+            if(!equal)
+            {
+               return false;
+            }
+         }
+         return true;
+      }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   Property* PropertyValue::CreateProperty() const
+   {
+      switch(mType)
+      {
+      case DataType::ARRAY:
+      {
+         ArrayProperty* arr = new ArrayProperty();
+         for(Array::const_iterator i = mData.mArray->begin(); i != mData.mArray->end(); ++i)
+         {
+            Property* p = i->CreateProperty();
+            if(p != NULL)
+            {
+               arr->Add(p);
+            }
+         }
+         return arr;
+      }
+      case DataType::GROUP:
+      {
+         GroupProperty* grp = new GroupProperty();
+         for(Group::const_iterator i = mData.mGroup->begin(); i != mData.mGroup->end(); ++i)
+         {
+            Property* p = i->second.CreateProperty();
+            if(p != NULL)
+            {
+               grp->Add(i->first, p);
+            }
+         }
+         return grp;
+      }
+      case DataType::BOOL: return new BoolProperty(mData.mBool);
+      case DataType::INT: return new IntProperty(mData.mInt);
+      case DataType::UINT: return new UIntProperty(mData.mUInt);
+      case DataType::FLOAT: return new FloatProperty(mData.mFloat);
+      case DataType::DOUBLE: return new DoubleProperty(mData.mDouble);
+      case DataType::MATRIX: return new MatrixProperty(MatrixValue());
+      case DataType::QUAT: return new QuatProperty(QuatValue());
+      case DataType::STRING: return new StringProperty(StringValue());
+      case DataType::STRINGID: return new StringIdProperty(StringIdValue());
+      case DataType::VEC2: return new Vec2Property(Vec2Value());
+      case DataType::VEC3: return new Vec3Property(Vec3Value());
+      case DataType::VEC4: return new Vec4Property(Vec4Value());
+      case DataType::VEC2D: return new Vec2dProperty(Vec2dValue());
+      case DataType::VEC3D: return new Vec3dProperty(Vec3dValue());
+      case DataType::VEC4D: return new Vec4dProperty(Vec4dValue());
+      default: return NULL;
+      }
+   }
+}
@@ -1085,10 +1085,9 @@ namespace dtEntity
    {
       dtProtoBuf::Message messageobj;
       messageobj.set_message_type(SIDToUInt(m.GetType()));
-      const PropertyGroup& props = m.Get();
-      for(PropertyGroup::const_iterator i = props.begin(); i != props.end(); ++i)
+      for(PropertyContainer::ConstIterator i(m); !i.AtEnd(); i.Next())
       {
-         SerializeProperty(*messageobj.add_property(), i->first, *i->second);
+         SerializeProperty(*messageobj.add_property(), i.GetName(), *i.GetProperty());
       }
       return messageobj.SerializeToOstream(&stream);
    }
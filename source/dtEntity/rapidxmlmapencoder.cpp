@@ -1125,20 +1125,16 @@ namespace dtEntity
       {
          std::string tname = i->first;
 
-         GroupProperty props = i->second;
-
          xml_node<>* compelem = doc.allocate_node(node_element, names.mComponent);
          entity->append_node(compelem);
 
          xml_attribute<>* typeattr = doc.allocate_attribute(names.mType, doc.allocate_string(tname.c_str()));
          compelem->append_attribute(typeattr);
 
-         PropertyGroup p = props.Get();
-
          std::map<std::string, const Property*> sorted;
-         for(PropertyGroup::const_iterator j = p.begin(); j != p.end(); ++j)
+         for(PropertyContainer::ConstIterator j(i->second); !j.AtEnd(); j.Next())
          {
-            sorted[GetStringFromSID(j->first)] = j->second;
+            sorted[GetStringFromSID(j.GetName())] = j.GetProperty();
          }
 
          for(std::map<std::string, const Property*>::const_iterator j = sorted.begin(); j != sorted.end(); ++j)
@@ -1159,13 +1155,11 @@ namespace dtEntity
       xml_attribute<>* typeattr = doc.allocate_attribute(names.mType, doc.allocate_string(tname.c_str()));
       element->append_attribute(typeattr);
 
-      const PropertyGroup& p = component->Get();
       // write properties sorted by property name
       std::map<std::string, const Property*> sorted;
-      PropertyGroup::const_iterator i;
-      for(i = p.begin(); i != p.end(); ++i)
+      for(PropertyContainer::ConstIterator i(*component); !i.AtEnd(); i.Next())
       {
-         sorted[GetStringFromSID(i->first)] = i->second;
+         sorted[GetStringFromSID(i.GetName())] = i.GetProperty();
       }
 
       std::map<std::string, const Property*>::const_iterator j;
@@ -0,0 +1,110 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/slaballocator.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+namespace dtEntity
+{
+   const StringId SlabAllocator::AllocLiveCountId(SID_LITERAL("AllocLiveCount"));
+   const StringId SlabAllocator::AllocPeakCountId(SID_LITERAL("AllocPeakCount"));
+   const StringId SlabAllocator::AllocBytesReservedId(SID_LITERAL("AllocBytesReserved"));
+   const StringId SlabAllocator::AllocFragmentationId(SID_LITERAL("AllocFragmentation"));
+
+   namespace
+   {
+      const size_t DEFAULT_SLAB_BYTES = 16 * 1024;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   SlabAllocator::SlabAllocator(size_t objectSize, unsigned int blocksPerSlab)
+      : mBlockSize((objectSize + CACHE_LINE_SIZE - 1) & ~size_t(CACHE_LINE_SIZE - 1))
+      , mBlocksPerSlab(blocksPerSlab)
+      , mFreeList(NULL)
+      , mLiveCount(0)
+      , mPeakCount(0)
+   {
+      if(mBlockSize == 0)
+      {
+         mBlockSize = CACHE_LINE_SIZE;
+      }
+      if(mBlocksPerSlab == 0)
+      {
+         size_t n = DEFAULT_SLAB_BYTES / mBlockSize;
+         mBlocksPerSlab = static_cast<unsigned int>(n < 8 ? 8 : n);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   SlabAllocator::~SlabAllocator()
+   {
+      FreeAll();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SlabAllocator::FreeAll()
+   {
+      for(std::vector<void*>::iterator i = mSlabs.begin(); i != mSlabs.end(); ++i)
+      {
+         free(*i);
+      }
+      mSlabs.clear();
+      mFreeList = NULL;
+      mLiveCount = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   float SlabAllocator::GetFragmentation() const
+   {
+      size_t capacity = mSlabs.size() * mBlocksPerSlab;
+      if(capacity == 0)
+      {
+         return 0;
+      }
+      return 1.0f - static_cast<float>(mLiveCount) / static_cast<float>(capacity);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SlabAllocator::AddSlab()
+   {
+      assert(mFreeList == NULL);
+      void* raw = malloc(mBlocksPerSlab * mBlockSize + CACHE_LINE_SIZE - 1);
+      if(raw == NULL)
+      {
+         return;
+      }
+      mSlabs.push_back(raw);
+
+      size_t addr = reinterpret_cast<size_t>(raw);
+      char* first = reinterpret_cast<char*>((addr + CACHE_LINE_SIZE - 1) & ~size_t(CACHE_LINE_SIZE - 1));
+
+      // link blocks in address order so that consecutive allocations are adjacent
+      for(unsigned int i = mBlocksPerSlab; i > 0; --i)
+      {
+         FreeBlock* b = reinterpret_cast<FreeBlock*>(first + (i - 1) * mBlockSize);
+         b->mNext = mFreeList;
+         mFreeList = b;
+      }
+   }
+}
@@ -102,15 +102,39 @@ namespace dtEntity
       GetAllComponentProperties(props);
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   void Spawner::GetAllComponentValuesRecursive(ComponentValues& values) const
+   {
+      if(mParent)
+      {
+         mParent->GetAllComponentValuesRecursive(values);
+      }
+
+      ComponentProperties::const_iterator i;
+      for(i = mComponentProperties.begin(); i != mComponentProperties.end(); ++i)
+      {
+         PropertyValue& compvalue = values[i->first];
+         if(compvalue.GetDataType() != DataType::GROUP)
+         {
+            compvalue.SetGroup();
+         }
+         const PropertyGroup& props = i->second.Get();
+         for(PropertyGroup::const_iterator j = props.begin(); j != props.end(); ++j)
+         {
+            j->second->GetValue(compvalue.GetOrAddGroupEntry(j->first));
+         }
+      }
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    bool Spawner::Spawn(Entity& entity) const
    {
       // combine component values of this spawner and the parent spawners
-      ComponentProperties componentValues;
-      GetAllComponentPropertiesRecursive(componentValues);
+      ComponentValues componentValues;
+      GetAllComponentValuesRecursive(componentValues);
 
       //first create all components
-      ComponentProperties::const_iterator i;
+      ComponentValues::const_iterator i;
       for(i = componentValues.begin(); i != componentValues.end(); ++i)
       {
          ComponentType ctype = i->first;
@@ -140,7 +164,6 @@ namespace dtEntity
       for(i = componentValues.begin(); i != componentValues.end(); ++i)
       {      
          ComponentType ctype = i->first;
-         GroupProperty propertyHolder = i->second;
          Component* newcomp;
          bool success = entity.GetComponent(ctype, newcomp);
          if(!success)
@@ -149,13 +172,12 @@ namespace dtEntity
             continue;
          }
 
-         PropertyGroup props = propertyHolder.Get();
+         const PropertyValue::Group& props = i->second.GroupValue();
 
-         PropertyGroup::iterator j;
+         PropertyValue::Group::const_iterator j;
          for(j = props.begin(); j != props.end(); ++j)
          {
             StringId propname = j->first;
-            const Property* prop = j->second;
             
             Property* toSet = newcomp->Get(propname);
             if(toSet == NULL)
@@ -164,7 +186,14 @@ namespace dtEntity
                continue;
             }
             
-            bool success = toSet->SetFrom(*prop);
+            bool success = toSet->SetValue(j->second);
+            if(!success)
+            {
+               // fall back to conversions supported by SetFrom
+               Property* prop = j->second.CreateProperty();
+               success = (prop != NULL && toSet->SetFrom(*prop));
+               delete prop;
+            }
             if(success)
             {  
 #if CALL_ONPROPERTYCHANGED_METHOD
@@ -20,32 +20,482 @@
 */
 
 #include <dtEntity/stringid.h>
-#include <OpenThreads/ReadWriteMutex>
 #include <dtEntity/hash.h>
 #include <dtEntity/dtentity_config.h>
+#include <dtEntity/log.h>
 #include <dtEntity/singleton.h>
-#include <map>
+#include <dtEntity/stringidfile.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <string>
-#include <iostream>
+#include <string.h>
 #include <fstream>
 #include <sstream>
+#include <vector>
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+   #include <windows.h>
+#else
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
 
 namespace dtEntity
 {
+   namespace
+   {
+      struct PendingLiteral
+      {
+         unsigned int mHash;
+         const char* mString;
+      };
+
+      // literals given to AddStringIdLiteral, not yet in reverse lookup table.
+      // Function statics, AddStringIdLiteral is called during static initialization.
+      std::vector<PendingLiteral>& GetPendingLiterals()
+      {
+         static std::vector<PendingLiteral> s_pending;
+         return s_pending;
+      }
+
+      OpenThreads::Mutex& GetPendingLiteralsMutex()
+      {
+         static OpenThreads::Mutex s_mutex;
+         return s_mutex;
+      }
+
+      OpenThreads::Atomic& GetNumPendingLiterals()
+      {
+         static OpenThreads::Atomic s_count;
+         return s_count;
+      }
 
+      ////////////////////////////////////////////////////////////////////////////////
+      /**
+       * Append-only storage for interned strings. Strings are never
+       * moved or freed before the arena is destroyed. Not thread safe.
+       */
+      class StringArena
+      {
+      public:
+
+         enum { BLOCK_SIZE = 16 * 1024 };
+
+         StringArena()
+            : mCurrent(NULL)
+            , mRemaining(0)
+         {
+         }
+
+         ~StringArena()
+         {
+            for(std::vector<char*>::iterator i = mBlocks.begin(); i != mBlocks.end(); ++i)
+            {
+               delete[] *i;
+            }
+         }
+
+         const char* Intern(const char* str, size_t len)
+         {
+            char* dest;
+            if(len + 1 > BLOCK_SIZE)
+            {
+               // long strings get their own block, current block stays in use
+               dest = new char[len + 1];
+               mBlocks.push_back(dest);
+            }
+            else
+            {
+               if(len + 1 > mRemaining)
+               {
+                  mCurrent = new char[BLOCK_SIZE];
+                  mRemaining = BLOCK_SIZE;
+                  mBlocks.push_back(mCurrent);
+               }
+               dest = mCurrent;
+               mCurrent += len + 1;
+               mRemaining -= len + 1;
+            }
+            memcpy(dest, str, len);
+            dest[len] = '\0';
+            return dest;
+         }
+
+      private:
+         char* mCurrent;
+         size_t mRemaining;
+         std::vector<char*> mBlocks;
+      };
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /**
+       * Read only memory mapping of a whole file, unmapped on destruction
+       */
+      class MappedFile
+      {
+      public:
+
+         MappedFile()
+            : mData(NULL)
+            , mSize(0)
+#if defined(WIN32) && !defined(__CYGWIN__)
+            , mMapping(NULL)
+#endif
+         {
+         }
+
+         ~MappedFile()
+         {
+            if(mData == NULL)
+            {
+               return;
+            }
+#if defined(WIN32) && !defined(__CYGWIN__)
+            UnmapViewOfFile(mData);
+            CloseHandle(mMapping);
+#else
+            munmap(const_cast<char*>(mData), mSize);
+#endif
+         }
+
+         bool Open(const std::string& path)
+         {
+#if defined(WIN32) && !defined(__CYGWIN__)
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if(file == INVALID_HANDLE_VALUE)
+            {
+               return false;
+            }
+            LARGE_INTEGER size;
+            if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            {
+               CloseHandle(file);
+               return false;
+            }
+            mMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            CloseHandle(file);
+            if(mMapping == NULL)
+            {
+               return false;
+            }
+            mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+            if(mData == NULL)
+            {
+               CloseHandle(mMapping);
+               mMapping = NULL;
+               return false;
+            }
+            mSize = static_cast<size_t>(size.QuadPart);
+#else
+            int fd = open(path.c_str(), O_RDONLY);
+            if(fd == -1)
+            {
+               return false;
+            }
+            struct stat st;
+            if(fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+               close(fd);
+               return false;
+            }
+            void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if(data == MAP_FAILED)
+            {
+               return false;
+            }
+            mData = static_cast<const char*>(data);
+            mSize = st.st_size;
+#endif
+            return true;
+         }
+
+         const char* GetData() const { return mData; }
+         size_t GetSize() const { return mSize; }
+
+      private:
+
+         // no copy ctor
+         MappedFile(const MappedFile&);
+         MappedFile& operator=(const MappedFile&);
+
+         const char* mData;
+         size_t mSize;
+#if defined(WIN32) && !defined(__CYGWIN__)
+         HANDLE mMapping;
+#endif
+      };
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /**
+    * Reverse lookup table from hash to string.
+    * Hashes are distributed over shards by their upper bits. Each shard is an
+    * open addressing hash table with linear probing. Lookups read the table
+    * without lock, inserts are serialized by a mutex per shard.
+    * A slot is published by setting its string pointer after its hash was written.
+    * When a shard table grows the old table is kept until destruction, so that
+    * readers still working on it are safe.
+    */
    class StringIdManager : public Singleton<StringIdManager>
    {
+      enum
+      {
+         SHARD_BITS = 4,
+         NUM_SHARDS = 1 << SHARD_BITS,
+         INITIAL_TABLE_SIZE = 256
+      };
+
+      struct Slot
+      {
+         unsigned int mHash;
+
+         // string or NULL if slot is empty
+         OpenThreads::AtomicPtr mString;
+      };
+
+      struct Table
+      {
+         Table(unsigned int size)
+            : mMask(size - 1)
+            , mSlots(new Slot[size])
+         {
+         }
+
+         ~Table()
+         {
+            delete[] mSlots;
+         }
+
+         unsigned int GetSize() const { return mMask + 1; }
+
+         const char* Find(unsigned int hash) const
+         {
+            for(unsigned int i = hash & mMask; ; i = (i + 1) & mMask)
+            {
+               const char* str = static_cast<const char*>(mSlots[i].mString.get());
+               if(str == NULL)
+               {
+                  return NULL;
+               }
+               if(mSlots[i].mHash == hash)
+               {
+                  return str;
+               }
+            }
+         }
+
+         // table has to contain at least one empty slot
+         void Insert(unsigned int hash, const char* str)
+         {
+            unsigned int i = hash & mMask;
+            while(mSlots[i].mString.get() != NULL)
+            {
+               i = (i + 1) & mMask;
+            }
+            mSlots[i].mHash = hash;
+            mSlots[i].mString.assign(const_cast<char*>(str), NULL);
+         }
+
+         unsigned int mMask;
+         Slot* mSlots;
+      };
+
+      struct Shard
+      {
+         Shard()
+            : mTable(new Table(INITIAL_TABLE_SIZE))
+            , mNumEntries(0)
+         {
+         }
+
+         ~Shard()
+         {
+            delete static_cast<Table*>(mTable.get());
+            for(std::vector<Table*>::iterator i = mRetired.begin(); i != mRetired.end(); ++i)
+            {
+               delete *i;
+            }
+         }
+
+         Table* GetTable() const { return static_cast<Table*>(mTable.get()); }
+
+         OpenThreads::AtomicPtr mTable;
 
-      typedef std::map<unsigned int, std::string> ReverseLookupMap;
-      ReverseLookupMap mReverseLookup;
-      OpenThreads::ReadWriteMutex mMutex;
+         // members below are guarded by mMutex
+         OpenThreads::Mutex mMutex;
+         unsigned int mNumEntries;
+         std::vector<Table*> mRetired;
+         StringArena mArena;
+      };
+
+      Shard mShards[NUM_SHARDS];
+
+      // memory mapped string databases, strings in them are referenced by the tables
+      std::vector<MappedFile*> mMappedFiles;
+      OpenThreads::Mutex mMappedFilesMutex;
+
+      Shard& GetShard(unsigned int hash)
+      {
+         return mShards[hash >> (32 - SHARD_BITS)];
+      }
 
    public:
 
       ////////////////////////////////////////////////////////////////////////////////
       StringIdManager()
       {
-         std::ifstream indbstr("sids.txt");
+         Insert(0, "", 0, false);
+         if(!LoadFile("sids.bin"))
+         {
+            LoadTextFile("sids.txt");
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      ~StringIdManager()
+      {
+         for(std::vector<MappedFile*>::iterator i = mMappedFiles.begin(); i != mMappedFiles.end(); ++i)
+         {
+            delete *i;
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      static unsigned int Hash(const std::string& str)
+      {
+         const unsigned char* s = reinterpret_cast<const unsigned char*>(str.c_str());
+         unsigned int hash;
+         MurmurHash3_x86_32(s, static_cast<int>(str.size()), 0, &hash);
+         return hash;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // Replace table of shard by a copy with given size. Shard mutex has to be locked.
+      static Table* Grow(Shard& shard, unsigned int size)
+      {
+         Table* table = shard.GetTable();
+         Table* grown = new Table(size);
+         for(unsigned int i = 0; i < table->GetSize(); ++i)
+         {
+            const char* s = static_cast<const char*>(table->mSlots[i].mString.get());
+            if(s != NULL)
+            {
+               grown->Insert(table->mSlots[i].mHash, s);
+            }
+         }
+         shard.mTable.assign(grown, table);
+         shard.mRetired.push_back(table);
+         return grown;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // Grow tables so that numEntries more strings can be inserted without growing
+      void Reserve(unsigned int numEntries)
+      {
+         // hashes are spread evenly, leave some slack for uneven shards
+         unsigned int perShard = numEntries / NUM_SHARDS + numEntries / (NUM_SHARDS * 4) + 1;
+         for(unsigned int i = 0; i < NUM_SHARDS; ++i)
+         {
+            Shard& shard = mShards[i];
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard.mMutex);
+            unsigned int size = shard.GetTable()->GetSize();
+            while((shard.mNumEntries + perShard) * 2 > size)
+            {
+               size *= 2;
+            }
+            if(size != shard.GetTable()->GetSize())
+            {
+               Grow(shard, size);
+            }
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // Add string to table if no string with same hash is in it yet.
+      // If copy is false str has to stay valid until the manager is destroyed.
+      void Insert(unsigned int hash, const char* str, size_t len, bool copy)
+      {
+         Shard& shard = GetShard(hash);
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard.mMutex);
+         Table* table = shard.GetTable();
+         if(table->Find(hash) != NULL)
+         {
+            return;
+         }
+         if((shard.mNumEntries + 1) * 2 > table->GetSize())
+         {
+            table = Grow(shard, table->GetSize() * 2);
+         }
+         table->Insert(hash, copy ? shard.mArena.Intern(str, len) : str);
+         ++shard.mNumEntries;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      void AddToReverseLookup(const std::string& str, unsigned int hash)
+      {
+         if(GetShard(hash).GetTable()->Find(hash) == NULL)
+         {
+            Insert(hash, str.c_str(), str.size(), true);
+         }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      bool LoadFile(const std::string& path)
+      {
+         MappedFile* file = new MappedFile();
+         if(!file->Open(path))
+         {
+            delete file;
+            return false;
+         }
+
+         const char* data = file->GetData();
+         size_t size = file->GetSize();
+         StringIdFileHeader header;
+         bool valid = size >= sizeof(StringIdFileHeader);
+         if(valid)
+         {
+            memcpy(&header, data, sizeof(StringIdFileHeader));
+            size_t entriesEnd = sizeof(StringIdFileHeader) + size_t(header.mNumEntries) * sizeof(StringIdFileEntry);
+            valid = memcmp(header.mMagic, STRINGID_FILE_MAGIC, sizeof(header.mMagic)) == 0 &&
+                    header.mVersion == STRINGID_FILE_VERSION &&
+                    header.mStringBytes > 0 &&
+                    entriesEnd + header.mStringBytes <= size &&
+                    data[entriesEnd + header.mStringBytes - 1] == '\0';
+         }
+         if(!valid)
+         {
+            delete file;
+            return false;
+         }
+
+         Reserve(header.mNumEntries);
+         const char* strings = data + sizeof(StringIdFileHeader) + header.mNumEntries * sizeof(StringIdFileEntry);
+         for(unsigned int i = 0; i < header.mNumEntries; ++i)
+         {
+            StringIdFileEntry entry;
+            memcpy(&entry, data + sizeof(StringIdFileHeader) + i * sizeof(StringIdFileEntry), sizeof(StringIdFileEntry));
+            if(entry.mOffset < header.mStringBytes)
+            {
+               Insert(entry.mHash, strings + entry.mOffset, 0, false);
+            }
+         }
+
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMappedFilesMutex);
+         mMappedFiles.push_back(file);
+         return true;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // old text format, one "hash string" pair per line
+      void LoadTextFile(const std::string& path)
+      {
+         std::ifstream indbstr(path.c_str());
          if(!indbstr.fail()) 
          {
            while(indbstr.good() )
@@ -64,48 +514,42 @@ namespace dtEntity
               unsigned int hash; 
               ss >> hash;
               std::string text = line.substr(offset + 1, line.length() - 1);
-              mReverseLookup[hash] = text;
+              Insert(hash, text.c_str(), text.size(), true);
            }
          }
-         mReverseLookup[0] = "";
-      }
-
-      ////////////////////////////////////////////////////////////////////////////////
-      static unsigned int Hash(const std::string& str)
-      {
-         const unsigned char* s = reinterpret_cast<const unsigned char*>(str.c_str());
-         unsigned int hash;
-         MurmurHash3_x86_32(s, static_cast<int>(str.size()), 0, &hash);
-         return hash;
       }
 
       ////////////////////////////////////////////////////////////////////////////////
-      void AddToReverseLookup(const std::string& str, unsigned int hash)
+      void FlushLiterals()
       {
+         if(GetNumPendingLiterals() == 0)
          {
-            OpenThreads::ScopedReadLock rlock(mMutex);
-            if(mReverseLookup.find(hash) != mReverseLookup.end())
-            {
-               return;
-            }
+            return;
+         }
+         std::vector<PendingLiteral> pending;
+         {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(GetPendingLiteralsMutex());
+            pending.swap(GetPendingLiterals());
+            GetNumPendingLiterals().exchange(0);
+         }
+         // copy strings, literals of plugin libraries are unmapped when the plugin is unloaded
+         for(std::vector<PendingLiteral>::const_iterator i = pending.begin(); i != pending.end(); ++i)
+         {
+            Insert(i->mHash, i->mString, strlen(i->mString), true);
          }
-         OpenThreads::ScopedWriteLock wlock(mMutex);
-         mReverseLookup[hash] = str;
       }
 
       ////////////////////////////////////////////////////////////////////////////////
-      // Warning: slow! Does a linear search over all strings!
       std::string ReverseLookup(unsigned int hash)
       {
-         OpenThreads::ScopedReadLock lock(mMutex);
-         ReverseLookupMap::const_iterator i = mReverseLookup.find(hash);         
-         if(i != mReverseLookup.end())
-            return i->second;
+         FlushLiterals();
+         const char* str = GetShard(hash).GetTable()->Find(hash);
+         if(str != NULL)
+            return str;
          return "<String not found>";
       }
    };
 
-
    ////////////////////////////////////////////////////////////////////////////////
    StringId SID(const std::string& str)
    {
@@ -149,6 +593,34 @@ namespace dtEntity
 #endif      
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   void AddStringIdLiteral(unsigned int hash, const char* str)
+   {
+      PendingLiteral p;
+      p.mHash = hash;
+      p.mString = str;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(GetPendingLiteralsMutex());
+      GetPendingLiterals().push_back(p);
+      ++GetNumPendingLiterals();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void FlushStringIdLiterals()
+   {
+      StringIdManager::GetInstance().FlushLiterals();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool LoadStringIdFile(const std::string& path)
+   {
+      if(!StringIdManager::GetInstance().LoadFile(path))
+      {
+         LOG_WARNING("Could not load string id file " << path);
+         return false;
+      }
+      return true;
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    unsigned int SIDToUInt(StringId v)
    {
@@ -63,9 +63,9 @@ namespace dtEntity
             
    }
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType CameraAddedMessage::TYPE(dtEntity::SID("CameraAddedMessage"));
-   const StringId CameraAddedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId CameraAddedMessage::ContextIdId(dtEntity::SID("ContextId"));
+   const MessageType CameraAddedMessage::TYPE(SID_LITERAL("CameraAddedMessage"));
+   const StringId CameraAddedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId CameraAddedMessage::ContextIdId(SID_LITERAL("ContextId"));
 
    CameraAddedMessage::CameraAddedMessage()
       : Message(TYPE)
@@ -75,8 +75,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType CameraRemovedMessage::TYPE(dtEntity::SID("CameraRemovedMessage"));
-   const StringId CameraRemovedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const MessageType CameraRemovedMessage::TYPE(SID_LITERAL("CameraRemovedMessage"));
+   const StringId CameraRemovedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    CameraRemovedMessage::CameraRemovedMessage()
       : Message(TYPE)
@@ -85,8 +85,8 @@ namespace dtEntity
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-   const MessageType InternalCloseWindowMessage::TYPE(dtEntity::SID("InternalCloseWindowMessage"));
-   const StringId InternalCloseWindowMessage::NameId(dtEntity::SID("Name"));
+   const MessageType InternalCloseWindowMessage::TYPE(SID_LITERAL("InternalCloseWindowMessage"));
+   const StringId InternalCloseWindowMessage::NameId(SID_LITERAL("Name"));
 
    InternalCloseWindowMessage::InternalCloseWindowMessage()
       : Message(TYPE)
@@ -95,7 +95,7 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EndOfFrameMessage::TYPE(dtEntity::SID("EndOfFrameMessage"));
+   const MessageType EndOfFrameMessage::TYPE(SID_LITERAL("EndOfFrameMessage"));
 
    EndOfFrameMessage::EndOfFrameMessage()
       : TickMessage(TYPE)
@@ -103,7 +103,7 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType PostUpdateMessage::TYPE(dtEntity::SID("PostUpdateMessage"));
+   const MessageType PostUpdateMessage::TYPE(SID_LITERAL("PostUpdateMessage"));
 
    PostUpdateMessage::PostUpdateMessage()
       : TickMessage(TYPE)
@@ -111,12 +111,12 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntityAddedToSceneMessage::TYPE(dtEntity::SID("EntityAddedToSceneMessage"));
-   const StringId EntityAddedToSceneMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId EntityAddedToSceneMessage::EntityNameId(dtEntity::SID("EntityName"));
-   const StringId EntityAddedToSceneMessage::UniqueIdId(dtEntity::SID("UniqueId"));
-   const StringId EntityAddedToSceneMessage::MapNameId(dtEntity::SID("MapName"));
-   const StringId EntityAddedToSceneMessage::VisibleInEntityListId(dtEntity::SID("VisibleInEntityList"));
+   const MessageType EntityAddedToSceneMessage::TYPE(SID_LITERAL("EntityAddedToSceneMessage"));
+   const StringId EntityAddedToSceneMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId EntityAddedToSceneMessage::EntityNameId(SID_LITERAL("EntityName"));
+   const StringId EntityAddedToSceneMessage::UniqueIdId(SID_LITERAL("UniqueId"));
+   const StringId EntityAddedToSceneMessage::MapNameId(SID_LITERAL("MapName"));
+   const StringId EntityAddedToSceneMessage::VisibleInEntityListId(SID_LITERAL("VisibleInEntityList"));
 
    EntityAddedToSceneMessage::EntityAddedToSceneMessage()
       : Message(TYPE)
@@ -129,8 +129,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntityDeselectedMessage::TYPE(dtEntity::SID("EntityDeselectedMessage"));
-   const StringId EntityDeselectedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const MessageType EntityDeselectedMessage::TYPE(SID_LITERAL("EntityDeselectedMessage"));
+   const StringId EntityDeselectedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    EntityDeselectedMessage::EntityDeselectedMessage()
       : Message(TYPE)
@@ -139,10 +139,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntityNameUpdatedMessage::TYPE(dtEntity::SID("EntityNameUpdatedMessage"));
-   const StringId EntityNameUpdatedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId EntityNameUpdatedMessage::EntityNameId(dtEntity::SID("EntityName"));
-   const StringId EntityNameUpdatedMessage::UniqueIdId(dtEntity::SID("UniqueId"));
+   const MessageType EntityNameUpdatedMessage::TYPE(SID_LITERAL("EntityNameUpdatedMessage"));
+   const StringId EntityNameUpdatedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId EntityNameUpdatedMessage::EntityNameId(SID_LITERAL("EntityName"));
+   const StringId EntityNameUpdatedMessage::UniqueIdId(SID_LITERAL("UniqueId"));
 
    EntityNameUpdatedMessage::EntityNameUpdatedMessage()
       : Message(TYPE)
@@ -153,12 +153,12 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntityRemovedFromSceneMessage::TYPE(dtEntity::SID("EntityRemovedFromSceneMessage"));
-   const StringId EntityRemovedFromSceneMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId EntityRemovedFromSceneMessage::EntityNameId(dtEntity::SID("EntityName"));
-   const StringId EntityRemovedFromSceneMessage::UniqueIdId(dtEntity::SID("UniqueId"));
-   const StringId EntityRemovedFromSceneMessage::MapNameId(dtEntity::SID("MapName"));
-   const StringId EntityRemovedFromSceneMessage::VisibleInEntityListId(dtEntity::SID("VisibleInEntityList"));
+   const MessageType EntityRemovedFromSceneMessage::TYPE(SID_LITERAL("EntityRemovedFromSceneMessage"));
+   const StringId EntityRemovedFromSceneMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId EntityRemovedFromSceneMessage::EntityNameId(SID_LITERAL("EntityName"));
+   const StringId EntityRemovedFromSceneMessage::UniqueIdId(SID_LITERAL("UniqueId"));
+   const StringId EntityRemovedFromSceneMessage::MapNameId(SID_LITERAL("MapName"));
+   const StringId EntityRemovedFromSceneMessage::VisibleInEntityListId(SID_LITERAL("VisibleInEntityList"));
 
    EntityRemovedFromSceneMessage::EntityRemovedFromSceneMessage()
       : Message(TYPE)
@@ -171,8 +171,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntitySelectedMessage::TYPE(dtEntity::SID("EntitySelectedMessage"));
-   const StringId EntitySelectedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const MessageType EntitySelectedMessage::TYPE(SID_LITERAL("EntitySelectedMessage"));
+   const StringId EntitySelectedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    EntitySelectedMessage::EntitySelectedMessage()
       : Message(TYPE)
@@ -181,9 +181,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntitySpawnedMessage::TYPE(dtEntity::SID("EntitySpawnedMessage"));
-   const StringId EntitySpawnedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId EntitySpawnedMessage::SpawnerNameId(dtEntity::SID("SpawnerName"));
+   const MessageType EntitySpawnedMessage::TYPE(SID_LITERAL("EntitySpawnedMessage"));
+   const StringId EntitySpawnedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId EntitySpawnedMessage::SpawnerNameId(SID_LITERAL("SpawnerName"));
 
    EntitySpawnedMessage::EntitySpawnedMessage()
       : Message(TYPE)
@@ -193,9 +193,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntitySystemAddedMessage::TYPE(dtEntity::SID("EntitySystemAddedMessage"));
-   const StringId EntitySystemAddedMessage::ComponentTypeId(dtEntity::SID("ComponentType"));
-   const StringId EntitySystemAddedMessage::ComponentTypeStringId(dtEntity::SID("ComponentTypeString"));
+   const MessageType EntitySystemAddedMessage::TYPE(SID_LITERAL("EntitySystemAddedMessage"));
+   const StringId EntitySystemAddedMessage::ComponentTypeId(SID_LITERAL("ComponentType"));
+   const StringId EntitySystemAddedMessage::ComponentTypeStringId(SID_LITERAL("ComponentTypeString"));
 
    EntitySystemAddedMessage::EntitySystemAddedMessage()
       : Message(TYPE)
@@ -205,9 +205,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntitySystemRemovedMessage::TYPE(dtEntity::SID("EntitySystemRemovedMessage"));
-   const StringId EntitySystemRemovedMessage::ComponentTypeId(dtEntity::SID("ComponentType"));
-   const StringId EntitySystemRemovedMessage::ComponentTypeStringId(dtEntity::SID("ComponentTypeString"));
+   const MessageType EntitySystemRemovedMessage::TYPE(SID_LITERAL("EntitySystemRemovedMessage"));
+   const StringId EntitySystemRemovedMessage::ComponentTypeId(SID_LITERAL("ComponentType"));
+   const StringId EntitySystemRemovedMessage::ComponentTypeStringId(SID_LITERAL("ComponentTypeString"));
 
    EntitySystemRemovedMessage::EntitySystemRemovedMessage()
       : Message(TYPE)
@@ -217,9 +217,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType EntityVelocityNotNullMessage::TYPE(dtEntity::SID("EntityVelocityNotNullMessage"));
-   const StringId EntityVelocityNotNullMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId EntityVelocityNotNullMessage::IsNullId(dtEntity::SID("IsNull"));
+   const MessageType EntityVelocityNotNullMessage::TYPE(SID_LITERAL("EntityVelocityNotNullMessage"));
+   const StringId EntityVelocityNotNullMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId EntityVelocityNotNullMessage::IsNullId(SID_LITERAL("IsNull"));
 
 
    EntityVelocityNotNullMessage::EntityVelocityNotNullMessage()
@@ -230,16 +230,17 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType TickMessage::TYPE(dtEntity::SID("TickMessage"));
-   const StringId TickMessage::DeltaSimTimeId(dtEntity::SID("DeltaSimTime"));
-   const StringId TickMessage::DeltaRealTimeId(dtEntity::SID("DeltaRealTime"));
-   const StringId TickMessage::SimTimeScaleId(dtEntity::SID("SimTimeScale"));
-   const StringId TickMessage::SimulationTimeId(dtEntity::SID("SimulationTime"));
+   const MessageType TickMessage::TYPE(SID_LITERAL("TickMessage"));
+   const StringId TickMessage::DeltaSimTimeId(SID_LITERAL("DeltaSimTime"));
+   const StringId TickMessage::DeltaRealTimeId(SID_LITERAL("DeltaRealTime"));
+   const StringId TickMessage::SimTimeScaleId(SID_LITERAL("SimTimeScale"));
+   const StringId TickMessage::SimulationTimeId(SID_LITERAL("SimulationTime"));
+   PropertySchema TickMessage::sPropertySchema;
 
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType ResourceChangedMessage::TYPE(dtEntity::SID("ResourceChanged"));
-   const StringId ResourceChangedMessage::PathId(dtEntity::SID("Path"));
+   const MessageType ResourceChangedMessage::TYPE(SID_LITERAL("ResourceChanged"));
+   const StringId ResourceChangedMessage::PathId(SID_LITERAL("Path"));
    
    ResourceChangedMessage::ResourceChangedMessage()
       : Message(TYPE)
@@ -248,8 +249,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType ResourceLoadedMessage::TYPE(dtEntity::SID("ResourceLoadedMessage"));
-   const StringId ResourceLoadedMessage::PathId(dtEntity::SID("Path"));
+   const MessageType ResourceLoadedMessage::TYPE(SID_LITERAL("ResourceLoadedMessage"));
+   const StringId ResourceLoadedMessage::PathId(SID_LITERAL("Path"));
    
    ResourceLoadedMessage::ResourceLoadedMessage()
       : Message(TYPE)
@@ -258,10 +259,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SpawnerAddedMessage::TYPE(dtEntity::SID("SpawnerAddedMessage"));
-   const StringId SpawnerAddedMessage::NameId(dtEntity::SID("Name"));
-   const StringId SpawnerAddedMessage::MapNameId(dtEntity::SID("MapName"));
-   const StringId SpawnerAddedMessage::ParentNameId(dtEntity::SID("ParentName"));
+   const MessageType SpawnerAddedMessage::TYPE(SID_LITERAL("SpawnerAddedMessage"));
+   const StringId SpawnerAddedMessage::NameId(SID_LITERAL("Name"));
+   const StringId SpawnerAddedMessage::MapNameId(SID_LITERAL("MapName"));
+   const StringId SpawnerAddedMessage::ParentNameId(SID_LITERAL("ParentName"));
 
    SpawnerAddedMessage::SpawnerAddedMessage()
       : Message(TYPE)
@@ -272,11 +273,11 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SpawnerModifiedMessage::TYPE(dtEntity::SID("SpawnerModifiedMessage"));
-   const StringId SpawnerModifiedMessage::NameId(dtEntity::SID("Name"));
-   const StringId SpawnerModifiedMessage::MapNameId(dtEntity::SID("MapName"));
-   const StringId SpawnerModifiedMessage::OldCategoryId(dtEntity::SID("OldCategory"));
-   const StringId SpawnerModifiedMessage::NewCategoryId(dtEntity::SID("NewCategory"));
+   const MessageType SpawnerModifiedMessage::TYPE(SID_LITERAL("SpawnerModifiedMessage"));
+   const StringId SpawnerModifiedMessage::NameId(SID_LITERAL("Name"));
+   const StringId SpawnerModifiedMessage::MapNameId(SID_LITERAL("MapName"));
+   const StringId SpawnerModifiedMessage::OldCategoryId(SID_LITERAL("OldCategory"));
+   const StringId SpawnerModifiedMessage::NewCategoryId(SID_LITERAL("NewCategory"));
 
    SpawnerModifiedMessage::SpawnerModifiedMessage()
       : Message(TYPE)
@@ -288,10 +289,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SpawnerRemovedMessage::TYPE(dtEntity::SID("SpawnerRemovedMessage"));
-   const StringId SpawnerRemovedMessage::NameId(dtEntity::SID("Name"));
-   const StringId SpawnerRemovedMessage::MapNameId(dtEntity::SID("MapName"));
-   const StringId SpawnerRemovedMessage::CategoryId(dtEntity::SID("Category"));
+   const MessageType SpawnerRemovedMessage::TYPE(SID_LITERAL("SpawnerRemovedMessage"));
+   const StringId SpawnerRemovedMessage::NameId(SID_LITERAL("Name"));
+   const StringId SpawnerRemovedMessage::MapNameId(SID_LITERAL("MapName"));
+   const StringId SpawnerRemovedMessage::CategoryId(SID_LITERAL("Category"));
 
    SpawnerRemovedMessage::SpawnerRemovedMessage()
       : Message(TYPE)
@@ -302,10 +303,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MapBeginLoadMessage::TYPE(dtEntity::SID("MapBeginLoadMessage"));
-   const StringId MapBeginLoadMessage::MapPathId(dtEntity::SID("MapPath"));
-   const StringId MapBeginLoadMessage::DataPathId(dtEntity::SID("DataPath"));
-   const StringId MapBeginLoadMessage::SaveOrderId(dtEntity::SID("SaveOrder"));
+   const MessageType MapBeginLoadMessage::TYPE(SID_LITERAL("MapBeginLoadMessage"));
+   const StringId MapBeginLoadMessage::MapPathId(SID_LITERAL("MapPath"));
+   const StringId MapBeginLoadMessage::DataPathId(SID_LITERAL("DataPath"));
+   const StringId MapBeginLoadMessage::SaveOrderId(SID_LITERAL("SaveOrder"));
 
    MapBeginLoadMessage::MapBeginLoadMessage()
       : Message(TYPE)
@@ -316,8 +317,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MapBeginUnloadMessage::TYPE(dtEntity::SID("MapBeginUnloadMessage"));
-   const StringId MapBeginUnloadMessage::MapPathId(dtEntity::SID("MapPath"));
+   const MessageType MapBeginUnloadMessage::TYPE(SID_LITERAL("MapBeginUnloadMessage"));
+   const StringId MapBeginUnloadMessage::MapPathId(SID_LITERAL("MapPath"));
 
    MapBeginUnloadMessage::MapBeginUnloadMessage()
       : Message(TYPE)
@@ -326,10 +327,10 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MapLoadedMessage::TYPE(dtEntity::SID("MapLoadedMessage"));
-   const StringId MapLoadedMessage::MapPathId(dtEntity::SID("MapPath"));
-   const StringId MapLoadedMessage::DataPathId(dtEntity::SID("DataPath"));
-   const StringId MapLoadedMessage::SaveOrderId(dtEntity::SID("SaveOrder"));
+   const MessageType MapLoadedMessage::TYPE(SID_LITERAL("MapLoadedMessage"));
+   const StringId MapLoadedMessage::MapPathId(SID_LITERAL("MapPath"));
+   const StringId MapLoadedMessage::DataPathId(SID_LITERAL("DataPath"));
+   const StringId MapLoadedMessage::SaveOrderId(SID_LITERAL("SaveOrder"));
 
    MapLoadedMessage::MapLoadedMessage()
       : Message(TYPE)
@@ -340,8 +341,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MapUnloadedMessage::TYPE(dtEntity::SID("MapUnloadedMessage"));
-   const StringId MapUnloadedMessage::MapPathId(dtEntity::SID("MapPath"));
+   const MessageType MapUnloadedMessage::TYPE(SID_LITERAL("MapUnloadedMessage"));
+   const StringId MapUnloadedMessage::MapPathId(SID_LITERAL("MapPath"));
 
    MapUnloadedMessage::MapUnloadedMessage()
       : Message(TYPE)
@@ -350,9 +351,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType MeshChangedMessage::TYPE(dtEntity::SID("MeshChangedMessage"));
-   const StringId MeshChangedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId MeshChangedMessage::FilePathId(dtEntity::SID("FilePathId"));
+   const MessageType MeshChangedMessage::TYPE(SID_LITERAL("MeshChangedMessage"));
+   const StringId MeshChangedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId MeshChangedMessage::FilePathId(SID_LITERAL("FilePathId"));
 
    MeshChangedMessage::MeshChangedMessage()
       : Message(TYPE)
@@ -362,8 +363,8 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SceneLoadedMessage::TYPE(dtEntity::SID("SceneLoadedMessage"));
-   const StringId SceneLoadedMessage::SceneNameId(dtEntity::SID("SceneName"));
+   const MessageType SceneLoadedMessage::TYPE(SID_LITERAL("SceneLoadedMessage"));
+   const StringId SceneLoadedMessage::SceneNameId(SID_LITERAL("SceneName"));
 
     SceneLoadedMessage::SceneLoadedMessage()
       : Message(TYPE)
@@ -372,7 +373,7 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType SceneUnloadedMessage::TYPE(dtEntity::SID("SceneUnloadedMessage"));
+   const MessageType SceneUnloadedMessage::TYPE(SID_LITERAL("SceneUnloadedMessage"));
 
    SceneUnloadedMessage::SceneUnloadedMessage()
       : Message(TYPE)
@@ -380,7 +381,7 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType StartSystemMessage::TYPE(dtEntity::SID("StartSystemMessage"));
+   const MessageType StartSystemMessage::TYPE(SID_LITERAL("StartSystemMessage"));
 
    StartSystemMessage::StartSystemMessage()
       : Message(TYPE)
@@ -388,7 +389,7 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType StopSystemMessage::TYPE(dtEntity::SID("StopSystemMessage"));
+   const MessageType StopSystemMessage::TYPE(SID_LITERAL("StopSystemMessage"));
 
    StopSystemMessage::StopSystemMessage()
       : Message(TYPE)
@@ -399,26 +400,44 @@ namespace dtEntity
    TickMessage::TickMessage() 
       : Message(TYPE)
    {
-      this->Register(DeltaSimTimeId, &mDeltaSimTime);
-      this->Register(DeltaRealTimeId, &mDeltaRealTime);
-      this->Register(SimTimeScaleId, &mSimTimeScale);
-      this->Register(SimulationTimeId, &mSimulationTime);
+      this->Register(sPropertySchema, DeltaSimTimeId, &mDeltaSimTime);
+      this->Register(sPropertySchema, DeltaRealTimeId, &mDeltaRealTime);
+      this->Register(sPropertySchema, SimTimeScaleId, &mSimTimeScale);
+      this->Register(sPropertySchema, SimulationTimeId, &mSimulationTime);
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    TickMessage::TickMessage(MessageType t) 
       : Message(t)
    {
-      this->Register(DeltaSimTimeId, &mDeltaSimTime);
-      this->Register(DeltaRealTimeId, &mDeltaRealTime);
-      this->Register(SimTimeScaleId, &mSimTimeScale);
-      this->Register(SimulationTimeId, &mSimulationTime);
+      this->Register(sPropertySchema, DeltaSimTimeId, &mDeltaSimTime);
+      this->Register(sPropertySchema, DeltaRealTimeId, &mDeltaRealTime);
+      this->Register(sPropertySchema, SimTimeScaleId, &mSimTimeScale);
+      this->Register(sPropertySchema, SimulationTimeId, &mSimulationTime);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void TickMessage::SetData(const TickData& d)
+   {
+      mDeltaSimTime.Set(d.mDeltaSimTime);
+      mDeltaRealTime.Set(d.mDeltaRealTime);
+      mSimTimeScale.Set(d.mSimTimeScale);
+      mSimulationTime.Set(d.mSimulationTime);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void TickMessage::GetData(TickData& d) const
+   {
+      d.mDeltaSimTime = mDeltaSimTime.Get();
+      d.mDeltaRealTime = mDeltaRealTime.Get();
+      d.mSimTimeScale = mSimTimeScale.Get();
+      d.mSimulationTime = mSimulationTime.Get();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType TimeChangedMessage::TYPE(dtEntity::SID("TimeChangedMessage"));
-   const StringId TimeChangedMessage::SimulationTimeId(dtEntity::SID("SimulationTime"));
-   const StringId TimeChangedMessage::TimeScaleId(dtEntity::SID("TimeScale"));
+   const MessageType TimeChangedMessage::TYPE(SID_LITERAL("TimeChangedMessage"));
+   const StringId TimeChangedMessage::SimulationTimeId(SID_LITERAL("SimulationTime"));
+   const StringId TimeChangedMessage::TimeScaleId(SID_LITERAL("TimeScale"));
    
    TimeChangedMessage::TimeChangedMessage() 
       : Message(TYPE)
@@ -428,9 +447,9 @@ namespace dtEntity
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const MessageType VisibilityChangedMessage::TYPE(dtEntity::SID("VisibilityChangedMessage"));
-   const StringId VisibilityChangedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
-   const StringId VisibilityChangedMessage::VisibleId(dtEntity::SID("Visible"));
+   const MessageType VisibilityChangedMessage::TYPE(SID_LITERAL("VisibilityChangedMessage"));
+   const StringId VisibilityChangedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
+   const StringId VisibilityChangedMessage::VisibleId(SID_LITERAL("Visible"));
 
    VisibilityChangedMessage::VisibilityChangedMessage()
       : Message(TYPE)
@@ -440,10 +459,10 @@ namespace dtEntity
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-   const MessageType WindowCreatedMessage::TYPE(dtEntity::SID("WindowCreatedMessage"));
-   const StringId WindowCreatedMessage::NameId(dtEntity::SID("Name"));
-   const StringId WindowCreatedMessage::ContextIdId(dtEntity::SID("ContextId"));
-   const StringId WindowCreatedMessage::CameraEntityIdId(dtEntity::SID("CameraEntityId"));
+   const MessageType WindowCreatedMessage::TYPE(SID_LITERAL("WindowCreatedMessage"));
+   const StringId WindowCreatedMessage::NameId(SID_LITERAL("Name"));
+   const StringId WindowCreatedMessage::ContextIdId(SID_LITERAL("ContextId"));
+   const StringId WindowCreatedMessage::CameraEntityIdId(SID_LITERAL("CameraEntityId"));
    
    WindowCreatedMessage::WindowCreatedMessage() 
       : Message(TYPE)
@@ -454,8 +473,8 @@ namespace dtEntity
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-   const MessageType WindowClosedMessage::TYPE(dtEntity::SID("WindowClosedMessage"));
-   const StringId WindowClosedMessage::NameId(dtEntity::SID("Name"));
+   const MessageType WindowClosedMessage::TYPE(SID_LITERAL("WindowClosedMessage"));
+   const StringId WindowClosedMessage::NameId(SID_LITERAL("Name"));
    
    WindowClosedMessage::WindowClosedMessage() 
       : Message(TYPE)
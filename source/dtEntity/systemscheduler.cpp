@@ -0,0 +1,337 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/systemscheduler.h>
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/entitysystem.h>
+#include <OpenThreads/Atomic>
+#include <algorithm>
+
+namespace dtEntity
+{
+   namespace
+   {
+      // true if sorted vectors have a common element
+      bool Intersects(const std::vector<ComponentType>& a, const std::vector<ComponentType>& b)
+      {
+         std::vector<ComponentType>::const_iterator i = a.begin();
+         std::vector<ComponentType>::const_iterator j = b.begin();
+         while(i != a.end() && j != b.end())
+         {
+            if(*i < *j)
+            {
+               ++i;
+            }
+            else if(*j < *i)
+            {
+               ++j;
+            }
+            else
+            {
+               return true;
+            }
+         }
+         return false;
+      }
+
+      void SortUnique(std::vector<ComponentType>& v)
+      {
+         std::sort(v.begin(), v.end());
+         v.erase(std::unique(v.begin(), v.end()), v.end());
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   class SystemScheduler::Task : public PoolTask
+   {
+   public:
+
+      Task(SystemScheduler& scheduler, const std::string& name, const TickFunctor& ftr, bool exclusive)
+         : mScheduler(&scheduler)
+         , mName(name)
+         , mFunctor(ftr)
+         , mExclusive(exclusive)
+         , mNumPredecessors(0)
+      {
+      }
+
+      virtual void Execute(WorkStealingPool& pool, unsigned int workerIndex)
+      {
+         Run(*mScheduler->mTickData);
+
+         // start tasks that waited only for this one
+         for(std::vector<Task*>::iterator i = mSuccessors.begin(); i != mSuccessors.end(); ++i)
+         {
+            if(--(*i)->mPending == 0)
+            {
+               pool.Push(*i, workerIndex);
+            }
+         }
+      }
+
+      void Run(const TickData& data)
+      {
+         MessagePump* pump = mScheduler->mMessagePump;
+         if(mExclusive || pump == NULL)
+         {
+            mFunctor(data);
+            return;
+         }
+         pump->BeginNoEmitSection();
+         mFunctor(data);
+         pump->EndNoEmitSection();
+      }
+
+      SystemScheduler* mScheduler;
+      std::string mName;
+      TickFunctor mFunctor;
+      bool mExclusive;
+
+      // sorted component types
+      std::vector<ComponentType> mReads;
+      std::vector<ComponentType> mWrites;
+
+      // conflicting tasks that were added later
+      std::vector<Task*> mSuccessors;
+      unsigned int mNumPredecessors;
+
+      // predecessors that did not finish yet in current tick
+      OpenThreads::Atomic mPending;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   SystemScheduler::SystemScheduler(unsigned int numThreads)
+      : mGraphDirty(false)
+      , mCriticalPathLength(0)
+      , mTickData(NULL)
+      , mMessagePump(NULL)
+      , mPool(numThreads)
+      , mEntityManager(NULL)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   SystemScheduler::~SystemScheduler()
+   {
+      Detach();
+      for(std::vector<Task*>::iterator i = mTasks.begin(); i != mTasks.end(); ++i)
+      {
+         delete *i;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::AddTask(const std::string& name, const TickFunctor& ftr,
+      const std::vector<ComponentType>& reads, const std::vector<ComponentType>& writes)
+   {
+      Task* task = new Task(*this, name, ftr, false);
+      task->mReads = reads;
+      task->mWrites = writes;
+      SortUnique(task->mReads);
+      SortUnique(task->mWrites);
+      mTasks.push_back(task);
+      mGraphDirty = true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::AddExclusiveTask(const std::string& name, const TickFunctor& ftr)
+   {
+      mTasks.push_back(new Task(*this, name, ftr, true));
+      mGraphDirty = true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::AddSystemTask(const EntitySystem& es, const std::string& name, const TickFunctor& ftr)
+   {
+      std::vector<ComponentType> reads, writes;
+      if(es.GetComponentAccess(reads, writes))
+      {
+         AddTask(name, ftr, reads, writes);
+      }
+      else
+      {
+         AddExclusiveTask(name, ftr);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool SystemScheduler::RemoveTask(const TickFunctor& ftr)
+   {
+      for(std::vector<Task*>::iterator i = mTasks.begin(); i != mTasks.end(); ++i)
+      {
+         if((*i)->mFunctor == ftr)
+         {
+            delete *i;
+            mTasks.erase(i);
+            mGraphDirty = true;
+            return true;
+         }
+      }
+      return false;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool SystemScheduler::Conflicts(const Task& a, const Task& b)
+   {
+      return a.mExclusive || b.mExclusive ||
+             Intersects(a.mWrites, b.mWrites) ||
+             Intersects(a.mWrites, b.mReads) ||
+             Intersects(a.mReads, b.mWrites);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::BuildGraph()
+   {
+      for(std::vector<Task*>::iterator i = mTasks.begin(); i != mTasks.end(); ++i)
+      {
+         (*i)->mSuccessors.clear();
+         (*i)->mNumPredecessors = 0;
+      }
+
+      mPhases.clear();
+      mPhases.push_back(Phase());
+      mPhases.back().mExclusive = NULL;
+      for(std::vector<Task*>::iterator i = mTasks.begin(); i != mTasks.end(); ++i)
+      {
+         // exclusive task ends phase, it conflicts with all tasks before and after
+         if((*i)->mExclusive)
+         {
+            mPhases.back().mExclusive = *i;
+            mPhases.push_back(Phase());
+            mPhases.back().mExclusive = NULL;
+         }
+         else
+         {
+            mPhases.back().mTasks.push_back(*i);
+         }
+      }
+
+      mCriticalPathLength = 0;
+      for(std::vector<Phase>::iterator p = mPhases.begin(); p != mPhases.end(); ++p)
+      {
+         // tasks added later depend on conflicting tasks added before them
+         std::vector<Task*>& tasks = p->mTasks;
+         std::vector<unsigned int> depth(tasks.size(), 1);
+         p->mCriticalPathLength = 0;
+         for(unsigned int j = 0; j < tasks.size(); ++j)
+         {
+            for(unsigned int i = 0; i < j; ++i)
+            {
+               if(Conflicts(*tasks[i], *tasks[j]))
+               {
+                  tasks[i]->mSuccessors.push_back(tasks[j]);
+                  ++tasks[j]->mNumPredecessors;
+                  depth[j] = std::max(depth[j], depth[i] + 1);
+               }
+            }
+            if(tasks[j]->mNumPredecessors == 0)
+            {
+               p->mRoots.push_back(tasks[j]);
+            }
+            p->mCriticalPathLength = std::max(p->mCriticalPathLength, depth[j]);
+         }
+         mCriticalPathLength += p->mCriticalPathLength;
+         if(p->mExclusive != NULL)
+         {
+            ++mCriticalPathLength;
+         }
+      }
+      mGraphDirty = false;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int SystemScheduler::GetCriticalPathLength()
+   {
+      if(mGraphDirty)
+      {
+         BuildGraph();
+      }
+      return mCriticalPathLength;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::Tick(const TickData& data)
+   {
+      if(mGraphDirty)
+      {
+         BuildGraph();
+      }
+
+      for(std::vector<Phase>::iterator p = mPhases.begin(); p != mPhases.end(); ++p)
+      {
+         // run in order of addition if nothing can run concurrently
+         if(mPool.GetNumThreads() == 1 || p->mCriticalPathLength == p->mTasks.size())
+         {
+            for(std::vector<Task*>::iterator i = p->mTasks.begin(); i != p->mTasks.end(); ++i)
+            {
+               (*i)->Run(data);
+            }
+         }
+         else
+         {
+            for(std::vector<Task*>::iterator i = p->mTasks.begin(); i != p->mTasks.end(); ++i)
+            {
+               (*i)->mPending.exchange((*i)->mNumPredecessors);
+            }
+            mTickData = &data;
+            mPool.Run(p->mRoots);
+            mTickData = NULL;
+         }
+
+         // exclusive tasks may use thread affine resources like script
+         // contexts, run them on the thread emitting the tick
+         if(p->mExclusive != NULL)
+         {
+            p->mExclusive->Run(data);
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::Attach(EntityManager& em, unsigned int options)
+   {
+      Detach();
+      if(em.GetSystemScheduler() != NULL)
+      {
+         // only one scheduler can run the system tick handlers
+         em.GetSystemScheduler()->Detach();
+      }
+      mEntityManager = &em;
+      mMessagePump = &em.GetMessagePump();
+      mTickFunctor = TickFunctor(this, &SystemScheduler::Tick);
+      em.RegisterForTypedMessages<TickData>(mTickFunctor, options, "SystemScheduler::Tick");
+      em.SetSystemScheduler(this);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SystemScheduler::Detach()
+   {
+      if(mEntityManager != NULL)
+      {
+         mEntityManager->SetSystemScheduler(NULL);
+         mEntityManager->UnregisterForTypedMessages<TickData>(mTickFunctor);
+         mEntityManager = NULL;
+         mMessagePump = NULL;
+      }
+   }
+}
@@ -0,0 +1,202 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include <dtEntity/workstealingpool.h>
+
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+
+namespace dtEntity
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   class PoolWorkerThread : public OpenThreads::Thread
+   {
+   public:
+
+      PoolWorkerThread(WorkStealingPool& pool, unsigned int index)
+         : mPool(&pool)
+         , mIndex(index)
+      {
+      }
+
+      virtual void run()
+      {
+         while(mPool->WaitForWork())
+         {
+            // spin while tasks of current run are pending
+            while(mPool->IsRunning())
+            {
+               if(!mPool->ExecuteTask(mIndex))
+               {
+                  OpenThreads::Thread::YieldCurrentThread();
+               }
+            }
+         }
+      }
+
+   private:
+      WorkStealingPool* mPool;
+      unsigned int mIndex;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   WorkStealingPool::WorkStealingPool(unsigned int numThreads)
+      : mQuit(false)
+   {
+      if(numThreads == 0)
+      {
+         numThreads = OpenThreads::GetNumberOfProcessors();
+         if(numThreads == 0)
+         {
+            numThreads = 1;
+         }
+      }
+
+      for(unsigned int i = 0; i < numThreads; ++i)
+      {
+         mQueues.push_back(new TaskQueue());
+      }
+
+      // worker 0 is the thread calling Run
+      for(unsigned int i = 1; i < numThreads; ++i)
+      {
+         PoolWorkerThread* t = new PoolWorkerThread(*this, i);
+         mThreads.push_back(t);
+         t->start();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   WorkStealingPool::~WorkStealingPool()
+   {
+      mWakeMutex.lock();
+      mQuit = true;
+      mWakeCondition.broadcast();
+      mWakeMutex.unlock();
+
+      for(std::vector<PoolWorkerThread*>::iterator i = mThreads.begin(); i != mThreads.end(); ++i)
+      {
+         (*i)->join();
+         delete *i;
+      }
+      for(std::vector<TaskQueue*>::iterator i = mQueues.begin(); i != mQueues.end(); ++i)
+      {
+         delete *i;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void WorkStealingPool::Push(PoolTask* task, unsigned int workerIndex)
+   {
+      // count before task can be taken, else Run may see no pending tasks
+      ++mPending;
+      TaskQueue& q = *mQueues[workerIndex];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(q.mMutex);
+      q.mTasks.push_back(task);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   PoolTask* WorkStealingPool::TakeTask(unsigned int workerIndex)
+   {
+      // newest task from own queue, its data is likely still in cache
+      {
+         TaskQueue& q = *mQueues[workerIndex];
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(q.mMutex);
+         if(!q.mTasks.empty())
+         {
+            PoolTask* t = q.mTasks.back();
+            q.mTasks.pop_back();
+            return t;
+         }
+      }
+
+      // steal oldest task of another thread
+      unsigned int numQueues = static_cast<unsigned int>(mQueues.size());
+      for(unsigned int i = 1; i < numQueues; ++i)
+      {
+         TaskQueue& q = *mQueues[(workerIndex + i) % numQueues];
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(q.mMutex);
+         if(!q.mTasks.empty())
+         {
+            PoolTask* t = q.mTasks.front();
+            q.mTasks.pop_front();
+            return t;
+         }
+      }
+      return NULL;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool WorkStealingPool::ExecuteTask(unsigned int workerIndex)
+   {
+      PoolTask* t = TakeTask(workerIndex);
+      if(t == NULL)
+      {
+         return false;
+      }
+      t->Execute(*this, workerIndex);
+
+      // decrement after execution, tasks pushed by t are already counted
+      --mPending;
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool WorkStealingPool::WaitForWork()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWakeMutex);
+      while(!mQuit && mRunning == 0)
+      {
+         mWakeCondition.wait(&mWakeMutex);
+      }
+      return !mQuit;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void WorkStealingPool::Run(const std::vector<PoolTask*>& tasks)
+   {
+      if(tasks.empty())
+      {
+         return;
+      }
+      for(std::vector<PoolTask*>::const_iterator i = tasks.begin(); i != tasks.end(); ++i)
+      {
+         Push(*i, 0);
+      }
+
+      if(!mThreads.empty())
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWakeMutex);
+         mRunning.exchange(1);
+         mWakeCondition.broadcast();
+      }
+
+      while(mPending != 0)
+      {
+         if(!ExecuteTask(0))
+         {
+            OpenThreads::Thread::YieldCurrentThread();
+         }
+      }
+      mRunning.exchange(0);
+   }
+}
@@ -35,13 +35,13 @@ namespace dtEntityAudio
 {
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId SoundComponent::TYPE(dtEntity::SID("Sound"));
-   const dtEntity::StringId SoundComponent::SoundPathId(dtEntity::SID("SoundPath"));
-   const dtEntity::StringId SoundComponent::AutoPlayId(dtEntity::SID("AutoPlay"));
-   const dtEntity::StringId SoundComponent::GainId(dtEntity::SID("Gain"));
-   const dtEntity::StringId SoundComponent::PitchId(dtEntity::SID("Pitch"));
-   const dtEntity::StringId SoundComponent::RollOffId(dtEntity::SID("RollOff"));
-   const dtEntity::StringId SoundComponent::LoopingId(dtEntity::SID("Looping"));
+   const dtEntity::StringId SoundComponent::TYPE(SID_LITERAL("Sound"));
+   const dtEntity::StringId SoundComponent::SoundPathId(SID_LITERAL("SoundPath"));
+   const dtEntity::StringId SoundComponent::AutoPlayId(SID_LITERAL("AutoPlay"));
+   const dtEntity::StringId SoundComponent::GainId(SID_LITERAL("Gain"));
+   const dtEntity::StringId SoundComponent::PitchId(SID_LITERAL("Pitch"));
+   const dtEntity::StringId SoundComponent::RollOffId(SID_LITERAL("RollOff"));
+   const dtEntity::StringId SoundComponent::LoopingId(SID_LITERAL("Looping"));
    
    
    ////////////////////////////////////////////////////////////////////////////////
@@ -141,10 +141,10 @@ namespace dtEntityAudio
       }
 
       // retrieve current PAT and set it to OpenAL
-      static const dtEntity::StringId patsid = dtEntity::SID("PositionAttitudeTransform");
-      static const dtEntity::StringId matrixsid = dtEntity::SID("MatrixTransform");
-      static const dtEntity::StringId possid = dtEntity::SID("Position");
-      static const dtEntity::StringId matsid = dtEntity::SID("Matrix");
+      static const dtEntity::StringId patsid = SID_LITERAL("PositionAttitudeTransform");
+      static const dtEntity::StringId matrixsid = SID_LITERAL("MatrixTransform");
+      static const dtEntity::StringId possid = SID_LITERAL("Position");
+      static const dtEntity::StringId matsid = SID_LITERAL("Matrix");
       dtEntity::Component* comp;
       if(mOwner->GetEntityManager().GetComponent(mOwner->GetId(), patsid, comp, true))
       {
@@ -260,9 +260,9 @@ namespace dtEntityAudio
 
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId SoundSystem::TYPE(dtEntity::SID("Sound"));
-   const dtEntity::StringId SoundSystem::ListenerGainId(dtEntity::SID("ListenerGain"));
-   const dtEntity::StringId SoundSystem::ListenerEntityId(dtEntity::SID("ListenerEntity"));
+   const dtEntity::StringId SoundSystem::TYPE(SID_LITERAL("Sound"));
+   const dtEntity::StringId SoundSystem::ListenerGainId(SID_LITERAL("ListenerGain"));
+   const dtEntity::StringId SoundSystem::ListenerEntityId(SID_LITERAL("ListenerEntity"));
 
    ////////////////////////////////////////////////////////////////////////////////
    SoundSystem::SoundSystem(dtEntity::EntityManager& em)
@@ -310,8 +310,8 @@ namespace dtEntityAudio
    mLeaveWorldFunctor = dtEntity::MessageFunctor(this, &SoundSystem::OnLeaveWorld);
    em.RegisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, mLeaveWorldFunctor, "SoundSystem::OnLeaveWorld");
    
-   mTickFunctor = dtEntity::MessageFunctor(this, &SoundSystem::OnTick);
-   em.RegisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor, "SoundSystem::OnTick");
+   mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(this, &SoundSystem::OnTick);
+   em.RegisterForTick(*this, mTickFunctor, "SoundSystem::OnTick");
    
    
       dtEntityAudio::AudioManager::GetInstance().Init();
@@ -327,7 +327,7 @@ namespace dtEntityAudio
       }
       em.UnregisterForMessages(dtEntity::EntityAddedToSceneMessage::TYPE, mEnterWorldFunctor);
       em.UnregisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, mLeaveWorldFunctor);
-      em.UnregisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor);
+      em.UnregisterForTick(mTickFunctor);
       em.UnregisterForMessages(dtEntity::WindowClosedMessage::TYPE, mWindowClosedFunctor);
 
    }
@@ -364,7 +364,7 @@ namespace dtEntityAudio
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   void SoundSystem::OnTick(const dtEntity::Message& msg)
+   void SoundSystem::OnTick(const dtEntity::TickData& tm)
    {
 
       if(mComponents.empty())
@@ -373,7 +373,6 @@ namespace dtEntityAudio
       }
 
       // 2 - update sound component (set position, flush commands)
-      const dtEntity::TickMessage& tm = static_cast<const dtEntity::TickMessage&>(msg);
 
       // copy current camera position to listener...
       CopyEntityTransformToListener();
@@ -391,11 +390,25 @@ namespace dtEntityAudio
             soundObj->SetMustLoadBuffer(false);
          }
 
-         currSoundComp->Update(tm.GetDeltaSimTime());
+         currSoundComp->Update(tm.mDeltaSimTime);
       }
 
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   bool SoundSystem::GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const
+   {
+      // listener follows a transform, sound components follow their
+      // position attitude or matrix transform
+      static const dtEntity::StringId patsid = SID_LITERAL("PositionAttitudeTransform");
+      static const dtEntity::StringId matrixsid = SID_LITERAL("MatrixTransform");
+      reads.push_back(SID_LITERAL("Transform"));
+      reads.push_back(patsid);
+      reads.push_back(matrixsid);
+      writes.push_back(TYPE);
+      return true;
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    void SoundSystem::SetSoundPath(dtEntity::EntityId eid, const std::string& p)
    {
@@ -430,10 +443,10 @@ namespace dtEntityAudio
    ////////////////////////////////////////////////////////////////////////////////
    void SoundSystem::CopyEntityTransformToListener()
    {
-      static const dtEntity::StringId possid = dtEntity::SID("Position");
-      static const dtEntity::StringId attsid = dtEntity::SID("Attitude");
-      static const dtEntity::StringId eyedirsid = dtEntity::SID("EyeDirection");
-      static const dtEntity::StringId upsid = dtEntity::SID("Up");
+      static const dtEntity::StringId possid = SID_LITERAL("Position");
+      static const dtEntity::StringId attsid = SID_LITERAL("Attitude");
+      static const dtEntity::StringId eyedirsid = SID_LITERAL("EyeDirection");
+      static const dtEntity::StringId upsid = SID_LITERAL("Up");
 
       if(mListenerEntityTrans)
       {
@@ -461,7 +474,7 @@ namespace dtEntityAudio
    void SoundSystem::SetListenerEntity(dtEntity::EntityId id)  
    { 
       
-      bool success = GetEntityManager().GetComponent(id, dtEntity::SID("Transform"), mListenerEntityTrans, true);
+      bool success = GetEntityManager().GetComponent(id, SID_LITERAL("Transform"), mListenerEntityTrans, true);
       if(success)
       {  
          mListenerEntityVal = id; 
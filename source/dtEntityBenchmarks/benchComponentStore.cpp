@@ -0,0 +1,115 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/sparsecomponentstore.h>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   struct BenchComponent
+   {
+      float mValue;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // fixed seed so that all stores see the same access pattern
+   static void Shuffle(std::vector<dtEntity::EntityId>& ids)
+   {
+      unsigned int seed = 42;
+      for(size_t i = ids.size(); i > 1; --i)
+      {
+         seed = seed * 1664525u + 1013904223u;
+         std::swap(ids[i - 1], ids[seed % i]);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   template<class Store>
+   void BenchmarkStore(const std::string& storeName, unsigned int numComponents)
+   {
+      std::vector<BenchComponent> components(numComponents);
+      std::vector<dtEntity::EntityId> ids(numComponents);
+      for(unsigned int i = 0; i < numComponents; ++i)
+      {
+         // entity ids start at 1
+         ids[i] = i + 1;
+         components[i].mValue = 1.0f;
+      }
+
+      std::ostringstream os;
+      os << storeName << " " << numComponents;
+
+      Store store;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numComponents; ++i)
+      {
+         store[ids[i]] = &components[i];
+      }
+      Report(os.str() + " insert", numComponents, watch.GetElapsedSeconds());
+
+      const unsigned int iterations = 10;
+      float sum = 0;
+      watch.Start();
+      for(unsigned int j = 0; j < iterations; ++j)
+      {
+         for(typename Store::iterator i = store.begin(); i != store.end(); ++i)
+         {
+            sum += i->second->mValue;
+         }
+      }
+      Report(os.str() + " iterate", numComponents * iterations, watch.GetElapsedSeconds());
+
+      Shuffle(ids);
+
+      watch.Start();
+      for(unsigned int i = 0; i < numComponents; ++i)
+      {
+         typename Store::iterator found = store.find(ids[i]);
+         sum += found->second->mValue;
+      }
+      Report(os.str() + " random lookup", numComponents, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numComponents; ++i)
+      {
+         store.erase(store.find(ids[i]));
+      }
+      Report(os.str() + " erase", numComponents, watch.GetElapsedSeconds());
+
+      DoNotOptimize(&sum);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(ComponentStore)
+   {
+      unsigned int sizes[] = { 10000, 100000, 1000000 };
+      for(unsigned int i = 0; i < 3; ++i)
+      {
+         BenchmarkStore<dtEntity::ComponentStoreMap<BenchComponent> >("ComponentStoreMap", sizes[i]);
+         BenchmarkStore<dtEntity::ComponentStoreSparseSet<BenchComponent> >("ComponentStoreSparseSet", sizes[i]);
+      }
+   }
+}
@@ -0,0 +1,121 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/component.h>
+#include <dtEntity/componentview.h>
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+
+namespace dtEntityBenchmarks
+{
+   class ViewBenchPosition : public dtEntity::Component
+   {
+   public:
+      static const dtEntity::ComponentType TYPE;
+      ViewBenchPosition() : mValue(0) {}
+      virtual dtEntity::ComponentType GetType() const { return TYPE; }
+      float mValue;
+   };
+
+   class ViewBenchVelocity : public dtEntity::Component
+   {
+   public:
+      static const dtEntity::ComponentType TYPE;
+      ViewBenchVelocity() : mValue(1) {}
+      virtual dtEntity::ComponentType GetType() const { return TYPE; }
+      float mValue;
+   };
+
+   const dtEntity::ComponentType ViewBenchPosition::TYPE(dtEntity::SID("ViewBenchPosition"));
+   const dtEntity::ComponentType ViewBenchVelocity::TYPE(dtEntity::SID("ViewBenchVelocity"));
+
+   typedef dtEntity::DefaultEntitySystem<ViewBenchPosition> ViewBenchPositionSystem;
+   typedef dtEntity::DefaultEntitySystem<ViewBenchVelocity> ViewBenchVelocitySystem;
+   typedef dtEntity::ComponentView<ViewBenchPosition, ViewBenchVelocity> ViewBenchView;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(ComponentView)
+   {
+      const unsigned int numEntities = 100000;
+      const unsigned int iterations = 10;
+
+      dtEntity::EntityManager em;
+      ViewBenchPositionSystem* possys = new ViewBenchPositionSystem(em);
+      ViewBenchVelocitySystem* velsys = new ViewBenchVelocitySystem(em);
+      em.AddEntitySystem(*possys);
+      em.AddEntitySystem(*velsys);
+
+      // every entity has a position, every fourth has a velocity
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         dtEntity::Entity* entity = NULL;
+         em.CreateEntity(entity);
+         ViewBenchPosition* pos = NULL;
+         entity->CreateComponent(pos);
+         if(i % 4 == 0)
+         {
+            ViewBenchVelocity* vel = NULL;
+            entity->CreateComponent(vel);
+         }
+      }
+
+      Stopwatch watch;
+      for(unsigned int j = 0; j < iterations; ++j)
+      {
+         for(ViewBenchPositionSystem::ComponentStore::iterator i = possys->begin(); i != possys->end(); ++i)
+         {
+            ViewBenchVelocity* vel = NULL;
+            if(em.GetComponent(i->first, vel))
+            {
+               i->second->mValue += vel->mValue;
+            }
+         }
+      }
+      Report("Position+Velocity, iterate store and GetComponent", numEntities * iterations, watch.GetElapsedSeconds());
+
+      ViewBenchView uncached(em);
+      watch.Start();
+      for(unsigned int j = 0; j < iterations; ++j)
+      {
+         uncached.Update();
+         for(ViewBenchView::iterator i = uncached.begin(); i != uncached.end(); ++i)
+         {
+            i->mFirst->mValue += i->mSecond->mValue;
+         }
+      }
+      Report("Position+Velocity, uncached ComponentView", numEntities * iterations, watch.GetElapsedSeconds());
+
+      ViewBenchView cached(em, true);
+      watch.Start();
+      for(unsigned int j = 0; j < iterations; ++j)
+      {
+         for(ViewBenchView::iterator i = cached.begin(); i != cached.end(); ++i)
+         {
+            i->mFirst->mValue += i->mSecond->mValue;
+         }
+      }
+      Report("Position+Velocity, cached ComponentView", numEntities * iterations, watch.GetElapsedSeconds());
+   }
+}
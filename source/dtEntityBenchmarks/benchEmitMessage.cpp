@@ -0,0 +1,275 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/messagefactory.h>
+#include <dtEntity/messagejournal.h>
+#include <dtEntity/messagepump.h>
+#include <dtEntity/systemmessages.h>
+#include <sstream>
+#include <stdio.h>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   class EmitBenchReceiver
+   {
+   public:
+      EmitBenchReceiver() : mCount(0) {}
+
+      void OnMessage(const dtEntity::Message&) { ++mCount; }
+      void OnTick(const dtEntity::TickData&) { ++mCount; }
+
+      unsigned int mCount;
+   };
+
+   // receiver that filters by entity id itself, as broadcast handlers do
+   class EntityFilterReceiver
+   {
+   public:
+      EntityFilterReceiver() : mId(0), mCount(0) {}
+
+      void OnMessage(const dtEntity::Message& m)
+      {
+         const dtEntity::MeshChangedMessage& msg = static_cast<const dtEntity::MeshChangedMessage&>(m);
+         if(msg.GetAboutEntityId() == mId)
+         {
+            ++mCount;
+         }
+      }
+
+      dtEntity::EntityId mId;
+      unsigned int mCount;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkEmit(unsigned int numHandlers)
+   {
+      dtEntity::MessagePump pump;
+      std::vector<EmitBenchReceiver> receivers(numHandlers);
+      for(unsigned int i = 0; i < numHandlers; ++i)
+      {
+         pump.RegisterForMessages(dtEntity::TickMessage::TYPE,
+            dtEntity::MessageFunctor(&receivers[i], &EmitBenchReceiver::OnMessage));
+      }
+      // other message types in registry
+      EmitBenchReceiver other;
+      pump.RegisterForMessages(dtEntity::EndOfFrameMessage::TYPE, dtEntity::MessageFunctor(&other, &EmitBenchReceiver::OnMessage));
+      pump.RegisterForMessages(dtEntity::PostUpdateMessage::TYPE, dtEntity::MessageFunctor(&other, &EmitBenchReceiver::OnMessage));
+
+      dtEntity::TickMessage msg;
+      const unsigned int numEmits = 2000000 / numHandlers;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEmits; ++i)
+      {
+         pump.EmitMessage(msg);
+      }
+      double seconds = watch.GetElapsedSeconds();
+      DoNotOptimize(&receivers[0].mCount);
+
+      std::ostringstream os;
+      os << "EmitMessage " << numHandlers << " handlers";
+      Report(os.str(), numEmits, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(EmitMessage)
+   {
+      BenchmarkEmit(1);
+      BenchmarkEmit(10);
+      BenchmarkEmit(100);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // compare a frame's tick sent as property message and as typed message
+   void BenchmarkTick(unsigned int numHandlers, bool typed, bool withScriptHandler)
+   {
+      dtEntity::MessagePump pump;
+      std::vector<EmitBenchReceiver> receivers(numHandlers);
+      for(unsigned int i = 0; i < numHandlers; ++i)
+      {
+         if(typed)
+         {
+            pump.RegisterForTypedMessages<dtEntity::TickData>(
+               dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(&receivers[i], &EmitBenchReceiver::OnTick));
+         }
+         else
+         {
+            pump.RegisterForMessages(dtEntity::TickMessage::TYPE,
+               dtEntity::MessageFunctor(&receivers[i], &EmitBenchReceiver::OnMessage));
+         }
+      }
+      EmitBenchReceiver script;
+      if(withScriptHandler)
+      {
+         pump.RegisterForMessages(dtEntity::TickMessage::TYPE, dtEntity::MessageFunctor(&script, &EmitBenchReceiver::OnMessage));
+      }
+
+      const unsigned int numEmits = 1000000 / numHandlers;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEmits; ++i)
+      {
+         // message is built each frame, as in OSGSystemInterface
+         if(typed)
+         {
+            dtEntity::TickData tick;
+            tick.mDeltaSimTime = 0.016f;
+            tick.mSimulationTime = i;
+            pump.EmitTypedMessage(tick);
+         }
+         else
+         {
+            dtEntity::TickMessage msg;
+            msg.SetDeltaSimTime(0.016f);
+            msg.SetSimulationTime(i);
+            pump.EmitMessage(msg);
+         }
+      }
+      double seconds = watch.GetElapsedSeconds();
+      DoNotOptimize(&receivers[0].mCount);
+
+      std::ostringstream os;
+      os << (typed ? "Tick typed " : "Tick property ") << numHandlers << " handlers"
+         << (withScriptHandler ? " + property listener" : "");
+      Report(os.str(), numEmits, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(EmitTick)
+   {
+      BenchmarkTick(1, false, false);
+      BenchmarkTick(1, true, false);
+      BenchmarkTick(10, false, false);
+      BenchmarkTick(10, true, false);
+      BenchmarkTick(10, true, true);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkEntityMessage(unsigned int numEntities, bool targeted)
+   {
+      dtEntity::MessagePump pump;
+      std::vector<EntityFilterReceiver> receivers(numEntities);
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         receivers[i].mId = i + 1;
+         dtEntity::MessageFunctor ftr(&receivers[i], &EntityFilterReceiver::OnMessage);
+         if(targeted)
+         {
+            pump.RegisterForMessages(dtEntity::MeshChangedMessage::TYPE, receivers[i].mId, ftr);
+         }
+         else
+         {
+            pump.RegisterForMessages(dtEntity::MeshChangedMessage::TYPE, ftr);
+         }
+      }
+
+      dtEntity::MeshChangedMessage msg;
+      const unsigned int numEmits = targeted ? 1000000 : 200;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEmits; ++i)
+      {
+         msg.SetAboutEntityId((i % numEntities) + 1);
+         pump.EmitMessage(msg);
+      }
+      double seconds = watch.GetElapsedSeconds();
+      DoNotOptimize(&receivers[0].mCount);
+
+      std::ostringstream os;
+      os << "MeshChanged " << (targeted ? "entity targeted " : "broadcast ") << numEntities << " entities";
+      Report(os.str(), numEmits, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(EntityTargetedMessage)
+   {
+      BenchmarkEntityMessage(1000, false);
+      BenchmarkEntityMessage(1000, true);
+      BenchmarkEntityMessage(50000, false);
+      BenchmarkEntityMessage(50000, true);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // emit ticks with one handler while recording to a journal, then replay them
+   void BenchmarkJournal(bool record)
+   {
+      const unsigned int numEmits = 200000;
+      const char* path = "benchmessagejournal.dtj";
+
+      dtEntity::EntityManager em;
+      EmitBenchReceiver receiver;
+      dtEntity::MessageFunctor ftr(&receiver, &EmitBenchReceiver::OnMessage);
+      em.RegisterForMessages(dtEntity::TickMessage::TYPE, ftr);
+
+      dtEntity::MessageJournalRecorder recorder(em);
+      if(record)
+      {
+         recorder.Start(path);
+      }
+      dtEntity::TickMessage msg;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEmits; ++i)
+      {
+         msg.SetSimulationTime(i * 0.01);
+         em.EmitMessage(msg);
+      }
+      double seconds = watch.GetElapsedSeconds();
+      Report(record ? "EmitMessage Tick while recording journal" : "EmitMessage Tick", numEmits, seconds);
+      if(!record)
+      {
+         return;
+      }
+
+      Stopwatch stopWatch;
+      recorder.Stop();
+      Report("MessageJournalRecorder::Stop, flush remaining records", 1, stopWatch.GetElapsedSeconds());
+
+      dtEntity::RegisterSystemMessages(dtEntity::MessageFactory::GetInstance());
+      dtEntity::MessageJournalPlayer player(em);
+      player.Open(path);
+      Stopwatch replayWatch;
+      unsigned int played = player.PlayAll();
+      Report("MessageJournalPlayer::PlayAll", played, replayWatch.GetElapsedSeconds());
+      DoNotOptimize(&receiver.mCount);
+      remove(path);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(MessageJournal)
+   {
+      dtEntity::TickMessage msg;
+      std::string buffer;
+      const unsigned int numEncodes = 1000000;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEncodes; ++i)
+      {
+         buffer.clear();
+         dtEntity::MessageJournal::EncodeRecord(msg, i * 0.01, 0, buffer);
+      }
+      Report("MessageJournal::EncodeRecord Tick", numEncodes, watch.GetElapsedSeconds());
+      DoNotOptimize(buffer.data());
+
+      BenchmarkJournal(false);
+      BenchmarkJournal(true);
+   }
+}
@@ -0,0 +1,195 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/component.h>
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   class KillBenchComponent : public dtEntity::Component
+   {
+   public:
+      static const dtEntity::ComponentType TYPE;
+
+      virtual dtEntity::ComponentType GetType() const { return TYPE; }
+   };
+
+   const dtEntity::ComponentType KillBenchComponent::TYPE(dtEntity::SID("KillBenchComponent"));
+
+   // entity system with component type given at runtime so that many systems can be registered
+   class KillBenchSystem : public dtEntity::DefaultEntitySystem<KillBenchComponent>
+   {
+   public:
+      KillBenchSystem(dtEntity::EntityManager& em, dtEntity::ComponentType t)
+         : dtEntity::DefaultEntitySystem<KillBenchComponent>(em)
+      {
+         mComponentType = t;
+      }
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(KillEntity)
+   {
+      const unsigned int numSystems = 50;
+      const unsigned int numEntities = 100000;
+      const unsigned int componentsPerEntity = 2;
+
+      dtEntity::EntityManager em;
+      std::vector<dtEntity::EntitySystem*> systems;
+      for(unsigned int i = 0; i < numSystems; ++i)
+      {
+         std::ostringstream os;
+         os << "KillBenchSystem" << i;
+         KillBenchSystem* sys = new KillBenchSystem(em, dtEntity::SID(os.str()));
+         em.AddEntitySystem(*sys);
+         systems.push_back(sys);
+      }
+
+      std::vector<dtEntity::EntityId> ids(numEntities);
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         dtEntity::Entity* entity = NULL;
+         em.CreateEntity(entity);
+         ids[i] = entity->GetId();
+         for(unsigned int j = 0; j < componentsPerEntity; ++j)
+         {
+            dtEntity::Component* comp = NULL;
+            systems[(i + j) % numSystems]->CreateComponent(ids[i], comp);
+         }
+      }
+      Report("CreateEntity with 2 components, 50 systems", numEntities, watch.GetElapsedSeconds());
+
+      watch.Start();
+      std::vector<dtEntity::Component*> comps;
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         comps.clear();
+         em.GetComponents(ids[i], comps);
+      }
+      Report("GetComponents, 50 systems", numEntities, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         em.KillEntity(ids[i]);
+      }
+      Report("KillEntity 100k with 2 components, 50 systems", numEntities, watch.GetElapsedSeconds());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static void CreateKillBenchSystems(dtEntity::EntityManager& em, unsigned int numSystems, std::vector<dtEntity::EntitySystem*>& systems)
+   {
+      for(unsigned int i = 0; i < numSystems; ++i)
+      {
+         std::ostringstream os;
+         os << "KillBenchSystem" << i;
+         KillBenchSystem* sys = new KillBenchSystem(em, dtEntity::SID(os.str()));
+         em.AddEntitySystem(*sys);
+         systems.push_back(sys);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static void CreateKillBenchEntities(dtEntity::EntityManager& em, const std::vector<dtEntity::EntitySystem*>& systems,
+                                       unsigned int numEntities, std::vector<dtEntity::EntityId>& ids)
+   {
+      std::vector<dtEntity::Entity*> entities;
+      em.CreateEntities(numEntities, entities);
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         ids.push_back(entities[i]->GetId());
+         for(unsigned int j = 0; j < 2; ++j)
+         {
+            dtEntity::Component* comp = NULL;
+            systems[(i + j) % systems.size()]->CreateComponent(ids.back(), comp);
+         }
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // kill entities in batches of 1000, like clearing projectiles each frame
+   BENCHMARK(KillEntities)
+   {
+      const unsigned int numEntities = 100000;
+      const unsigned int batchSize = 1000;
+
+      {
+         dtEntity::EntityManager em;
+         std::vector<dtEntity::EntitySystem*> systems;
+         CreateKillBenchSystems(em, 50, systems);
+         std::vector<dtEntity::EntityId> ids;
+         Stopwatch watch;
+         CreateKillBenchEntities(em, systems, numEntities, ids);
+         Report("CreateEntities 100k with 2 components, 50 systems", numEntities, watch.GetElapsedSeconds());
+
+         watch.Start();
+         for(unsigned int i = 0; i < numEntities; ++i)
+         {
+            em.KillEntity(ids[i]);
+         }
+         Report("KillEntity one by one, 50 systems", numEntities, watch.GetElapsedSeconds());
+      }
+
+      {
+         dtEntity::EntityManager em;
+         std::vector<dtEntity::EntitySystem*> systems;
+         CreateKillBenchSystems(em, 50, systems);
+         std::vector<dtEntity::EntityId> ids;
+         CreateKillBenchEntities(em, systems, numEntities, ids);
+
+         Stopwatch watch;
+         std::vector<dtEntity::EntityId> batch;
+         for(unsigned int i = 0; i < numEntities; i += batchSize)
+         {
+            batch.assign(ids.begin() + i, ids.begin() + i + batchSize);
+            em.KillEntities(batch);
+         }
+         Report("KillEntities in batches of 1000, 50 systems", numEntities, watch.GetElapsedSeconds());
+      }
+
+      {
+         dtEntity::EntityManager em;
+         std::vector<dtEntity::EntitySystem*> systems;
+         CreateKillBenchSystems(em, 50, systems);
+         std::vector<dtEntity::EntityId> ids;
+         CreateKillBenchEntities(em, systems, numEntities, ids);
+
+         Stopwatch watch;
+         for(unsigned int i = 0; i < numEntities; i += batchSize)
+         {
+            for(unsigned int j = i; j < i + batchSize; ++j)
+            {
+               em.KillEntityDeferred(ids[j]);
+            }
+            em.FlushDeferredKills();
+         }
+         Report("KillEntityDeferred + flush in batches of 1000, 50 systems", numEntities, watch.GetElapsedSeconds());
+      }
+   }
+}
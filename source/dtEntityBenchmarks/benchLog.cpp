@@ -0,0 +1,87 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/asyncloglistener.h>
+#include <dtEntity/log.h>
+#include <ostream>
+#include <streambuf>
+
+namespace dtEntityBenchmarks
+{
+   // stream buffer that discards everything written to it
+   class NullStreamBuf : public std::streambuf
+   {
+   protected:
+      virtual int overflow(int c) { return c; }
+      virtual std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+   };
+
+   // writes messages synchronously, as ConsoleLogHandler does
+   class SyncStreamLogListener : public dtEntity::LogListener
+   {
+   public:
+      SyncStreamLogListener(std::ostream& stream) : mStream(&stream) {}
+
+      virtual void LogMessage(dtEntity::LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
+                      const std::string& msg)
+      {
+         (*mStream) << dtEntity::LogLevel::GetName(level) << " File: " << filename << " Line: " << linenumber << " Message: " << msg << std::endl;
+      }
+
+      std::ostream* mStream;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkLogCalls(const std::string& name, unsigned int numCalls)
+   {
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numCalls; ++i)
+      {
+         LOG_INFO("Benchmark message " << i << " of " << numCalls);
+      }
+      Report(name, numCalls, watch.GetElapsedSeconds());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(Log)
+   {
+      dtEntity::LogManager& lm = dtEntity::LogManager::GetInstance();
+      NullStreamBuf nullBuf;
+      std::ostream nullStream(&nullBuf);
+
+      osg::ref_ptr<SyncStreamLogListener> sync = new SyncStreamLogListener(nullStream);
+      lm.AddListener(sync);
+      lm.SetLogLevel(dtEntity::LogLevel::LVL_WARNING);
+      BenchmarkLogCalls("LOG_INFO below log level", 10000000);
+      lm.SetLogLevel(dtEntity::LogLevel::LVL_DEBUG);
+      BenchmarkLogCalls("LOG_INFO synchronous listener", 500000);
+      lm.RemoveListener(sync);
+
+      osg::ref_ptr<dtEntity::AsyncLogListener> async = new dtEntity::AsyncLogListener(nullStream, 1 << 16);
+      lm.AddListener(async);
+      BenchmarkLogCalls("LOG_INFO async listener", 500000);
+      async->Flush();
+      lm.RemoveListener(async);
+   }
+}
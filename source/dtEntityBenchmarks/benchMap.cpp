@@ -0,0 +1,150 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/core.h>
+#include <dtEntity/dynamicscomponent.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/headlesssysteminterface.h>
+#include <dtEntity/mapcomponent.h>
+#include <dtEntity/mapencoder.h>
+#include <osg/Vec3>
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   // adds the systems that are needed to load the benchmark map
+   static void SetupMapBenchSystems(dtEntity::EntityManager& em)
+   {
+      em.AddEntitySystem(*new dtEntity::MapSystem(em));
+      em.AddEntitySystem(*new dtEntity::DynamicsSystem(em));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static void CreateMapBenchEntities(dtEntity::EntityManager& em, const std::string& mapName, unsigned int numEntities)
+   {
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         dtEntity::Entity* entity = NULL;
+         em.CreateEntity(entity);
+
+         dtEntity::MapComponent* mc = NULL;
+         em.CreateComponent(entity->GetId(), mc);
+         std::ostringstream os;
+         os << "BenchEntity" << i;
+         mc->SetEntityName(os.str());
+         mc->SetMapName(mapName);
+         mc->Finished();
+
+         dtEntity::DynamicsComponent* dc = NULL;
+         em.CreateComponent(entity->GetId(), dc);
+         dc->SetVelocity(osg::Vec3(static_cast<float>(i), 1, 2));
+         dc->Finished();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // save and load a map with the encoder registered for given extension
+   static void BenchmarkMapEncoder(const std::string& extension, unsigned int numEntities)
+   {
+      const std::string mapName = "dtEntityBenchmarkMap." + extension;
+      const unsigned int numLoads = 5;
+
+      dtEntity::EntityManager em;
+      SetupMapBenchSystems(em);
+      dtEntity::MapSystem* mapSystem = NULL;
+      em.GetES(mapSystem);
+      dtEntity::MapEncoder* encoder = mapSystem->GetEncoderForMap(extension);
+      if(encoder == NULL)
+      {
+         std::cout << "No map encoder for extension " << extension << ", skipped" << std::endl;
+         return;
+      }
+
+      CreateMapBenchEntities(em, mapName, numEntities);
+
+      std::ostringstream os;
+      os << numEntities << " entities, " << extension;
+
+      Stopwatch watch;
+      if(!encoder->SaveMapToFile(mapName, mapName))
+      {
+         std::cout << "Could not save " << mapName << std::endl;
+         return;
+      }
+      Report("Save map " + os.str(), numEntities, watch.GetElapsedSeconds());
+
+      double loadSeconds = 0;
+      for(unsigned int i = 0; i < numLoads; ++i)
+      {
+         // load into a fresh entity manager so that unique ids do not collide
+         dtEntity::EntityManager loadEm;
+         SetupMapBenchSystems(loadEm);
+         dtEntity::MapSystem* loadMapSystem = NULL;
+         loadEm.GetES(loadMapSystem);
+
+         watch.Start();
+         loadMapSystem->GetEncoderForMap(extension)->LoadMapFromFile(mapName);
+         loadSeconds += watch.GetElapsedSeconds();
+
+         std::vector<dtEntity::EntityId> ids;
+         loadMapSystem->GetEntitiesInMap(mapName, ids);
+         if(ids.size() != numEntities)
+         {
+            std::cout << "Loaded " << ids.size() << " entities, expected " << numEntities << std::endl;
+         }
+      }
+      Report("Load map " + os.str(), numEntities * numLoads, loadSeconds);
+
+      remove(mapName.c_str());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(Map)
+   {
+      // encoders look up map files through the system interface
+      dtEntity::EntityManager em;
+      dtEntity::HeadlessSystemInterface* iface = NULL;
+      if(dtEntity::GetSystemInterface() == NULL)
+      {
+         iface = new dtEntity::HeadlessSystemInterface(em.GetMessagePump(), 0, NULL);
+         dtEntity::SetSystemInterface(iface);
+      }
+
+      BenchmarkMapEncoder("dtemap", 5000);
+
+      // protobuf encoder only exists if dtEntity was built with protobuf
+      BenchmarkMapEncoder("bmap", 5000);
+
+      if(iface != NULL)
+      {
+         dtEntity::SetSystemInterface(NULL);
+         delete iface;
+      }
+   }
+}
@@ -0,0 +1,170 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/component.h>
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/sparsecomponentstore.h>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   class ChurnBenchComponent : public dtEntity::Component
+   {
+   public:
+      static const dtEntity::ComponentType TYPE;
+      static const dtEntity::StringId ValueId;
+
+      ChurnBenchComponent()
+      {
+         Register(ValueId, &mValue);
+      }
+
+      virtual dtEntity::ComponentType GetType() const { return TYPE; }
+
+      dtEntity::FloatProperty mValue;
+   };
+
+   const dtEntity::ComponentType ChurnBenchComponent::TYPE(dtEntity::SID("ChurnBenchComponent"));
+   const dtEntity::StringId ChurnBenchComponent::ValueId(dtEntity::SID("Value"));
+
+   template<template<class> class MemAllocPolicy>
+   class ChurnBenchSystem
+      : public dtEntity::DefaultEntitySystem<ChurnBenchComponent, MemAllocPolicy, dtEntity::ComponentStoreSparseSet>
+   {
+   public:
+      ChurnBenchSystem(dtEntity::EntityManager& em)
+         : dtEntity::DefaultEntitySystem<ChurnBenchComponent, MemAllocPolicy, dtEntity::ComponentStoreSparseSet>(em)
+      {
+      }
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // Keep numLive components alive, each step deletes a pseudo random one and
+   // creates a new one in its place. Then iterate over all components.
+   template<template<class> class MemAllocPolicy>
+   void BenchmarkChurn(const std::string& policyName, unsigned int numLive)
+   {
+      dtEntity::EntityManager em;
+      ChurnBenchSystem<MemAllocPolicy>* sys = new ChurnBenchSystem<MemAllocPolicy>(em);
+      em.AddEntitySystem(*sys);
+
+      std::vector<dtEntity::Entity*> entities;
+      em.CreateEntities(numLive, entities);
+      std::vector<dtEntity::EntityId> ids(numLive);
+      for(unsigned int i = 0; i < numLive; ++i)
+      {
+         ids[i] = entities[i]->GetId();
+      }
+
+      std::ostringstream os;
+      os << policyName << " " << numLive;
+
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numLive; ++i)
+      {
+         dtEntity::Component* comp = NULL;
+         sys->CreateComponent(ids[i], comp);
+      }
+      Report(os.str() + " create", numLive, watch.GetElapsedSeconds());
+
+      const unsigned int steps = 200000;
+      unsigned int seed = 42;
+      watch.Start();
+      for(unsigned int i = 0; i < steps; ++i)
+      {
+         seed = seed * 1664525u + 1013904223u;
+         dtEntity::EntityId id = ids[(seed >> 8) % numLive];
+         sys->DeleteComponent(id);
+         dtEntity::Component* comp = NULL;
+         sys->CreateComponent(id, comp);
+      }
+      Report(os.str() + " delete+create churn", steps, watch.GetElapsedSeconds());
+
+      const unsigned int iterations = 10;
+      float sum = 0;
+      watch.Start();
+      for(unsigned int j = 0; j < iterations; ++j)
+      {
+         for(typename ChurnBenchSystem<MemAllocPolicy>::ComponentStore::iterator i = sys->begin(); i != sys->end(); ++i)
+         {
+            sum += i->second->mValue.Get();
+         }
+      }
+      Report(os.str() + " iterate after churn", numLive * iterations, watch.GetElapsedSeconds());
+      DoNotOptimize(&sum);
+   }
+
+   // allocation policy destructors are protected
+   template<template<class> class MemAllocPolicy>
+   struct PolicyHolder : public MemAllocPolicy<ChurnBenchComponent>
+   {
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // Same churn pattern without entity system, measures only allocation policy
+   template<template<class> class MemAllocPolicy>
+   void BenchmarkPolicyChurn(const std::string& policyName, unsigned int numLive)
+   {
+      PolicyHolder<MemAllocPolicy> policy;
+      std::vector<ChurnBenchComponent*> comps(numLive);
+      for(unsigned int i = 0; i < numLive; ++i)
+      {
+         comps[i] = policy.Create();
+      }
+
+      std::ostringstream os;
+      os << policyName << " " << numLive << " Create+Destroy only";
+
+      const unsigned int steps = 200000;
+      unsigned int seed = 42;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < steps; ++i)
+      {
+         seed = seed * 1664525u + 1013904223u;
+         unsigned int idx = (seed >> 8) % numLive;
+         policy.Destroy(comps[idx]);
+         comps[idx] = policy.Create();
+      }
+      Report(os.str(), steps, watch.GetElapsedSeconds());
+
+      for(unsigned int i = 0; i < numLive; ++i)
+      {
+         policy.Destroy(comps[i]);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(MemAllocPolicy)
+   {
+      BenchmarkChurn<dtEntity::MemAllocPolicyNew>("MemAllocPolicyNew", 10000);
+      BenchmarkChurn<dtEntity::MemAllocPolicySlab>("MemAllocPolicySlab", 10000);
+      BenchmarkChurn<dtEntity::MemAllocPolicyNew>("MemAllocPolicyNew", 100000);
+      BenchmarkChurn<dtEntity::MemAllocPolicySlab>("MemAllocPolicySlab", 100000);
+      BenchmarkPolicyChurn<dtEntity::MemAllocPolicyNew>("MemAllocPolicyNew", 100000);
+      BenchmarkPolicyChurn<dtEntity::MemAllocPolicySlab>("MemAllocPolicySlab", 100000);
+   }
+}
@@ -0,0 +1,303 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/messagepump.h>
+#include <dtEntity/mpscqueue.h>
+#include <dtEntity/systemmessages.h>
+#include <dtEntity/threadsafequeue.h>
+#include <OpenThreads/Thread>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   // common interface for the measured queues
+   class LockedQueue
+   {
+   public:
+      void Push(unsigned int v) { mQueue.Push(v); }
+
+      // drain like MessagePump did before: Empty() and Pop() lock once each
+      bool PopAll(std::vector<unsigned int>& toFill)
+      {
+         bool found = false;
+         while(!mQueue.Empty())
+         {
+            toFill.push_back(mQueue.Pop());
+            found = true;
+         }
+         return found;
+      }
+
+   private:
+      dtEntity::ThreadSafeQueue<unsigned int> mQueue;
+   };
+
+   class UnboundedQueue
+   {
+   public:
+      void Push(unsigned int v) { mQueue.Push(v); }
+      bool PopAll(std::vector<unsigned int>& toFill) { return mQueue.PopAll(toFill); }
+
+   private:
+      dtEntity::MPSCQueue<unsigned int> mQueue;
+   };
+
+   class BoundedQueue
+   {
+   public:
+      BoundedQueue() : mQueue(1 << 16) {}
+
+      void Push(unsigned int v)
+      {
+         while(!mQueue.Push(v))
+         {
+            OpenThreads::Thread::YieldCurrentThread();
+         }
+      }
+
+      bool PopAll(std::vector<unsigned int>& toFill) { return mQueue.PopAll(toFill); }
+
+   private:
+      dtEntity::BoundedMPSCQueue<unsigned int> mQueue;
+   };
+
+   template<class Queue>
+   class QueueProducer : public OpenThreads::Thread
+   {
+   public:
+      QueueProducer(Queue& q, unsigned int numPushes)
+         : mQueue(&q)
+         , mNumPushes(numPushes)
+      {
+      }
+
+      virtual void run()
+      {
+         for(unsigned int i = 0; i < mNumPushes; ++i)
+         {
+            mQueue->Push(i);
+         }
+      }
+
+   private:
+      Queue* mQueue;
+      unsigned int mNumPushes;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // producers push concurrently while main thread drains
+   template<class Queue>
+   void BenchmarkQueue(const std::string& queueName, unsigned int numProducers)
+   {
+      const unsigned int pushesPerProducer = 200000;
+      const unsigned int total = pushesPerProducer * numProducers;
+
+      Queue q;
+      std::vector<QueueProducer<Queue>*> producers;
+      for(unsigned int i = 0; i < numProducers; ++i)
+      {
+         producers.push_back(new QueueProducer<Queue>(q, pushesPerProducer));
+      }
+
+      std::vector<unsigned int> batch;
+      unsigned int received = 0;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numProducers; ++i)
+      {
+         producers[i]->start();
+      }
+      while(received < total)
+      {
+         batch.clear();
+         if(q.PopAll(batch))
+         {
+            received += batch.size();
+         }
+         else
+         {
+            OpenThreads::Thread::YieldCurrentThread();
+         }
+      }
+      double seconds = watch.GetElapsedSeconds();
+
+      for(unsigned int i = 0; i < numProducers; ++i)
+      {
+         producers[i]->join();
+         delete producers[i];
+      }
+
+      std::ostringstream os;
+      os << queueName << " " << numProducers << " producers push+pop";
+      Report(os.str(), total, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(MessageQueue)
+   {
+      unsigned int numProducers[] = { 1, 4 };
+      for(unsigned int i = 0; i < 2; ++i)
+      {
+         BenchmarkQueue<LockedQueue>("ThreadSafeQueue", numProducers[i]);
+         BenchmarkQueue<UnboundedQueue>("MPSCQueue", numProducers[i]);
+         BenchmarkQueue<BoundedQueue>("BoundedMPSCQueue", numProducers[i]);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // enqueue and emit 1000 tick messages per frame
+   void BenchmarkEnqueue(const std::string& name, unsigned int poolSize)
+   {
+      const unsigned int numFrames = 100;
+      const unsigned int messagesPerFrame = 1000;
+      dtEntity::MessagePump pump;
+      pump.GetMessagePool().SetMaxPerType(poolSize);
+      dtEntity::TickMessage msg;
+
+      Stopwatch watch;
+      for(unsigned int j = 0; j < numFrames; ++j)
+      {
+         for(unsigned int i = 0; i < messagesPerFrame; ++i)
+         {
+            pump.EnqueueMessage(msg);
+         }
+         pump.EmitQueuedMessages(0);
+      }
+      Report(name, numFrames * messagesPerFrame, watch.GetElapsedSeconds());
+
+      const dtEntity::MessagePool& pool = pump.GetMessagePool();
+      std::cout << "  message pool hits: " << pool.GetNumHits() << " misses: " << pool.GetNumMisses() << std::endl;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(EnqueueMessage)
+   {
+      BenchmarkEnqueue("EnqueueMessage+EmitQueuedMessages, no pooling", 0);
+      BenchmarkEnqueue("EnqueueMessage+EmitQueuedMessages, pool size 1000", 1000);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // many pending timeouts, few of them due per frame
+   BENCHMARK(FutureMessages)
+   {
+      const unsigned int numPending = 20000;
+      dtEntity::MessagePump pump;
+      dtEntity::EndOfFrameMessage msg;
+
+      std::vector<unsigned int> handles(numPending);
+      unsigned int seed = 42;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numPending; ++i)
+      {
+         seed = seed * 1664525u + 1013904223u;
+         handles[i] = pump.EnqueueMessage(msg, 1.0 + (seed >> 8) % 100000);
+      }
+      pump.EmitQueuedMessages(0);
+      Report("EnqueueMessage with time, 20k pending", numPending, watch.GetElapsedSeconds());
+
+      const unsigned int numFrames = 1000;
+      watch.Start();
+      for(unsigned int i = 0; i < numFrames; ++i)
+      {
+         pump.EmitQueuedMessages(0.5);
+      }
+      Report("EmitQueuedMessages, 20k pending, none due", numFrames, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numPending; i += 2)
+      {
+         pump.CancelMessage(handles[i]);
+      }
+      Report("CancelMessage, 20k pending", numPending / 2, watch.GetElapsedSeconds());
+
+      // emit all remaining messages over 100 frames
+      watch.Start();
+      for(unsigned int i = 1; i <= 100; ++i)
+      {
+         pump.EmitQueuedMessages(i * 1000.0);
+      }
+      Report("EmitQueuedMessages, 10k due over 100 frames", numPending / 2, watch.GetElapsedSeconds());
+   }
+
+   class NameUpdateHandler
+   {
+   public:
+      NameUpdateHandler() : mLength(0) {}
+
+      void OnNameUpdated(const dtEntity::Message& m)
+      {
+         const dtEntity::EntityNameUpdatedMessage& msg = static_cast<const dtEntity::EntityNameUpdatedMessage&>(m);
+         mLength += msg.GetEntityName().size();
+      }
+
+      size_t mLength;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // 100 entities get 10 name updates each per frame
+   void BenchmarkNameUpdates(const std::string& name, bool coalesce)
+   {
+      const unsigned int numFrames = 100;
+      const unsigned int numEntities = 100;
+      const unsigned int updatesPerEntity = 10;
+      dtEntity::MessagePump pump;
+      NameUpdateHandler handler;
+      pump.RegisterForMessages(dtEntity::EntityNameUpdatedMessage::TYPE,
+         dtEntity::MessageFunctor(&handler, &NameUpdateHandler::OnNameUpdated));
+      dtEntity::EntityNameUpdatedMessage msg;
+      msg.SetEntityName("SomeEntityName");
+
+      Stopwatch watch;
+      for(unsigned int j = 0; j < numFrames; ++j)
+      {
+         for(unsigned int k = 0; k < updatesPerEntity; ++k)
+         {
+            for(unsigned int i = 0; i < numEntities; ++i)
+            {
+               msg.SetAboutEntityId(i + 1);
+               if(coalesce)
+               {
+                  pump.EnqueueMessageCoalesced(msg, i + 1);
+               }
+               else
+               {
+                  pump.EnqueueMessage(msg);
+               }
+            }
+         }
+         pump.EmitQueuedMessages(0);
+      }
+      Report(name, numFrames * numEntities * updatesPerEntity, watch.GetElapsedSeconds());
+      DoNotOptimize(&handler.mLength);
+      std::cout << "  dropped messages: " << pump.GetNumCoalescedDrops() << std::endl;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(EnqueueMessageCoalesced)
+   {
+      BenchmarkNameUpdates("EnqueueMessage, 10 name updates per entity", false);
+      BenchmarkNameUpdates("EnqueueMessageCoalesced, 10 name updates per entity", true);
+   }
+}
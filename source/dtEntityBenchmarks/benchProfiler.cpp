@@ -0,0 +1,108 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/messagepump.h>
+#include <dtEntity/profiler.h>
+#include <dtEntity/systemmessages.h>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   class ProfilerBenchReceiver
+   {
+   public:
+      ProfilerBenchReceiver() : mCount(0) {}
+      void OnMessage(const dtEntity::Message&) { ++mCount; }
+      unsigned int mCount;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkZones(bool enabled)
+   {
+      dtEntity::StringId name = dtEntity::SID("BenchmarkZone");
+      dtEntity::Profiler::SetEnabled(enabled);
+      const unsigned int numZones = 5000000;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numZones; ++i)
+      {
+         dtEntity::ProfileScope zone(name);
+         // keep ring buffer from overflowing, as once per frame
+         if(i % 10000 == 0)
+         {
+            dtEntity::Profiler::EndFrame();
+         }
+      }
+      double seconds = watch.GetElapsedSeconds();
+      dtEntity::Profiler::SetEnabled(false);
+      dtEntity::Profiler::EndFrame();
+      dtEntity::Profiler::ResetStats();
+      Report(enabled ? "ProfileScope enabled" : "ProfileScope disabled", numZones, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkProfiledEmit(bool enabled)
+   {
+      const unsigned int numHandlers = 10;
+      dtEntity::MessagePump pump;
+      std::vector<ProfilerBenchReceiver> receivers(numHandlers);
+      for(unsigned int i = 0; i < numHandlers; ++i)
+      {
+         std::ostringstream os;
+         os << "ProfilerBenchReceiver" << i;
+         pump.RegisterForMessages(dtEntity::TickMessage::TYPE,
+            dtEntity::MessageFunctor(&receivers[i], &ProfilerBenchReceiver::OnMessage),
+            dtEntity::FilterOptions::DEFAULT, os.str());
+      }
+
+      dtEntity::Profiler::SetEnabled(enabled);
+      dtEntity::TickMessage msg;
+      const unsigned int numEmits = 500000;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEmits; ++i)
+      {
+         pump.EmitMessage(msg);
+         if(i % 1000 == 0)
+         {
+            dtEntity::Profiler::EndFrame();
+         }
+      }
+      double seconds = watch.GetElapsedSeconds();
+      dtEntity::Profiler::SetEnabled(false);
+      dtEntity::Profiler::EndFrame();
+      dtEntity::Profiler::ResetStats();
+      DoNotOptimize(&receivers[0].mCount);
+
+      Report(enabled ? "EmitMessage 10 handlers, profiler enabled" : "EmitMessage 10 handlers, profiler disabled", numEmits, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(Profiler)
+   {
+      BenchmarkZones(false);
+      BenchmarkZones(true);
+      BenchmarkProfiledEmit(false);
+      BenchmarkProfiledEmit(true);
+   }
+}
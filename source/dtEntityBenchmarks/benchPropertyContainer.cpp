@@ -0,0 +1,111 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/propertycontainer.h>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   const dtEntity::StringId PropBenchIds[8] = {
+      dtEntity::SID("PropBench0"), dtEntity::SID("PropBench1"),
+      dtEntity::SID("PropBench2"), dtEntity::SID("PropBench3"),
+      dtEntity::SID("PropBench4"), dtEntity::SID("PropBench5"),
+      dtEntity::SID("PropBench6"), dtEntity::SID("PropBench7")
+   };
+
+   // registers its properties per instance
+   class InstanceRegisteredContainer : public dtEntity::PropertyContainer
+   {
+   public:
+      InstanceRegisteredContainer()
+      {
+         for(unsigned int i = 0; i < 8; ++i)
+         {
+            Register(PropBenchIds[i], &mProps[i]);
+         }
+      }
+      dtEntity::FloatProperty mProps[8];
+   };
+
+   // registers its properties with a static schema
+   class SchemaRegisteredContainer : public dtEntity::PropertyContainer
+   {
+   public:
+      static dtEntity::PropertySchema sPropertySchema;
+
+      SchemaRegisteredContainer()
+      {
+         for(unsigned int i = 0; i < 8; ++i)
+         {
+            Register(sPropertySchema, PropBenchIds[i], &mProps[i]);
+         }
+      }
+      dtEntity::FloatProperty mProps[8];
+   };
+
+   dtEntity::PropertySchema SchemaRegisteredContainer::sPropertySchema;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   template <class T>
+   static void BenchContainers(const char* createName, const char* getName, const char* destroyName)
+   {
+      const unsigned int numContainers = 100000;
+      std::vector<T*> containers(numContainers);
+
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numContainers; ++i)
+      {
+         containers[i] = new T();
+      }
+      Report(createName, numContainers, watch.GetElapsedSeconds());
+
+      watch.Start();
+      float sum = 0;
+      for(unsigned int i = 0; i < numContainers; ++i)
+      {
+         for(unsigned int j = 0; j < 8; ++j)
+         {
+            sum += containers[i]->GetFloat(PropBenchIds[j]);
+         }
+      }
+      Report(getName, numContainers * 8, watch.GetElapsedSeconds());
+      DoNotOptimize(&sum);
+
+      watch.Start();
+      for(unsigned int i = 0; i < numContainers; ++i)
+      {
+         delete containers[i];
+      }
+      Report(destroyName, numContainers, watch.GetElapsedSeconds());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(PropertyContainer)
+   {
+      BenchContainers<InstanceRegisteredContainer>("Create 100k containers, 8 properties, per instance",
+         "GetFloat by name, per instance", "Destroy 100k containers, per instance");
+      BenchContainers<SchemaRegisteredContainer>("Create 100k containers, 8 properties, schema",
+         "GetFloat by name, schema", "Destroy 100k containers, schema");
+   }
+}
@@ -0,0 +1,111 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/property.h>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   typedef std::map<dtEntity::StringId, dtEntity::Property*> PropertyMap;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   template <class Group>
+   static void BenchGroup(const std::string& groupName, unsigned int numEntries)
+   {
+      const unsigned int numOps = 1000000;
+
+      std::vector<dtEntity::StringId> keys;
+      std::vector<dtEntity::IntProperty> props(numEntries);
+      for(unsigned int i = 0; i < numEntries; ++i)
+      {
+         std::ostringstream os;
+         os << "GroupBench" << i;
+         keys.push_back(dtEntity::SID(os.str()));
+      }
+
+      std::ostringstream suffix;
+      suffix << ", " << groupName << ", " << numEntries << " entries";
+
+      Stopwatch watch;
+      unsigned int groups = numOps / numEntries;
+      for(unsigned int g = 0; g < groups; ++g)
+      {
+         Group group;
+         for(unsigned int i = 0; i < numEntries; ++i)
+         {
+            group[keys[i]] = &props[i];
+         }
+         DoNotOptimize(&group);
+      }
+      Report("Set" + suffix.str(), groups * numEntries, watch.GetElapsedSeconds());
+
+      Group group;
+      for(unsigned int i = 0; i < numEntries; ++i)
+      {
+         group[keys[i]] = &props[i];
+      }
+
+      watch.Start();
+      dtEntity::Property* found = NULL;
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         found = group.find(keys[(i * 7) % numEntries])->second;
+      }
+      Report("Get" + suffix.str(), numOps, watch.GetElapsedSeconds());
+      DoNotOptimize(found);
+
+      watch.Start();
+      unsigned int count = 0;
+      for(unsigned int g = 0; g < groups; ++g)
+      {
+         for(typename Group::const_iterator i = group.begin(); i != group.end(); ++i)
+         {
+            count += (i->second != NULL) ? 1 : 0;
+         }
+      }
+      Report("Iterate" + suffix.str(), groups * numEntries, watch.GetElapsedSeconds());
+      DoNotOptimize(&count);
+
+      watch.Start();
+      for(unsigned int g = 0; g < groups; ++g)
+      {
+         Group copy(group);
+         DoNotOptimize(&copy);
+      }
+      Report("Copy" + suffix.str(), groups, watch.GetElapsedSeconds());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(PropertyGroup)
+   {
+      const unsigned int sizes[3] = { 4, 16, 64 };
+      for(unsigned int i = 0; i < 3; ++i)
+      {
+         BenchGroup<PropertyMap>("std::map", sizes[i]);
+         BenchGroup<dtEntity::PropertyGroup>("PropertyGroup", sizes[i]);
+      }
+   }
+}
@@ -0,0 +1,107 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/property.h>
+#include <dtEntity/propertyvalue.h>
+#include <sstream>
+
+namespace dtEntityBenchmarks
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   // group with 8 floats and 2 strings, like a typical component
+   static void FillBenchGroup(dtEntity::GroupProperty& grp)
+   {
+      for(unsigned int i = 0; i < 8; ++i)
+      {
+         std::ostringstream os;
+         os << "Float" << i;
+         grp.Add(dtEntity::SID(os.str()), new dtEntity::FloatProperty(static_cast<float>(i)));
+      }
+      grp.Add(dtEntity::SID("Name"), new dtEntity::StringProperty("BenchEntity"));
+      grp.Add(dtEntity::SID("Mesh"), new dtEntity::StringProperty("StaticMeshes/physics_crate.ive"));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(PropertyValue)
+   {
+      const unsigned int numCopies = 200000;
+
+      dtEntity::GroupProperty grp;
+      FillBenchGroup(grp);
+
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numCopies; ++i)
+      {
+         dtEntity::GroupProperty copy(grp);
+         DoNotOptimize(&copy);
+      }
+      Report("Copy GroupProperty, 10 entries", numCopies, watch.GetElapsedSeconds());
+
+      dtEntity::PropertyValue value;
+      grp.GetValue(value);
+
+      watch.Start();
+      for(unsigned int i = 0; i < numCopies; ++i)
+      {
+         dtEntity::PropertyValue copy(value);
+         DoNotOptimize(&copy);
+      }
+      Report("Copy PropertyValue group, 10 entries", numCopies, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numCopies; ++i)
+      {
+         dtEntity::PropertyValue v;
+         grp.GetValue(v);
+         DoNotOptimize(&v);
+      }
+      Report("GroupProperty::GetValue, 10 entries", numCopies, watch.GetElapsedSeconds());
+
+      dtEntity::GroupProperty target;
+      FillBenchGroup(target);
+      const dtEntity::PropertyGroup& targetprops = target.Get();
+      const dtEntity::PropertyValue::Group& values = value.GroupValue();
+
+      watch.Start();
+      for(unsigned int i = 0; i < numCopies; ++i)
+      {
+         for(dtEntity::PropertyValue::Group::const_iterator j = values.begin(); j != values.end(); ++j)
+         {
+            targetprops.find(j->first)->second->SetValue(j->second);
+         }
+      }
+      Report("Property::SetValue, 10 entries", numCopies, watch.GetElapsedSeconds());
+
+      const dtEntity::PropertyGroup& sourceprops = grp.Get();
+      watch.Start();
+      for(unsigned int i = 0; i < numCopies; ++i)
+      {
+         for(dtEntity::PropertyGroup::const_iterator j = sourceprops.begin(); j != sourceprops.end(); ++j)
+         {
+            targetprops.find(j->first)->second->SetFrom(*j->second);
+         }
+      }
+      Report("Property::SetFrom, 10 entries", numCopies, watch.GetElapsedSeconds());
+   }
+}
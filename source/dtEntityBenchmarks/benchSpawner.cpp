@@ -0,0 +1,86 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/dynamicscomponent.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/mapcomponent.h>
+#include <dtEntity/spawner.h>
+#include <osg/Vec3>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   void BenchmarkSpawn(const std::string& name, dtEntity::EntityManager& em, const dtEntity::Spawner& spawner)
+   {
+      const unsigned int numEntities = 50000;
+      std::vector<dtEntity::Entity*> entities;
+      em.CreateEntities(numEntities, entities);
+
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         spawner.Spawn(*entities[i]);
+      }
+      Report(name, numEntities, watch.GetElapsedSeconds());
+
+      std::vector<dtEntity::EntityId> ids;
+      for(unsigned int i = 0; i < numEntities; ++i)
+      {
+         ids.push_back(entities[i]->GetId());
+      }
+      em.KillEntities(ids);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(Spawner)
+   {
+      dtEntity::EntityManager em;
+      em.AddEntitySystem(*new dtEntity::MapSystem(em));
+      em.AddEntitySystem(*new dtEntity::DynamicsSystem(em));
+
+      osg::ref_ptr<dtEntity::Spawner> parent = new dtEntity::Spawner("BenchParent", "bench.dtemap");
+      dtEntity::GroupProperty dynamics;
+      dynamics.Add(dtEntity::DynamicsComponent::VelocityId, new dtEntity::Vec3Property(osg::Vec3(1, 2, 3)));
+      dynamics.Add(dtEntity::DynamicsComponent::AngularVelocityId, new dtEntity::QuatProperty(0, 0, 0, 1));
+      dynamics.Add(dtEntity::DynamicsComponent::AccelerationId, new dtEntity::Vec3Property(osg::Vec3(0, 0, -9.81f)));
+      parent->AddComponent(dtEntity::DynamicsComponent::TYPE, dynamics);
+
+      dtEntity::GroupProperty map;
+      map.Add(dtEntity::MapComponent::EntityNameId, new dtEntity::StringProperty("BenchEntity"));
+      map.Add(dtEntity::MapComponent::EntityDescriptionId, new dtEntity::StringProperty("Spawned by benchmark"));
+      parent->AddComponent(dtEntity::MapComponent::TYPE, map);
+
+      BenchmarkSpawn("Spawn 2 components", em, *parent);
+
+      // child overrides one property of its parent
+      osg::ref_ptr<dtEntity::Spawner> child = new dtEntity::Spawner("BenchChild", "bench.dtemap", parent.get());
+      dtEntity::GroupProperty childDynamics;
+      childDynamics.Add(dtEntity::DynamicsComponent::VelocityId, new dtEntity::Vec3Property(osg::Vec3(4, 5, 6)));
+      child->AddComponent(dtEntity::DynamicsComponent::TYPE, childDynamics);
+
+      BenchmarkSpawn("Spawn 2 components from child spawner", em, *child);
+   }
+}
@@ -0,0 +1,99 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/stringid.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   // string ids created from literals, as in property and message constructors
+   BENCHMARK(StringId)
+   {
+      const unsigned int numOps = 2000000;
+      const dtEntity::StringId expected = dtEntity::SIDHash("PositionAttitudeTransform");
+      unsigned int sum = 0;
+
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         if(dtEntity::SID("PositionAttitudeTransform") == expected) ++sum;
+      }
+      Report("SID literal string", numOps, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         if(SID_LITERAL("PositionAttitudeTransform") == expected) ++sum;
+      }
+      Report("SID_LITERAL", numOps, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         if(dtEntity::SIDHash("PositionAttitudeTransform") == expected) ++sum;
+      }
+      Report("SIDHash literal string", numOps, watch.GetElapsedSeconds());
+
+      // SID_HASH is a compile time constant, nothing to measure
+
+      DoNotOptimize(&sum);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // SID calls with strings that are already in the reverse lookup table,
+   // as when properties are accessed by name from scripts
+   BENCHMARK(StringIdLookup)
+   {
+      std::vector<std::string> names;
+      for(unsigned int i = 0; i < 10000; ++i)
+      {
+         std::ostringstream os;
+         os << "Component" << i << ".Property" << i * 7;
+         names.push_back(os.str());
+         dtEntity::SID(names.back());
+      }
+
+      const dtEntity::StringId empty = dtEntity::SIDHash("");
+      const unsigned int numOps = 2000000;
+      unsigned int sum = 0;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         if(dtEntity::SID(names[i % names.size()]) == empty) ++sum;
+      }
+      Report("SID 10000 known strings", numOps, watch.GetElapsedSeconds());
+
+      watch.Start();
+      for(unsigned int i = 0; i < numOps; ++i)
+      {
+         if(dtEntity::SIDHash(names[i % names.size()]) == empty) ++sum;
+      }
+      Report("SIDHash 10000 strings", numOps, watch.GetElapsedSeconds());
+
+      DoNotOptimize(&sum);
+   }
+}
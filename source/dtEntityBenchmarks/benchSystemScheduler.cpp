@@ -0,0 +1,102 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/systemscheduler.h>
+#include <sstream>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   // synthetic system that burns a fixed amount of cpu time per tick
+   class BusySystem
+   {
+   public:
+      BusySystem() : mWork(0), mResult(0) {}
+
+      void Tick(const dtEntity::TickData& data)
+      {
+         unsigned int v = mResult;
+         for(unsigned int i = 0; i < mWork; ++i)
+         {
+            v = v * 1664525u + 1013904223u;
+         }
+         mResult = v;
+      }
+
+      unsigned int mWork;
+      unsigned int mResult;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // numChained systems write the same component, the others are independent
+   void BenchmarkScheduler(unsigned int numThreads, unsigned int numSystems, unsigned int numChained)
+   {
+      dtEntity::SystemScheduler scheduler(numThreads);
+      std::vector<BusySystem> systems(numSystems);
+      std::vector<dtEntity::ComponentType> reads;
+      reads.push_back(dtEntity::SID("Transform"));
+      for(unsigned int i = 0; i < numSystems; ++i)
+      {
+         systems[i].mWork = 50000;
+         std::vector<dtEntity::ComponentType> writes;
+         writes.push_back(i < numChained ? dtEntity::SID("Shared") : dtEntity::SID("Own") + i);
+         scheduler.AddTask("Busy", dtEntity::SystemScheduler::TickFunctor(&systems[i], &BusySystem::Tick), reads, writes);
+      }
+
+      dtEntity::TickData data;
+      scheduler.Tick(data);
+
+      const unsigned int numTicks = 200;
+      Stopwatch watch;
+      for(unsigned int i = 0; i < numTicks; ++i)
+      {
+         scheduler.Tick(data);
+      }
+      double seconds = watch.GetElapsedSeconds();
+
+      for(unsigned int i = 0; i < numSystems; ++i)
+      {
+         DoNotOptimize(&systems[i].mResult);
+      }
+
+      std::ostringstream os;
+      os << "SystemScheduler::Tick " << numSystems << " systems, " << numChained
+         << " conflicting, " << numThreads << " threads";
+      Report(os.str(), numTicks, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(SystemScheduler)
+   {
+      unsigned int threads[] = { 1, 2, 4, 8 };
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         BenchmarkScheduler(threads[i], 16, 0);
+      }
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         BenchmarkScheduler(threads[i], 16, 8);
+      }
+   }
+}
@@ -0,0 +1,98 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+#include "benchmark.h"
+
+#include <dtEntity/core.h>
+#include <dtEntity/dynamicscomponent.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/headlesssysteminterface.h>
+#include <dtEntity/mapcomponent.h>
+#include <dtEntityWrappers/scriptcomponent.h>
+#include <iostream>
+#include <sstream>
+#include <v8.h>
+
+namespace dtEntityBenchmarks
+{
+   ////////////////////////////////////////////////////////////////////////////////
+   // runs loopBody numIterations times in a script loop, comp is the wrapped dynamics component
+   static void BenchmarkScript(dtEntityWrappers::ScriptSystem& scriptSystem, dtEntity::EntityId eid,
+                               const std::string& name, const std::string& loopBody)
+   {
+      const unsigned int numIterations = 200000;
+      std::ostringstream code;
+      code << "(function() {"
+           << "  var comp = EntityManager.getEntitySystem(\"Dynamics\").getComponent(" << eid << ");"
+           << "  var sum = 0;"
+           << "  for(var i = 0; i < " << numIterations << "; ++i) { " << loopBody << " }"
+           << "  return sum;"
+           << "})()";
+
+      v8::HandleScope scope;
+      Stopwatch watch;
+      v8::Handle<v8::Value> result = scriptSystem.ExecuteJS(code.str());
+      double seconds = watch.GetElapsedSeconds();
+      if(result.IsEmpty())
+      {
+         std::cout << "Script failed: " << name << std::endl;
+         return;
+      }
+      Report(name, numIterations, seconds);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BENCHMARK(V8PropertyAccess)
+   {
+      dtEntity::EntityManager em;
+      dtEntity::HeadlessSystemInterface* iface = NULL;
+      if(dtEntity::GetSystemInterface() == NULL)
+      {
+         iface = new dtEntity::HeadlessSystemInterface(em.GetMessagePump(), 0, NULL);
+         dtEntity::SetSystemInterface(iface);
+      }
+
+      {
+         em.AddEntitySystem(*new dtEntity::MapSystem(em));
+         em.AddEntitySystem(*new dtEntity::DynamicsSystem(em));
+         dtEntityWrappers::ScriptSystem* scriptSystem = new dtEntityWrappers::ScriptSystem(em);
+         em.AddEntitySystem(*scriptSystem);
+
+         dtEntity::Entity* entity = NULL;
+         em.CreateEntity(entity);
+         dtEntity::DynamicsComponent* dc = NULL;
+         em.CreateComponent(entity->GetId(), dc);
+
+         BenchmarkScript(*scriptSystem, entity->GetId(), "Baseline, empty script loop", "sum += i;");
+         BenchmarkScript(*scriptSystem, entity->GetId(), "Get Vec3 property from script", "sum += comp.Velocity[0];");
+         BenchmarkScript(*scriptSystem, entity->GetId(), "Set Vec3 property from script", "comp.Velocity = [i, 0, 0];");
+         BenchmarkScript(*scriptSystem, entity->GetId(), "Get Quat property from script", "sum += comp.AngularVelocity[3];");
+      }
+
+      if(iface != NULL)
+      {
+         dtEntity::SetSystemInterface(NULL);
+         delete iface;
+      }
+   }
+}
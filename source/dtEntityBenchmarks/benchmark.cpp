@@ -0,0 +1,286 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include "benchmark.h"
+
+#include <dtEntity/dtentity_config.h>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+namespace dtEntityBenchmarks
+{
+   struct BenchmarkEntry
+   {
+      const char* mName;
+      BenchmarkFunction mFunction;
+   };
+
+   // all measurements of one reported operation, one per repetition
+   struct BenchmarkResult
+   {
+      std::string mBenchmark;
+      std::string mName;
+      unsigned int mNumOperations;
+      std::vector<double> mNsPerOp;
+   };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   // function-local static so that registration order of translation units does not matter
+   static std::vector<BenchmarkEntry>& GetBenchmarks()
+   {
+      static std::vector<BenchmarkEntry> benchmarks;
+      return benchmarks;
+   }
+
+   static std::vector<BenchmarkResult> s_results;
+
+   // name of benchmark that is currently running
+   static std::string s_currentBenchmark;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   BenchmarkRegistrar::BenchmarkRegistrar(const char* name, BenchmarkFunction func)
+   {
+      BenchmarkEntry e;
+      e.mName = name;
+      e.mFunction = func;
+      GetBenchmarks().push_back(e);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void Report(const std::string& name, unsigned int numOperations, double seconds)
+   {
+      double nsPerOp = numOperations == 0 ? 0 : seconds * 1e9 / numOperations;
+      double opsPerSec = seconds <= 0 ? 0 : numOperations / seconds;
+      std::cout << std::left << std::setw(56) << name
+                << std::right << std::setw(12) << std::fixed << std::setprecision(2) << nsPerOp << " ns/op"
+                << std::setw(16) << std::setprecision(0) << opsPerSec << " ops/s" << std::endl;
+
+      for(std::vector<BenchmarkResult>::iterator i = s_results.begin(); i != s_results.end(); ++i)
+      {
+         if(i->mBenchmark == s_currentBenchmark && i->mName == name)
+         {
+            i->mNsPerOp.push_back(nsPerOp);
+            return;
+         }
+      }
+      BenchmarkResult r;
+      r.mBenchmark = s_currentBenchmark;
+      r.mName = name;
+      r.mNumOperations = numOperations;
+      r.mNsPerOp.push_back(nsPerOp);
+      s_results.push_back(r);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   int RunBenchmarks(const std::string& filter, unsigned int repetitions)
+   {
+      int count = 0;
+      std::vector<BenchmarkEntry>& benchmarks = GetBenchmarks();
+      for(std::vector<BenchmarkEntry>::iterator i = benchmarks.begin(); i != benchmarks.end(); ++i)
+      {
+         if(!filter.empty() && std::string(i->mName).find(filter) == std::string::npos)
+         {
+            continue;
+         }
+         s_currentBenchmark = i->mName;
+         for(unsigned int rep = 0; rep < repetitions; ++rep)
+         {
+            std::cout << "--- " << i->mName;
+            if(repetitions > 1)
+            {
+               std::cout << " (" << rep + 1 << "/" << repetitions << ")";
+            }
+            std::cout << std::endl;
+            i->mFunction();
+         }
+         ++count;
+      }
+      s_currentBenchmark.clear();
+      return count;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void ListBenchmarks()
+   {
+      std::vector<BenchmarkEntry>& benchmarks = GetBenchmarks();
+      for(std::vector<BenchmarkEntry>::iterator i = benchmarks.begin(); i != benchmarks.end(); ++i)
+      {
+         std::cout << i->mName << std::endl;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static std::string EscapeJson(const std::string& str)
+   {
+      std::string out;
+      for(std::string::const_iterator i = str.begin(); i != str.end(); ++i)
+      {
+         switch(*i)
+         {
+         case '"':  out += "\\\""; break;
+         case '\\': out += "\\\\"; break;
+         case '\n': out += "\\n"; break;
+         case '\t': out += "\\t"; break;
+         default:   out += *i;
+         }
+      }
+      return out;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static std::string GetCompilerName()
+   {
+      std::ostringstream os;
+#if defined(_MSC_VER)
+      os << "MSVC " << _MSC_VER;
+#elif defined(__clang__)
+      os << "clang " << __clang_major__ << "." << __clang_minor__ << "." << __clang_patchlevel__;
+#elif defined(__GNUC__)
+      os << "gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "." << __GNUC_PATCHLEVEL__;
+#else
+      os << "unknown";
+#endif
+      return os.str();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool WriteJsonReport(const std::string& path)
+   {
+      std::ofstream out(path.c_str());
+      if(!out)
+      {
+         return false;
+      }
+
+      char timestamp[32];
+      time_t now = time(NULL);
+      strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+#ifdef NDEBUG
+      const char* buildType = "release";
+#else
+      const char* buildType = "debug";
+#endif
+
+      out << "{\n"
+          << "  \"version\": 1,\n"
+          << "  \"timestamp\": \"" << timestamp << "\",\n"
+          << "  \"build\": {\n"
+          << "    \"compiler\": \"" << EscapeJson(GetCompilerName()) << "\",\n"
+          << "    \"type\": \"" << buildType << "\",\n"
+          << "    \"stringsAsStringIds\": " << (DTENTITY_USE_STRINGS_AS_STRINGIDS ? "true" : "false") << ",\n"
+          << "    \"processors\": " << OpenThreads::GetNumberOfProcessors() << "\n"
+          << "  },\n"
+          << "  \"results\": [";
+
+      out << std::setprecision(6);
+      for(std::vector<BenchmarkResult>::const_iterator i = s_results.begin(); i != s_results.end(); ++i)
+      {
+         std::vector<double> sorted = i->mNsPerOp;
+         std::sort(sorted.begin(), sorted.end());
+         size_t mid = sorted.size() / 2;
+         double median = (sorted.size() % 2 == 1) ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+
+         out << (i == s_results.begin() ? "\n" : ",\n")
+             << "    {\"benchmark\": \"" << EscapeJson(i->mBenchmark) << "\""
+             << ", \"name\": \"" << EscapeJson(i->mName) << "\""
+             << ", \"operations\": " << i->mNumOperations
+             << ", \"repetitions\": " << sorted.size()
+             << ", \"nsPerOp\": " << median
+             << ", \"nsPerOpMin\": " << sorted.front()
+             << ", \"nsPerOpMax\": " << sorted.back()
+             << "}";
+      }
+      out << "\n  ]\n}\n";
+      return out.good();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   static const void* volatile s_sink;
+   void DoNotOptimize(const void* p)
+   {
+      s_sink = p;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * dtEntityBenchmarks [filter] [--repeat 5] [--json results.json] [--list]
+ *
+ * Runs all benchmarks whose name contains filter. With --repeat every
+ * benchmark is run several times and the JSON report contains the median.
+ * Compare two JSON reports with compare_benchmarks.py.
+ */
+int main(int argc, char** argv)
+{
+   std::string filter;
+   std::string jsonPath;
+   unsigned int repetitions = 1;
+
+   for(int curArg = 1; curArg < argc; ++curArg)
+   {
+      std::string curArgv = argv[curArg];
+      bool hasValue = curArg + 1 < argc;
+      if(curArgv == "--json" && hasValue)
+      {
+         jsonPath = argv[++curArg];
+      }
+      else if(curArgv == "--repeat" && hasValue)
+      {
+         int r = atoi(argv[++curArg]);
+         repetitions = r > 0 ? r : 1;
+      }
+      else if(curArgv == "--list")
+      {
+         dtEntityBenchmarks::ListBenchmarks();
+         return 0;
+      }
+      else
+      {
+         filter = curArgv;
+      }
+   }
+
+   int count = dtEntityBenchmarks::RunBenchmarks(filter, repetitions);
+   if(count == 0)
+   {
+      std::cout << "No benchmark matches filter " << filter << std::endl;
+      return 1;
+   }
+
+   if(!jsonPath.empty())
+   {
+      if(!dtEntityBenchmarks::WriteJsonReport(jsonPath))
+      {
+         std::cerr << "Could not write " << jsonPath << std::endl;
+         return 1;
+      }
+      std::cout << "Wrote results to " << jsonPath << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+#include <osg/Timer>
+#include <string>
+
+namespace dtEntityBenchmarks
+{
+   typedef void (*BenchmarkFunction)();
+
+   /**
+    * Adds a benchmark function to the global benchmark list at static
+    * initialization time. Use the BENCHMARK macro instead of using this directly.
+    */
+   class BenchmarkRegistrar
+   {
+   public:
+      BenchmarkRegistrar(const char* name, BenchmarkFunction func);
+   };
+
+   /**
+    * Measures wall clock time since construction or last call to Start()
+    */
+   class Stopwatch
+   {
+   public:
+      Stopwatch() { Start(); }
+
+      void Start() { mStart = osg::Timer::instance()->tick(); }
+
+      double GetElapsedSeconds() const
+      {
+         return osg::Timer::instance()->delta_s(mStart, osg::Timer::instance()->tick());
+      }
+
+   private:
+      osg::Timer_t mStart;
+   };
+
+   /**
+    * Report a measurement.
+    * @param name Name of the measured operation
+    * @param numOperations Number of operations that were executed
+    * @param seconds Time it took to execute them
+    */
+   void Report(const std::string& name, unsigned int numOperations, double seconds);
+
+   /**
+    * Run all registered benchmarks whose name contains filter.
+    * @param repetitions How often each benchmark is run
+    * @return number of benchmarks run
+    */
+   int RunBenchmarks(const std::string& filter, unsigned int repetitions = 1);
+
+   /**
+    * Print names of all registered benchmarks
+    */
+   void ListBenchmarks();
+
+   /**
+    * Write all reported measurements to a JSON file. For operations that were
+    * measured more than once the median, minimum and maximum are written.
+    * @return false if file could not be written
+    */
+   bool WriteJsonReport(const std::string& path);
+
+   /**
+    * Keeps the optimizer from removing a computation whose result is unused
+    */
+   void DoNotOptimize(const void* p);
+}
+
+#define BENCHMARK(Name) \
+   static void Benchmark##Name(); \
+   static dtEntityBenchmarks::BenchmarkRegistrar s_benchmarkRegistrar##Name(#Name, &Benchmark##Name); \
+   static void Benchmark##Name()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+#
+# dtEntity Game and Simulation Engine
+#
+# Compares two JSON reports written by dtEntityBenchmarks --json and
+# prints the change of ns/op for every measurement found in both.
+#
+# usage: compare_benchmarks.py baseline.json current.json [--threshold 10] [--filter name]
+#
+# Exits with status 1 if a measurement got slower by more than threshold
+# percent, so the script can fail a CI job. Use --repeat when recording
+# reports, single runs are noisy.
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        report = json.load(f)
+    results = {}
+    for r in report["results"]:
+        results[(r["benchmark"], r["name"])] = r
+    return report, results
+
+
+def describe_build(report):
+    build = report.get("build", {})
+    return "%s %s, %s processors, %s" % (build.get("compiler", "?"), build.get("type", "?"),
+                                        build.get("processors", "?"), report.get("timestamp", "?"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two dtEntityBenchmarks JSON reports")
+    parser.add_argument("baseline", help="report of the reference build")
+    parser.add_argument("current", help="report of the build to check")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percentage of slowdown that counts as regression (default 10)")
+    parser.add_argument("--filter", default="",
+                        help="only compare benchmarks whose name contains this string")
+    args = parser.parse_args()
+
+    baseline_report, baseline = load_results(args.baseline)
+    current_report, current = load_results(args.current)
+
+    print("baseline: %s (%s)" % (args.baseline, describe_build(baseline_report)))
+    print("current:  %s (%s)" % (args.current, describe_build(current_report)))
+    print()
+    print("%-72s %12s %12s %9s" % ("measurement", "base ns/op", "cur ns/op", "change"))
+
+    regressions = []
+    improvements = 0
+    keys = [k for k in sorted(current.keys()) if args.filter in k[0]]
+    for key in keys:
+        if key not in baseline:
+            continue
+        old = baseline[key]["nsPerOp"]
+        new = current[key]["nsPerOp"]
+        if old <= 0:
+            continue
+        change = (new - old) * 100.0 / old
+        marker = ""
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions.append(key)
+        elif change < -args.threshold:
+            marker = "  faster"
+            improvements += 1
+        label = "%s: %s" % key
+        print("%-72s %12.2f %12.2f %+8.1f%%%s" % (label[:72], old, new, change, marker))
+
+    missing = [k for k in sorted(baseline.keys()) if args.filter in k[0] and k not in current]
+    added = [k for k in keys if k not in baseline]
+    for key in missing:
+        print("only in baseline: %s: %s" % key)
+    for key in added:
+        print("only in current:  %s: %s" % key)
+
+    print()
+    print("%d compared, %d faster, %d slower by more than %.1f%%" %
+          (len([k for k in keys if k in baseline]), improvements, len(regressions), args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -160,7 +160,7 @@ namespace dtEntityCEGUI
    ////////////////////////////////////////////////////////////////////////////////
    ResourceProvider mResProvider;
    bool CEGUISystem::SystemAndRendererCreatedByHUD = false;
-   const dtEntity::StringId CEGUISystem::TYPE(dtEntity::SID("CEGUI"));
+   const dtEntity::StringId CEGUISystem::TYPE(SID_LITERAL("CEGUI"));
 
    
    ////////////////////////////////////////////////////////////////////////////////
@@ -21,8 +21,8 @@ namespace dtEntityCal3d
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId Cal3dComponent::TYPE(dtEntity::SID("Cal3d"));
-   const dtEntity::StringId Cal3dComponent::PathId(dtEntity::SID("Path"));
+   const dtEntity::StringId Cal3dComponent::TYPE(SID_LITERAL("Cal3d"));
+   const dtEntity::StringId Cal3dComponent::PathId(SID_LITERAL("Path"));
 
 
    ////////////////////////////////////////////////////////////////////////////
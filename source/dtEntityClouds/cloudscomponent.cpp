@@ -134,14 +134,15 @@ namespace dtEntityCloud
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId CloudsComponent::TYPE(dtEntity::SID("Clouds"));
-   const dtEntity::StringId CloudsComponent::WindId(dtEntity::SID("Wind"));
-   const dtEntity::StringId CloudsComponent::CloudCoverId(dtEntity::SID("CloudCover"));
-   const dtEntity::StringId CloudsComponent::CloudSharpnessId(dtEntity::SID("CloudSharpness"));
-   const dtEntity::StringId CloudsComponent::CloudMutationRateId(dtEntity::SID("CloudMutationRate"));
-   const dtEntity::StringId CloudsComponent::SunPosId(dtEntity::SID("SunPos"));
-   const dtEntity::StringId CloudsComponent::TraceStartId(dtEntity::SID("TraceStart"));
-   const dtEntity::StringId CloudsComponent::TraceDistId(dtEntity::SID("TraceDist"));   
+   const dtEntity::StringId CloudsComponent::TYPE(SID_LITERAL("Clouds"));
+   const dtEntity::StringId CloudsComponent::WindId(SID_LITERAL("Wind"));
+   const dtEntity::StringId CloudsComponent::CloudCoverId(SID_LITERAL("CloudCover"));
+   const dtEntity::StringId CloudsComponent::CloudSharpnessId(SID_LITERAL("CloudSharpness"));
+   const dtEntity::StringId CloudsComponent::CloudMutationRateId(SID_LITERAL("CloudMutationRate"));
+   const dtEntity::StringId CloudsComponent::SunPosId(SID_LITERAL("SunPos"));
+   const dtEntity::StringId CloudsComponent::TraceStartId(SID_LITERAL("TraceStart"));
+   const dtEntity::StringId CloudsComponent::TraceDistId(SID_LITERAL("TraceDist"));   
+   dtEntity::PropertySchema CloudsComponent::sPropertySchema;
    
    ////////////////////////////////////////////////////////////////////////////
    CloudsComponent::CloudsComponent()
@@ -175,13 +176,13 @@ namespace dtEntityCloud
       )
       , mDrawables(new osg::Group())
    {
-      Register(WindId, &mWind);
-      Register(CloudCoverId, &mCloudCover);
-      Register(CloudSharpnessId, &mCloudSharpness);
-      Register(CloudMutationRateId, &mCloudMutationRate);
-      Register(SunPosId, &mSunPos);
-      Register(TraceStartId, &mTraceStart);
-      Register(TraceDistId, &mTraceDist);
+      Register(sPropertySchema, WindId, &mWind);
+      Register(sPropertySchema, CloudCoverId, &mCloudCover);
+      Register(sPropertySchema, CloudSharpnessId, &mCloudSharpness);
+      Register(sPropertySchema, CloudMutationRateId, &mCloudMutationRate);
+      Register(sPropertySchema, SunPosId, &mSunPos);
+      Register(sPropertySchema, TraceStartId, &mTraceStart);
+      Register(sPropertySchema, TraceDistId, &mTraceDist);
 
       unsigned int noiseSize = 256;
       unsigned int combinedSize = 256;
@@ -565,12 +566,13 @@ namespace dtEntityCloud
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
 
-   const dtEntity::StringId CloudsSystem::TYPE(dtEntity::SID("Clouds"));
+   const dtEntity::StringId CloudsSystem::TYPE(SID_LITERAL("Clouds"));
 
    ////////////////////////////////////////////////////////////////////////////
    CloudsSystem::CloudsSystem(dtEntity::EntityManager& em)
       : BaseClass(em)
    {    
+      dtEntityOSG::SceneGraphChanges::AddDirectWriter();
 #if OSGEPHEMERIS_FOUND
       mTickFunctor = dtEntity::MessageFunctor(this, &CloudsSystem::Tick);
       GetEntityManager().RegisterForMessages(dtEntity::TickMessage::TYPE,
@@ -581,6 +583,7 @@ namespace dtEntityCloud
    ////////////////////////////////////////////////////////////////////////////
    CloudsSystem::~CloudsSystem()
    {
+      dtEntityOSG::SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -81,6 +81,8 @@ namespace dtEntityCloud
       osg::Camera* CreateCloudDensityCam(osg::Texture2D* tex, unsigned int texsize) const;
       osg::Geometry* CreateCloudPlane() const;
 
+      static dtEntity::PropertySchema sPropertySchema;
+
       dtEntity::DynamicVec3Property mSunPos;
       dtEntity::DynamicVec2Property mWind;
       dtEntity::DynamicFloatProperty mCloudCover;
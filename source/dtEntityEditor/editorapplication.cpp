@@ -63,7 +63,7 @@ namespace dtEntityEditor
       , mTimeScale(1)
       , mFileSystemWatcher(new QFileSystemWatcher())
    {
-      dtEntity::SetSystemInterface(new dtEntityOSG::OSGSystemInterface(mEntityManager->GetMessagePump(), argc, (const char**) argv));
+      dtEntity::SetSystemInterface(new dtEntityOSG::OSGSystemInterface(*mEntityManager, argc, (const char**) argv));
       dtEntity::SetWindowInterface(new dtEntityOSG::OSGWindowInterface(*mEntityManager));
       dtEntity::SetInputInterface(new dtEntityOSG::OSGInputInterface(mEntityManager->GetMessagePump()));
 
@@ -370,10 +370,10 @@ namespace dtEntityEditor
             motioncomp->Finished();
          }
       }
-      dtEntity::EntitySystem* soundsys = mEntityManager->GetEntitySystem(dtEntity::SID("Sound"));
+      dtEntity::EntitySystem* soundsys = mEntityManager->GetEntitySystem(SID_LITERAL("Sound"));
       if(soundsys)
       {
-          soundsys->SetUInt(dtEntity::SID("ListenerEntity"), camid);
+          soundsys->SetUInt(SID_LITERAL("ListenerEntity"), camid);
           soundsys->Finished();
       }
    }
@@ -445,7 +445,7 @@ namespace dtEntityEditor
    void EditorApplication::InitializeScripting()
    {
 
-      dtEntity::StringId scriptId = dtEntity::SID("Script");
+      dtEntity::StringId scriptId = SID_LITERAL("Script");
 
       if(!GetEntityManager().HasEntitySystem(scriptId))
       {
@@ -464,10 +464,10 @@ namespace dtEntityEditor
       }
 
       dtEntity::Message* msg;
-      bool success = dtEntity::MessageFactory::GetInstance().CreateMessage(dtEntity::SID("ExecuteScriptMessage"), msg);
+      bool success = dtEntity::MessageFactory::GetInstance().CreateMessage(SID_LITERAL("ExecuteScriptMessage"), msg);
       assert(success);
-      msg->Get(dtEntity::SID("IncludeOnce"))->SetBool(true);
-      dtEntity::Property* pathprop = msg->Get(dtEntity::SID("Path"));
+      msg->Get(SID_LITERAL("IncludeOnce"))->SetBool(true);
+      dtEntity::Property* pathprop = msg->Get(SID_LITERAL("Path"));
 
       pathprop->SetString("Scripts/editorautostart.js");
       GetEntityManager().EmitMessage(*msg);
@@ -30,17 +30,17 @@
 namespace dtEntityEditor
 {
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId MotionModelComponent::TYPE(dtEntity::SID("MotionModel"));
+   const dtEntity::StringId MotionModelComponent::TYPE(SID_LITERAL("MotionModel"));
 
-   const dtEntity::StringId MotionModelComponent::ContextIdId(dtEntity::SID("ContextId"));
-   const dtEntity::StringId MotionModelComponent::MoveSpeedId(dtEntity::SID("MoveSpeed"));
-   const dtEntity::StringId MotionModelComponent::RotateSpeedId(dtEntity::SID("RotateSpeed"));
-   const dtEntity::StringId MotionModelComponent::RotateKeySpeedId(dtEntity::SID("RotateKeySpeed"));
-   const dtEntity::StringId MotionModelComponent::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId MotionModelComponent::ContextIdId(SID_LITERAL("ContextId"));
+   const dtEntity::StringId MotionModelComponent::MoveSpeedId(SID_LITERAL("MoveSpeed"));
+   const dtEntity::StringId MotionModelComponent::RotateSpeedId(SID_LITERAL("RotateSpeed"));
+   const dtEntity::StringId MotionModelComponent::RotateKeySpeedId(SID_LITERAL("RotateKeySpeed"));
+   const dtEntity::StringId MotionModelComponent::EnabledId(SID_LITERAL("Enabled"));
 
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId MotionModelSystem::TYPE(dtEntity::SID("MotionModel"));
+   const dtEntity::StringId MotionModelSystem::TYPE(SID_LITERAL("MotionModel"));
 
    ////////////////////////////////////////////////////////////////////////////
    MotionModelComponent::MotionModelComponent()
@@ -325,9 +325,8 @@ namespace dtEntityEditor
    MotionModelSystem::MotionModelSystem(dtEntity::EntityManager& em)
       : BaseClass(em)
    {
-      mTickFunctor = dtEntity::MessageFunctor(this, &MotionModelSystem::Tick);
-      GetEntityManager().RegisterForMessages(dtEntity::TickMessage::TYPE,
-         mTickFunctor, dtEntity::FilterOptions::ORDER_DEFAULT, "MotionModelSystem::Tick");
+      mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(this, &MotionModelSystem::Tick);
+      GetEntityManager().RegisterForTick(*this, mTickFunctor, "MotionModelSystem::Tick");
 
       mMoveToPosFunctor = dtEntity::MessageFunctor(this, &MotionModelSystem::MoveToPos);
       GetEntityManager().RegisterForMessages(dtEntity::MoveCameraToPositionMessage::TYPE,
@@ -341,15 +340,25 @@ namespace dtEntityEditor
    ////////////////////////////////////////////////////////////////////////////
    MotionModelSystem::~MotionModelSystem()
    {
+      GetEntityManager().UnregisterForTick(mTickFunctor);
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void MotionModelSystem::Tick(const dtEntity::Message& m)
+   bool MotionModelSystem::GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const
+   {
+      // moves the camera of the component, cameras are transforms
+      writes.push_back(TYPE);
+      writes.push_back(dtEntityOSG::CameraComponent::TYPE);
+      writes.push_back(dtEntityOSG::TransformComponent::TYPE);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void MotionModelSystem::Tick(const dtEntity::TickData& msg)
    {
-      const dtEntity::TickMessage& msg = static_cast<const dtEntity::TickMessage&>(m);
       for(ComponentStore::iterator i = mComponents.begin(); i != mComponents.end(); ++i)
       {
-         i->second->Tick(msg.GetDeltaRealTime());
+         i->second->Tick(msg.mDeltaRealTime);
       }
    }
 
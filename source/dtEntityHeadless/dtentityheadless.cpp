@@ -0,0 +1,220 @@
+/* -*-c++-*-
+* dtEntity Game and Simulation Engine
+*
+* Copyright (c) 2013 Martin Scheffler
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+* and associated documentation files (the "Software"), to deal in the Software without restriction,
+* including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies 
+* or substantial portions of the Software.
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+* INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+* PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+* FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*/
+
+
+/**
+ * Runs a scene without a window for a fixed number of ticks and reports
+ * ticks per second. Used for dedicated servers, CI and performance tests.
+ *
+ * dtEntityHeadless --scene Scenes/test.dtescene --ticks 1000 [--timestep 0.0166]
+ *                  [--realtime] [--maxCatchUp 5] [--journal messages.dtj]
+ *                  [--logLevel warning] [--logFile log.txt]
+ *                  [--projectAssets path] [--baseAssets path]
+ *
+ * Without --realtime, ticks run as fast as possible.
+ * --journal replays a message journal recorded with MessageJournalRecorder
+ * in sync with simulation time.
+ * --logLevel drops log messages less severe than given level,
+ * --logFile writes log messages from a background thread instead of the console.
+ */
+
+#include <dtEntity/asyncloglistener.h>
+#include <dtEntity/core.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/headlesssysteminterface.h>
+#include <dtEntity/init.h>
+#include <dtEntity/log.h>
+#include <dtEntity/mapcomponent.h>
+#include <dtEntity/messagejournal.h>
+#include <dtEntity/systemmessages.h>
+#include <osg/Timer>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+// replays journal messages that are due before each tick
+class JournalTicker
+{
+public:
+   JournalTicker(dtEntity::MessageJournalPlayer& player)
+      : mPlayer(&player)
+      , mNumPlayed(0)
+   {
+   }
+
+   void Tick(const dtEntity::TickData& tick)
+   {
+      mNumPlayed += mPlayer->PlayUntil(tick.mSimulationTime);
+   }
+
+   dtEntity::MessageJournalPlayer* mPlayer;
+   unsigned int mNumPlayed;
+};
+
+// removes the async log listener when leaving main, so that its writer
+// thread is stopped before the log file is closed
+class AsyncLogGuard
+{
+public:
+   ~AsyncLogGuard()
+   {
+      if(mListener.valid())
+      {
+         dtEntity::LogManager::GetInstance().RemoveListener(mListener);
+      }
+   }
+
+   osg::ref_ptr<dtEntity::AsyncLogListener> mListener;
+};
+
+int main(int argc, char** argv)
+{
+   std::string scene;
+   std::string journal;
+   std::string logFile;
+   dtEntity::LogLevel::e logLevel = dtEntity::LogLevel::LVL_DEBUG;
+   unsigned int numTicks = 1000;
+   float timeStep = 1.0f / 60.0f;
+   bool realtime = false;
+   unsigned int maxCatchUp = 5;
+
+   for(int curArg = 1; curArg < argc; ++curArg)
+   {
+      std::string curArgv = argv[curArg];
+      bool hasValue = curArg + 1 < argc;
+      if(curArgv == "--scene" && hasValue)
+      {
+         scene = argv[++curArg];
+      }
+      else if(curArgv == "--journal" && hasValue)
+      {
+         journal = argv[++curArg];
+      }
+      else if(curArgv == "--logFile" && hasValue)
+      {
+         logFile = argv[++curArg];
+      }
+      else if(curArgv == "--logLevel" && hasValue)
+      {
+         if(!dtEntity::LogLevel::FromName(argv[++curArg], logLevel))
+         {
+            std::cerr << "Unknown log level " << argv[curArg] << std::endl;
+            return 1;
+         }
+      }
+      else if(curArgv == "--ticks" && hasValue)
+      {
+         numTicks = atoi(argv[++curArg]);
+      }
+      else if(curArgv == "--timestep" && hasValue)
+      {
+         timeStep = static_cast<float>(atof(argv[++curArg]));
+      }
+      else if(curArgv == "--maxCatchUp" && hasValue)
+      {
+         maxCatchUp = atoi(argv[++curArg]);
+      }
+      else if(curArgv == "--realtime")
+      {
+         realtime = true;
+      }
+   }
+
+   std::ofstream logStream;
+   AsyncLogGuard asyncLog;
+   if(!logFile.empty())
+   {
+      logStream.open(logFile.c_str());
+      if(!logStream)
+      {
+         std::cerr << "Could not open log file " << logFile << std::endl;
+         return 1;
+      }
+      asyncLog.mListener = new dtEntity::AsyncLogListener(logStream);
+      dtEntity::LogManager::GetInstance().AddListener(asyncLog.mListener);
+   }
+   else
+   {
+      dtEntity::LogManager::GetInstance().AddListener(new dtEntity::ConsoleLogHandler());
+   }
+   dtEntity::LogManager::GetInstance().SetLogLevel(logLevel);
+
+   dtEntity::EntityManager em;
+
+   dtEntity::HeadlessSystemInterface* iface = new dtEntity::HeadlessSystemInterface(em.GetMessagePump(), argc, (const char**)argv);
+   dtEntity::SetSystemInterface(iface);
+   iface->SetFixedTimeStep(timeStep);
+   iface->SetRealTimePacing(realtime);
+   iface->SetMaxCatchUpTicks(maxCatchUp);
+
+   dtEntity::SetupDataPaths(argc, argv, false);
+   dtEntity::AddDefaultEntitySystemsAndFactories(argc, argv, em);
+
+   if(!scene.empty())
+   {
+      dtEntity::MapSystem* mapSystem;
+      em.GetES(mapSystem);
+      if(!mapSystem->LoadScene(scene))
+      {
+         LOG_ERROR("Could not load scene " + scene);
+         return 1;
+      }
+   }
+
+   dtEntity::MessageJournalPlayer player(em);
+   JournalTicker journalTicker(player);
+   dtEntity::TypedMessageFunctor<dtEntity::TickData>::type journalFunctor(&journalTicker, &JournalTicker::Tick);
+   if(!journal.empty())
+   {
+      if(!player.Open(journal))
+      {
+         LOG_ERROR("Could not open message journal " + journal);
+         return 1;
+      }
+      em.RegisterForTypedMessages<dtEntity::TickData>(journalFunctor, dtEntity::FilterOptions::PRIORITY_HIGHEST, "JournalTicker::Tick");
+   }
+
+   dtEntity::StartSystemMessage msg;
+   em.EnqueueMessage(msg);
+
+   osg::Timer_t start = osg::Timer::instance()->tick();
+   while(iface->GetNumTicks() < numTicks)
+   {
+      iface->Step();
+   }
+   double seconds = osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick());
+
+   std::cout << "Ran " << iface->GetNumTicks() << " ticks in " << seconds << " s, "
+             << (seconds > 0 ? iface->GetNumTicks() / seconds : 0) << " ticks/s, simulation time "
+             << iface->GetSimulationTime() << " s, " << iface->GetNumDroppedTicks() << " ticks dropped";
+   if(!journal.empty())
+   {
+      std::cout << ", " << journalTicker.mNumPlayed << " journal messages replayed";
+      em.UnregisterForTypedMessages<dtEntity::TickData>(journalFunctor);
+   }
+   std::cout << std::endl;
+
+   if(asyncLog.mListener.valid() && asyncLog.mListener->GetNumDropped() > 0)
+   {
+      std::cout << asyncLog.mListener->GetNumDropped() << " log messages dropped" << std::endl;
+   }
+   return 0;
+}
@@ -36,8 +36,8 @@ namespace dtEntityNet
 {
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId DeadReckoningReceiverComponent::TYPE(dtEntity::SID("DeadReckoningReceiver"));
-   const dtEntity::StringId DeadReckoningReceiverComponent::UniqueIdId(dtEntity::SID("UniqueId"));
+   const dtEntity::StringId DeadReckoningReceiverComponent::TYPE(SID_LITERAL("DeadReckoningReceiver"));
+   const dtEntity::StringId DeadReckoningReceiverComponent::UniqueIdId(SID_LITERAL("UniqueId"));
 
    ////////////////////////////////////////////////////////////////////////////
    DeadReckoningReceiverComponent::DeadReckoningReceiverComponent()
@@ -50,8 +50,8 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId DeadReckoningReceiverSystem::TYPE(dtEntity::SID("DeadReckoningReceiver"));
-   const dtEntity::StringId DeadReckoningReceiverSystem::SpawnFromEntityTypeId(dtEntity::SID("SpawnFromEntityType"));
+   const dtEntity::StringId DeadReckoningReceiverSystem::TYPE(SID_LITERAL("DeadReckoningReceiver"));
+   const dtEntity::StringId DeadReckoningReceiverSystem::SpawnFromEntityTypeId(SID_LITERAL("SpawnFromEntityType"));
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
@@ -60,7 +60,7 @@ namespace dtEntityNet
       : BaseClass(em)
       , mMapSystem(NULL)
    {
-      mTickFunctor = dtEntity::MessageFunctor(this, &DeadReckoningReceiverSystem::Tick);
+      mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(this, &DeadReckoningReceiverSystem::Tick);
 
       em.GetES(mMapSystem);
 
@@ -72,26 +72,35 @@ namespace dtEntityNet
    ////////////////////////////////////////////////////////////////////////////
    DeadReckoningReceiverSystem::~DeadReckoningReceiverSystem()
    {
+      GetEntityManager().UnregisterForTick(mTickFunctor);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void DeadReckoningReceiverSystem::OnAddedToEntityManager(dtEntity::EntityManager &em)
    {
-      GetEntityManager().RegisterForMessages(dtEntity::TickMessage::TYPE,
-         mTickFunctor, dtEntity::FilterOptions::ORDER_DEFAULT, "DeadReckoningReceiverSystem::Tick");
+      GetEntityManager().RegisterForTick(*this, mTickFunctor, "DeadReckoningReceiverSystem::Tick");
 
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void DeadReckoningReceiverSystem::OnRemovedFromEntityManager(dtEntity::EntityManager &em)
    {
-      GetEntityManager().UnregisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor);
+      GetEntityManager().UnregisterForTick(mTickFunctor);
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void DeadReckoningReceiverSystem::Tick(const dtEntity::Message& m)
+   bool DeadReckoningReceiverSystem::GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const
+   {
+      // SetVelocity enqueues its message when called from concurrent handler
+      reads.push_back(TYPE);
+      writes.push_back(dtEntityOSG::TransformComponent::TYPE);
+      writes.push_back(dtEntity::DynamicsComponent::TYPE);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void DeadReckoningReceiverSystem::Tick(const dtEntity::TickData& msg)
    {
-      const dtEntity::TickMessage& msg = static_cast<const dtEntity::TickMessage&>(m);
 
       for(ComponentStore::iterator i = mComponents.begin();i != mComponents.end(); ++i)
       {
@@ -148,7 +157,7 @@ namespace dtEntityNet
                            comp->mOrientation,
                            comp->mVelocity,
                            comp->mAngularVelocity,
-                           msg.GetSimulationTime() - comp->mTimeLastReceive,
+                           msg.mSimulationTime - comp->mTimeLastReceive,
                            newpos,
                            newori);
 
@@ -237,13 +246,10 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void DeadReckoningReceiverSystem::OnUpdateTransform(const dtEntity::Message& m)
+   void DeadReckoningReceiverSystem::OnUpdateTransform(const UpdateTransformData& msg)
    {
-      assert(dynamic_cast<const UpdateTransformMessage*>(&m) != NULL);
-      const UpdateTransformMessage& msg = static_cast<const UpdateTransformMessage&>(m);
-
       assert(mMapSystem != NULL);
-      dtEntity::EntityId id = mMapSystem->GetEntityIdByUniqueId(msg.GetUniqueId());
+      dtEntity::EntityId id = mMapSystem->GetEntityIdByUniqueId(msg.mUniqueId);
       if(id == 0)
       {
          LOG_ERROR("Got transform for an entity that has not yet joined!?!");
@@ -269,18 +275,18 @@ namespace dtEntityNet
             }
          }
 
-         comp->mTransformComponent->SetTranslation(msg.GetPosition());
-         comp->mTransformComponent->SetRotation(EulerToQuat(msg.GetOrientation()));
+         comp->mTransformComponent->SetTranslation(msg.mPosition);
+         comp->mTransformComponent->SetRotation(EulerToQuat(msg.mOrientation));
          mMapSystem->AddToScene(id);
       }
 
 
       comp->mTimeLastReceive = dtEntity::GetSystemInterface()->GetSimulationTime();
-      comp->mPosition = msg.GetPosition();
-      comp->mOrientation = msg.GetOrientation();
-      comp->mVelocity = msg.GetVelocity();
-      comp->mAngularVelocity = msg.GetAngularVelocity();
-      comp->mDeadRecAlg = msg.GetDeadReckoning();
+      comp->mPosition = msg.mPosition;
+      comp->mOrientation = msg.mOrientation;
+      comp->mVelocity = msg.mVelocity;
+      comp->mAngularVelocity = msg.mAngularVelocity;
+      comp->mDeadRecAlg = msg.mDeadReckoning;
    }
 
 }
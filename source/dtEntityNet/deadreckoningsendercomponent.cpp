@@ -35,8 +35,8 @@ namespace dtEntityNet
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId DeadReckoningSenderComponent::TYPE(dtEntity::SID("DeadReckoningSender"));
-   const dtEntity::StringId DeadReckoningSenderComponent::DeadReckoningAlgorithmId(dtEntity::SID("DeadReckoningAlgorithm"));
+   const dtEntity::StringId DeadReckoningSenderComponent::TYPE(SID_LITERAL("DeadReckoningSender"));
+   const dtEntity::StringId DeadReckoningSenderComponent::DeadReckoningAlgorithmId(SID_LITERAL("DeadReckoningAlgorithm"));
 
    DeadReckoningSenderComponent::DeadReckoningSenderComponent()
       : mDeadReckoningAlgorithm (
@@ -78,25 +78,25 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void DeadReckoningSenderComponent::FillMessage(UpdateTransformMessage& msg)
+   void DeadReckoningSenderComponent::FillMessage(UpdateTransformData& msg)
    {
-      msg.SetUniqueId(mUniqueId);
-      msg.SetPosition(mLastPosition);
-      msg.SetOrientation(mLastOrientation);
-      msg.SetVelocity(mLastVelocity);
-      msg.SetAngularVelocity(mLastAngularVelocity);
-      msg.SetDeadReckoning(GetDeadReckoningAlgorithm());
-      msg.SetSimTime(mTimeLastSend);
+      msg.mUniqueId = mUniqueId;
+      msg.mPosition = mLastPosition;
+      msg.mOrientation = mLastOrientation;
+      msg.mVelocity = mLastVelocity;
+      msg.mAngularVelocity = mLastAngularVelocity;
+      msg.mDeadReckoning = GetDeadReckoningAlgorithm();
+      msg.mSimTime = mTimeLastSend;
    }
 
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId DeadReckoningSenderSystem::TYPE(dtEntity::SID("DeadReckoningSender"));
-   const dtEntity::StringId DeadReckoningSenderSystem::MaxUpdateIntervalId(dtEntity::SID("MaxUpdateInterval"));
-   const dtEntity::StringId DeadReckoningSenderSystem::MinUpdateIntervalId(dtEntity::SID("MinUpdateInterval"));
-   const dtEntity::StringId DeadReckoningSenderSystem::MaxPositionDeviationId(dtEntity::SID("MaxPositionDeviation"));
-   const dtEntity::StringId DeadReckoningSenderSystem::MaxOrientationDeviationId(dtEntity::SID("MaxOrientationDeviation"));
+   const dtEntity::StringId DeadReckoningSenderSystem::TYPE(SID_LITERAL("DeadReckoningSender"));
+   const dtEntity::StringId DeadReckoningSenderSystem::MaxUpdateIntervalId(SID_LITERAL("MaxUpdateInterval"));
+   const dtEntity::StringId DeadReckoningSenderSystem::MinUpdateIntervalId(SID_LITERAL("MinUpdateInterval"));
+   const dtEntity::StringId DeadReckoningSenderSystem::MaxPositionDeviationId(SID_LITERAL("MaxPositionDeviation"));
+   const dtEntity::StringId DeadReckoningSenderSystem::MaxOrientationDeviationId(SID_LITERAL("MaxOrientationDeviation"));
 
    ////////////////////////////////////////////////////////////////////////////
    DeadReckoningSenderSystem::DeadReckoningSenderSystem(dtEntity::EntityManager& em)
@@ -112,9 +112,8 @@ namespace dtEntityNet
       Register(MaxPositionDeviationId, &mMaxPositionDeviation);
       Register(MaxOrientationDeviationId, &mMaxOrientationDeviation);
 
-      mTickFunctor = dtEntity::MessageFunctor(this, &DeadReckoningSenderSystem::Tick);
-      em.RegisterForMessages(dtEntity::TickMessage::TYPE,
-         mTickFunctor, dtEntity::FilterOptions::ORDER_DEFAULT, "DeadReckoningSenderSystem::Tick");
+      mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(this, &DeadReckoningSenderSystem::Tick);
+      em.RegisterForTick(*this, mTickFunctor, "DeadReckoningSenderSystem::Tick");
 
       mEnterWorldFunctor = dtEntity::MessageFunctor(this, &DeadReckoningSenderSystem::OnAddedToScene);
       em.RegisterForMessages(dtEntity::EntityAddedToSceneMessage::TYPE, mEnterWorldFunctor, "DeadReckoningSenderSystem::OnAddedToScene");
@@ -127,22 +126,30 @@ namespace dtEntityNet
    ////////////////////////////////////////////////////////////////////////////
    DeadReckoningSenderSystem::~DeadReckoningSenderSystem()
    {
-      GetEntityManager().UnregisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor);
+      GetEntityManager().UnregisterForTick(mTickFunctor);
       GetEntityManager().UnregisterForMessages(dtEntity::EntityAddedToSceneMessage::TYPE, mEnterWorldFunctor);
       GetEntityManager().UnregisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, mLeaveWorldFunctor);
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void DeadReckoningSenderSystem::Tick(const dtEntity::Message& m)
+   bool DeadReckoningSenderSystem::GetComponentAccess(std::vector<dtEntity::ComponentType>& reads, std::vector<dtEntity::ComponentType>& writes) const
+   {
+      // updates are emitted on mOutgoing, no other tick handler uses that pump
+      reads.push_back(dtEntityOSG::TransformComponent::TYPE);
+      reads.push_back(dtEntity::DynamicsComponent::TYPE);
+      writes.push_back(TYPE);
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void DeadReckoningSenderSystem::Tick(const dtEntity::TickData& msg)
    {
       if(mComponents.empty())
       {
          return;
       }
 
-      const dtEntity::TickMessage& msg = static_cast<const dtEntity::TickMessage&>(m);
-
-      double simtime = msg.GetSimulationTime();
+      double simtime = msg.mSimulationTime;
 
       osg::Vec3d newpos;
       osg::Vec3 newori;
@@ -238,9 +245,9 @@ namespace dtEntityNet
             comp->mLastAngularVelocity = QuatToEuler(comp->mDynamicsComponent->GetAngularVelocity());
             comp->mTimeLastSend = simtime;
 
-            UpdateTransformMessage msg;
+            UpdateTransformData msg;
             comp->FillMessage(msg);
-            mOutgoing.EmitMessage(msg);
+            mOutgoing.EmitTypedMessage(msg);
          }
       }
    }
@@ -303,6 +310,7 @@ namespace dtEntityNet
          }
       }
 
+      UpdateTransformData transdata;
       UpdateTransformMessage transmsg;
 
       for(ComponentStore::const_iterator i = mComponents.begin(); i != mComponents.end(); ++i)
@@ -310,7 +318,8 @@ namespace dtEntityNet
          DeadReckoningSenderComponent* comp = i->second;
          if(comp->IsInScene())
          {
-            comp->FillMessage(transmsg);
+            comp->FillMessage(transdata);
+            transmsg.SetData(transdata);
             rcvr.Receive(transmsg);
          }
       }
@@ -57,7 +57,7 @@ namespace dtEntityNet
    };
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ENetSystem::TYPE(dtEntity::SID("ENet"));
+   const dtEntity::StringId ENetSystem::TYPE(SID_LITERAL("ENet"));
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
@@ -91,8 +91,8 @@ namespace dtEntityNet
       bool deadRecReceiverSystemInEntityManager = em.GetES(receiversys);
       assert(deadRecReceiverSystemInEntityManager);
 
-      GetIncomingMessagePump().RegisterForMessages(UpdateTransformMessage::TYPE,
-         dtEntity::MessageFunctor(receiversys, &DeadReckoningReceiverSystem::OnUpdateTransform),
+      GetIncomingMessagePump().RegisterForTypedMessages<UpdateTransformData>(
+         dtEntity::TypedMessageFunctor<UpdateTransformData>::type(receiversys, &DeadReckoningReceiverSystem::OnUpdateTransform),
                                    dtEntity::FilterOptions::ORDER_LATE, "DeadReckoningReceiverSystem::OnUpdateTransform");
 
       GetIncomingMessagePump().RegisterForMessages(JoinMessage::TYPE,
@@ -235,7 +235,7 @@ namespace dtEntityNet
          }
          case ENET_EVENT_TYPE_RECEIVE:
          {
-            LOG_ALWAYS("A packet of length " << event.packet->dataLength << " was received from " <<
+            LOG_DEBUG("A packet of length " << event.packet->dataLength << " was received from " <<
                     event.peer->data << " on channel " << (int)event.channelID << "\n");
 
             //std::istringstream is(reinterpret_cast<char*>(event.packet->data), std::ios_base::in | std::ios_base::binary);
@@ -250,7 +250,7 @@ namespace dtEntityNet
             }
             else
             {
-               LOG_ALWAYS("Received message of type " << dtEntity::GetStringFromSID(msg->GetType()));
+               LOG_DEBUG("Received message of type " << dtEntity::GetStringFromSID(msg->GetType()));
                mIncoming.EmitMessage(*msg);
             }
             delete msg;
@@ -289,7 +289,7 @@ namespace dtEntityNet
       bool success = dtEntity::ProtoBufMapEncoder::EncodeMessage(msg, buf);
       if(success)
       {
-         LOG_ALWAYS("Sending to clients: " << dtEntity::GetStringFromSID(msg.GetType()));
+         LOG_DEBUG("Sending to clients: " << dtEntity::GetStringFromSID(msg.GetType()));
          const std::string byteArray = buf.str();
          ENetPacket* packet = enet_packet_create (byteArray.c_str(), byteArray.size(),
                                               ENET_PACKET_FLAG_RELIABLE);
@@ -324,7 +324,7 @@ namespace dtEntityNet
       bool success = dtEntity::ProtoBufMapEncoder::EncodeMessage(msg, buf);
       if(success)
       {
-         LOG_ALWAYS("Sending to peer: " << dtEntity::GetStringFromSID(msg.GetType()));
+         LOG_DEBUG("Sending to peer: " << dtEntity::GetStringFromSID(msg.GetType()));
          const std::string byteArray = buf.str();
          ENetPacket* packet = enet_packet_create (byteArray.c_str(), byteArray.size(),
                                               ENET_PACKET_FLAG_RELIABLE);
@@ -38,9 +38,9 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::MessageType JoinMessage::TYPE(dtEntity::SID("JoinMessage"));
-   const dtEntity::StringId JoinMessage::EntityTypeId(dtEntity::SID("EntityType"));
-   const dtEntity::StringId JoinMessage::UniqueIdId(dtEntity::SID("UniqueId"));
+   const dtEntity::MessageType JoinMessage::TYPE(SID_LITERAL("JoinMessage"));
+   const dtEntity::StringId JoinMessage::EntityTypeId(SID_LITERAL("EntityType"));
+   const dtEntity::StringId JoinMessage::UniqueIdId(SID_LITERAL("UniqueId"));
 
    JoinMessage::JoinMessage()
       : Message(TYPE)
@@ -50,7 +50,7 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::MessageType NetConnectedMessage::TYPE(dtEntity::SID("NetConnectedMessage"));
+   const dtEntity::MessageType NetConnectedMessage::TYPE(SID_LITERAL("NetConnectedMessage"));
 
    NetConnectedMessage::NetConnectedMessage()
       : Message(TYPE)
@@ -58,7 +58,7 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::MessageType NetDisconnectedMessage::TYPE(dtEntity::SID("NetDisconnectedMessage"));
+   const dtEntity::MessageType NetDisconnectedMessage::TYPE(SID_LITERAL("NetDisconnectedMessage"));
 
    NetDisconnectedMessage::NetDisconnectedMessage()
       : Message(TYPE)
@@ -66,8 +66,8 @@ namespace dtEntityNet
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::MessageType ResignMessage::TYPE(dtEntity::SID("ResignMessage"));
-   const dtEntity::StringId ResignMessage::UniqueIdId(dtEntity::SID("UniqueId"));
+   const dtEntity::MessageType ResignMessage::TYPE(SID_LITERAL("ResignMessage"));
+   const dtEntity::StringId ResignMessage::UniqueIdId(SID_LITERAL("UniqueId"));
 
    ResignMessage::ResignMessage()
       : Message(TYPE)
@@ -76,14 +76,14 @@ namespace dtEntityNet
    }
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::MessageType UpdateTransformMessage::TYPE(dtEntity::SID("UpdateTransformMessage"));
-   const dtEntity::StringId UpdateTransformMessage::DeadReckoningAlgorithmId(dtEntity::SID("DeadReckoningAlgorithm"));
-   const dtEntity::StringId UpdateTransformMessage::PositionId(dtEntity::SID("Position"));
-   const dtEntity::StringId UpdateTransformMessage::VelocityId(dtEntity::SID("Velocity"));
-   const dtEntity::StringId UpdateTransformMessage::OrientationId(dtEntity::SID("Orientation"));
-   const dtEntity::StringId UpdateTransformMessage::AngularVelocityId(dtEntity::SID("AngularVelocity"));
-   const dtEntity::StringId UpdateTransformMessage::SimTimeId(dtEntity::SID("SimTime"));
-   const dtEntity::StringId UpdateTransformMessage::UniqueIdId(dtEntity::SID("UniqueId"));
+   const dtEntity::MessageType UpdateTransformMessage::TYPE(SID_LITERAL("UpdateTransformMessage"));
+   const dtEntity::StringId UpdateTransformMessage::DeadReckoningAlgorithmId(SID_LITERAL("DeadReckoningAlgorithm"));
+   const dtEntity::StringId UpdateTransformMessage::PositionId(SID_LITERAL("Position"));
+   const dtEntity::StringId UpdateTransformMessage::VelocityId(SID_LITERAL("Velocity"));
+   const dtEntity::StringId UpdateTransformMessage::OrientationId(SID_LITERAL("Orientation"));
+   const dtEntity::StringId UpdateTransformMessage::AngularVelocityId(SID_LITERAL("AngularVelocity"));
+   const dtEntity::StringId UpdateTransformMessage::SimTimeId(SID_LITERAL("SimTime"));
+   const dtEntity::StringId UpdateTransformMessage::UniqueIdId(SID_LITERAL("UniqueId"));
 
    UpdateTransformMessage::UpdateTransformMessage()
       : dtEntity::Message(TYPE)
@@ -96,5 +96,29 @@ namespace dtEntityNet
       Register(SimTimeId, &mSimTime);
       Register(UniqueIdId, &mUniqueId);
    }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void UpdateTransformMessage::SetData(const UpdateTransformData& d)
+   {
+      SetDeadReckoning(d.mDeadReckoning);
+      SetPosition(d.mPosition);
+      SetVelocity(d.mVelocity);
+      SetOrientation(d.mOrientation);
+      SetAngularVelocity(d.mAngularVelocity);
+      SetSimTime(d.mSimTime);
+      SetUniqueId(d.mUniqueId);
+   }
+
+   ///////////////////////////////////////////////////////////////////////////////////////////////////////
+   void UpdateTransformMessage::GetData(UpdateTransformData& d) const
+   {
+      d.mDeadReckoning = GetDeadReckoning();
+      d.mPosition = GetPosition();
+      d.mVelocity = GetVelocity();
+      d.mOrientation = GetOrientation();
+      d.mAngularVelocity = GetAngularVelocity();
+      d.mSimTime = GetSimTime();
+      d.mUniqueId = GetUniqueId();
+   }
 }
 
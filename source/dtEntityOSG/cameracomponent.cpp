@@ -40,36 +40,36 @@ namespace dtEntityOSG
 {
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId CameraComponent::TYPE(dtEntity::SID("Camera"));
-
-   const dtEntity::StringId CameraComponent::ContextIdId(dtEntity::SID("ContextId"));
-   const dtEntity::StringId CameraComponent::LayerAttachPointId(dtEntity::SID("LayerAttachPoint"));
-
-   const dtEntity::StringId CameraComponent::CullingModeId(dtEntity::SID("CullingMode"));
-   const dtEntity::StringId CameraComponent::NoAutoNearFarCullingId(dtEntity::SID("NoAutoNearFarCulling"));
-   const dtEntity::StringId CameraComponent::BoundingVolumeNearFarCullingId(dtEntity::SID("BoundingVolumeNearFarCulling"));
-   const dtEntity::StringId CameraComponent::PrimitiveNearFarCullingId(dtEntity::SID("PrimitiveNearFarCulling"));
-   const dtEntity::StringId CameraComponent::FieldOfViewId(dtEntity::SID("FieldOfView"));
-   const dtEntity::StringId CameraComponent::AspectRatioId(dtEntity::SID("AspectRatio"));
-   const dtEntity::StringId CameraComponent::NearClipId(dtEntity::SID("NearClip"));
-   const dtEntity::StringId CameraComponent::FarClipId(dtEntity::SID("FarClip"));
-   const dtEntity::StringId CameraComponent::ClearColorId(dtEntity::SID("ClearColor"));
-   const dtEntity::StringId CameraComponent::LODScaleId(dtEntity::SID("LODScale"));
-   const dtEntity::StringId CameraComponent::PositionId(dtEntity::SID("Position"));
-   const dtEntity::StringId CameraComponent::UpId(dtEntity::SID("Up"));
-   const dtEntity::StringId CameraComponent::EyeDirectionId(dtEntity::SID("EyeDirection"));
-   const dtEntity::StringId CameraComponent::CullMaskId(dtEntity::SID("CullMask"));
-
-   const dtEntity::StringId CameraComponent::ProjectionModeId(dtEntity::SID("ProjectionMode"));
-   const dtEntity::StringId CameraComponent::ModePerspectiveId(dtEntity::SID("ModePerspective"));
-   const dtEntity::StringId CameraComponent::ModeOrthoId(dtEntity::SID("ModeOrtho"));
-
-   const dtEntity::StringId CameraComponent::OrthoLeftId(dtEntity::SID("OrthoLeft"));
-   const dtEntity::StringId CameraComponent::OrthoRightId(dtEntity::SID("OrthoRight"));
-   const dtEntity::StringId CameraComponent::OrthoBottomId(dtEntity::SID("OrthoBottom"));
-   const dtEntity::StringId CameraComponent::OrthoTopId(dtEntity::SID("OrthoTop"));
-   const dtEntity::StringId CameraComponent::OrthoZNearId(dtEntity::SID("OrthoZNear"));
-   const dtEntity::StringId CameraComponent::OrthoZFarId(dtEntity::SID("OrthoZFar"));
+   const dtEntity::StringId CameraComponent::TYPE(SID_LITERAL("Camera"));
+
+   const dtEntity::StringId CameraComponent::ContextIdId(SID_LITERAL("ContextId"));
+   const dtEntity::StringId CameraComponent::LayerAttachPointId(SID_LITERAL("LayerAttachPoint"));
+
+   const dtEntity::StringId CameraComponent::CullingModeId(SID_LITERAL("CullingMode"));
+   const dtEntity::StringId CameraComponent::NoAutoNearFarCullingId(SID_LITERAL("NoAutoNearFarCulling"));
+   const dtEntity::StringId CameraComponent::BoundingVolumeNearFarCullingId(SID_LITERAL("BoundingVolumeNearFarCulling"));
+   const dtEntity::StringId CameraComponent::PrimitiveNearFarCullingId(SID_LITERAL("PrimitiveNearFarCulling"));
+   const dtEntity::StringId CameraComponent::FieldOfViewId(SID_LITERAL("FieldOfView"));
+   const dtEntity::StringId CameraComponent::AspectRatioId(SID_LITERAL("AspectRatio"));
+   const dtEntity::StringId CameraComponent::NearClipId(SID_LITERAL("NearClip"));
+   const dtEntity::StringId CameraComponent::FarClipId(SID_LITERAL("FarClip"));
+   const dtEntity::StringId CameraComponent::ClearColorId(SID_LITERAL("ClearColor"));
+   const dtEntity::StringId CameraComponent::LODScaleId(SID_LITERAL("LODScale"));
+   const dtEntity::StringId CameraComponent::PositionId(SID_LITERAL("Position"));
+   const dtEntity::StringId CameraComponent::UpId(SID_LITERAL("Up"));
+   const dtEntity::StringId CameraComponent::EyeDirectionId(SID_LITERAL("EyeDirection"));
+   const dtEntity::StringId CameraComponent::CullMaskId(SID_LITERAL("CullMask"));
+
+   const dtEntity::StringId CameraComponent::ProjectionModeId(SID_LITERAL("ProjectionMode"));
+   const dtEntity::StringId CameraComponent::ModePerspectiveId(SID_LITERAL("ModePerspective"));
+   const dtEntity::StringId CameraComponent::ModeOrthoId(SID_LITERAL("ModeOrtho"));
+
+   const dtEntity::StringId CameraComponent::OrthoLeftId(SID_LITERAL("OrthoLeft"));
+   const dtEntity::StringId CameraComponent::OrthoRightId(SID_LITERAL("OrthoRight"));
+   const dtEntity::StringId CameraComponent::OrthoBottomId(SID_LITERAL("OrthoBottom"));
+   const dtEntity::StringId CameraComponent::OrthoTopId(SID_LITERAL("OrthoTop"));
+   const dtEntity::StringId CameraComponent::OrthoZNearId(SID_LITERAL("OrthoZNear"));
+   const dtEntity::StringId CameraComponent::OrthoZFarId(SID_LITERAL("OrthoZFar"));
 
    ////////////////////////////////////////////////////////////////////////////
    CameraComponent::CameraComponent()
@@ -168,7 +168,7 @@ namespace dtEntityOSG
       Register(OrthoZNearId, &mOrthoZNear);
       Register(OrthoZFarId, &mOrthoZFar);
 
-      mLayerAttachPoint.Set(dtEntity::SID("root"));
+      mLayerAttachPoint.Set(SID_LITERAL("root"));
 
       GetCamera()->setCullMask(dtEntity::NodeMasks::VISIBLE);
       mUp.Set(osg::Vec3(0, 0, 1));
@@ -520,6 +520,19 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    void CameraComponent::UpdateViewMatrix()
+   {
+      if(IsDoubleBuffered())
+      {
+         MarkBackBufferDirty();
+      }
+      else
+      {
+         ApplyBackBuffer();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void CameraComponent::ApplyBackBuffer()
    {
       osg::Vec3d lookat = mPosition.Get() + mEyeDirection.Get();
       GetCamera()->setViewMatrixAsLookAt(mPosition.Get(), lookat, mUp.Get());
@@ -668,7 +681,7 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId CameraSystem::TYPE(dtEntity::SID("Camera"));
+   const dtEntity::StringId CameraSystem::TYPE(SID_LITERAL("Camera"));
 
    ////////////////////////////////////////////////////////////////////////////
    CameraSystem::CameraSystem(dtEntity::EntityManager& em)
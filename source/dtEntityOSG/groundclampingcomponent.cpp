@@ -35,17 +35,17 @@ namespace dtEntityOSG
 {
 
 
-   const dtEntity::StringId GroundClampingComponent::TYPE(dtEntity::SID("GroundClamping"));
-   const dtEntity::StringId GroundClampingComponent::ClampingModeId(dtEntity::SID("ClampingMode"));
-   const dtEntity::StringId GroundClampingComponent::ClampingMode_DisabledId(dtEntity::SID("Disabled"));
-   const dtEntity::StringId GroundClampingComponent::ClampingMode_KeepAboveTerrainId(dtEntity::SID("KeepAboveTerrain"));
+   const dtEntity::StringId GroundClampingComponent::TYPE(SID_LITERAL("GroundClamping"));
+   const dtEntity::StringId GroundClampingComponent::ClampingModeId(SID_LITERAL("ClampingMode"));
+   const dtEntity::StringId GroundClampingComponent::ClampingMode_DisabledId(SID_LITERAL("Disabled"));
+   const dtEntity::StringId GroundClampingComponent::ClampingMode_KeepAboveTerrainId(SID_LITERAL("KeepAboveTerrain"));
    const dtEntity::StringId GroundClampingComponent::ClampingMode_SetHeightToTerrainHeightId(
-      dtEntity::SID("SetHeightToTerrainHeight"));
+      SID_LITERAL("SetHeightToTerrainHeight"));
    const dtEntity::StringId GroundClampingComponent::ClampingMode_SetHeightAndRotationToTerrainId(
-      dtEntity::SID("SetHeightAndRotationToTerrain"));
-   const dtEntity::StringId GroundClampingComponent::VerticalOffsetId(dtEntity::SID("VerticalOffset"));
-   const dtEntity::StringId GroundClampingComponent::MinDistToCameraId(dtEntity::SID("MinDistToCamera"));
-   const dtEntity::StringId GroundClampingComponent::MinMovementDeltaId(dtEntity::SID("MinMovementDelta"));
+      SID_LITERAL("SetHeightAndRotationToTerrain"));
+   const dtEntity::StringId GroundClampingComponent::VerticalOffsetId(SID_LITERAL("VerticalOffset"));
+   const dtEntity::StringId GroundClampingComponent::MinDistToCameraId(SID_LITERAL("MinDistToCamera"));
+   const dtEntity::StringId GroundClampingComponent::MinMovementDeltaId(SID_LITERAL("MinMovementDelta"));
 
    ////////////////////////////////////////////////////////////////////////////
    GroundClampingComponent::GroundClampingComponent()
@@ -90,10 +90,10 @@ namespace dtEntityOSG
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId GroundClampingSystem::TYPE(dtEntity::SID("GroundClamping"));
-   const dtEntity::StringId GroundClampingSystem::EnabledId(dtEntity::SID("Enabled"));
-   const dtEntity::StringId GroundClampingSystem::IntersectLayerId(dtEntity::SID("IntersectLayer"));
-   const dtEntity::StringId GroundClampingSystem::FetchLODsId(dtEntity::SID("FetchLODs"));
+   const dtEntity::StringId GroundClampingSystem::TYPE(SID_LITERAL("GroundClamping"));
+   const dtEntity::StringId GroundClampingSystem::EnabledId(SID_LITERAL("Enabled"));
+   const dtEntity::StringId GroundClampingSystem::IntersectLayerId(SID_LITERAL("IntersectLayer"));
+   const dtEntity::StringId GroundClampingSystem::FetchLODsId(SID_LITERAL("FetchLODs"));
 
    ////////////////////////////////////////////////////////////////////////////
    GroundClampingSystem::GroundClampingSystem(dtEntity::EntityManager& em)
@@ -117,8 +117,8 @@ namespace dtEntityOSG
       Register(FetchLODsId, &mFetchLODs);
       mFetchLODs.Set(true);
 
-      mTickFunctor = dtEntity::MessageFunctor(this, &GroundClampingSystem::Tick);
-      GetEntityManager().RegisterForMessages(dtEntity::EndOfFrameMessage::TYPE,
+      mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::EndOfFrameData>::type(this, &GroundClampingSystem::Tick);
+      GetEntityManager().RegisterForTypedMessages<dtEntity::EndOfFrameData>(
          mTickFunctor, dtEntity::FilterOptions::ORDER_DEFAULT, "GroundClampingSystem::Tick");
 
       mCameraAddedFunctor = dtEntity::MessageFunctor(this, &GroundClampingSystem::CameraAdded);
@@ -184,7 +184,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    void GroundClampingSystem::OnRemoveFromEntityManager(dtEntity::EntityManager& em)
    {
-      GetEntityManager().UnregisterForMessages(dtEntity::EndOfFrameMessage::TYPE, mTickFunctor);
+      GetEntityManager().UnregisterForTypedMessages<dtEntity::EndOfFrameData>(mTickFunctor);
       GetEntityManager().UnregisterForMessages(dtEntity::CameraAddedMessage::TYPE, mCameraAddedFunctor);
       GetEntityManager().UnregisterForMessages(dtEntity::CameraRemovedMessage::TYPE, mCameraRemovedFunctor);
 	   GetEntityManager().UnregisterForMessages(dtEntity::MapLoadedMessage::TYPE, mMapLoadedFunctor);
@@ -299,11 +299,10 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void GroundClampingSystem::Tick(const dtEntity::Message& m)
+   void GroundClampingSystem::Tick(const dtEntity::EndOfFrameData& tick)
    {
-      const dtEntity::TickMessage& tick = static_cast<const dtEntity::TickMessage&>(m);
-      float dt = tick.GetDeltaSimTime();
-      double simTime = tick.GetSimulationTime();
+      float dt = tick.mDeltaSimTime;
+      double simTime = tick.mSimulationTime;
 
       if(!mRootNode.valid() || mCamera == NULL || !mEnabled.Get() || mComponents.empty() )
       {
@@ -27,8 +27,8 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId GroupComponent::TYPE(dtEntity::SID("Group"));
-   const dtEntity::StringId GroupComponent::ChildrenId(dtEntity::SID("Children"));
+   const dtEntity::StringId GroupComponent::TYPE(SID_LITERAL("Group"));
+   const dtEntity::StringId GroupComponent::ChildrenId(SID_LITERAL("Children"));
    
    ////////////////////////////////////////////////////////////////////////////
    GroupComponent::GroupComponent()
@@ -78,8 +78,8 @@ namespace dtEntityOSG
          return false;
       }
       NodeStore* nc = dynamic_cast<NodeStore*>(component);
-      assert(nc->GetNode()->getNumParents() == 0);
-      bool success = GetAttachmentGroup()->addChild(nc->GetNode());
+      assert(SceneGraphChanges::IsDeferred() || nc->GetNode()->getNumParents() == 0);
+      bool success = SceneGraphChanges::AddChild(GetAttachmentGroup(), nc->GetNode());
       assert(success);
       nc->SetParentComponent(this->GetType());
       mChildrenVal.Add(new dtEntity::StringIdProperty(ct));
@@ -96,7 +96,7 @@ namespace dtEntityOSG
       }
 
       NodeStore* nc = dynamic_cast<NodeStore*>(component);
-      GetAttachmentGroup()->removeChild(nc->GetNode());
+      SceneGraphChanges::RemoveChild(GetAttachmentGroup(), nc->GetNode());
       nc->SetParentComponent(dtEntity::StringId());
 
       for(dtEntity::PropertyArray::const_iterator i = mChildrenVal.Get().begin(); i != mChildrenVal.Get().end(); ++i)
@@ -117,7 +117,7 @@ namespace dtEntityOSG
       
       assert(GetNodeEntity() != NULL && "Please add group component to entity before adding children!");
 
-      GetAttachmentGroup()->removeChild(0, GetAttachmentGroup()->getNumChildren());
+      SceneGraphChanges::RemoveChildren(GetAttachmentGroup());
 
       dtEntity::PropertyArray::const_iterator it;
       for(it = arr.begin(); it != arr.end(); ++it)
@@ -138,11 +138,11 @@ namespace dtEntityOSG
 
             if(nc)
             {
-               if(nc->GetNode()->getNumParents() != 0)
+               if(!SceneGraphChanges::IsDeferred() && nc->GetNode()->getNumParents() != 0)
                {
                   LOG_ERROR("A node component is child of multiple node components!");
                }
-               bool success = GetAttachmentGroup()->addChild(nc->GetNode());
+               bool success = SceneGraphChanges::AddChild(GetAttachmentGroup(), nc->GetNode());
                assert(success);
                nc->SetParentComponent(this->GetType());
             }
@@ -64,8 +64,8 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
 
-   const dtEntity::StringId LayerAttachPointComponent::TYPE(dtEntity::SID("LayerAttachPoint"));
-   const dtEntity::StringId LayerAttachPointComponent::NameId(dtEntity::SID("Name"));
+   const dtEntity::StringId LayerAttachPointComponent::TYPE(SID_LITERAL("LayerAttachPoint"));
+   const dtEntity::StringId LayerAttachPointComponent::NameId(SID_LITERAL("Name"));
    
    ////////////////////////////////////////////////////////////////////////////
    LayerAttachPointComponent::LayerAttachPointComponent()    
@@ -155,9 +155,9 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId LayerAttachPointSystem::TYPE(dtEntity::SID("LayerAttachPoint"));
-   const dtEntity::StringId LayerAttachPointSystem::DefaultLayerId(dtEntity::SID("default"));
-   const dtEntity::StringId LayerAttachPointSystem::RootId(dtEntity::SID("root"));
+   const dtEntity::StringId LayerAttachPointSystem::TYPE(SID_LITERAL("LayerAttachPoint"));
+   const dtEntity::StringId LayerAttachPointSystem::DefaultLayerId(SID_LITERAL("default"));
+   const dtEntity::StringId LayerAttachPointSystem::RootId(SID_LITERAL("root"));
 
 
    ////////////////////////////////////////////////////////////////////////////////
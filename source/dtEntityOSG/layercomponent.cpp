@@ -43,10 +43,10 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
 
-   const dtEntity::StringId LayerComponent::TYPE(dtEntity::SID("Layer"));
-   const dtEntity::StringId LayerComponent::LayerId(dtEntity::SID("Layer"));
-   const dtEntity::StringId LayerComponent::AttachedComponentId(dtEntity::SID("AttachedComponent"));
-   const dtEntity::StringId LayerComponent::VisibleId(dtEntity::SID("Visible"));
+   const dtEntity::StringId LayerComponent::TYPE(SID_LITERAL("Layer"));
+   const dtEntity::StringId LayerComponent::LayerId(SID_LITERAL("Layer"));
+   const dtEntity::StringId LayerComponent::AttachedComponentId(SID_LITERAL("AttachedComponent"));
+   const dtEntity::StringId LayerComponent::VisibleId(SID_LITERAL("Visible"));
    
    ////////////////////////////////////////////////////////////////////////////
    LayerComponent::LayerComponent()
@@ -185,10 +185,10 @@ namespace dtEntityOSG
          return false;
       }      
       osg::Group* grp = current->GetAttachmentGroup();
-      grp->removeChild(attachedNode);
+      SceneGraphChanges::RemoveChild(grp, attachedNode);
 
       //assert(success);
-      if(attachedNode->getNumParents() != 0)
+      if(!SceneGraphChanges::IsDeferred() && attachedNode->getNumParents() != 0)
       {
          LOG_ERROR("Detaching: attached node still has parents!");
       }
@@ -228,12 +228,12 @@ namespace dtEntityOSG
          return false;
       }
       
-      if(attachedNode->getNumParents() != 0)
+      if(!SceneGraphChanges::IsDeferred() && attachedNode->getNumParents() != 0)
       {
          LOG_ERROR("Node already attached!");
       }
       osg::Group* attchgrp = current->GetAttachmentGroup();
-      bool success = attchgrp->addChild(attachedNode);
+      bool success = SceneGraphChanges::AddChild(attchgrp, attachedNode);
       assert(success);
       return true;
    }
@@ -306,11 +306,11 @@ namespace dtEntityOSG
 
          if(visible)
          {
-            GetAttachedComponentNode()->setNodeMask(GetAttachedComponentNode()->getNodeMask() | visiblemask);
+            SceneGraphChanges::ChangeNodeMask(GetAttachedComponentNode(), visiblemask, 0);
          }
          else
          {
-            GetAttachedComponentNode()->setNodeMask(GetAttachedComponentNode()->getNodeMask() & ~visiblemask);
+            SceneGraphChanges::ChangeNodeMask(GetAttachedComponentNode(), 0, visiblemask);
          }
       }
 
@@ -412,8 +412,8 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId LayerSystem::TYPE(dtEntity::SID("Layer"));
-   const dtEntity::StringId LayerSystem::VisibilityBitsId(dtEntity::SID("VisibilityBits"));
+   const dtEntity::StringId LayerSystem::TYPE(SID_LITERAL("Layer"));
+   const dtEntity::StringId LayerSystem::VisibilityBitsId(SID_LITERAL("VisibilityBits"));
 
    ////////////////////////////////////////////////////////////////////////////
    LayerSystem::LayerSystem(dtEntity::EntityManager& em)
@@ -566,7 +566,7 @@ namespace dtEntityOSG
       // store pointer to entity to make box identifiable for removal
       geode->setUserData(new EntityData(entity));
 
-      node->asGroup()->addChild(geode);
+      SceneGraphChanges::AddChild(node->asGroup(), geode);
 
       // make box wireframe
       osg::ref_ptr<osg::StateSet> stateset = geode->getOrCreateStateSet();
@@ -609,7 +609,7 @@ namespace dtEntityOSG
          EntityData* ed = dynamic_cast<EntityData*>(child->getUserData());
          if(child->getName() == "SelectionBounds" && ed && ed->mEntity->GetId() == id)
          {
-            grp->removeChild(i, 1);
+            SceneGraphChanges::RemoveChild(grp, child);
             return;
          }
       }
@@ -625,7 +625,7 @@ namespace dtEntityOSG
          EntityData* ed = dynamic_cast<EntityData*>(child->getUserData());
          if(child->getName() == "SelectionBounds" && ed->mEntity->GetId() == id)
          {
-            grp->removeChild(i, 1);
+            SceneGraphChanges::RemoveChild(grp, child);
             return;
          }
       }
@@ -27,18 +27,18 @@
 
 namespace dtEntityOSG
 {
-   const dtEntity::StringId LightComponent::TYPE(dtEntity::SID("Light"));
-   const dtEntity::StringId LightComponent::LightNumId(dtEntity::SID("LightNum"));
-   const dtEntity::StringId LightComponent::PositionId(dtEntity::SID("Position"));
-   const dtEntity::StringId LightComponent::AmbientId(dtEntity::SID("Ambient"));
-   const dtEntity::StringId LightComponent::DiffuseId(dtEntity::SID("Diffuse"));
-   const dtEntity::StringId LightComponent::SpecularId(dtEntity::SID("Specular"));
-   const dtEntity::StringId LightComponent::SpotCutoffId(dtEntity::SID("SpotCutoff"));
-   const dtEntity::StringId LightComponent::SpotExponentId(dtEntity::SID("SpotExponent"));
-   const dtEntity::StringId LightComponent::DirectionId(dtEntity::SID("Direction"));
-   const dtEntity::StringId LightComponent::ConstantAttenuationId(dtEntity::SID("ConstantAttenuation"));
-   const dtEntity::StringId LightComponent::LinearAttenuationId(dtEntity::SID("LinearAttenuation"));
-   const dtEntity::StringId LightComponent::QuadraticAttenuationId(dtEntity::SID("QuadraticAttenuation"));
+   const dtEntity::StringId LightComponent::TYPE(SID_LITERAL("Light"));
+   const dtEntity::StringId LightComponent::LightNumId(SID_LITERAL("LightNum"));
+   const dtEntity::StringId LightComponent::PositionId(SID_LITERAL("Position"));
+   const dtEntity::StringId LightComponent::AmbientId(SID_LITERAL("Ambient"));
+   const dtEntity::StringId LightComponent::DiffuseId(SID_LITERAL("Diffuse"));
+   const dtEntity::StringId LightComponent::SpecularId(SID_LITERAL("Specular"));
+   const dtEntity::StringId LightComponent::SpotCutoffId(SID_LITERAL("SpotCutoff"));
+   const dtEntity::StringId LightComponent::SpotExponentId(SID_LITERAL("SpotExponent"));
+   const dtEntity::StringId LightComponent::DirectionId(SID_LITERAL("Direction"));
+   const dtEntity::StringId LightComponent::ConstantAttenuationId(SID_LITERAL("ConstantAttenuation"));
+   const dtEntity::StringId LightComponent::LinearAttenuationId(SID_LITERAL("LinearAttenuation"));
+   const dtEntity::StringId LightComponent::QuadraticAttenuationId(SID_LITERAL("QuadraticAttenuation"));
 
    ////////////////////////////////////////////////////////////////////////////
    LightComponent::LightComponent()
@@ -149,7 +149,7 @@ namespace dtEntityOSG
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId LightSystem::TYPE(dtEntity::SID("Light"));
+   const dtEntity::StringId LightSystem::TYPE(SID_LITERAL("Light"));
 
    ////////////////////////////////////////////////////////////////////////////
    LightSystem::LightSystem(dtEntity::EntityManager& em)
@@ -214,24 +214,24 @@ namespace dtEntityOSG
    };
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ManipulatorComponent::TYPE(dtEntity::SID("Manipulator"));
-   const dtEntity::StringId ManipulatorComponent::LayerId(dtEntity::SID("Layer"));
-   const dtEntity::StringId ManipulatorComponent::DraggerTypeId(dtEntity::SID("DraggerType"));
-   const dtEntity::StringId ManipulatorComponent::OffsetFromStartId(dtEntity::SID("OffsetFromStart"));
-   const dtEntity::StringId ManipulatorComponent::UseLocalCoordsId(dtEntity::SID("UseLocalCoords"));
-   const dtEntity::StringId ManipulatorComponent::KeepSizeConstantId(dtEntity::SID("KeepSizeConstant"));
-   const dtEntity::StringId ManipulatorComponent::PivotAtBottomId(dtEntity::SID("PivotAtBottom"));
-
-   const dtEntity::StringId ManipulatorComponent::TabPlaneDraggerId(dtEntity::SID("TabPlaneDragger"));
-   const dtEntity::StringId ManipulatorComponent::TabPlaneTrackballDraggerId(dtEntity::SID("TabPlaneTrackballDragger"));
-   const dtEntity::StringId ManipulatorComponent::TabBoxTrackballDraggerId(dtEntity::SID("TabBoxTrackballDragger"));
-   const dtEntity::StringId ManipulatorComponent::TrackballDraggerId(dtEntity::SID("TrackballDragger"));
-   const dtEntity::StringId ManipulatorComponent::Translate1DDraggerId(dtEntity::SID("Translate1DDragger"));
-   const dtEntity::StringId ManipulatorComponent::Translate2DDraggerId(dtEntity::SID("Translate2DDragger"));
-   const dtEntity::StringId ManipulatorComponent::TranslateAxisDraggerId(dtEntity::SID("TranslateAxisDragger"));
-   const dtEntity::StringId ManipulatorComponent::TabBoxDraggerId(dtEntity::SID("TabBoxDragger"));
-   const dtEntity::StringId ManipulatorComponent::TerrainTranslateDraggerId(dtEntity::SID("TerrainTranslateDragger"));
-   const dtEntity::StringId ManipulatorComponent::ScaleDraggerId(dtEntity::SID("ScaleDragger"));
+   const dtEntity::StringId ManipulatorComponent::TYPE(SID_LITERAL("Manipulator"));
+   const dtEntity::StringId ManipulatorComponent::LayerId(SID_LITERAL("Layer"));
+   const dtEntity::StringId ManipulatorComponent::DraggerTypeId(SID_LITERAL("DraggerType"));
+   const dtEntity::StringId ManipulatorComponent::OffsetFromStartId(SID_LITERAL("OffsetFromStart"));
+   const dtEntity::StringId ManipulatorComponent::UseLocalCoordsId(SID_LITERAL("UseLocalCoords"));
+   const dtEntity::StringId ManipulatorComponent::KeepSizeConstantId(SID_LITERAL("KeepSizeConstant"));
+   const dtEntity::StringId ManipulatorComponent::PivotAtBottomId(SID_LITERAL("PivotAtBottom"));
+
+   const dtEntity::StringId ManipulatorComponent::TabPlaneDraggerId(SID_LITERAL("TabPlaneDragger"));
+   const dtEntity::StringId ManipulatorComponent::TabPlaneTrackballDraggerId(SID_LITERAL("TabPlaneTrackballDragger"));
+   const dtEntity::StringId ManipulatorComponent::TabBoxTrackballDraggerId(SID_LITERAL("TabBoxTrackballDragger"));
+   const dtEntity::StringId ManipulatorComponent::TrackballDraggerId(SID_LITERAL("TrackballDragger"));
+   const dtEntity::StringId ManipulatorComponent::Translate1DDraggerId(SID_LITERAL("Translate1DDragger"));
+   const dtEntity::StringId ManipulatorComponent::Translate2DDraggerId(SID_LITERAL("Translate2DDragger"));
+   const dtEntity::StringId ManipulatorComponent::TranslateAxisDraggerId(SID_LITERAL("TranslateAxisDragger"));
+   const dtEntity::StringId ManipulatorComponent::TabBoxDraggerId(SID_LITERAL("TabBoxDragger"));
+   const dtEntity::StringId ManipulatorComponent::TerrainTranslateDraggerId(SID_LITERAL("TerrainTranslateDragger"));
+   const dtEntity::StringId ManipulatorComponent::ScaleDraggerId(SID_LITERAL("ScaleDragger"));
 
    ////////////////////////////////////////////////////////////////////////////
    ManipulatorComponent::ManipulatorComponent()
@@ -521,9 +521,9 @@ namespace dtEntityOSG
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ManipulatorSystem::TYPE(dtEntity::SID("Manipulator"));
-   const dtEntity::StringId ManipulatorSystem::UseLocalCoordsId(dtEntity::SID("UseLocalCoords"));
-   const dtEntity::StringId ManipulatorSystem::UseGroundClampingId(dtEntity::SID("UseGroundClamping"));
+   const dtEntity::StringId ManipulatorSystem::TYPE(SID_LITERAL("Manipulator"));
+   const dtEntity::StringId ManipulatorSystem::UseLocalCoordsId(SID_LITERAL("UseLocalCoords"));
+   const dtEntity::StringId ManipulatorSystem::UseGroundClampingId(SID_LITERAL("UseGroundClamping"));
 
    ////////////////////////////////////////////////////////////////////////////
    ManipulatorSystem::ManipulatorSystem(dtEntity::EntityManager& em)
@@ -534,6 +534,7 @@ namespace dtEntityOSG
       )
       , mUseLocalCoordsVal(false)
    {
+      SceneGraphChanges::AddDirectWriter();
       Register(UseLocalCoordsId, &mUseLocalCoords);
       Register(UseGroundClampingId, &mUseGroundClamping);
 
@@ -542,6 +543,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    ManipulatorSystem::~ManipulatorSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
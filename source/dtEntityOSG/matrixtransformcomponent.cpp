@@ -25,8 +25,8 @@ namespace dtEntityOSG
 {
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId MatrixTransformComponent::TYPE(dtEntity::SID("MatrixTransform"));
-   const dtEntity::StringId MatrixTransformComponent::MatrixId(dtEntity::SID("Matrix"));
+   const dtEntity::StringId MatrixTransformComponent::TYPE(SID_LITERAL("MatrixTransform"));
+   const dtEntity::StringId MatrixTransformComponent::MatrixId(SID_LITERAL("Matrix"));
    
    ////////////////////////////////////////////////////////////////////////////
    MatrixTransformComponent::MatrixTransformComponent()
@@ -72,12 +72,30 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    dtEntity::Matrix MatrixTransformComponent::GetMatrix() const
    {
+      if(IsBackBufferDirty())
+      {
+         return mBackMatrix;
+      }
       return GetMatrixTransform()->getMatrix();
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void MatrixTransformComponent::SetMatrix(const dtEntity::Matrix& m)
    {
-      GetMatrixTransform()->setMatrix(m);
+      if(IsDoubleBuffered())
+      {
+         mBackMatrix = m;
+         MarkBackBufferDirty();
+      }
+      else
+      {
+         GetMatrixTransform()->setMatrix(m);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void MatrixTransformComponent::ApplyBackBuffer()
+   {
+      GetMatrixTransform()->setMatrix(mBackMatrix);
    }
 }
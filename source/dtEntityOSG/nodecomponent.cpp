@@ -22,11 +22,174 @@
 #include <dtEntityOSG/groupcomponent.h>
 #include <dtEntityOSG/layercomponent.h>
 #include <dtEntityOSG/nodemaskvisitor.h>
+#include <dtEntity/log.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <osg/NodeVisitor>
 #include <osg/Group>
+#include <vector>
 
 namespace dtEntityOSG
 {
+   namespace
+   {
+      struct SceneGraphChange
+      {
+         enum Type
+         {
+            ADD_CHILD,
+            REMOVE_CHILD,
+            REMOVE_CHILDREN,
+            CHANGE_NODE_MASK,
+            SET_NODE_MASK_RECURSIVE
+         };
+
+         SceneGraphChange(Type t, osg::Group* parent, osg::Node* node, unsigned int set = 0, unsigned int clear = 0)
+            : mType(t)
+            , mParent(parent)
+            , mNode(node)
+            , mSet(set)
+            , mClear(clear)
+         {
+         }
+
+         Type mType;
+         // referenced, nodes may be removed from their component before change is applied
+         osg::ref_ptr<osg::Group> mParent;
+         osg::ref_ptr<osg::Node> mNode;
+         unsigned int mSet;
+         unsigned int mClear;
+      };
+
+      // deferred changes in order of calls. Guarded by mutex because
+      // systems run by the scheduler may change the scene graph concurrently.
+      std::vector<SceneGraphChange> s_changes;
+      OpenThreads::Mutex s_changesMutex;
+      OpenThreads::Atomic s_numDirectWriters;
+
+      bool Apply(const SceneGraphChange& c)
+      {
+         switch(c.mType)
+         {
+         case SceneGraphChange::ADD_CHILD:
+            return c.mParent->addChild(c.mNode.get());
+         case SceneGraphChange::REMOVE_CHILD:
+            return c.mParent->removeChild(c.mNode.get());
+         case SceneGraphChange::REMOVE_CHILDREN:
+            return c.mParent->removeChildren(0, c.mParent->getNumChildren());
+         case SceneGraphChange::CHANGE_NODE_MASK:
+            c.mNode->setNodeMask((c.mNode->getNodeMask() | c.mSet) & ~c.mClear);
+            return true;
+         case SceneGraphChange::SET_NODE_MASK_RECURSIVE:
+         {
+            NodeMaskVisitor nv(c.mSet);
+            c.mNode->accept(nv);
+            return true;
+         }
+         }
+         return false;
+      }
+
+      bool ApplyOrDefer(const SceneGraphChange& c)
+      {
+         if(!SceneGraphChanges::IsDeferred())
+         {
+            return Apply(c);
+         }
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(s_changesMutex);
+         s_changes.push_back(c);
+         return true;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool SceneGraphChanges::s_deferred = false;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   bool SceneGraphChanges::AddChild(osg::Group* parent, osg::Node* child)
+   {
+      if(child == NULL)
+      {
+         return false;
+      }
+      return ApplyOrDefer(SceneGraphChange(SceneGraphChange::ADD_CHILD, parent, child));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::RemoveChild(osg::Group* parent, osg::Node* child)
+   {
+      ApplyOrDefer(SceneGraphChange(SceneGraphChange::REMOVE_CHILD, parent, child));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::RemoveChildren(osg::Group* parent)
+   {
+      ApplyOrDefer(SceneGraphChange(SceneGraphChange::REMOVE_CHILDREN, parent, NULL));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::ChangeNodeMask(osg::Node* node, unsigned int set, unsigned int clear)
+   {
+      ApplyOrDefer(SceneGraphChange(SceneGraphChange::CHANGE_NODE_MASK, NULL, node, set, clear));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::SetNodeMask(osg::Node* node, unsigned int mask, bool recursive)
+   {
+      if(recursive)
+      {
+         ApplyOrDefer(SceneGraphChange(SceneGraphChange::SET_NODE_MASK_RECURSIVE, NULL, node, mask));
+      }
+      else
+      {
+         ApplyOrDefer(SceneGraphChange(SceneGraphChange::CHANGE_NODE_MASK, NULL, node, mask, ~mask));
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::SetDeferred(bool v)
+   {
+      if(!v && s_deferred)
+      {
+         ApplyChanges();
+      }
+      s_deferred = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::ApplyChanges()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(s_changesMutex);
+      for(std::vector<SceneGraphChange>::const_iterator i = s_changes.begin(); i != s_changes.end(); ++i)
+      {
+         Apply(*i);
+      }
+      s_changes.clear();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::AddDirectWriter()
+   {
+      ++s_numDirectWriters;
+      if(s_deferred)
+      {
+         LOG_ERROR("Entity system changing the scene graph directly was created in pipelined mode!");
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   void SceneGraphChanges::RemoveDirectWriter()
+   {
+      --s_numDirectWriters;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   unsigned int SceneGraphChanges::GetNumDirectWriters()
+   {
+      return s_numDirectWriters;
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    NodeStore::NodeStore()
       : mNode(new osg::Node())
@@ -76,7 +239,7 @@ namespace dtEntityOSG
             GroupComponent* grp = dynamic_cast<GroupComponent*>(comp);
             if(grp)
             {
-               grp->GetAttachmentGroup()->removeChild(GetNode());
+               SceneGraphChanges::RemoveChild(grp->GetAttachmentGroup(), GetNode());
             }
          }
       }
@@ -92,10 +255,12 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    void NodeStore::SetNode(osg::Node* node)
    {  
-      // remove current node from all its parents
-      while(mNode->getNumParents() != 0)
+      // remove current node from all its parents. Copy list, deferred
+      // changes do not modify it.
+      osg::Node::ParentList parents = mNode->getParents();
+      for(osg::Node::ParentList::iterator i = parents.begin(); i != parents.end(); ++i)
       {
-         mNode->getParent(0)->removeChild(mNode);
+         SceneGraphChanges::RemoveChild(*i, mNode);
       }
       dtEntity::Entity* entity = GetNodeEntity();
       mNode->setUserData(0);
@@ -125,7 +290,7 @@ namespace dtEntityOSG
                {
                   assert(dynamic_cast<GroupComponent*>(parent) != NULL);
                   
-                  bool success = static_cast<GroupComponent*>(parent)->GetAttachmentGroup()->addChild(mNode);                  
+                  bool success = SceneGraphChanges::AddChild(static_cast<GroupComponent*>(parent)->GetAttachmentGroup(), mNode);
                   assert(success);
                }
             }            
@@ -136,15 +301,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    void NodeStore::SetNodeMask(unsigned int nodemask, bool recursive)
    {
-      if(recursive)
-      {
-         NodeMaskVisitor nv(nodemask);
-         GetNode()->accept(nv);
-      }
-      else
-      {
-         GetNode()->setNodeMask(nodemask);
-      }
+      SceneGraphChanges::SetNodeMask(GetNode(), nodemask, recursive);
    }
   
    ////////////////////////////////////////////////////////////////////////////
@@ -155,7 +312,7 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId NodeComponent::TYPE(dtEntity::SID("Node"));
+   const dtEntity::StringId NodeComponent::TYPE(SID_LITERAL("Node"));
    
    ////////////////////////////////////////////////////////////////////////////
    NodeComponent::NodeComponent()
@@ -235,8 +235,8 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId OSGAnimationComponent::TYPE(dtEntity::SID("OSGAnimation"));
-   const dtEntity::StringId OSGAnimationComponent::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId OSGAnimationComponent::TYPE(SID_LITERAL("OSGAnimation"));
+   const dtEntity::StringId OSGAnimationComponent::EnabledId(SID_LITERAL("Enabled"));
    
    ////////////////////////////////////////////////////////////////////////////
    OSGAnimationComponent::OSGAnimationComponent()
@@ -419,10 +419,10 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId OSGAnimationSystem::TYPE(dtEntity::SID("OSGAnimation"));
-   const dtEntity::StringId OSGAnimationSystem::VertexShaderId(dtEntity::SID("VertexShader"));
-   const dtEntity::StringId OSGAnimationSystem::FragmentShaderId(dtEntity::SID("FragmentShader"));
-   const dtEntity::StringId OSGAnimationSystem::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId OSGAnimationSystem::TYPE(SID_LITERAL("OSGAnimation"));
+   const dtEntity::StringId OSGAnimationSystem::VertexShaderId(SID_LITERAL("VertexShader"));
+   const dtEntity::StringId OSGAnimationSystem::FragmentShaderId(SID_LITERAL("FragmentShader"));
+   const dtEntity::StringId OSGAnimationSystem::EnabledId(SID_LITERAL("Enabled"));
    
    ////////////////////////////////////////////////////////////////////////////
    OSGAnimationSystem::OSGAnimationSystem(dtEntity::EntityManager& em)
@@ -432,6 +432,7 @@ namespace dtEntityOSG
            dtEntity::DynamicBoolProperty::SetValueCB(this, &OSGAnimationSystem::SetEnabled),
            dtEntity::DynamicBoolProperty::GetValueCB(this, &OSGAnimationSystem::GetEnabled)))
    {
+      SceneGraphChanges::AddDirectWriter();
       Register(VertexShaderId, &mVertexShader);
       Register(FragmentShaderId, &mFragmentShader);
       Register(EnabledId, &mEnabled);
@@ -455,6 +456,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    OSGAnimationSystem::~OSGAnimationSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
       GetEntityManager().UnregisterForMessages(dtEntity::MeshChangedMessage::TYPE, mMeshChangedFunctor);
    }
 
@@ -148,7 +148,9 @@ namespace dtEntityOSG
 
       if(enabled)
       {
-         mEntityManager->RegisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor, dtEntity::FilterOptions::ORDER_EARLIEST, "OSGDebugDrawInterface::Update");
+         mEntityManager->RegisterForTypedMessages<dtEntity::TickData>(mTickFunctor, dtEntity::FilterOptions::ORDER_EARLIEST, "OSGDebugDrawInterface::Update");
+         // adds and removes drawables on every tick
+         SceneGraphChanges::AddDirectWriter();
          mGroupDepthTest->setNodeMask(ALL_BITS);
          mGroupNoDepthTest->setNodeMask(ALL_BITS);
       }
@@ -157,7 +159,8 @@ namespace dtEntityOSG
          Clear();
          mGroupDepthTest->setNodeMask(0);
          mGroupNoDepthTest->setNodeMask(0);
-         mEntityManager->UnregisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor);
+         mEntityManager->UnregisterForTypedMessages<dtEntity::TickData>(mTickFunctor);
+         SceneGraphChanges::RemoveDirectWriter();
       }
       mEnabled = enabled;
    }
@@ -175,10 +178,9 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////////
-   void OSGDebugDrawInterface::Tick(const dtEntity::Message& m)
+   void OSGDebugDrawInterface::Tick(const dtEntity::TickData& msg)
    {
-      const dtEntity::TickMessage& msg = static_cast<const dtEntity::TickMessage&>(m);
-      float dt = msg.GetDeltaRealTime();
+      float dt = msg.mDeltaRealTime;
 
       mCurrentTime += dt;
       unsigned int i = 0;
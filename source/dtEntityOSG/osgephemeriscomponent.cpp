@@ -106,7 +106,7 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId OSGEphemerisComponent::TYPE(dtEntity::SID("OSGEphemeris"));
+   const dtEntity::StringId OSGEphemerisComponent::TYPE(SID_LITERAL("OSGEphemeris"));
    
 
    class SetRenderBinsVisitor : public osg::NodeVisitor
@@ -186,12 +186,13 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId OSGEphemerisSystem::TYPE(dtEntity::SID("OSGEphemeris"));
+   const dtEntity::StringId OSGEphemerisSystem::TYPE(SID_LITERAL("OSGEphemeris"));
    
    ////////////////////////////////////////////////////////////////////////////
    OSGEphemerisSystem::OSGEphemerisSystem(dtEntity::EntityManager& em)
      : dtEntity::DefaultEntitySystem<OSGEphemerisComponent>(em)
    {
+      SceneGraphChanges::AddDirectWriter();
       mTickFunctor = dtEntity::MessageFunctor(this, &OSGEphemerisSystem::Tick);
       GetEntityManager().RegisterForMessages(dtEntity::TickMessage::TYPE,
          mTickFunctor, dtEntity::FilterOptions::ORDER_LATE, "OSGEphemerisSystem::Tick");
@@ -200,6 +201,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    OSGEphemerisSystem::~OSGEphemerisSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -21,8 +21,16 @@
 #include <dtEntityOSG/osgsysteminterface.h>
 
 #include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/log.h>
 #include <dtEntity/messagepump.h>
 #include <dtEntity/systemmessages.h>
+#include <dtEntityOSG/nodecomponent.h>
+#include <dtEntityOSG/transformcomponent.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
 #include <osg/NodeCallback>
 #include <osg/Timer>
 #include <osg/FrameStamp>
@@ -98,20 +106,146 @@ namespace dtEntityOSG
 
    };
 
+   namespace
+   {
+      ////////////////////////////////////////////////////////////////////////////////
+      void EmitFrameMessages(dtEntity::MessagePump& pump, const dtEntity::TickData& tick)
+      {
+         // typed messages, a TickMessage is only built if script or
+         // other property based handlers are registered
+         pump.EmitTypedMessage(tick);
+
+         pump.EmitQueuedMessages(tick.mSimulationTime);
+
+         dtEntity::EndOfFrameData endofframe;
+         static_cast<dtEntity::TickData&>(endofframe) = tick;
+         pump.EmitTypedMessage(endofframe);
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /**
+       * Emits the messages of one frame when the main thread hands over a frame,
+       * used in pipelined mode
+       */
+      class SimulationThread : public OpenThreads::Thread
+      {
+      public:
+
+         SimulationThread(dtEntity::MessagePump& pump)
+            : mMessagePump(&pump)
+            , mHasFrame(false)
+            , mQuit(false)
+         {
+         }
+
+         // previous frame has to be finished
+         void StartFrame(const dtEntity::TickData& tick)
+         {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+            mTick = tick;
+            mHasFrame = true;
+            mCondition.broadcast();
+         }
+
+         void WaitForFrame()
+         {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+            while(mHasFrame)
+            {
+               mCondition.wait(&mMutex);
+            }
+         }
+
+         // finish current frame and stop thread
+         void Quit()
+         {
+            WaitForFrame();
+            {
+               OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+               mQuit = true;
+               mCondition.broadcast();
+            }
+            join();
+         }
+
+         virtual void run()
+         {
+            for(;;)
+            {
+               dtEntity::TickData tick;
+               {
+                  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+                  while(!mHasFrame && !mQuit)
+                  {
+                     mCondition.wait(&mMutex);
+                  }
+                  if(mQuit)
+                  {
+                     return;
+                  }
+                  tick = mTick;
+               }
+
+               EmitFrameMessages(*mMessagePump, tick);
+
+               dtEntity::PostUpdateData postupdate;
+               static_cast<dtEntity::TickData&>(postupdate) = tick;
+               mMessagePump->EmitTypedMessage(postupdate);
+
+               OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+               mHasFrame = false;
+               mCondition.broadcast();
+            }
+         }
+
+      private:
+
+         dtEntity::MessagePump* mMessagePump;
+         dtEntity::TickData mTick;
+         bool mHasFrame;
+         bool mQuit;
+         OpenThreads::Mutex mMutex;
+         OpenThreads::Condition mCondition;
+      };
+   }
+
    class OSGSystemInterface::Impl
    {
    public:
 	   Impl() 
 		   : mUpdateCallback(new DtEntityUpdateCallback())
+		   , mSimulationThread(NULL)
+		   , mFrameClockTime(0)
 	   {
 	   }
 		
 	   osg::ref_ptr<DtEntityUpdateCallback> mUpdateCallback;
+
+	   // only exists in pipelined mode
+	   SimulationThread* mSimulationThread;
+
+	   // time values of frame being simulated. The update callback
+	   // changes its values while the simulation thread runs.
+	   dtEntity::TickData mFrame;
+	   dtEntity::Timer_t mFrameClockTime;
    };
 
+   ////////////////////////////////////////////////////////////////////////////////
+   OSGSystemInterface::OSGSystemInterface(dtEntity::EntityManager& em, int argc, const char** argv)
+      : mEntityManager(&em)
+      , mMessagePump(&em.GetMessagePump())
+      , mImpl(new Impl())
+      , mArgC(argc)
+   {  
+      // create a copy of the argv
+      for (int i =0; i<mArgC; ++i)
+         mArgV.push_back(std::string(argv[i]));
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    OSGSystemInterface::OSGSystemInterface(dtEntity::MessagePump& mp, int argc, const char** argv)
-      : mMessagePump(&mp)
+      : mEntityManager(NULL)
+      , mMessagePump(&mp)
       , mImpl(new Impl())
       , mArgC(argc)
    {  
@@ -124,6 +258,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////////
    OSGSystemInterface::~OSGSystemInterface()
    {
+      SetPipelined(false);
       if(mViewer.valid())
       {
          mViewer->stopThreading();
@@ -140,49 +275,95 @@ namespace dtEntityOSG
    //////////////////////////////////////////////////////////////////////////////
    void OSGSystemInterface::EmitTickMessagesAndQueuedMessages()
    {
-      float deltasimtime = GetDeltaSimTime();
-      float deltarealtime = GetDeltaRealTime();
-      float simtimescale = GetTimeScale();
-      double simulationtime = GetSimulationTime();
-
+      if(mImpl->mSimulationThread == NULL)
       {
-         dtEntity::TickMessage msg;
-         msg.SetDeltaSimTime(deltasimtime);
-         msg.SetDeltaRealTime(deltarealtime);
-         msg.SetSimTimeScale(simtimescale);
-         msg.SetSimulationTime(simulationtime);
-         mMessagePump->EmitMessage(msg);
-      }
-
-      mMessagePump->EmitQueuedMessages(simulationtime);
-
-      {
-         dtEntity::EndOfFrameMessage msg;
-         msg.SetDeltaSimTime(deltasimtime);
-         msg.SetDeltaRealTime(deltarealtime);
-         msg.SetSimTimeScale(simtimescale);
-         msg.SetSimulationTime(simulationtime);
-         mMessagePump->EmitMessage(msg);
+         dtEntity::TickData tick;
+         tick.mDeltaSimTime = GetDeltaSimTime();
+         tick.mDeltaRealTime = GetDeltaRealTime();
+         tick.mSimTimeScale = GetTimeScale();
+         tick.mSimulationTime = GetSimulationTime();
+         EmitFrameMessages(*mMessagePump, tick);
+         return;
       }
 
+      // sync point: cull of last frame is done, simulation of last frame
+      // is done after wait. Show its results and start next frame.
+      mImpl->mSimulationThread->WaitForFrame();
+      SceneGraphChanges::ApplyChanges();
+      TransformSystem::GetOrCreate(*mEntityManager).SwapBuffers();
+
+      DtEntityUpdateCallback* cb = mImpl->mUpdateCallback.get();
+      mImpl->mFrame.mDeltaSimTime = cb->mDeltaSimTime;
+      mImpl->mFrame.mDeltaRealTime = cb->mDeltaTime;
+      mImpl->mFrame.mSimTimeScale = cb->mTimeScale;
+      mImpl->mFrame.mSimulationTime = cb->mSimTime;
+      mImpl->mFrameClockTime = cb->mSimulationClockTime;
+      mImpl->mSimulationThread->StartFrame(mImpl->mFrame);
    }
    
    //////////////////////////////////////////////////////////////////////////////
    void OSGSystemInterface::EmitPostUpdateMessage()
    {
-      float deltasimtime = GetDeltaSimTime();
-      float deltarealtime = GetDeltaRealTime();
-      float simtimescale = GetTimeScale();
-      double simulationtime = GetSimulationTime();
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return;
+      }
+      dtEntity::PostUpdateData msg;
+      msg.mDeltaSimTime = GetDeltaSimTime();
+      msg.mDeltaRealTime = GetDeltaRealTime();
+      msg.mSimTimeScale = GetTimeScale();
+      msg.mSimulationTime = GetSimulationTime();
+      mMessagePump->EmitTypedMessage(msg);
+   }
 
+   //////////////////////////////////////////////////////////////////////////////
+   bool OSGSystemInterface::SetPipelined(bool v)
+   {
+      if(v == IsPipelined())
+      {
+         return true;
+      }
+      if(v)
+      {
+         if(mEntityManager == NULL)
+         {
+            LOG_WARNING("Cannot switch to pipelined mode: system interface was created without entity manager.");
+            return false;
+         }
+         if(SceneGraphChanges::GetNumDirectWriters() != 0)
+         {
+            LOG_WARNING("Cannot switch to pipelined mode: " << SceneGraphChanges::GetNumDirectWriters()
+               << " entity systems change the scene graph directly.");
+            return false;
+         }
+         SceneGraphChanges::SetDeferred(true);
+         TransformSystem::GetOrCreate(*mEntityManager).SetDoubleBuffered(true);
+         mImpl->mSimulationThread = new SimulationThread(*mMessagePump);
+         mImpl->mSimulationThread->start();
+      }
+      else
+      {
+         mImpl->mSimulationThread->Quit();
+         delete mImpl->mSimulationThread;
+         mImpl->mSimulationThread = NULL;
+         SceneGraphChanges::SetDeferred(false);
+         TransformSystem::GetOrCreate(*mEntityManager).SetDoubleBuffered(false);
+      }
+      return true;
+   }
 
+   //////////////////////////////////////////////////////////////////////////////
+   bool OSGSystemInterface::IsPipelined() const
+   {
+      return mImpl->mSimulationThread != NULL;
+   }
+
+   //////////////////////////////////////////////////////////////////////////////
+   void OSGSystemInterface::WaitForSimulation()
+   {
+      if(mImpl->mSimulationThread != NULL)
       {
-         dtEntity::PostUpdateMessage msg;
-         msg.SetDeltaSimTime(deltasimtime);
-         msg.SetDeltaRealTime(deltarealtime);
-         msg.SetSimTimeScale(simtimescale);
-         msg.SetSimulationTime(simulationtime);
-         mMessagePump->EmitMessage(msg);
+         mImpl->mSimulationThread->WaitForFrame();
       }
    }
 
@@ -219,18 +400,30 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////////
    float OSGSystemInterface::GetDeltaSimTime() const
    {
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return mImpl->mFrame.mDeltaSimTime;
+      }
       return mImpl->mUpdateCallback->mDeltaSimTime;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    float OSGSystemInterface::GetDeltaRealTime() const
    {
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return mImpl->mFrame.mDeltaRealTime;
+      }
       return mImpl->mUpdateCallback->mDeltaTime;
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    float OSGSystemInterface::GetTimeScale() const
    {
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return mImpl->mFrame.mSimTimeScale;
+      }
       return mImpl->mUpdateCallback->mTimeScale;
    }
 
@@ -248,6 +441,10 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////////
    double OSGSystemInterface::GetSimulationTime() const
    {
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return mImpl->mFrame.mSimulationTime;
+      }
       return mImpl->mUpdateCallback->mSimTime;
    }
 
@@ -290,6 +487,10 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////////
    dtEntity::Timer_t OSGSystemInterface::GetSimulationClockTime() const
    {
+      if(mImpl->mSimulationThread != NULL)
+      {
+         return mImpl->mFrameClockTime;
+      }
       return mImpl->mUpdateCallback->mSimulationClockTime;
    }
 
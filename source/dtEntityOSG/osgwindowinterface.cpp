@@ -527,7 +527,7 @@ namespace dtEntityOSG
    {
       if(layer == dtEntity::StringId())
       {
-         layer = dtEntity::SID("default");
+         layer = SID_LITERAL("default");
       }
       osg::ref_ptr<osgUtil::LineSegmentIntersector> lsi;
       lsi = new osgUtil::LineSegmentIntersector(start, end);
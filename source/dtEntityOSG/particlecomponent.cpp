@@ -37,72 +37,72 @@ namespace dtEntityOSG
 {
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ParticleComponent::TYPE(dtEntity::SID("Particle"));
+   const dtEntity::StringId ParticleComponent::TYPE(SID_LITERAL("Particle"));
    
-   const dtEntity::StringId ParticleComponent::AlphaRangeId(dtEntity::SID("AlphaRange"));
-   const dtEntity::StringId ParticleComponent::ColorRangeMinId(dtEntity::SID("ColorRangeMin"));
-   const dtEntity::StringId ParticleComponent::ColorRangeMaxId(dtEntity::SID("ColorRangeMax"));
-
-   const dtEntity::StringId ParticleComponent::CounterId(dtEntity::SID("Counter"));
-   const dtEntity::StringId ParticleComponent::DebugOnId(dtEntity::SID("DebugOn"));
-   const dtEntity::StringId ParticleComponent::EmissiveParticlesId(dtEntity::SID("EmissiveParticles"));
-   const dtEntity::StringId ParticleComponent::EnabledId(dtEntity::SID("Enabled"));
-   const dtEntity::StringId ParticleComponent::LifeTimeId(dtEntity::SID("LifeTime"));
-   const dtEntity::StringId ParticleComponent::LightingId(dtEntity::SID("Lighting"));
-   const dtEntity::StringId ParticleComponent::MassId(dtEntity::SID("Mass"));
-   const dtEntity::StringId ParticleComponent::PlacerId(dtEntity::SID("Placer"));
-   const dtEntity::StringId ParticleComponent::OperatorsId(dtEntity::SID("Operators"));
-   const dtEntity::StringId ParticleComponent::SizeRangeId(dtEntity::SID("SizeRange"));
-   const dtEntity::StringId ParticleComponent::TextureFileId(dtEntity::SID("TextureFile"));
-   const dtEntity::StringId ParticleComponent::TextureUnitId(dtEntity::SID("TextureUnit"));
-   const dtEntity::StringId ParticleComponent::__SELECTED__Id(dtEntity::SID("__SELECTED__"));
-
-   const dtEntity::StringId ParticleComponent::BoxId(dtEntity::SID("Box"));
-   const dtEntity::StringId ParticleComponent::CompositeId(dtEntity::SID("Composite"));
-   const dtEntity::StringId ParticleComponent::MultiSegmentId(dtEntity::SID("MultiSegment"));
-   const dtEntity::StringId ParticleComponent::PointId(dtEntity::SID("Point"));
-   const dtEntity::StringId ParticleComponent::SectorId(dtEntity::SID("Sector"));
-   const dtEntity::StringId ParticleComponent::SegmentId(dtEntity::SID("Segment"));
+   const dtEntity::StringId ParticleComponent::AlphaRangeId(SID_LITERAL("AlphaRange"));
+   const dtEntity::StringId ParticleComponent::ColorRangeMinId(SID_LITERAL("ColorRangeMin"));
+   const dtEntity::StringId ParticleComponent::ColorRangeMaxId(SID_LITERAL("ColorRangeMax"));
+
+   const dtEntity::StringId ParticleComponent::CounterId(SID_LITERAL("Counter"));
+   const dtEntity::StringId ParticleComponent::DebugOnId(SID_LITERAL("DebugOn"));
+   const dtEntity::StringId ParticleComponent::EmissiveParticlesId(SID_LITERAL("EmissiveParticles"));
+   const dtEntity::StringId ParticleComponent::EnabledId(SID_LITERAL("Enabled"));
+   const dtEntity::StringId ParticleComponent::LifeTimeId(SID_LITERAL("LifeTime"));
+   const dtEntity::StringId ParticleComponent::LightingId(SID_LITERAL("Lighting"));
+   const dtEntity::StringId ParticleComponent::MassId(SID_LITERAL("Mass"));
+   const dtEntity::StringId ParticleComponent::PlacerId(SID_LITERAL("Placer"));
+   const dtEntity::StringId ParticleComponent::OperatorsId(SID_LITERAL("Operators"));
+   const dtEntity::StringId ParticleComponent::SizeRangeId(SID_LITERAL("SizeRange"));
+   const dtEntity::StringId ParticleComponent::TextureFileId(SID_LITERAL("TextureFile"));
+   const dtEntity::StringId ParticleComponent::TextureUnitId(SID_LITERAL("TextureUnit"));
+   const dtEntity::StringId ParticleComponent::__SELECTED__Id(SID_LITERAL("__SELECTED__"));
+
+   const dtEntity::StringId ParticleComponent::BoxId(SID_LITERAL("Box"));
+   const dtEntity::StringId ParticleComponent::CompositeId(SID_LITERAL("Composite"));
+   const dtEntity::StringId ParticleComponent::MultiSegmentId(SID_LITERAL("MultiSegment"));
+   const dtEntity::StringId ParticleComponent::PointId(SID_LITERAL("Point"));
+   const dtEntity::StringId ParticleComponent::SectorId(SID_LITERAL("Sector"));
+   const dtEntity::StringId ParticleComponent::SegmentId(SID_LITERAL("Segment"));
  
-   const dtEntity::StringId ParticleComponent::XRangeId(dtEntity::SID("XRange"));
-   const dtEntity::StringId ParticleComponent::YRangeId(dtEntity::SID("YRange"));
-   const dtEntity::StringId ParticleComponent::ZRangeId(dtEntity::SID("ZRange"));
-   const dtEntity::StringId ParticleComponent::CenterId(dtEntity::SID("Center"));
+   const dtEntity::StringId ParticleComponent::XRangeId(SID_LITERAL("XRange"));
+   const dtEntity::StringId ParticleComponent::YRangeId(SID_LITERAL("YRange"));
+   const dtEntity::StringId ParticleComponent::ZRangeId(SID_LITERAL("ZRange"));
+   const dtEntity::StringId ParticleComponent::CenterId(SID_LITERAL("Center"));
 
-   const dtEntity::StringId ParticleComponent::RandomRateCounterId(dtEntity::SID("RandomRateCounter"));
-   const dtEntity::StringId ParticleComponent::ConstantRateCounterId(dtEntity::SID("ConstantRateCounter"));
+   const dtEntity::StringId ParticleComponent::RandomRateCounterId(SID_LITERAL("RandomRateCounter"));
+   const dtEntity::StringId ParticleComponent::ConstantRateCounterId(SID_LITERAL("ConstantRateCounter"));
 
-   const dtEntity::StringId ParticleComponent::RateRangeId(dtEntity::SID("RateRange"));
-   const dtEntity::StringId ParticleComponent::MinimumNumberOfParticlesToCreateId(dtEntity::SID("MinimumNumberOfParticlesToCreate"));
-   const dtEntity::StringId ParticleComponent::NumberOfParticlesPerSecondToCreateId(dtEntity::SID("NumberOfParticlesPerSecondToCreate"));
+   const dtEntity::StringId ParticleComponent::RateRangeId(SID_LITERAL("RateRange"));
+   const dtEntity::StringId ParticleComponent::MinimumNumberOfParticlesToCreateId(SID_LITERAL("MinimumNumberOfParticlesToCreate"));
+   const dtEntity::StringId ParticleComponent::NumberOfParticlesPerSecondToCreateId(SID_LITERAL("NumberOfParticlesPerSecondToCreate"));
 
-   const dtEntity::StringId ParticleComponent::ShooterThetaRangeId(dtEntity::SID("ShooterThetaRange"));
-   const dtEntity::StringId ParticleComponent::ShooterPhiRangeId(dtEntity::SID("ShooterPhiRange"));
-   const dtEntity::StringId ParticleComponent::ShooterInitialSpeedRangeId(dtEntity::SID("ShooterInitialSpeedRange"));
-   const dtEntity::StringId ParticleComponent::ShooterInitialRotationalSpeedMinId(dtEntity::SID("ShooterInitialRotationalSpeedMin"));
-   const dtEntity::StringId ParticleComponent::ShooterInitialRotationalSpeedMaxId(dtEntity::SID("ShooterInitialRotationalSpeedMax"));
+   const dtEntity::StringId ParticleComponent::ShooterThetaRangeId(SID_LITERAL("ShooterThetaRange"));
+   const dtEntity::StringId ParticleComponent::ShooterPhiRangeId(SID_LITERAL("ShooterPhiRange"));
+   const dtEntity::StringId ParticleComponent::ShooterInitialSpeedRangeId(SID_LITERAL("ShooterInitialSpeedRange"));
+   const dtEntity::StringId ParticleComponent::ShooterInitialRotationalSpeedMinId(SID_LITERAL("ShooterInitialRotationalSpeedMin"));
+   const dtEntity::StringId ParticleComponent::ShooterInitialRotationalSpeedMaxId(SID_LITERAL("ShooterInitialRotationalSpeedMax"));
 
-   const dtEntity::StringId ParticleComponent::ShapeId(dtEntity::SID("Shape"));
-   const dtEntity::StringId ParticleComponent::ShapePointId(dtEntity::SID("Point"));
-   const dtEntity::StringId ParticleComponent::ShapeQuadId(dtEntity::SID("Quad"));
-   const dtEntity::StringId ParticleComponent::ShapeQuadTriangeStripId(dtEntity::SID("QuadTriangeStrip"));
-   const dtEntity::StringId ParticleComponent::ShapeHexagonId(dtEntity::SID("Hexagon"));
-   const dtEntity::StringId ParticleComponent::ShapeLineId(dtEntity::SID("Line"));
+   const dtEntity::StringId ParticleComponent::ShapeId(SID_LITERAL("Shape"));
+   const dtEntity::StringId ParticleComponent::ShapePointId(SID_LITERAL("Point"));
+   const dtEntity::StringId ParticleComponent::ShapeQuadId(SID_LITERAL("Quad"));
+   const dtEntity::StringId ParticleComponent::ShapeQuadTriangeStripId(SID_LITERAL("QuadTriangeStrip"));
+   const dtEntity::StringId ParticleComponent::ShapeHexagonId(SID_LITERAL("Hexagon"));
+   const dtEntity::StringId ParticleComponent::ShapeLineId(SID_LITERAL("Line"));
 
-   const dtEntity::StringId ParticleComponent::BounceOperatorId(dtEntity::SID("BounceOperator"));
-   const dtEntity::StringId ParticleComponent::ForceOperatorId(dtEntity::SID("ForceOperator"));
+   const dtEntity::StringId ParticleComponent::BounceOperatorId(SID_LITERAL("BounceOperator"));
+   const dtEntity::StringId ParticleComponent::ForceOperatorId(SID_LITERAL("ForceOperator"));
 
-   const dtEntity::StringId ParticleComponent::FrictionId(dtEntity::SID("Friction"));
-   const dtEntity::StringId ParticleComponent::ResilienceId(dtEntity::SID("Resilience"));
-   const dtEntity::StringId ParticleComponent::CutoffId(dtEntity::SID("Cutoff"));
-   const dtEntity::StringId ParticleComponent::DomainsId(dtEntity::SID("Domains"));
-   const dtEntity::StringId ParticleComponent::PlaneDomainId(dtEntity::SID("PlaneDomain"));
-   const dtEntity::StringId ParticleComponent::SphereDomainId(dtEntity::SID("SphereDomain"));
+   const dtEntity::StringId ParticleComponent::FrictionId(SID_LITERAL("Friction"));
+   const dtEntity::StringId ParticleComponent::ResilienceId(SID_LITERAL("Resilience"));
+   const dtEntity::StringId ParticleComponent::CutoffId(SID_LITERAL("Cutoff"));
+   const dtEntity::StringId ParticleComponent::DomainsId(SID_LITERAL("Domains"));
+   const dtEntity::StringId ParticleComponent::PlaneDomainId(SID_LITERAL("PlaneDomain"));
+   const dtEntity::StringId ParticleComponent::SphereDomainId(SID_LITERAL("SphereDomain"));
 
-   const dtEntity::StringId ParticleComponent::ForceId(dtEntity::SID("Force"));
-   const dtEntity::StringId ParticleComponent::NormalId(dtEntity::SID("Normal"));
-   const dtEntity::StringId ParticleComponent::DistId(dtEntity::SID("Dist"));
-   const dtEntity::StringId ParticleComponent::RadiusId(dtEntity::SID("Radius"));
+   const dtEntity::StringId ParticleComponent::ForceId(SID_LITERAL("Force"));
+   const dtEntity::StringId ParticleComponent::NormalId(SID_LITERAL("Normal"));
+   const dtEntity::StringId ParticleComponent::DistId(SID_LITERAL("Dist"));
+   const dtEntity::StringId ParticleComponent::RadiusId(SID_LITERAL("Radius"));
 
 
 
@@ -567,16 +567,18 @@ namespace dtEntityOSG
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ParticleSystem::TYPE(dtEntity::SID("Particle"));
+   const dtEntity::StringId ParticleSystem::TYPE(SID_LITERAL("Particle"));
 
    ////////////////////////////////////////////////////////////////////////////
    ParticleSystem::ParticleSystem(dtEntity::EntityManager& em)
       : BaseClass(em)
    {
+      SceneGraphChanges::AddDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
    ParticleSystem::~ParticleSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 }
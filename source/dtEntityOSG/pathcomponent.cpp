@@ -39,11 +39,11 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId PathComponent::TYPE(dtEntity::SID("Path"));
+   const dtEntity::StringId PathComponent::TYPE(SID_LITERAL("Path"));
 
-   const dtEntity::StringId PathComponent::VertsId(dtEntity::SID("Verts"));
-   const dtEntity::StringId PathComponent::PathVisibleId(dtEntity::SID("PathVisible"));
-   const dtEntity::StringId PathComponent::VertsVisibleId(dtEntity::SID("VertsVisible"));
+   const dtEntity::StringId PathComponent::VertsId(SID_LITERAL("Verts"));
+   const dtEntity::StringId PathComponent::PathVisibleId(SID_LITERAL("PathVisible"));
+   const dtEntity::StringId PathComponent::VertsVisibleId(SID_LITERAL("VertsVisible"));
 
    ////////////////////////////////////////////////////////////////////////////
    PathComponent::PathComponent()
@@ -150,12 +150,13 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId PathSystem::TYPE(dtEntity::SID("Path"));
+   const dtEntity::StringId PathSystem::TYPE(SID_LITERAL("Path"));
 
    ////////////////////////////////////////////////////////////////////////////
    PathSystem::PathSystem(dtEntity::EntityManager& em)
       : BaseClass(em)
    {
+      SceneGraphChanges::AddDirectWriter();
       AddScriptedMethod("pickVertex", dtEntity::ScriptMethodFunctor(this, &PathSystem::ScriptPickVertex));
       AddScriptedMethod("getVertexWorldPosition", dtEntity::ScriptMethodFunctor(this, &PathSystem::ScriptGetVertexWorldPosition));
       AddScriptedMethod("setVertexWorldPosition", dtEntity::ScriptMethodFunctor(this, &PathSystem::ScriptSetVertexWorldPosition));
@@ -165,6 +166,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    PathSystem::~PathSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -30,10 +30,10 @@ namespace dtEntityOSG
 {
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId PickShapeComponent::TYPE(dtEntity::SID("PickShape"));
-   const dtEntity::StringId PickShapeComponent::MinBoundsId(dtEntity::SID("MinBounds"));
-   const dtEntity::StringId PickShapeComponent::MaxBoundsId(dtEntity::SID("MaxBounds"));
-   const dtEntity::StringId PickShapeComponent::VisibleId(dtEntity::SID("Visible"));
+   const dtEntity::StringId PickShapeComponent::TYPE(SID_LITERAL("PickShape"));
+   const dtEntity::StringId PickShapeComponent::MinBoundsId(SID_LITERAL("MinBounds"));
+   const dtEntity::StringId PickShapeComponent::MaxBoundsId(SID_LITERAL("MaxBounds"));
+   const dtEntity::StringId PickShapeComponent::VisibleId(SID_LITERAL("Visible"));
    
    ////////////////////////////////////////////////////////////////////////////
    PickShapeComponent::PickShapeComponent()
@@ -123,18 +123,20 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId PickShapeSystem::TYPE(dtEntity::SID("PickShape"));
+   const dtEntity::StringId PickShapeSystem::TYPE(SID_LITERAL("PickShape"));
 
    ////////////////////////////////////////////////////////////////////////////
    PickShapeSystem::PickShapeSystem(dtEntity::EntityManager& em)
       : dtEntity::DefaultEntitySystem<PickShapeComponent>(em)
    {
+      SceneGraphChanges::AddDirectWriter();
 
    }
 
    ////////////////////////////////////////////////////////////////////////////
    PickShapeSystem::~PickShapeSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
 }
@@ -26,10 +26,10 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId PositionAttitudeTransformComponent::TYPE(dtEntity::SID("PositionAttitudeTransform"));
-   const dtEntity::StringId PositionAttitudeTransformComponent::PositionId(dtEntity::SID("Position"));
-   const dtEntity::StringId PositionAttitudeTransformComponent::AttitudeId(dtEntity::SID("Attitude"));
-   const dtEntity::StringId PositionAttitudeTransformComponent::ScaleId(dtEntity::SID("Scale"));
+   const dtEntity::StringId PositionAttitudeTransformComponent::TYPE(SID_LITERAL("PositionAttitudeTransform"));
+   const dtEntity::StringId PositionAttitudeTransformComponent::PositionId(SID_LITERAL("Position"));
+   const dtEntity::StringId PositionAttitudeTransformComponent::AttitudeId(SID_LITERAL("Attitude"));
+   const dtEntity::StringId PositionAttitudeTransformComponent::ScaleId(SID_LITERAL("Scale"));
    
    ////////////////////////////////////////////////////////////////////////////
    PositionAttitudeTransformComponent::PositionAttitudeTransformComponent()
@@ -95,40 +95,98 @@ namespace dtEntityOSG
       return static_cast<osg::PositionAttitudeTransform*>(GetNode());
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   void PositionAttitudeTransformComponent::PrepareBackBuffer()
+   {
+      if(!IsBackBufferDirty())
+      {
+         const osg::PositionAttitudeTransform* pat = GetPositionAttitudeTransform();
+         mBackPosition = pat->getPosition();
+         mBackAttitude = pat->getAttitude();
+         mBackScale = pat->getScale();
+         MarkBackBufferDirty();
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void PositionAttitudeTransformComponent::ApplyBackBuffer()
+   {
+      osg::PositionAttitudeTransform* pat = GetPositionAttitudeTransform();
+      pat->setPosition(mBackPosition);
+      pat->setAttitude(mBackAttitude);
+      pat->setScale(mBackScale);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    dtEntity::Vec3d PositionAttitudeTransformComponent::GetPosition() const
    {
+      if(IsBackBufferDirty())
+      {
+         return mBackPosition;
+      }
       return GetPositionAttitudeTransform()->getPosition();
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void PositionAttitudeTransformComponent::SetPosition(const dtEntity::Vec3d& p)
    {
-      GetPositionAttitudeTransform()->setPosition(p);
+      if(IsDoubleBuffered())
+      {
+         PrepareBackBuffer();
+         mBackPosition = p;
+      }
+      else
+      {
+         GetPositionAttitudeTransform()->setPosition(p);
+      }
    }
 
    ////////////////////////////////////////////////////////////////////////////
    dtEntity::Quat PositionAttitudeTransformComponent::GetAttitude() const
    {
+      if(IsBackBufferDirty())
+      {
+         return mBackAttitude;
+      }
       return GetPositionAttitudeTransform()->getAttitude();
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void PositionAttitudeTransformComponent::SetAttitude(const dtEntity::Quat& p)
    {
-      GetPositionAttitudeTransform()->setAttitude(p);
+      if(IsDoubleBuffered())
+      {
+         PrepareBackBuffer();
+         mBackAttitude = p;
+      }
+      else
+      {
+         GetPositionAttitudeTransform()->setAttitude(p);
+      }
    }
 
    ////////////////////////////////////////////////////////////////////////////
    dtEntity::Vec3d PositionAttitudeTransformComponent::GetScale() const
    {
+      if(IsBackBufferDirty())
+      {
+         return mBackScale;
+      }
       return GetPositionAttitudeTransform()->getScale();
    }
 
    ////////////////////////////////////////////////////////////////////////////
    void PositionAttitudeTransformComponent::SetScale(const dtEntity::Vec3d& s)
    {
-      GetPositionAttitudeTransform()->setScale(s);
+      if(IsDoubleBuffered())
+      {
+         PrepareBackBuffer();
+         mBackScale = s;
+      }
+      else
+      {
+         GetPositionAttitudeTransform()->setScale(s);
+      }
    }
 
 }
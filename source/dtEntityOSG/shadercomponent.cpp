@@ -97,9 +97,9 @@ namespace dtEntityOSG
    };
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ShaderComponent::TYPE(dtEntity::SID("Shader"));
-   const dtEntity::StringId ShaderComponent::MaterialNamePrefixId(dtEntity::SID("MaterialNamePrefix"));
-   const dtEntity::StringId ShaderComponent::TopLevelMaterialNameId(dtEntity::SID("TopLevelMaterialName"));
+   const dtEntity::StringId ShaderComponent::TYPE(SID_LITERAL("Shader"));
+   const dtEntity::StringId ShaderComponent::MaterialNamePrefixId(SID_LITERAL("MaterialNamePrefix"));
+   const dtEntity::StringId ShaderComponent::TopLevelMaterialNameId(SID_LITERAL("TopLevelMaterialName"));
 
    ////////////////////////////////////////////////////////////////////////////
    ShaderComponent::ShaderComponent()
@@ -121,7 +121,7 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ShaderSystem::TYPE(dtEntity::SID("Shader"));
+   const dtEntity::StringId ShaderSystem::TYPE(SID_LITERAL("Shader"));
 
    ////////////////////////////////////////////////////////////////////////////
    ShaderSystem::ShaderSystem(dtEntity::EntityManager& em)
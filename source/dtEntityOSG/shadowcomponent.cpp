@@ -39,28 +39,28 @@ namespace dtEntityOSG
 {
   
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ShadowComponent::TYPE(dtEntity::SID("Shadow"));
-   const dtEntity::StringId ShadowComponent::ShadowTechniqueId(dtEntity::SID("ShadowTechnique"));
-   const dtEntity::StringId ShadowComponent::MinLightMarginId(dtEntity::SID("MinLightMargin"));
-   const dtEntity::StringId ShadowComponent::MaxFarPlaneId(dtEntity::SID("MaxFarPlane"));
-   const dtEntity::StringId ShadowComponent::TexSizeId(dtEntity::SID("TexSize"));
-   const dtEntity::StringId ShadowComponent::BaseTexUnitId(dtEntity::SID("BaseTexUnit"));
-   const dtEntity::StringId ShadowComponent::ShadowTexUnitId(dtEntity::SID("ShadowTexUnit"));
-   const dtEntity::StringId ShadowComponent::ShadowTexCoordIndexId(dtEntity::SID("ShadowTexCoordIndex"));
-   const dtEntity::StringId ShadowComponent::BaseTexCoordIndexId(dtEntity::SID("BaseTexCoordIndex"));
-   const dtEntity::StringId ShadowComponent::MapCountId(dtEntity::SID("MapCount"));
-   const dtEntity::StringId ShadowComponent::MapResId(dtEntity::SID("MapRes"));
-   const dtEntity::StringId ShadowComponent::DebugColorOnId(dtEntity::SID("DebugColorOn"));
-   const dtEntity::StringId ShadowComponent::MinNearSplitId(dtEntity::SID("MinNearSplit"));
-   const dtEntity::StringId ShadowComponent::MaxFarDistId(dtEntity::SID("MaxFarDist"));
-   const dtEntity::StringId ShadowComponent::MoveVCamFactorId(dtEntity::SID("MoveVCamFactor"));
-   const dtEntity::StringId ShadowComponent::PolyOffsetFactorId(dtEntity::SID("PolyOffsetFactor"));
-   const dtEntity::StringId ShadowComponent::PolyOffsetUnitId(dtEntity::SID("PolyOffsetUnit"));
-   const dtEntity::StringId ShadowComponent::EnabledId(dtEntity::SID("Enabled"));
-   const dtEntity::StringId ShadowComponent::ShadowTypeId(dtEntity::SID("ShadowType"));
-   const dtEntity::StringId ShadowComponent::LISPId(dtEntity::SID("LISP"));
-   const dtEntity::StringId ShadowComponent::PSSMId(dtEntity::SID("PSSM"));
-   const dtEntity::StringId ShadowComponent::__SELECTED__Id(dtEntity::SID("__SELECTED__"));
+   const dtEntity::StringId ShadowComponent::TYPE(SID_LITERAL("Shadow"));
+   const dtEntity::StringId ShadowComponent::ShadowTechniqueId(SID_LITERAL("ShadowTechnique"));
+   const dtEntity::StringId ShadowComponent::MinLightMarginId(SID_LITERAL("MinLightMargin"));
+   const dtEntity::StringId ShadowComponent::MaxFarPlaneId(SID_LITERAL("MaxFarPlane"));
+   const dtEntity::StringId ShadowComponent::TexSizeId(SID_LITERAL("TexSize"));
+   const dtEntity::StringId ShadowComponent::BaseTexUnitId(SID_LITERAL("BaseTexUnit"));
+   const dtEntity::StringId ShadowComponent::ShadowTexUnitId(SID_LITERAL("ShadowTexUnit"));
+   const dtEntity::StringId ShadowComponent::ShadowTexCoordIndexId(SID_LITERAL("ShadowTexCoordIndex"));
+   const dtEntity::StringId ShadowComponent::BaseTexCoordIndexId(SID_LITERAL("BaseTexCoordIndex"));
+   const dtEntity::StringId ShadowComponent::MapCountId(SID_LITERAL("MapCount"));
+   const dtEntity::StringId ShadowComponent::MapResId(SID_LITERAL("MapRes"));
+   const dtEntity::StringId ShadowComponent::DebugColorOnId(SID_LITERAL("DebugColorOn"));
+   const dtEntity::StringId ShadowComponent::MinNearSplitId(SID_LITERAL("MinNearSplit"));
+   const dtEntity::StringId ShadowComponent::MaxFarDistId(SID_LITERAL("MaxFarDist"));
+   const dtEntity::StringId ShadowComponent::MoveVCamFactorId(SID_LITERAL("MoveVCamFactor"));
+   const dtEntity::StringId ShadowComponent::PolyOffsetFactorId(SID_LITERAL("PolyOffsetFactor"));
+   const dtEntity::StringId ShadowComponent::PolyOffsetUnitId(SID_LITERAL("PolyOffsetUnit"));
+   const dtEntity::StringId ShadowComponent::EnabledId(SID_LITERAL("Enabled"));
+   const dtEntity::StringId ShadowComponent::ShadowTypeId(SID_LITERAL("ShadowType"));
+   const dtEntity::StringId ShadowComponent::LISPId(SID_LITERAL("LISP"));
+   const dtEntity::StringId ShadowComponent::PSSMId(SID_LITERAL("PSSM"));
+   const dtEntity::StringId ShadowComponent::__SELECTED__Id(SID_LITERAL("__SELECTED__"));
 
 
 
@@ -215,8 +215,8 @@ namespace dtEntityOSG
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ShadowSystem::TYPE(dtEntity::SID("Shadow"));
-   const dtEntity::StringId ShadowSystem::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId ShadowSystem::TYPE(SID_LITERAL("Shadow"));
+   const dtEntity::StringId ShadowSystem::EnabledId(SID_LITERAL("Enabled"));
 
    ////////////////////////////////////////////////////////////////////////////
    ShadowSystem::ShadowSystem(dtEntity::EntityManager& em)
@@ -227,12 +227,14 @@ namespace dtEntityOSG
           )
       , mEnabledVal(true)
    {
+      SceneGraphChanges::AddDirectWriter();
       Register(EnabledId, &mEnabled);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    ShadowSystem::~ShadowSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -178,13 +178,13 @@ namespace dtEntityOSG
 
 
    ////////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId SkyBoxComponent::TYPE(dtEntity::SID("SkyBox"));
-   const dtEntity::StringId SkyBoxComponent::TextureUpId(dtEntity::SID("TextureUp"));
-   const dtEntity::StringId SkyBoxComponent::TextureDownId(dtEntity::SID("TextureDown"));
-   const dtEntity::StringId SkyBoxComponent::TextureNorthId(dtEntity::SID("TextureNorth"));
-   const dtEntity::StringId SkyBoxComponent::TextureSouthId(dtEntity::SID("TextureSouth"));
-   const dtEntity::StringId SkyBoxComponent::TextureEastId(dtEntity::SID("TextureEast"));
-   const dtEntity::StringId SkyBoxComponent::TextureWestId(dtEntity::SID("TextureWest"));
+   const dtEntity::StringId SkyBoxComponent::TYPE(SID_LITERAL("SkyBox"));
+   const dtEntity::StringId SkyBoxComponent::TextureUpId(SID_LITERAL("TextureUp"));
+   const dtEntity::StringId SkyBoxComponent::TextureDownId(SID_LITERAL("TextureDown"));
+   const dtEntity::StringId SkyBoxComponent::TextureNorthId(SID_LITERAL("TextureNorth"));
+   const dtEntity::StringId SkyBoxComponent::TextureSouthId(SID_LITERAL("TextureSouth"));
+   const dtEntity::StringId SkyBoxComponent::TextureEastId(SID_LITERAL("TextureEast"));
+   const dtEntity::StringId SkyBoxComponent::TextureWestId(SID_LITERAL("TextureWest"));
 
    ////////////////////////////////////////////////////////////////////////////
    SkyBoxComponent::SkyBoxComponent()
@@ -298,11 +298,18 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId SkyBoxSystem::TYPE(dtEntity::SID("SkyBox"));
+   const dtEntity::StringId SkyBoxSystem::TYPE(SID_LITERAL("SkyBox"));
 
    ////////////////////////////////////////////////////////////////////////////
    SkyBoxSystem::SkyBoxSystem(dtEntity::EntityManager& em)
       : DefaultEntitySystem<SkyBoxComponent>(em)
    {
+      SceneGraphChanges::AddDirectWriter();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   SkyBoxSystem::~SkyBoxSystem()
+   {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 }
@@ -29,16 +29,16 @@ namespace dtEntityOSG
 {
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId StaticMeshComponent::TYPE(dtEntity::SID("StaticMesh"));
-   const dtEntity::StringId StaticMeshComponent::MeshId(dtEntity::SID("Mesh"));
-   const dtEntity::StringId StaticMeshComponent::OptimizeId(dtEntity::SID("Optimize"));
-   const dtEntity::StringId StaticMeshComponent::IsTerrainId(dtEntity::SID("IsTerrain"));
-   const dtEntity::StringId StaticMeshComponent::CacheHintId(dtEntity::SID("CacheHint"));
+   const dtEntity::StringId StaticMeshComponent::TYPE(SID_LITERAL("StaticMesh"));
+   const dtEntity::StringId StaticMeshComponent::MeshId(SID_LITERAL("Mesh"));
+   const dtEntity::StringId StaticMeshComponent::OptimizeId(SID_LITERAL("Optimize"));
+   const dtEntity::StringId StaticMeshComponent::IsTerrainId(SID_LITERAL("IsTerrain"));
+   const dtEntity::StringId StaticMeshComponent::CacheHintId(SID_LITERAL("CacheHint"));
 
-   const dtEntity::StringId StaticMeshComponent::CacheNoneId(dtEntity::SID("None"));
-   const dtEntity::StringId StaticMeshComponent::CacheAllId(dtEntity::SID("All"));
-   const dtEntity::StringId StaticMeshComponent::CacheNodesId(dtEntity::SID("Nodes"));
-   const dtEntity::StringId StaticMeshComponent::CacheHardwareMeshesId(dtEntity::SID("CacheHardwareMeshes"));
+   const dtEntity::StringId StaticMeshComponent::CacheNoneId(SID_LITERAL("None"));
+   const dtEntity::StringId StaticMeshComponent::CacheAllId(SID_LITERAL("All"));
+   const dtEntity::StringId StaticMeshComponent::CacheNodesId(SID_LITERAL("Nodes"));
+   const dtEntity::StringId StaticMeshComponent::CacheHardwareMeshesId(SID_LITERAL("CacheHardwareMeshes"));
 
    ////////////////////////////////////////////////////////////////////////////
    StaticMeshComponent::StaticMeshComponent()
@@ -81,11 +81,11 @@ namespace dtEntityOSG
       mIsTerrainVal = v; 
       if(mIsTerrainVal)
       {
-         SetNodeMask(GetNode()->getNodeMask() | dtEntity::NodeMasks::TERRAIN);
+         SceneGraphChanges::ChangeNodeMask(GetNode(), dtEntity::NodeMasks::TERRAIN, 0);
       }
       else
       {
-         SetNodeMask(GetNode()->getNodeMask() & ~dtEntity::NodeMasks::TERRAIN);
+         SceneGraphChanges::ChangeNodeMask(GetNode(), 0, dtEntity::NodeMasks::TERRAIN);
       }
    }
    
@@ -176,7 +176,7 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId StaticMeshSystem::TYPE(dtEntity::SID("StaticMesh"));
+   const dtEntity::StringId StaticMeshSystem::TYPE(SID_LITERAL("StaticMesh"));
 
    ////////////////////////////////////////////////////////////////////////////
    StaticMeshSystem::StaticMeshSystem(dtEntity::EntityManager& em)
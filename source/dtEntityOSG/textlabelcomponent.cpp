@@ -42,19 +42,19 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId TextLabelComponent::TYPE(dtEntity::SID("TextLabel"));
-   const dtEntity::StringId TextLabelComponent::TextsId(dtEntity::SID("Texts"));
-   const dtEntity::StringId TextLabelComponent::AlwaysOnTopId(dtEntity::SID("AlwaysOnTop"));
+   const dtEntity::StringId TextLabelComponent::TYPE(SID_LITERAL("TextLabel"));
+   const dtEntity::StringId TextLabelComponent::TextsId(SID_LITERAL("Texts"));
+   const dtEntity::StringId TextLabelComponent::AlwaysOnTopId(SID_LITERAL("AlwaysOnTop"));
 
-   const dtEntity::StringId TextLabelComponent::TextId(dtEntity::SID("Text"));
-   const dtEntity::StringId TextLabelComponent::ColorId(dtEntity::SID("Color"));
-   const dtEntity::StringId TextLabelComponent::BackdropColorId(dtEntity::SID("BackdropColor"));
-   const dtEntity::StringId TextLabelComponent::VisibleId(dtEntity::SID("Visible"));
-   const dtEntity::StringId TextLabelComponent::HighlightedId(dtEntity::SID("Highlighted"));
-   const dtEntity::StringId TextLabelComponent::OffsetId(dtEntity::SID("Offset"));
-   const dtEntity::StringId TextLabelComponent::CharacterHeightId(dtEntity::SID("CharacterHeight"));
-   const dtEntity::StringId TextLabelComponent::FontId(dtEntity::SID("Font"));
-   const dtEntity::StringId TextLabelComponent::AlignmentId(dtEntity::SID("Alignment"));
+   const dtEntity::StringId TextLabelComponent::TextId(SID_LITERAL("Text"));
+   const dtEntity::StringId TextLabelComponent::ColorId(SID_LITERAL("Color"));
+   const dtEntity::StringId TextLabelComponent::BackdropColorId(SID_LITERAL("BackdropColor"));
+   const dtEntity::StringId TextLabelComponent::VisibleId(SID_LITERAL("Visible"));
+   const dtEntity::StringId TextLabelComponent::HighlightedId(SID_LITERAL("Highlighted"));
+   const dtEntity::StringId TextLabelComponent::OffsetId(SID_LITERAL("Offset"));
+   const dtEntity::StringId TextLabelComponent::CharacterHeightId(SID_LITERAL("CharacterHeight"));
+   const dtEntity::StringId TextLabelComponent::FontId(SID_LITERAL("Font"));
+   const dtEntity::StringId TextLabelComponent::AlignmentId(SID_LITERAL("Alignment"));
 
 
    ////////////////////////////////////////////////////////////////////////////
@@ -602,8 +602,8 @@ namespace dtEntityOSG
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId TextLabelSystem::TYPE(dtEntity::SID("TextLabel"));
-   const dtEntity::StringId TextLabelSystem::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId TextLabelSystem::TYPE(SID_LITERAL("TextLabel"));
+   const dtEntity::StringId TextLabelSystem::EnabledId(SID_LITERAL("Enabled"));
    
    ///////////////
    TextLabelSystem::TextLabelSystem(dtEntity::EntityManager& em)
@@ -614,6 +614,7 @@ namespace dtEntityOSG
         )
       , mEnabledVal(true)
    {
+      SceneGraphChanges::AddDirectWriter();
       Register(EnabledId, &mEnabled);
 
       AddScriptedMethod("create", dtEntity::ScriptMethodFunctor(this, &TextLabelSystem::ScriptCreate));
@@ -626,6 +627,12 @@ namespace dtEntityOSG
       AddScriptedMethod("setHighlighted", dtEntity::ScriptMethodFunctor(this, &TextLabelSystem::ScriptSetHighlighted));
    }  
 
+   ////////////////////////////////////////////////////////////////////////////
+   TextLabelSystem::~TextLabelSystem()
+   {
+      SceneGraphChanges::RemoveDirectWriter();
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    bool TextLabelSystem::GetEnabled() const
    {
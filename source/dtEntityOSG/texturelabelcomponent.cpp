@@ -43,16 +43,16 @@ namespace dtEntityOSG
 {
    
 
-   const dtEntity::StringId TextureLabelComponent::TYPE(dtEntity::SID("TextureLabel"));
-   const dtEntity::StringId TextureLabelComponent::OffsetId(dtEntity::SID("Offset"));
-   const dtEntity::StringId TextureLabelComponent::ColorId(dtEntity::SID("Color"));
-   const dtEntity::StringId TextureLabelComponent::PathId(dtEntity::SID("Path"));
-   const dtEntity::StringId TextureLabelComponent::VisibleId(dtEntity::SID("Visible"));
-   const dtEntity::StringId TextureLabelComponent::MaxSizeId(dtEntity::SID("MaxSize"));
-   const dtEntity::StringId TextureLabelComponent::MinSizeId(dtEntity::SID("MinSize"));
-   const dtEntity::StringId TextureLabelComponent::DistanceAttenuationId(dtEntity::SID("DistanceAttenuation"));
-   const dtEntity::StringId TextureLabelComponent::AlwaysOnTopId(dtEntity::SID("AlwaysOnTop"));
-   const dtEntity::StringId TextureLabelComponent::AddConnectingLineId(dtEntity::SID("AddConnectingLine"));
+   const dtEntity::StringId TextureLabelComponent::TYPE(SID_LITERAL("TextureLabel"));
+   const dtEntity::StringId TextureLabelComponent::OffsetId(SID_LITERAL("Offset"));
+   const dtEntity::StringId TextureLabelComponent::ColorId(SID_LITERAL("Color"));
+   const dtEntity::StringId TextureLabelComponent::PathId(SID_LITERAL("Path"));
+   const dtEntity::StringId TextureLabelComponent::VisibleId(SID_LITERAL("Visible"));
+   const dtEntity::StringId TextureLabelComponent::MaxSizeId(SID_LITERAL("MaxSize"));
+   const dtEntity::StringId TextureLabelComponent::MinSizeId(SID_LITERAL("MinSize"));
+   const dtEntity::StringId TextureLabelComponent::DistanceAttenuationId(SID_LITERAL("DistanceAttenuation"));
+   const dtEntity::StringId TextureLabelComponent::AlwaysOnTopId(SID_LITERAL("AlwaysOnTop"));
+   const dtEntity::StringId TextureLabelComponent::AddConnectingLineId(SID_LITERAL("AddConnectingLine"));
 
    ////////////////////////////////////////////////////////////////////////////
    TextureLabelComponent::TextureLabelComponent()
@@ -185,8 +185,8 @@ namespace dtEntityOSG
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId TextureLabelSystem::TYPE(dtEntity::SID("TextureLabel"));
-   const dtEntity::StringId TextureLabelSystem::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId TextureLabelSystem::TYPE(SID_LITERAL("TextureLabel"));
+   const dtEntity::StringId TextureLabelSystem::EnabledId(SID_LITERAL("Enabled"));
 
    TextureLabelSystem::TextureLabelSystem(dtEntity::EntityManager& em)
       : dtEntity::DefaultEntitySystem<TextureLabelComponent>(em)
@@ -196,6 +196,7 @@ namespace dtEntityOSG
       )
       , mEnabledVal(true)
    {
+      SceneGraphChanges::AddDirectWriter();
       Register(EnabledId, &mEnabled);
 
 
@@ -237,6 +238,7 @@ namespace dtEntityOSG
    ////////////////////////////////////////////////////////////////////////////
    TextureLabelSystem::~TextureLabelSystem()
    {
+      SceneGraphChanges::RemoveDirectWriter();
    }
 
    ////////////////////////////////////////////////////////////////////////////
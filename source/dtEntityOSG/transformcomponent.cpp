@@ -19,24 +19,130 @@
 */
 
 #include <dtEntityOSG/transformcomponent.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <OpenThreads/ScopedLock>
 #include <osg/Transform>
+#include <algorithm>
 
 namespace dtEntityOSG
 {
 
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId TransformComponent::TYPE(dtEntity::SID("Transform"));
+   TransformBuffers::TransformBuffers()
+      : mDoubleBuffered(false)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   TransformBuffers::~TransformBuffers()
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformBuffers::SetDoubleBuffered(bool v)
+   {
+      if(!v && mDoubleBuffered)
+      {
+         SwapBuffers();
+      }
+      mDoubleBuffered = v;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformBuffers::SwapBuffers()
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      for(std::vector<TransformComponent*>::iterator i = mDirty.begin(); i != mDirty.end(); ++i)
+      {
+         (*i)->ApplyBackBuffer();
+         (*i)->mBackBufferDirty = false;
+      }
+      mDirty.clear();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformBuffers::MarkDirty(TransformComponent& c)
+   {
+      // flag is reset by SwapBuffers on the main thread, test and set under the lock
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      if(!c.mBackBufferDirty)
+      {
+         mDirty.push_back(&c);
+         c.mBackBufferDirty = true;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformBuffers::Remove(TransformComponent& c)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+      if(c.mBackBufferDirty)
+      {
+         std::vector<TransformComponent*>::iterator i = std::find(mDirty.begin(), mDirty.end(), &c);
+         if(i != mDirty.end())
+         {
+            mDirty.erase(i);
+         }
+         c.mBackBufferDirty = false;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   ////////////////////////////////////////////////////////////////////////////
+   const dtEntity::StringId TransformComponent::TYPE(SID_LITERAL("Transform"));
 
    ////////////////////////////////////////////////////////////////////////////
    TransformComponent::TransformComponent(osg::Transform* t)
       : BaseClass(t)
+      , mBackBufferDirty(false)
    {
    }
 
    ////////////////////////////////////////////////////////////////////////////
    TransformComponent::~TransformComponent()
    {
+      if(mBuffers.valid())
+      {
+         mBuffers->Remove(*this);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformComponent::OnAddedToEntity(dtEntity::Entity& entity)
+   {
+      BaseClass::OnAddedToEntity(entity);
+      mBuffers = TransformSystem::GetOrCreate(entity.GetEntityManager()).GetBuffers();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   void TransformComponent::MarkBackBufferDirty()
+   {
+      if(mBuffers.valid())
+      {
+         mBuffers->MarkDirty(*this);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   ////////////////////////////////////////////////////////////////////////////
+   TransformSystem::TransformSystem(dtEntity::EntityManager& em)
+      : dtEntity::EntitySystem(em)
+      , mBuffers(new TransformBuffers())
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   TransformSystem& TransformSystem::GetOrCreate(dtEntity::EntityManager& em)
+   {
+      TransformSystem* ts;
+      if(!em.GetEntitySystem(TransformComponent::TYPE, ts))
+      {
+         ts = new TransformSystem(em);
+         em.AddEntitySystem(*ts);
+      }
+      return *ts;
    }
 
 }
@@ -39,7 +39,7 @@ struct SceneFixture
    SceneFixture()
    {
       SetupDataPaths(0, NULL, true);
-      SetSystemInterface(new dtEntityOSG::OSGSystemInterface(mEntityManager.GetMessagePump(), 0, NULL));
+      SetSystemInterface(new dtEntityOSG::OSGSystemInterface(mEntityManager, 0, NULL));
       AddDefaultEntitySystemsAndFactories(0, NULL, mEntityManager); 
       mEntityManager.AddEntitySystem(*new dtEntity::DynamicsSystem(mEntityManager));
       mEntityManager.GetEntitySystem(MapComponent::TYPE, mMapSystem);
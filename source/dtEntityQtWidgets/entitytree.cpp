@@ -244,7 +244,17 @@ namespace dtEntityQtWidgets
    ////////////////////////////////////////////////////////////////////////////////
    void EntityTreeModel::EnqueueMessage(const dtEntity::Message& m)
    {
-      mMessagePump.EnqueueMessage(m);
+      const dtEntity::EntityNameUpdatedMessage* msg =
+         dynamic_cast<const dtEntity::EntityNameUpdatedMessage*>(&m);
+      if(msg != NULL)
+      {
+         // only last name of entity is shown, drop outdated updates
+         mMessagePump.EnqueueMessageCoalesced(m, msg->GetAboutEntityId());
+      }
+      else
+      {
+         mMessagePump.EnqueueMessage(m);
+      }
       QMetaObject::invokeMethod(this, "ProcessMessages", Qt::QueuedConnection);
    }
 
@@ -25,25 +25,25 @@ namespace dtEntityQtWidgets
 {
    ////////////////////////////////////////////////////////////////////////////////
    
-   const dtEntity::MessageType SpawnerSelectedMessage::TYPE(dtEntity::SID("SpawnerSelectedMessage"));
-   const dtEntity::StringId SpawnerSelectedMessage::NameId(dtEntity::SID("Name"));
+   const dtEntity::MessageType SpawnerSelectedMessage::TYPE(SID_LITERAL("SpawnerSelectedMessage"));
+   const dtEntity::StringId SpawnerSelectedMessage::NameId(SID_LITERAL("Name"));
 
-   const dtEntity::MessageType EntitySystemSelectedMessage::TYPE(dtEntity::SID("EntitySystemSelectedMessage"));
-   const dtEntity::StringId EntitySystemSelectedMessage::NameId(dtEntity::SID("Name"));
+   const dtEntity::MessageType EntitySystemSelectedMessage::TYPE(SID_LITERAL("EntitySystemSelectedMessage"));
+   const dtEntity::StringId EntitySystemSelectedMessage::NameId(SID_LITERAL("Name"));
 
-   const dtEntity::MessageType MapSelectedMessage::TYPE(dtEntity::SID("MapSelectedMessage"));
-   const dtEntity::StringId MapSelectedMessage::NameId(dtEntity::SID("Name"));
+   const dtEntity::MessageType MapSelectedMessage::TYPE(SID_LITERAL("MapSelectedMessage"));
+   const dtEntity::StringId MapSelectedMessage::NameId(SID_LITERAL("Name"));
 
-   const dtEntity::MessageType EnableMotionModelMessage::TYPE(dtEntity::SID("EnableMotionModelMessage"));
-   const dtEntity::StringId EnableMotionModelMessage::EnableId(dtEntity::SID("Enable"));
+   const dtEntity::MessageType EnableMotionModelMessage::TYPE(SID_LITERAL("EnableMotionModelMessage"));
+   const dtEntity::StringId EnableMotionModelMessage::EnableId(SID_LITERAL("Enable"));
 
-   const dtEntity::MessageType EntityDblClickedMessage::TYPE(dtEntity::SID("EntityDblClickedMessage"));
-   const dtEntity::StringId EntityDblClickedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));   
-   const dtEntity::StringId EntityDblClickedMessage::PositionId(dtEntity::SID("Position"));
+   const dtEntity::MessageType EntityDblClickedMessage::TYPE(SID_LITERAL("EntityDblClickedMessage"));
+   const dtEntity::StringId EntityDblClickedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));   
+   const dtEntity::StringId EntityDblClickedMessage::PositionId(SID_LITERAL("Position"));
 
-   const dtEntity::MessageType ComponentDataChangedMessage::TYPE(dtEntity::SID("ComponentDataChangedMessage"));
-   const dtEntity::StringId ComponentDataChangedMessage::ComponentTypeId(dtEntity::SID("ComponentType"));
-   const dtEntity::StringId ComponentDataChangedMessage::AboutEntityId(dtEntity::SID("AboutEntity"));
+   const dtEntity::MessageType ComponentDataChangedMessage::TYPE(SID_LITERAL("ComponentDataChangedMessage"));
+   const dtEntity::StringId ComponentDataChangedMessage::ComponentTypeId(SID_LITERAL("ComponentType"));
+   const dtEntity::StringId ComponentDataChangedMessage::AboutEntityId(SID_LITERAL("AboutEntity"));
 
    ////////////////////////////////////////////////////////////////////////////////
    void RegisterMessageTypes(dtEntity::MessageFactory& em)
@@ -409,14 +409,14 @@ namespace dtEntityQtWidgets
       osg::Vec3 pickray = iface->GetPickRay(0, pos.x(), pos.y());
       
       dtEntity::Component* cam = NULL;
-      bool foundCam = mEntityManager->GetComponent(mtsystem->GetEntityIdByUniqueId("cam_0"), dtEntity::SID("Camera"), cam);
+      bool foundCam = mEntityManager->GetComponent(mtsystem->GetEntityIdByUniqueId("cam_0"), SID_LITERAL("Camera"), cam);
       if(!foundCam)
       {
          LOG_ERROR("Could not spawn by drag and drop: no \"cam_0\" camera entity!");
          return;
       }
 
-      osg::Vec3d start = cam->GetVec3d(dtEntity::SID("Position"));
+      osg::Vec3d start = cam->GetVec3d(SID_LITERAL("Position"));
      
       osg::ref_ptr<osgUtil::LineSegmentIntersector> lsi = new osgUtil::LineSegmentIntersector(start, start + pickray * 100000);
 
@@ -454,10 +454,10 @@ namespace dtEntityQtWidgets
       }
 
       dtEntity::Component* tcomp;
-      if(mEntityManager->GetComponent(entity->GetId(), dtEntity::SID("Transform"), tcomp, true) &&
-         tcomp->Has(dtEntity::SID("Position")))
+      if(mEntityManager->GetComponent(entity->GetId(), SID_LITERAL("Transform"), tcomp, true) &&
+         tcomp->Has(SID_LITERAL("Position")))
       {
-         tcomp->SetVec3d(dtEntity::SID("Position"), spawnPosition);
+         tcomp->SetVec3d(SID_LITERAL("Position"), spawnPosition);
       }
 
       {
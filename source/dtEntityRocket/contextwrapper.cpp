@@ -32,7 +32,7 @@ using namespace dtEntityWrappers;
 
 namespace dtEntityRocket
 {
-   dtEntity::StringId s_contextWrapper = dtEntity::SID("ContextWrapper");
+   dtEntity::StringId s_contextWrapper = SID_LITERAL("ContextWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> RCToString(const Arguments& args)
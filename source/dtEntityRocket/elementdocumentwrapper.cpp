@@ -31,7 +31,7 @@ using namespace dtEntityWrappers;
 namespace dtEntityRocket
 {
 
-   dtEntity::StringId s_elementDocumentWrapper = dtEntity::SID("ElementDocumentWrapper");
+   dtEntity::StringId s_elementDocumentWrapper = SID_LITERAL("ElementDocumentWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> EDToString(const Arguments& args)
@@ -33,7 +33,7 @@ using namespace dtEntityWrappers;
 namespace dtEntityRocket
 {
 
-   dtEntity::StringId s_elementWrapper = dtEntity::SID("ElementWrapper");
+   dtEntity::StringId s_elementWrapper = SID_LITERAL("ElementWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> ELToString(const Arguments& args)
@@ -30,7 +30,7 @@ using namespace dtEntityWrappers;
 namespace dtEntityRocket
 {
 
-   dtEntity::StringId s_eventListenerWrapper = dtEntity::SID("EventListenerWrapper");
+   dtEntity::StringId s_eventListenerWrapper = SID_LITERAL("EventListenerWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> ELIToString(const Arguments& args)
@@ -35,19 +35,20 @@
 namespace dtEntityRocket
 {
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId HUDComponent::TYPE(dtEntity::SID("HUD"));
-   const dtEntity::StringId HUDComponent::ElementId(dtEntity::SID("Element"));
-   const dtEntity::StringId HUDComponent::OffsetId(dtEntity::SID("Offset"));
-   const dtEntity::StringId HUDComponent::PixelOffsetId(dtEntity::SID("PixelOffset"));
-   const dtEntity::StringId HUDComponent::VisibleId(dtEntity::SID("Visible"));
-   const dtEntity::StringId HUDComponent::AlignmentId(dtEntity::SID("Alignment"));
-   const dtEntity::StringId HUDComponent::AlignToOriginId(dtEntity::SID("AlignToOrigin"));
-   const dtEntity::StringId HUDComponent::AlignToBoundingSphereCenterId(dtEntity::SID("AlignToBoundingSphereCenter"));
-   const dtEntity::StringId HUDComponent::AlignToBoundingSphereTopId(dtEntity::SID("AlignToBoundingSphereTop"));
-   const dtEntity::StringId HUDComponent::AlignToBoundingSphereBottomId(dtEntity::SID("AlignToBoundingSphereBottom"));
-   const dtEntity::StringId HUDComponent::AlignToBoundingBoxTopId(dtEntity::SID("AlignToBoundingBoxTop"));
-   const dtEntity::StringId HUDComponent::AlignToBoundingBoxBottomId(dtEntity::SID("AlignToBoundingBoxBottom"));
-   const dtEntity::StringId HUDComponent::HideWhenNormalPointsAwayId(dtEntity::SID("HideWhenNormalPointsAway"));
+   const dtEntity::StringId HUDComponent::TYPE(SID_LITERAL("HUD"));
+   const dtEntity::StringId HUDComponent::ElementId(SID_LITERAL("Element"));
+   const dtEntity::StringId HUDComponent::OffsetId(SID_LITERAL("Offset"));
+   const dtEntity::StringId HUDComponent::PixelOffsetId(SID_LITERAL("PixelOffset"));
+   const dtEntity::StringId HUDComponent::VisibleId(SID_LITERAL("Visible"));
+   const dtEntity::StringId HUDComponent::AlignmentId(SID_LITERAL("Alignment"));
+   const dtEntity::StringId HUDComponent::AlignToOriginId(SID_LITERAL("AlignToOrigin"));
+   const dtEntity::StringId HUDComponent::AlignToBoundingSphereCenterId(SID_LITERAL("AlignToBoundingSphereCenter"));
+   const dtEntity::StringId HUDComponent::AlignToBoundingSphereTopId(SID_LITERAL("AlignToBoundingSphereTop"));
+   const dtEntity::StringId HUDComponent::AlignToBoundingSphereBottomId(SID_LITERAL("AlignToBoundingSphereBottom"));
+   const dtEntity::StringId HUDComponent::AlignToBoundingBoxTopId(SID_LITERAL("AlignToBoundingBoxTop"));
+   const dtEntity::StringId HUDComponent::AlignToBoundingBoxBottomId(SID_LITERAL("AlignToBoundingBoxBottom"));
+   const dtEntity::StringId HUDComponent::HideWhenNormalPointsAwayId(SID_LITERAL("HideWhenNormalPointsAway"));
+   dtEntity::PropertySchema HUDComponent::sPropertySchema;
 
    ////////////////////////////////////////////////////////////////////////////
    HUDComponent::HUDComponent()
@@ -68,12 +69,12 @@ namespace dtEntityRocket
       , mAlignmentVal(AlignToOriginId)
       , mTransformComponent(NULL)
    {
-      Register(ElementId, &mElementProp);
-      Register(OffsetId, &mOffset);
-      Register(PixelOffsetId, &mPixelOffset);
-      Register(VisibleId, &mVisible);
-      Register(AlignmentId, &mAlignment);
-      Register(HideWhenNormalPointsAwayId, &mHideWhenNormalPointsAway);
+      Register(sPropertySchema, ElementId, &mElementProp);
+      Register(sPropertySchema, OffsetId, &mOffset);
+      Register(sPropertySchema, PixelOffsetId, &mPixelOffset);
+      Register(sPropertySchema, VisibleId, &mVisible);
+      Register(sPropertySchema, AlignmentId, &mAlignment);
+      Register(sPropertySchema, HideWhenNormalPointsAwayId, &mHideWhenNormalPointsAway);
 
       mVisible.Set(true);
 
@@ -247,7 +248,7 @@ namespace dtEntityRocket
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
 
-   const dtEntity::StringId HUDSystem::EnabledId(dtEntity::SID("Enabled"));
+   const dtEntity::StringId HUDSystem::EnabledId(SID_LITERAL("Enabled"));
 
    HUDSystem::HUDSystem(dtEntity::EntityManager& em)
       : BaseClass(em)
@@ -259,17 +260,10 @@ namespace dtEntityRocket
       GetEntityManager().RegisterForMessages(dtEntity::EndOfFrameMessage::TYPE,
          mTickFunctor, dtEntity::FilterOptions::ORDER_LATE, "HUDSystem::Tick");
 
+      // registered per entity in CreateComponent
       mVisibilityChangedFunctor = dtEntity::MessageFunctor(this, &HUDSystem::OnVisibilityChanged);
-      GetEntityManager().RegisterForMessages(dtEntity::VisibilityChangedMessage::TYPE,
-         mVisibilityChangedFunctor, dtEntity::FilterOptions::ORDER_LATE, "HUDSystem::OnVisibilityChanged");
-
       mMeshChangedFunctor = dtEntity::MessageFunctor(this, &HUDSystem::OnMeshChanged);
-      GetEntityManager().RegisterForMessages(dtEntity::MeshChangedMessage::TYPE, mMeshChangedFunctor,
-                            dtEntity::FilterOptions::ORDER_DEFAULT, "HUDSystem::OnMeshChanged");
-
       mLeaveWorldFunctor = dtEntity::MessageFunctor(this, &HUDSystem::OnRemovedFromScene);
-      em.RegisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, mLeaveWorldFunctor,
-                             "HUDSystem::OnRemovedFromScene");
 
       mEnabled.Set(true);
    }
@@ -292,8 +286,44 @@ namespace dtEntityRocket
    void HUDSystem::OnRemoveFromEntityManager(dtEntity::EntityManager &em)
    {
       GetEntityManager().UnregisterForMessages(dtEntity::EndOfFrameMessage::TYPE, mTickFunctor);
-      GetEntityManager().UnregisterForMessages(dtEntity::VisibilityChangedMessage::TYPE, mVisibilityChangedFunctor);
-      GetEntityManager().UnregisterForMessages(dtEntity::MeshChangedMessage::TYPE, mMeshChangedFunctor);
+      for(ComponentStore::iterator i = mComponents.begin(); i != mComponents.end(); ++i)
+      {
+         dtEntity::EntityId id = i->first;
+         em.UnregisterForMessages(dtEntity::VisibilityChangedMessage::TYPE, id, mVisibilityChangedFunctor);
+         em.UnregisterForMessages(dtEntity::MeshChangedMessage::TYPE, id, mMeshChangedFunctor);
+         em.UnregisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, id, mLeaveWorldFunctor);
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   bool HUDSystem::CreateComponent(dtEntity::EntityId eid, dtEntity::Component*& component)
+   {
+      if(!BaseClass::CreateComponent(eid, component))
+      {
+         return false;
+      }
+      dtEntity::EntityManager& em = GetEntityManager();
+      em.RegisterForMessages(dtEntity::VisibilityChangedMessage::TYPE, eid,
+         mVisibilityChangedFunctor, dtEntity::FilterOptions::ORDER_LATE, "HUDSystem::OnVisibilityChanged");
+      em.RegisterForMessages(dtEntity::MeshChangedMessage::TYPE, eid, mMeshChangedFunctor,
+                            dtEntity::FilterOptions::ORDER_DEFAULT, "HUDSystem::OnMeshChanged");
+      em.RegisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, eid, mLeaveWorldFunctor,
+                             dtEntity::FilterOptions::DEFAULT, "HUDSystem::OnRemovedFromScene");
+      return true;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   bool HUDSystem::DeleteComponent(dtEntity::EntityId eid)
+   {
+      if(!BaseClass::DeleteComponent(eid))
+      {
+         return false;
+      }
+      dtEntity::EntityManager& em = GetEntityManager();
+      em.UnregisterForMessages(dtEntity::VisibilityChangedMessage::TYPE, eid, mVisibilityChangedFunctor);
+      em.UnregisterForMessages(dtEntity::MeshChangedMessage::TYPE, eid, mMeshChangedFunctor);
+      em.UnregisterForMessages(dtEntity::EntityRemovedFromSceneMessage::TYPE, eid, mLeaveWorldFunctor);
+      return true;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -104,6 +104,7 @@ namespace dtEntityRocket
 
    private:
 
+      static dtEntity::PropertySchema sPropertySchema;
 
       dtEntity::Entity* mEntity;
       Rocket::Core::Element* mElement;
@@ -142,6 +143,10 @@ namespace dtEntityRocket
 
       void OnRemoveFromEntityManager(dtEntity::EntityManager &em);
 
+      // register for messages about entity of component
+      virtual bool CreateComponent(dtEntity::EntityId eid, dtEntity::Component*& component);
+      virtual bool DeleteComponent(dtEntity::EntityId eid);
+
       void SetEnabled(bool);
       bool GetEnabled() const { return mEnabled.Get(); }
 
@@ -22,9 +22,9 @@
 
 namespace dtEntityRocket
 {
-  const dtEntity::MessageType RocketEventMessage::TYPE(dtEntity::SID("RocketEventMessage"));
-  const dtEntity::StringId RocketEventMessage::NameId(dtEntity::SID("Name"));
-  const dtEntity::StringId RocketEventMessage::ParametersId(dtEntity::SID("Parameters"));
+  const dtEntity::MessageType RocketEventMessage::TYPE(SID_LITERAL("RocketEventMessage"));
+  const dtEntity::StringId RocketEventMessage::NameId(SID_LITERAL("Name"));
+  const dtEntity::StringId RocketEventMessage::ParametersId(SID_LITERAL("Parameters"));
   
 }
 
@@ -173,10 +173,10 @@ namespace dtEntityRocket
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId RocketComponent::TYPE(dtEntity::SID("Rocket"));
-   const dtEntity::StringId RocketComponent::FullScreenId(dtEntity::SID("FullScreen"));
-   const dtEntity::StringId RocketComponent::ContextNameId(dtEntity::SID("ContextName"));
-   const dtEntity::StringId RocketComponent::DebugId(dtEntity::SID("Debug"));
+   const dtEntity::StringId RocketComponent::TYPE(SID_LITERAL("Rocket"));
+   const dtEntity::StringId RocketComponent::FullScreenId(SID_LITERAL("FullScreen"));
+   const dtEntity::StringId RocketComponent::ContextNameId(SID_LITERAL("ContextName"));
+   const dtEntity::StringId RocketComponent::DebugId(SID_LITERAL("Debug"));
 
 
    ////////////////////////////////////////////////////////////////////////////
@@ -277,7 +277,7 @@ namespace dtEntityRocket
   
    ////////////////////////////////////////////////////////////////////////////
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId RocketSystem::TYPE(dtEntity::SID("Rocket"));
+   const dtEntity::StringId RocketSystem::TYPE(SID_LITERAL("Rocket"));
 
    ////////////////////////////////////////////////////////////////////////////
    RocketSystem::RocketSystem(dtEntity::EntityManager& em)
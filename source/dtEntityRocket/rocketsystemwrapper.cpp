@@ -34,7 +34,7 @@ using namespace dtEntityWrappers;
 namespace dtEntityRocket
 {
 
-   dtEntity::StringId s_rocketSystemWrapper = dtEntity::SID("RocketSystemWrapper");
+   dtEntity::StringId s_rocketSystemWrapper = SID_LITERAL("RocketSystemWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> RSToString(const Arguments& args)
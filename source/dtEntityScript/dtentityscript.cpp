@@ -35,9 +35,8 @@
 #include <osgViewer/CompositeViewer>
 #include <osgViewer/ViewerEventHandlers>
 
-#if DTENTITY_PROFILING_ENABLED
-#include <dtEntity/profile.h>
-#endif
+#include <dtEntity/profiler.h>
+#include <dtEntity/profilersystem.h>
 
 // include the plugins we need
 USE_DTENTITYPLUGIN(dtEntityRocket)
@@ -46,9 +45,8 @@ USE_DTENTITYPLUGIN(dtEntityV8Plugin)
 int main(int argc, char** argv)
 {
     std::string script = "Scripts/autostart.js";
-#if DTENTITY_PROFILING_ENABLED
     bool profiling_enabled = false;
-#endif
+    std::string trace_file;
     int curArg = 1;
 
     while (curArg < argc)
@@ -64,12 +62,18 @@ int main(int argc, char** argv)
                 script = argv[curArg];
              }
           }
-#if DTENTITY_PROFILING_ENABLED
           else if (curArgv == "--enable-profiling")
           {
              profiling_enabled = true;
           }
-#endif
+          else if (curArgv == "--profile-trace")
+          {
+             ++curArg;
+             if (curArg < argc)
+             {
+                trace_file = argv[curArg];
+             }
+          }
         }
        ++curArg;
     }
@@ -89,7 +93,7 @@ int main(int argc, char** argv)
    dtEntity::ComponentPluginManager& pm = dtEntity::ComponentPluginManager::GetInstance();
    pm.AddPlugin("plugins/", "dtEntityV8Plugin", true);
    
-   dtEntity::StringId scriptId = dtEntity::SID("Script");
+   dtEntity::StringId scriptId = SID_LITERAL("Script");
       
    if(!entityManager.HasEntitySystem(scriptId))
    {
@@ -108,10 +112,10 @@ int main(int argc, char** argv)
    }
 
    dtEntity::Message* msg;
-   bool success = dtEntity::MessageFactory::GetInstance().CreateMessage(dtEntity::SID("ExecuteScriptMessage"), msg);
+   bool success = dtEntity::MessageFactory::GetInstance().CreateMessage(SID_LITERAL("ExecuteScriptMessage"), msg);
    assert(success);
-   msg->Get(dtEntity::SID("IncludeOnce"))->SetBool(true);
-   dtEntity::Property* pathprop = msg->Get(dtEntity::SID("Path"));
+   msg->Get(SID_LITERAL("IncludeOnce"))->SetBool(true);
+   dtEntity::Property* pathprop = msg->Get(SID_LITERAL("Path"));
 
    pathprop->SetString(script); 
    entityManager.EmitMessage(*msg);
@@ -119,63 +123,63 @@ int main(int argc, char** argv)
 
    dtEntity::SystemInterface* iface = dtEntity::GetSystemInterface();
 
-#if DTENTITY_PROFILING_ENABLED
-   if(profiling_enabled)
+   if(profiling_enabled || !trace_file.empty())
    {
-      static dtEntity::StringId frameId = dtEntity::SID("Frame");
-      static dtEntity::StringId frameAdvanceId = dtEntity::SID("Frame_Advance");
-      static dtEntity::StringId frameEvTrId = dtEntity::SID("Frame_EventTraversal");
-      static dtEntity::StringId frameUpTrId = dtEntity::SID("Frame_UpdateTraversal");
-      static dtEntity::StringId frameRenderTrId = dtEntity::SID("Frame_RenderingTraversals");
-
-      unsigned int framecount = 0;
-      while (!viewer.done()) 
+      // profiler system collects profiler data at end of frame
+      pm.StartEntitySystem(entityManager, dtEntity::ProfilerSystem::TYPE);
+      dtEntity::Profiler::SetEnabled(true);
+      dtEntity::Profiler::SetThreadName("Main");
+      if(!trace_file.empty())
       {
-         CProfileManager::Increment_Frame_Counter();
-			CProfileManager::Start_Profile(frameId);
-         
-         CProfileManager::Start_Profile(frameAdvanceId);
-         viewer.advance();
-         CProfileManager::Stop_Profile();
+         dtEntity::Profiler::StartTrace();
+      }
+   }
 
-         CProfileManager::Start_Profile(frameEvTrId);
-         viewer.eventTraversal();
-         CProfileManager::Stop_Profile();
+   static dtEntity::StringId frameId = SID_LITERAL("Frame");
+   static dtEntity::StringId frameAdvanceId = SID_LITERAL("Frame_Advance");
+   static dtEntity::StringId frameEvTrId = SID_LITERAL("Frame_EventTraversal");
+   static dtEntity::StringId frameUpTrId = SID_LITERAL("Frame_UpdateTraversal");
+   static dtEntity::StringId frameRenderTrId = SID_LITERAL("Frame_RenderingTraversals");
 
-         CProfileManager::Start_Profile(frameUpTrId);
-         iface->EmitTickMessagesAndQueuedMessages();
-         viewer.updateTraversal();
-         CProfileManager::Stop_Profile();
+   unsigned int framecount = 0;
+   while (!viewer.done())
+   {
+      {
+         dtEntity::ProfileScope frameZone(frameId);
+         {
+            dtEntity::ProfileScope zone(frameAdvanceId);
+            viewer.advance(DBL_MAX);
+         }
+         {
+            dtEntity::ProfileScope zone(frameEvTrId);
+            viewer.eventTraversal();
+         }
+         {
+            dtEntity::ProfileScope zone(frameUpTrId);
+            iface->EmitTickMessagesAndQueuedMessages();
+            viewer.updateTraversal();
+         }
 
          iface->EmitPostUpdateMessage();
 
-         CProfileManager::Start_Profile(frameRenderTrId);
-         viewer.renderingTraversals();
-         CProfileManager::Stop_Profile();
-
-         CProfileManager::Stop_Profile();
-         if(++framecount > 999)
          {
-            CProfileManager::dumpAll();
-			   fflush(stdout);
-            framecount = 0;
-            CProfileManager::Reset();
+            dtEntity::ProfileScope zone(frameRenderTrId);
+            viewer.renderingTraversals();
          }
       }
-   }
-   else
-#endif
-   {
-      while (!viewer.done())
+
+      if(profiling_enabled && ++framecount > 999)
       {
-         viewer.advance(DBL_MAX);
-         viewer.eventTraversal();
-         iface->EmitTickMessagesAndQueuedMessages();
-         viewer.updateTraversal();
-         iface->EmitPostUpdateMessage();
-         viewer.renderingTraversals();
+         dtEntity::Profiler::LogStats();
+         dtEntity::Profiler::ResetStats();
+         framecount = 0;
       }
    }
 
+   if(!trace_file.empty())
+   {
+      dtEntity::Profiler::WriteChromeTrace(trace_file);
+   }
+
    return 0;
 }
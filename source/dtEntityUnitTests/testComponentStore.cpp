@@ -0,0 +1,213 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/component.h>
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/slaballocator.h>
+#include <dtEntity/sparsecomponentstore.h>
+#include <UnitTest++.h>
+#include <set>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace ComponentStoreTest
+{
+   class StoreTestComponent : public Component
+   {
+   public:
+      static const ComponentType TYPE;
+      static const StringId ValueId;
+
+      StoreTestComponent()
+      {
+         Register(ValueId, &mValue);
+      }
+
+      virtual ComponentType GetType() const { return TYPE; }
+
+      IntProperty mValue;
+   };
+
+   const ComponentType StoreTestComponent::TYPE(SID("StoreTestComponent"));
+   const StringId StoreTestComponent::ValueId(SID("Value"));
+
+   class StoreTestSystem
+      : public DefaultEntitySystem<StoreTestComponent, MemAllocPolicyNew, ComponentStoreSparseSet>
+   {
+   public:
+      StoreTestSystem(EntityManager& em)
+         : DefaultEntitySystem<StoreTestComponent, MemAllocPolicyNew, ComponentStoreSparseSet>(em)
+      {
+      }
+   };
+
+   class SlabTestSystem
+      : public DefaultEntitySystem<StoreTestComponent, MemAllocPolicySlab, ComponentStoreSparseSet>
+   {
+   public:
+      SlabTestSystem(EntityManager& em)
+         : DefaultEntitySystem<StoreTestComponent, MemAllocPolicySlab, ComponentStoreSparseSet>(em)
+      {
+      }
+   };
+
+   //------------------------------------------------------------------
+   TEST(SparseSetInsertFindErase)
+   {
+      ComponentStoreSparseSet<int> store;
+      int a = 1, b = 2, c = 3;
+      store[5] = &a;
+      store[70000] = &b;
+      store[9] = &c;
+
+      CHECK_EQUAL(3u, (unsigned int)store.size());
+      CHECK(store.find(5)->second == &a);
+      CHECK(store.find(70000)->second == &b);
+      CHECK(store.find(6) == store.end());
+      CHECK(store.find(1000000) == store.end());
+
+      // erase first entry, last entry gets moved into its slot
+      store.erase(store.find(5));
+      CHECK_EQUAL(2u, (unsigned int)store.size());
+      CHECK(store.find(5) == store.end());
+      CHECK(store.find(9)->second == &c);
+      CHECK(store.find(70000)->second == &b);
+
+      CHECK_EQUAL(1u, (unsigned int)store.erase(9));
+      CHECK_EQUAL(0u, (unsigned int)store.erase(9));
+      CHECK(store.find(70000)->second == &b);
+
+      store.clear();
+      CHECK(store.empty());
+      CHECK(store.find(70000) == store.end());
+   }
+
+   //------------------------------------------------------------------
+   TEST(SparseSetEntitySystem)
+   {
+      EntityManager em;
+      StoreTestSystem* sys = new StoreTestSystem(em);
+      em.AddEntitySystem(*sys);
+
+      std::vector<EntityId> ids;
+      for(int i = 0; i < 100; ++i)
+      {
+         Entity* entity = NULL;
+         em.CreateEntity(entity);
+         StoreTestComponent* comp = NULL;
+         CHECK(entity->CreateComponent(comp));
+         comp->mValue.Set(i);
+         ids.push_back(entity->GetId());
+      }
+      CHECK_EQUAL(100u, (unsigned int)sys->GetNumComponents());
+
+      // kill every second entity
+      for(unsigned int i = 0; i < ids.size(); i += 2)
+      {
+         em.KillEntity(ids[i]);
+      }
+      CHECK_EQUAL(50u, (unsigned int)sys->GetNumComponents());
+
+      for(unsigned int i = 0; i < ids.size(); ++i)
+      {
+         StoreTestComponent* comp = sys->GetComponent(ids[i]);
+         if(i % 2 == 0)
+         {
+            CHECK(comp == NULL);
+         }
+         else
+         {
+            CHECK(comp != NULL);
+            CHECK_EQUAL((int)i, comp->mValue.Get());
+         }
+      }
+
+      std::set<EntityId> iterated;
+      for(StoreTestSystem::ComponentStore::iterator i = sys->begin(); i != sys->end(); ++i)
+      {
+         CHECK(sys->GetComponent(i->first) == i->second);
+         iterated.insert(i->first);
+      }
+      CHECK_EQUAL(50u, (unsigned int)iterated.size());
+   }
+
+   //------------------------------------------------------------------
+   TEST(SlabAllocatorReuse)
+   {
+      SlabAllocator slab(10, 4);
+      CHECK_EQUAL((unsigned int)SlabAllocator::CACHE_LINE_SIZE, (unsigned int)slab.GetBlockSize());
+
+      std::vector<void*> blocks;
+      for(int i = 0; i < 6; ++i)
+      {
+         void* p = slab.Allocate();
+         CHECK_EQUAL(0u, (unsigned int)(reinterpret_cast<size_t>(p) % SlabAllocator::CACHE_LINE_SIZE));
+         blocks.push_back(p);
+      }
+      CHECK_EQUAL(2u, slab.GetNumSlabs());
+      CHECK_EQUAL(6u, slab.GetLiveCount());
+      CHECK_EQUAL((unsigned int)(8 * SlabAllocator::CACHE_LINE_SIZE), (unsigned int)slab.GetBytesReserved());
+      CHECK_CLOSE(0.25f, slab.GetFragmentation(), 0.0001f);
+
+      // freed block is handed out again
+      slab.Free(blocks[2]);
+      CHECK_EQUAL(5u, slab.GetLiveCount());
+      CHECK(slab.Allocate() == blocks[2]);
+      CHECK_EQUAL(6u, slab.GetPeakCount());
+
+      slab.FreeAll();
+      CHECK_EQUAL(0u, slab.GetNumSlabs());
+      CHECK_EQUAL(0u, slab.GetLiveCount());
+   }
+
+   //------------------------------------------------------------------
+   TEST(SlabEntitySystem)
+   {
+      EntityManager em;
+      SlabTestSystem* sys = new SlabTestSystem(em);
+      em.AddEntitySystem(*sys);
+
+      std::vector<EntityId> ids;
+      for(int i = 0; i < 100; ++i)
+      {
+         Entity* entity = NULL;
+         em.CreateEntity(entity);
+         StoreTestComponent* comp = NULL;
+         CHECK(entity->CreateComponent(comp));
+         comp->mValue.Set(i);
+         ids.push_back(entity->GetId());
+      }
+
+      for(unsigned int i = 0; i < ids.size(); i += 2)
+      {
+         em.KillEntity(ids[i]);
+      }
+      CHECK_EQUAL(50u, (unsigned int)sys->GetNumComponents());
+      CHECK_EQUAL(99, sys->GetComponent(ids[99])->mValue.Get());
+
+      CHECK_EQUAL(50u, sys->GetUInt(SlabAllocator::AllocLiveCountId));
+      CHECK_EQUAL(100u, sys->GetUInt(SlabAllocator::AllocPeakCountId));
+      CHECK_EQUAL((unsigned int)sys->GetSlabAllocator().GetBytesReserved(), sys->GetUInt(SlabAllocator::AllocBytesReservedId));
+      CHECK(sys->GetFloat(SlabAllocator::AllocFragmentationId) >= 0.5f);
+   }
+}
@@ -0,0 +1,150 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/component.h>
+#include <dtEntity/componentview.h>
+#include <dtEntity/defaultentitysystem.h>
+#include <dtEntity/entity.h>
+#include <dtEntity/entitymanager.h>
+#include <UnitTest++.h>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace ComponentViewTest
+{
+   class ViewCompA : public Component
+   {
+   public:
+      static const ComponentType TYPE;
+      virtual ComponentType GetType() const { return TYPE; }
+   };
+
+   class ViewCompB : public Component
+   {
+   public:
+      static const ComponentType TYPE;
+      virtual ComponentType GetType() const { return TYPE; }
+   };
+
+   // derives from A in the type hierarchy
+   class ViewCompDerivedA : public ViewCompA
+   {
+   public:
+      static const ComponentType TYPE;
+      virtual ComponentType GetType() const { return TYPE; }
+   };
+
+   const ComponentType ViewCompA::TYPE(SID("ViewCompA"));
+   const ComponentType ViewCompB::TYPE(SID("ViewCompB"));
+   const ComponentType ViewCompDerivedA::TYPE(SID("ViewCompDerivedA"));
+
+   typedef DefaultEntitySystem<ViewCompA> ViewSystemA;
+   typedef DefaultEntitySystem<ViewCompB> ViewSystemB;
+
+   class ViewSystemDerivedA : public DefaultEntitySystem<ViewCompDerivedA>
+   {
+   public:
+      ViewSystemDerivedA(EntityManager& em)
+         : DefaultEntitySystem<ViewCompDerivedA>(em, ViewCompA::TYPE)
+      {
+      }
+   };
+
+   struct ViewFixture
+   {
+      ViewFixture()
+      {
+         mSysA = new ViewSystemA(mEntityManager);
+         mSysB = new ViewSystemB(mEntityManager);
+         mSysDerivedA = new ViewSystemDerivedA(mEntityManager);
+         mEntityManager.AddEntitySystem(*mSysA);
+         mEntityManager.AddEntitySystem(*mSysB);
+         mEntityManager.AddEntitySystem(*mSysDerivedA);
+      }
+
+      EntityId Create(bool a, bool b, bool derivedA)
+      {
+         Entity* entity;
+         mEntityManager.CreateEntity(entity);
+         Component* c;
+         if(a) mSysA->CreateComponent(entity->GetId(), c);
+         if(b) mSysB->CreateComponent(entity->GetId(), c);
+         if(derivedA) mSysDerivedA->CreateComponent(entity->GetId(), c);
+         return entity->GetId();
+      }
+
+      EntityManager mEntityManager;
+      ViewSystemA* mSysA;
+      ViewSystemB* mSysB;
+      ViewSystemDerivedA* mSysDerivedA;
+   };
+
+   //------------------------------------------------------------------
+   TEST_FIXTURE(ViewFixture, UncachedView)
+   {
+      EntityId ab = Create(true, true, false);
+      Create(true, false, false);
+      Create(false, true, false);
+      EntityId derivedb = Create(false, true, true);
+
+      ComponentView<ViewCompA, ViewCompB> view(mEntityManager);
+      CHECK(view.empty());
+      view.Update();
+      CHECK_EQUAL(2u, (unsigned int)view.size());
+
+      for(ComponentView<ViewCompA, ViewCompB>::iterator i = view.begin(); i != view.end(); ++i)
+      {
+         CHECK(i->mEntityId == ab || i->mEntityId == derivedb);
+         CHECK(i->mSecond == mSysB->GetComponent(i->mEntityId));
+         if(i->mEntityId == ab)
+         {
+            CHECK(i->mFirst == mSysA->GetComponent(ab));
+         }
+         else
+         {
+            CHECK(i->mFirst == mSysDerivedA->GetComponent(derivedb));
+         }
+      }
+   }
+
+   //------------------------------------------------------------------
+   TEST_FIXTURE(ViewFixture, CachedView)
+   {
+      EntityId ab = Create(true, true, false);
+      ComponentView<ViewCompA, ViewCompB> view(mEntityManager, true);
+      CHECK_EQUAL(1u, (unsigned int)view.size());
+
+      EntityId a = Create(true, false, false);
+      CHECK_EQUAL(1u, (unsigned int)view.size());
+
+      Component* c;
+      mEntityManager.CreateComponent(a, ViewCompB::TYPE, c);
+      CHECK_EQUAL(2u, (unsigned int)view.size());
+
+      mEntityManager.DeleteComponent(ab, ViewCompA::TYPE);
+      CHECK_EQUAL(1u, (unsigned int)view.size());
+      CHECK_EQUAL(a, view.begin()->mEntityId);
+      CHECK(view.begin()->mSecond == mSysB->GetComponent(a));
+
+      mEntityManager.KillEntity(a);
+      CHECK(view.empty());
+   }
+}
@@ -20,6 +20,7 @@
 
 #include <UnitTest++.h>
 #include <dtEntity/dynamicproperty.h>
+#include <dtEntity/propertyvalue.h>
 
 using namespace UnitTest;
 using namespace dtEntity;
@@ -191,3 +192,21 @@ TEST(SetValuesDynamicMatrix)
    prop.Set(Matrix(4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19));
    CHECK(prop.Get() == Matrix(4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19));
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(PropertyValueDynamicFloat)
+{
+   DynamicFloatProperty prop = DynamicFloatProperty(DynamicFloatProperty::SetValueCB(SetFloat), DynamicFloatProperty::GetValueCB(GetFloat));
+   PropertyValue v;
+   v.SetInt(42);
+   CHECK(prop.SetValue(v));
+   CHECK_EQUAL(42.0f, s_fval);
+
+   prop.Set(5);
+   prop.GetValue(v);
+   CHECK_EQUAL(DataType::FLOAT, v.GetDataType());
+   CHECK_EQUAL(5.0f, v.FloatValue());
+
+   v.SetString("not a number");
+   CHECK_EQUAL(false, prop.SetValue(v));
+}
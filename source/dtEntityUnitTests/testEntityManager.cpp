@@ -18,10 +18,12 @@
 * Martin Scheffler
 */
 
+#include <dtEntity/defaultentitysystem.h>
 #include <dtEntity/entitymanager.h>
 #include <dtEntity/entity.h>
 #include <dtEntity/entitysystem.h>
 #include <dtEntity/mapcomponent.h>
+#include <dtEntity/systemmessages.h>
 #include <UnitTest++.h>
 
 using namespace UnitTest;
@@ -29,7 +31,24 @@ using namespace dtEntity;
 
 namespace EMTest
 {
+   class SignatureTestComponent : public Component
+   {
+   public:
+      static const ComponentType TYPE;
+      virtual ComponentType GetType() const { return TYPE; }
+   };
+
+   const ComponentType SignatureTestComponent::TYPE(SID("SignatureTestComponent"));
 
+   class SignatureTestSystem : public DefaultEntitySystem<SignatureTestComponent>
+   {
+   public:
+      SignatureTestSystem(EntityManager& em, ComponentType t)
+         : DefaultEntitySystem<SignatureTestComponent>(em)
+      {
+         mComponentType = t;
+      }
+   };
 
 
    //------------------------------------------------------------------
@@ -84,6 +103,247 @@ namespace EMTest
 
    }
 
+   //------------------------------------------------------------------
+   TEST(StaleEntityHandle)
+   {
+      EntityManager* em = new EntityManager();
+      Entity* entity;
+
+      // kill enough entities that freed slots get recycled
+      std::vector<EntityId> killed;
+      for(unsigned int i = 0; i < 2000; ++i)
+      {
+         em->CreateEntity(entity);
+         killed.push_back(entity->GetId());
+      }
+      for(unsigned int i = 0; i < killed.size(); ++i)
+      {
+         CHECK(em->KillEntity(killed[i]));
+      }
+      CHECK_EQUAL(false, em->HasEntities());
+
+      em->CreateEntity(entity);
+      EntityId reused = entity->GetId();
+      CHECK_EQUAL(GetEntityIndex(killed.front()), GetEntityIndex(reused));
+      CHECK(reused != killed.front());
+
+      Entity* found = NULL;
+      CHECK_EQUAL(false, em->GetEntity(killed.front(), found));
+      CHECK_EQUAL(false, em->EntityExists(killed.front()));
+      CHECK_EQUAL(false, em->KillEntity(killed.front()));
+      CHECK(em->GetEntity(reused, found));
+      CHECK_EQUAL(entity, found);
+
+      delete em;
+   }
+
+   //------------------------------------------------------------------
+   TEST(ComponentSystemsOfEntity)
+   {
+      EntityManager* em = new EntityManager();
+      SignatureTestSystem* sysA = new SignatureTestSystem(*em, SID("SignatureA"));
+      SignatureTestSystem* sysB = new SignatureTestSystem(*em, SID("SignatureB"));
+      SignatureTestSystem* sysC = new SignatureTestSystem(*em, SID("SignatureC"));
+      em->AddEntitySystem(*sysA);
+      em->AddEntitySystem(*sysB);
+      em->AddEntitySystem(*sysC);
+
+      Entity* entity;
+      em->CreateEntity(entity);
+      EntityId id = entity->GetId();
+      Component* comp;
+      CHECK(sysC->CreateComponent(id, comp));
+      CHECK(em->CreateComponent(id, SID("SignatureA"), comp));
+
+      CHECK_EQUAL(2u, (unsigned int)entity->GetComponentSystems().size());
+      CHECK(entity->GetComponentSystems().front() == sysC);
+
+      std::vector<Component*> comps;
+      em->GetComponents(id, comps);
+      CHECK_EQUAL(2u, (unsigned int)comps.size());
+
+      CHECK(em->DeleteComponent(id, SID("SignatureC")));
+      CHECK_EQUAL(1u, (unsigned int)entity->GetComponentSystems().size());
+      CHECK(entity->GetComponentSystems().front() == sysA);
+
+      CHECK(em->KillEntity(id));
+      CHECK_EQUAL(0u, (unsigned int)sysA->GetNumComponents());
+      CHECK_EQUAL(0u, (unsigned int)sysB->GetNumComponents());
+      CHECK_EQUAL(0u, (unsigned int)sysC->GetNumComponents());
+
+      delete em;
+   }
+
+   class CountingDeletedCallback : public EntityManager::ComponentDeletedCallback
+   {
+   public:
+      virtual void ComponentDeleted(ComponentType t, EntityId id)
+      {
+         mTypes.push_back(t);
+      }
+      std::vector<ComponentType> mTypes;
+   };
+
+   //------------------------------------------------------------------
+   TEST(CreateAndKillEntities)
+   {
+      EntityManager* em = new EntityManager();
+      SignatureTestSystem* sysA = new SignatureTestSystem(*em, SID("SignatureA"));
+      SignatureTestSystem* sysB = new SignatureTestSystem(*em, SID("SignatureB"));
+      em->AddEntitySystem(*sysA);
+      em->AddEntitySystem(*sysB);
+
+      std::vector<Entity*> entities;
+      CHECK(em->CreateEntities(100, entities));
+      CHECK_EQUAL(100u, (unsigned int)entities.size());
+
+      std::vector<EntityId> ids;
+      for(unsigned int i = 0; i < entities.size(); ++i)
+      {
+         Component* comp;
+         sysA->CreateComponent(entities[i]->GetId(), comp);
+         sysB->CreateComponent(entities[i]->GetId(), comp);
+         ids.push_back(entities[i]->GetId());
+      }
+
+      CountingDeletedCallback cb;
+      em->AddDeletedCallback(&cb);
+
+      // kill half of the entities, with a duplicate id
+      std::vector<EntityId> toKill(ids.begin(), ids.begin() + 50);
+      toKill.push_back(ids.front());
+      CHECK(em->KillEntities(toKill));
+      CHECK_EQUAL(50u, (unsigned int)sysA->GetNumComponents());
+      CHECK_EQUAL(50u, (unsigned int)sysB->GetNumComponents());
+      CHECK_EQUAL(false, em->EntityExists(ids.front()));
+      CHECK(em->EntityExists(ids.back()));
+
+      // callbacks are grouped by component type
+      CHECK_EQUAL(100u, (unsigned int)cb.mTypes.size());
+      unsigned int typeChanges = 0;
+      for(unsigned int i = 1; i < cb.mTypes.size(); ++i)
+      {
+         if(cb.mTypes[i] != cb.mTypes[i - 1]) ++typeChanges;
+      }
+      CHECK_EQUAL(1u, typeChanges);
+
+      em->RemoveDeletedCallback(&cb);
+      delete em;
+   }
+
+   // records the types of deleted components in a shared log
+   class DeletionOrderSystem : public SignatureTestSystem
+   {
+   public:
+      DeletionOrderSystem(EntityManager& em, ComponentType t, std::vector<ComponentType>& log)
+         : SignatureTestSystem(em, t)
+         , mLog(&log)
+      {
+      }
+
+      virtual bool DeleteComponent(EntityId eid)
+      {
+         mLog->push_back(GetComponentType());
+         return SignatureTestSystem::DeleteComponent(eid);
+      }
+
+      std::vector<ComponentType>* mLog;
+   };
+
+   //------------------------------------------------------------------
+   TEST(KillEntitiesDeletesInKillEntityOrder)
+   {
+      EntityManager* em = new EntityManager();
+      std::vector<ComponentType> log;
+      DeletionOrderSystem* sysA = new DeletionOrderSystem(*em, SID("SignatureA"), log);
+      DeletionOrderSystem* sysB = new DeletionOrderSystem(*em, SID("SignatureB"), log);
+      DeletionOrderSystem* sysC = new DeletionOrderSystem(*em, SID("SignatureC"), log);
+      em->AddEntitySystem(*sysA);
+      em->AddEntitySystem(*sysB);
+      em->AddEntitySystem(*sysC);
+
+      CountingDeletedCallback cb;
+      em->AddDeletedCallback(&cb);
+
+      // both entities get components in order C, A, B
+      std::vector<Entity*> entities;
+      CHECK(em->CreateEntities(2, entities));
+      for(unsigned int i = 0; i < entities.size(); ++i)
+      {
+         Component* comp;
+         sysC->CreateComponent(entities[i]->GetId(), comp);
+         sysA->CreateComponent(entities[i]->GetId(), comp);
+         sysB->CreateComponent(entities[i]->GetId(), comp);
+      }
+
+      CHECK(em->KillEntity(entities[0]->GetId()));
+      std::vector<ComponentType> single;
+      single.swap(log);
+      CHECK_EQUAL(3u, (unsigned int)single.size());
+      CHECK(single[0] == SID("SignatureB"));
+      CHECK(single[2] == SID("SignatureC"));
+
+      std::vector<EntityId> toKill;
+      toKill.push_back(entities[1]->GetId());
+      CHECK(em->KillEntities(toKill));
+      CHECK(log == single);
+      CHECK_EQUAL(6u, (unsigned int)cb.mTypes.size());
+
+      em->RemoveDeletedCallback(&cb);
+      delete em;
+   }
+
+   //------------------------------------------------------------------
+   TEST(KillEntityDeferred)
+   {
+      EntityManager* em = new EntityManager();
+      Entity* entity;
+      em->CreateEntity(entity);
+      EntityId id = entity->GetId();
+
+      em->KillEntityDeferred(id);
+      CHECK(em->EntityExists(id));
+
+      EndOfFrameMessage msg;
+      em->EmitMessage(msg);
+      CHECK_EQUAL(false, em->EntityExists(id));
+
+      delete em;
+   }
+
+   class AboutEntityCounter
+   {
+   public:
+      AboutEntityCounter() : mCount(0) {}
+      void OnMessage(const Message&) { ++mCount; }
+      unsigned int mCount;
+   };
+
+   //------------------------------------------------------------------
+   TEST(KillEntityUnregistersEntityFunctors)
+   {
+      EntityManager* em = new EntityManager();
+      Entity* entity;
+      em->CreateEntity(entity);
+      EntityId id = entity->GetId();
+
+      AboutEntityCounter counter;
+      MessageFunctor ftr(&counter, &AboutEntityCounter::OnMessage);
+      em->RegisterForMessages(EntityAddedToSceneMessage::TYPE, id, ftr);
+
+      EntityAddedToSceneMessage msg;
+      msg.SetAboutEntityId(id);
+      em->EmitMessage(msg);
+      CHECK_EQUAL(1u, counter.mCount);
+
+      em->KillEntity(id);
+      CHECK_EQUAL(false, em->GetMessagePump().IsRegistered(EntityAddedToSceneMessage::TYPE, id, ftr));
+      em->EmitMessage(msg);
+      CHECK_EQUAL(1u, counter.mCount);
+
+      delete em;
+   }
+
    /*//------------------------------------------------------------------
    TEST(AddEntitySystem)
    {
@@ -0,0 +1,107 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/headlesssysteminterface.h>
+#include <dtEntity/messagepump.h>
+#include <dtEntity/systemmessages.h>
+#include <OpenThreads/Thread>
+#include <UnitTest++.h>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace HeadlessTest
+{
+   class FrameCounter
+   {
+   public:
+      FrameCounter() : mTicks(0), mEndOfFrames(0), mPostUpdates(0), mLastSimTime(0) {}
+
+      void OnTick(const TickData& d) { ++mTicks; mLastSimTime = d.mSimulationTime; mLastDelta = d.mDeltaSimTime; }
+      void OnEndOfFrame(const EndOfFrameData&) { ++mEndOfFrames; }
+      void OnPostUpdate(const PostUpdateData&) { ++mPostUpdates; }
+
+      unsigned int mTicks;
+      unsigned int mEndOfFrames;
+      unsigned int mPostUpdates;
+      double mLastSimTime;
+      float mLastDelta;
+   };
+
+   //------------------------------------------------------------------
+   TEST(HeadlessFixedTimeStep)
+   {
+      MessagePump pump;
+      FrameCounter counter;
+      TypedMessageFunctor<TickData>::type tickFtr(&counter, &FrameCounter::OnTick);
+      TypedMessageFunctor<EndOfFrameData>::type eofFtr(&counter, &FrameCounter::OnEndOfFrame);
+      TypedMessageFunctor<PostUpdateData>::type postFtr(&counter, &FrameCounter::OnPostUpdate);
+      pump.RegisterForTypedMessages<TickData>(tickFtr);
+      pump.RegisterForTypedMessages<EndOfFrameData>(eofFtr);
+      pump.RegisterForTypedMessages<PostUpdateData>(postFtr);
+
+      const char* argv[] = { "test" };
+      HeadlessSystemInterface iface(pump, 1, argv);
+      iface.SetRealTimePacing(false);
+      iface.SetFixedTimeStep(0.25f);
+
+      for(unsigned int i = 0; i < 8; ++i)
+      {
+         CHECK_EQUAL(1u, iface.Step());
+      }
+      CHECK_EQUAL(8u, iface.GetNumTicks());
+      CHECK_EQUAL(8u, counter.mTicks);
+      CHECK_EQUAL(8u, counter.mEndOfFrames);
+      CHECK_EQUAL(8u, counter.mPostUpdates);
+      CHECK_CLOSE(2.0, iface.GetSimulationTime(), 0.0001);
+      CHECK_CLOSE(2.0, counter.mLastSimTime, 0.0001);
+      CHECK_CLOSE(0.25f, counter.mLastDelta, 0.0001f);
+
+      iface.SetTimeScale(2);
+      iface.Tick();
+      CHECK_CLOSE(2.5, iface.GetSimulationTime(), 0.0001);
+      CHECK_CLOSE(0.5f, iface.GetDeltaSimTime(), 0.0001f);
+   }
+
+   //------------------------------------------------------------------
+   TEST(HeadlessCatchUpLimit)
+   {
+      MessagePump pump;
+      const char* argv[] = { "test" };
+      HeadlessSystemInterface iface(pump, 1, argv);
+      iface.SetFixedTimeStep(0.001f);
+      iface.SetMaxCatchUpTicks(5);
+
+      CHECK_EQUAL(1u, iface.Step());
+
+      // fall far behind, only max catch up ticks run, rest is dropped
+      OpenThreads::Thread::microSleep(50000);
+      CHECK_EQUAL(5u, iface.Step());
+      CHECK_EQUAL(6u, iface.GetNumTicks());
+      CHECK(iface.GetNumDroppedTicks() > 30);
+
+      // next step waits for next tick instead of catching up
+      unsigned int dropped = iface.GetNumDroppedTicks();
+      unsigned int ticks = iface.Step();
+      CHECK(ticks >= 1);
+      CHECK(ticks <= 5);
+      CHECK(iface.GetNumDroppedTicks() - dropped < 5);
+   }
+}
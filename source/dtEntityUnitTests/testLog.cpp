@@ -0,0 +1,226 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/asyncloglistener.h>
+#include <dtEntity/log.h>
+#include <OpenThreads/Thread>
+#include <UnitTest++.h>
+#include <sstream>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace LogTest
+{
+   class CountingLogListener : public LogListener
+   {
+   public:
+      CountingLogListener() : mCount(0) {}
+
+      virtual void LogMessage(LogLevel::e level, const std::string& filename, const std::string& methodname, int linenumber,
+                      const std::string& msg)
+      {
+         ++mCount;
+         mLast = msg;
+      }
+
+      unsigned int mCount;
+      std::string mLast;
+   };
+
+   // counts how often a log message was formatted
+   struct FormatCounter
+   {
+      FormatCounter() : mCount(0) {}
+      unsigned int mCount;
+   };
+
+   std::ostream& operator<<(std::ostream& os, FormatCounter& c)
+   {
+      ++c.mCount;
+      return os << "formatted";
+   }
+
+   //------------------------------------------------------------------
+   TEST(LogLevelNames)
+   {
+      LogLevel::e level;
+      CHECK(LogLevel::FromName("warning", level));
+      CHECK_EQUAL(LogLevel::LVL_WARNING, level);
+      CHECK(LogLevel::FromName("DEBUG", level));
+      CHECK_EQUAL(LogLevel::LVL_DEBUG, level);
+      CHECK_EQUAL(false, LogLevel::FromName("verbose", level));
+      CHECK_EQUAL(std::string("ERROR"), std::string(LogLevel::GetName(LogLevel::LVL_ERROR)));
+   }
+
+   //------------------------------------------------------------------
+   TEST(LogLevelThreshold)
+   {
+      LogManager& lm = LogManager::GetInstance();
+      osg::ref_ptr<CountingLogListener> listener = new CountingLogListener();
+      lm.AddListener(listener);
+
+      lm.SetLogLevel(LogLevel::LVL_WARNING);
+      CHECK(LogManager::IsLevelEnabled(LogLevel::LVL_ALWAYS));
+      CHECK(LogManager::IsLevelEnabled(LogLevel::LVL_ERROR));
+      CHECK(LogManager::IsLevelEnabled(LogLevel::LVL_WARNING));
+      CHECK_EQUAL(false, LogManager::IsLevelEnabled(LogLevel::LVL_INFO));
+      CHECK_EQUAL(false, LogManager::IsLevelEnabled(LogLevel::LVL_DEBUG));
+
+      // disabled levels are not formatted
+      FormatCounter counter;
+      LOG_DEBUG(counter);
+      LOG_INFO(counter);
+      CHECK_EQUAL(0u, counter.mCount);
+      CHECK_EQUAL(0u, listener->mCount);
+
+      LOG_WARNING(counter);
+      CHECK_EQUAL(1u, counter.mCount);
+      CHECK_EQUAL(1u, listener->mCount);
+      CHECK_EQUAL(std::string("formatted"), listener->mLast);
+
+      lm.SetLogLevel(LogLevel::LVL_DEBUG);
+      LOG_DEBUG(counter);
+      CHECK_EQUAL(2u, listener->mCount);
+
+      lm.RemoveListener(listener);
+   }
+
+   //------------------------------------------------------------------
+   TEST(LogListenerLevelMask)
+   {
+      LogManager& lm = LogManager::GetInstance();
+      osg::ref_ptr<CountingLogListener> errors = new CountingLogListener();
+      osg::ref_ptr<CountingLogListener> all = new CountingLogListener();
+      errors->SetLevelMask(LogLevel::MASK_ERROR);
+      lm.AddListener(errors);
+
+      // no listener wants info messages
+      CHECK(LogManager::IsLevelEnabled(LogLevel::LVL_ERROR));
+      CHECK_EQUAL(false, LogManager::IsLevelEnabled(LogLevel::LVL_INFO));
+
+      lm.AddListener(all);
+      CHECK(LogManager::IsLevelEnabled(LogLevel::LVL_INFO));
+
+      LOG_INFO("info");
+      LOG_ERROR("error");
+      CHECK_EQUAL(1u, errors->mCount);
+      CHECK_EQUAL(2u, all->mCount);
+
+      all->SetLevelMask(LogLevel::MASK_WARNING);
+      CHECK_EQUAL(false, LogManager::IsLevelEnabled(LogLevel::LVL_INFO));
+
+      lm.RemoveListener(all);
+      lm.RemoveListener(errors);
+      CHECK_EQUAL(false, LogManager::IsLevelEnabled(LogLevel::LVL_ERROR));
+   }
+
+   //------------------------------------------------------------------
+   TEST(AsyncLogListener)
+   {
+      std::ostringstream out;
+      osg::ref_ptr<AsyncLogListener> listener = new AsyncLogListener(out, 5);
+      CHECK_EQUAL(8u, listener->GetCapacity());
+
+      for(unsigned int i = 0; i < 3; ++i)
+      {
+         listener->LogMessage(LogLevel::LVL_WARNING, "file.cpp", "Method", 42, "message");
+      }
+      listener->Flush();
+
+      std::string expected = "WARNING File: file.cpp Line: 42 Message: message\n";
+      CHECK_EQUAL(expected + expected + expected, out.str());
+      CHECK_EQUAL(0u, listener->GetNumDropped());
+   }
+
+   class LoggingThread : public OpenThreads::Thread
+   {
+   public:
+      LoggingThread(AsyncLogListener& listener) : mListener(&listener) {}
+
+      virtual void run()
+      {
+         for(unsigned int i = 0; i < 1000; ++i)
+         {
+            mListener->LogMessage(LogLevel::LVL_INFO, "file.cpp", "run", i, "message");
+         }
+      }
+
+      AsyncLogListener* mListener;
+   };
+
+   //------------------------------------------------------------------
+   TEST(AsyncLogListenerManyThreads)
+   {
+      std::ostringstream out;
+      osg::ref_ptr<AsyncLogListener> listener = new AsyncLogListener(out, 1 << 13);
+
+      std::vector<LoggingThread*> threads;
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         threads.push_back(new LoggingThread(*listener));
+         threads.back()->start();
+      }
+      for(unsigned int i = 0; i < threads.size(); ++i)
+      {
+         threads[i]->join();
+         delete threads[i];
+      }
+      listener->Flush();
+
+      std::string text = out.str();
+      unsigned int numLines = 0;
+      for(std::string::size_type i = 0; i < text.size(); ++i)
+      {
+         if(text[i] == '\n') ++numLines;
+      }
+      CHECK_EQUAL(4000u, numLines);
+      CHECK_EQUAL(0u, listener->GetNumDropped());
+   }
+
+   //------------------------------------------------------------------
+   TEST(AsyncLogListenerFullRingDrops)
+   {
+      std::ostringstream out;
+      osg::ref_ptr<AsyncLogListener> listener = new AsyncLogListener(out, 8);
+
+      // producers do not wait for the writer thread, messages that do not fit are dropped
+      std::vector<LoggingThread*> threads;
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         threads.push_back(new LoggingThread(*listener));
+         threads.back()->start();
+      }
+      for(unsigned int i = 0; i < threads.size(); ++i)
+      {
+         threads[i]->join();
+         delete threads[i];
+      }
+      listener->Flush();
+
+      std::string text = out.str();
+      unsigned int numLines = 0;
+      for(std::string::size_type i = 0; i < text.size(); ++i)
+      {
+         if(text[i] == '\n') ++numLines;
+      }
+      CHECK_EQUAL(4000u, numLines + listener->GetNumDropped());
+   }
+}
@@ -0,0 +1,302 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/messagefactory.h>
+#include <dtEntity/messagejournal.h>
+#include <dtEntity/systemmessages.h>
+#include <UnitTest++.h>
+#include <algorithm>
+#include <stdio.h>
+#include <vector>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace MessageJournalTest
+{
+   const char* JOURNAL_PATH = "messagejournaltest.dtj";
+
+   // emits a name update for every tick
+   class TickHandler
+   {
+   public:
+      TickHandler(EntityManager& em) : mEntityManager(&em) {}
+
+      void OnTick(const Message& m)
+      {
+         EntityNameUpdatedMessage msg;
+         msg.SetEntityName("nested");
+         mEntityManager->EmitMessage(msg);
+      }
+
+      EntityManager* mEntityManager;
+   };
+
+   class NameRecorder
+   {
+   public:
+      void OnNameUpdated(const Message& m)
+      {
+         const EntityNameUpdatedMessage& msg = static_cast<const EntityNameUpdatedMessage&>(m);
+         mNames.push_back(msg.GetEntityName());
+         mIds.push_back(msg.GetAboutEntityId());
+      }
+
+      std::vector<std::string> mNames;
+      std::vector<EntityId> mIds;
+   };
+
+   // record three ticks with a nested message each and a name update after the last tick
+   void RecordJournal(unsigned int& numRecords)
+   {
+      EntityManager em;
+      TickHandler handler(em);
+      MessageFunctor ftr(&handler, &TickHandler::OnTick);
+      em.RegisterForMessages(TickMessage::TYPE, ftr);
+
+      MessageJournalRecorder recorder(em);
+      CHECK(recorder.Start(JOURNAL_PATH));
+      for(unsigned int i = 1; i <= 3; ++i)
+      {
+         TickMessage tick;
+         tick.SetSimulationTime(i);
+         em.EmitMessage(tick);
+      }
+      EntityNameUpdatedMessage msg;
+      msg.SetAboutEntityId(42);
+      msg.SetEntityName("root");
+      em.EmitMessage(msg);
+      recorder.Stop();
+
+      CHECK_EQUAL(false, recorder.IsRecording());
+      CHECK(em.GetMessagePump().GetEmitObserver() == NULL);
+      numRecords = recorder.GetNumRecords();
+   }
+
+   //------------------------------------------------------------------
+   TEST(RecordAndReplayJournal)
+   {
+      RegisterSystemMessages(MessageFactory::GetInstance());
+      unsigned int numRecords;
+      RecordJournal(numRecords);
+      CHECK_EQUAL(7u, numRecords);
+
+      EntityManager em;
+      NameRecorder rec;
+      MessageFunctor ftr(&rec, &NameRecorder::OnNameUpdated);
+      em.RegisterForMessages(EntityNameUpdatedMessage::TYPE, ftr);
+
+      MessageJournalPlayer player(em);
+      CHECK(player.Open(JOURNAL_PATH));
+
+      // nested messages are skipped by default
+      CHECK_EQUAL(4u, player.PlayAll());
+      CHECK(player.AtEnd());
+      CHECK_EQUAL(1u, (unsigned int)rec.mNames.size());
+      CHECK_EQUAL("root", rec.mNames[0]);
+      CHECK_EQUAL(42u, rec.mIds[0]);
+
+      player.Rewind();
+      player.SetPlayNested(true);
+      CHECK_EQUAL(7u, player.PlayAll());
+      CHECK_EQUAL(5u, (unsigned int)rec.mNames.size());
+      CHECK_EQUAL("nested", rec.mNames[1]);
+      CHECK_EQUAL("root", rec.mNames[4]);
+
+      remove(JOURNAL_PATH);
+   }
+
+   //------------------------------------------------------------------
+   TEST(ReplayJournalUntilTime)
+   {
+      RegisterSystemMessages(MessageFactory::GetInstance());
+      unsigned int numRecords;
+      RecordJournal(numRecords);
+
+      EntityManager em;
+      MessageJournalPlayer player(em);
+      CHECK(player.Open(JOURNAL_PATH));
+      CHECK_CLOSE(1.0, player.GetNextTime(), 0.0001);
+
+      CHECK_EQUAL(2u, player.PlayUntil(2.5));
+      CHECK_CLOSE(3.0, player.GetNextTime(), 0.0001);
+      CHECK_EQUAL(2u, player.PlayUntil(3.0));
+      CHECK(player.AtEnd());
+      CHECK_EQUAL(-1.0, player.GetNextTime());
+
+      remove(JOURNAL_PATH);
+   }
+
+   // enqueues a name update for every tick
+   class EnqueueingTickHandler
+   {
+   public:
+      EnqueueingTickHandler(EntityManager& em) : mEntityManager(&em) {}
+
+      void OnTick(const Message& m)
+      {
+         EntityNameUpdatedMessage msg;
+         msg.SetEntityName("enqueued");
+         mEntityManager->EnqueueMessage(msg);
+      }
+
+      EntityManager* mEntityManager;
+   };
+
+   //------------------------------------------------------------------
+   TEST(ReplayDeliversMessagesEnqueuedByHandlersOnce)
+   {
+      RegisterSystemMessages(MessageFactory::GetInstance());
+      {
+         EntityManager em;
+         EnqueueingTickHandler handler(em);
+         MessageFunctor ftr(&handler, &EnqueueingTickHandler::OnTick);
+         em.RegisterForMessages(TickMessage::TYPE, ftr);
+
+         MessageJournalRecorder recorder(em);
+         CHECK(recorder.Start(JOURNAL_PATH));
+         TickMessage tick;
+         tick.SetSimulationTime(1);
+         em.EmitMessage(tick);
+
+         // enqueued outside of a handler, replayed from journal
+         EntityNameUpdatedMessage msg;
+         msg.SetEntityName("root");
+         em.EnqueueMessage(msg);
+
+         em.GetMessagePump().EmitQueuedMessages(1);
+         recorder.Stop();
+         CHECK_EQUAL(3u, recorder.GetNumRecords());
+      }
+
+      EntityManager em;
+      EnqueueingTickHandler handler(em);
+      MessageFunctor tickftr(&handler, &EnqueueingTickHandler::OnTick);
+      em.RegisterForMessages(TickMessage::TYPE, tickftr);
+      NameRecorder rec;
+      MessageFunctor nameftr(&rec, &NameRecorder::OnNameUpdated);
+      em.RegisterForMessages(EntityNameUpdatedMessage::TYPE, nameftr);
+
+      MessageJournalPlayer player(em);
+      CHECK(player.Open(JOURNAL_PATH));
+      CHECK_EQUAL(2u, player.PlayAll());
+      em.GetMessagePump().EmitQueuedMessages(1);
+
+      CHECK_EQUAL(2u, (unsigned int)rec.mNames.size());
+      CHECK_EQUAL(1, (int)std::count(rec.mNames.begin(), rec.mNames.end(), std::string("enqueued")));
+      CHECK_EQUAL(1, (int)std::count(rec.mNames.begin(), rec.mNames.end(), std::string("root")));
+
+      remove(JOURNAL_PATH);
+   }
+
+   class JournalTestMessage : public Message
+   {
+   public:
+      static const MessageType TYPE;
+
+      JournalTestMessage()
+         : Message(TYPE)
+      {
+         Register(SID("Array"), &mArray);
+         Register(SID("Group"), &mGroup);
+         Register(SID("Matrix"), &mMatrix);
+         Register(SID("Quat"), &mQuat);
+         Register(SID("Vec3d"), &mVec3d);
+         Register(SID("Flag"), &mFlag);
+         Register(SID("Name"), &mName);
+      }
+
+      virtual Message* Clone() const { return CloneContainer<JournalTestMessage>(); }
+
+      ArrayProperty mArray;
+      GroupProperty mGroup;
+      MatrixProperty mMatrix;
+      QuatProperty mQuat;
+      Vec3dProperty mVec3d;
+      BoolProperty mFlag;
+      StringIdProperty mName;
+   };
+
+   const MessageType JournalTestMessage::TYPE(SID("JournalTestMessage"));
+
+   class TestMessageRecorder
+   {
+   public:
+      TestMessageRecorder() : mReceived(NULL) {}
+      ~TestMessageRecorder() { delete mReceived; }
+
+      void OnMessage(const Message& m) { mReceived = m.Clone(); }
+
+      Message* mReceived;
+   };
+
+   //------------------------------------------------------------------
+   TEST(JournalEncodesAllPropertyTypes)
+   {
+      MessageFactory::GetInstance().RegisterMessageType<JournalTestMessage>(JournalTestMessage::TYPE);
+
+      JournalTestMessage msg;
+      msg.mArray.Add(new IntProperty(-5));
+      msg.mArray.Add(new StringProperty("text"));
+      msg.mGroup.Add(SID("Inner"), new Vec2Property(1, 2));
+      msg.mGroup.Add(SID("Count"), new UIntProperty(7));
+      Matrix m;
+      m(3, 1) = 12.5;
+      msg.mMatrix.Set(m);
+      msg.mQuat.Set(Quat(0, 0, 1, 0));
+      msg.mVec3d.Set(Vec3d(1, 2, 3));
+      msg.mFlag.Set(true);
+      msg.mName.Set(SID("SomeName"));
+
+      {
+         EntityManager em;
+         MessageJournalRecorder recorder(em);
+         CHECK(recorder.Start(JOURNAL_PATH));
+         em.EmitMessage(msg);
+      }
+
+      EntityManager em;
+      TestMessageRecorder rec;
+      MessageFunctor ftr(&rec, &TestMessageRecorder::OnMessage);
+      em.RegisterForMessages(JournalTestMessage::TYPE, ftr);
+      MessageJournalPlayer player(em);
+      CHECK(player.Open(JOURNAL_PATH));
+      CHECK_EQUAL(1u, player.PlayAll());
+      CHECK(rec.mReceived != NULL);
+      if(rec.mReceived != NULL)
+      {
+         // array and group properties compare pointers, check their elements
+         JournalTestMessage& r = *static_cast<JournalTestMessage*>(rec.mReceived);
+         CHECK_EQUAL(2u, (unsigned int)r.mArray.Size());
+         CHECK_EQUAL(-5, r.mArray.Get(0)->IntValue());
+         CHECK_EQUAL("text", r.mArray.Get(1)->StringValue());
+         CHECK(*r.mGroup.Get(SID("Inner")) == *msg.mGroup.Get(SID("Inner")));
+         CHECK_EQUAL(7u, r.mGroup.Get(SID("Count"))->UIntValue());
+         CHECK(r.mMatrix == msg.mMatrix);
+         CHECK(r.mQuat == msg.mQuat);
+         CHECK(r.mVec3d == msg.mVec3d);
+         CHECK(r.mFlag == msg.mFlag);
+         CHECK(r.mName == msg.mName);
+      }
+
+      remove(JOURNAL_PATH);
+   }
+}
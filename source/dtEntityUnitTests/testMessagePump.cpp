@@ -0,0 +1,638 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+
+#include <dtEntity/messagepump.h>
+#include <dtEntity/messagescheduler.h>
+#include <dtEntity/mpscqueue.h>
+#include <dtEntity/systemmessages.h>
+#include <OpenThreads/Thread>
+#include <UnitTest++.h>
+#include <vector>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace MessagePumpTest
+{
+   const unsigned int NUM_PRODUCERS = 4;
+   const unsigned int PUSHES_PER_PRODUCER = 20000;
+
+   // pushes producer index in upper 16 bits and sequence number in lower bits
+   template<class Queue>
+   class ProducerThread : public OpenThreads::Thread
+   {
+   public:
+      ProducerThread(Queue& q, unsigned int producer)
+         : mQueue(&q)
+         , mProducer(producer)
+      {
+      }
+
+      virtual void run()
+      {
+         for(unsigned int i = 0; i < PUSHES_PER_PRODUCER; ++i)
+         {
+            while(!mQueue->Push((mProducer << 16) | i))
+            {
+               YieldCurrentThread();
+            }
+         }
+      }
+
+   private:
+      Queue* mQueue;
+      unsigned int mProducer;
+   };
+
+   // unbounded queue Push returns void, adapt to bounded interface
+   class UnboundedQueue : public MPSCQueue<unsigned int>
+   {
+   public:
+      bool Push(unsigned int v) { MPSCQueue<unsigned int>::Push(v); return true; }
+   };
+
+   // consume concurrently with producers, check that nothing is lost
+   // and that elements of each producer arrive in push order
+   template<class Queue>
+   void StressQueue(Queue& q)
+   {
+      std::vector<ProducerThread<Queue>*> producers;
+      for(unsigned int i = 0; i < NUM_PRODUCERS; ++i)
+      {
+         producers.push_back(new ProducerThread<Queue>(q, i));
+      }
+      for(unsigned int i = 0; i < NUM_PRODUCERS; ++i)
+      {
+         producers[i]->start();
+      }
+
+      std::vector<unsigned int> next(NUM_PRODUCERS, 0);
+      std::vector<unsigned int> batch;
+      unsigned int received = 0;
+      bool ordered = true;
+      while(received < NUM_PRODUCERS * PUSHES_PER_PRODUCER)
+      {
+         batch.clear();
+         if(!q.PopAll(batch))
+         {
+            OpenThreads::Thread::YieldCurrentThread();
+            continue;
+         }
+         for(unsigned int i = 0; i < batch.size(); ++i)
+         {
+            unsigned int producer = batch[i] >> 16;
+            unsigned int seq = batch[i] & 0xFFFF;
+            if(producer >= NUM_PRODUCERS || next[producer] != seq)
+            {
+               ordered = false;
+            }
+            else
+            {
+               ++next[producer];
+            }
+         }
+         received += batch.size();
+      }
+
+      for(unsigned int i = 0; i < NUM_PRODUCERS; ++i)
+      {
+         producers[i]->join();
+         delete producers[i];
+      }
+
+      CHECK(ordered);
+      CHECK_EQUAL(NUM_PRODUCERS * PUSHES_PER_PRODUCER, received);
+      CHECK(q.Empty());
+   }
+
+   //------------------------------------------------------------------
+   TEST(MPSCQueueStress)
+   {
+      UnboundedQueue q;
+      StressQueue(q);
+   }
+
+   //------------------------------------------------------------------
+   TEST(BoundedMPSCQueueStress)
+   {
+      BoundedMPSCQueue<unsigned int> q(1000);
+      CHECK_EQUAL(1024u, q.GetCapacity());
+      StressQueue(q);
+   }
+
+   //------------------------------------------------------------------
+   TEST(BoundedMPSCQueueFull)
+   {
+      BoundedMPSCQueue<unsigned int> q(4);
+      for(unsigned int i = 0; i < 4; ++i)
+      {
+         CHECK(q.Push(i));
+      }
+      CHECK_EQUAL(false, q.Push(4));
+
+      std::vector<unsigned int> batch;
+      CHECK(q.PopAll(batch));
+      CHECK_EQUAL(4u, (unsigned int)batch.size());
+      CHECK_EQUAL(3u, batch.back());
+      CHECK(q.Push(5));
+      CHECK_EQUAL(false, q.Empty());
+   }
+
+   class MessageCounter
+   {
+   public:
+      MessageCounter(MessagePump& pump) : mPump(&pump), mCount(0) {}
+
+      void OnEndOfFrame(const Message& msg)
+      {
+         // messages enqueued while emitting are emitted in the same frame
+         if(++mCount == 1)
+         {
+            mPump->EnqueueMessage(msg);
+         }
+      }
+
+      MessagePump* mPump;
+      unsigned int mCount;
+   };
+
+   //------------------------------------------------------------------
+   TEST(EmitQueuedMessages)
+   {
+      MessagePump pump;
+      MessageCounter counter(pump);
+      MessageFunctor ftr(&counter, &MessageCounter::OnEndOfFrame);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, ftr);
+
+      EndOfFrameMessage msg;
+      pump.EnqueueMessage(msg);
+      pump.EnqueueMessage(msg, 10.0);
+      CHECK_EQUAL(0u, counter.mCount);
+
+      pump.EmitQueuedMessages(1.0);
+      CHECK_EQUAL(2u, counter.mCount);
+
+      pump.EmitQueuedMessages(11.0);
+      CHECK_EQUAL(3u, counter.mCount);
+   }
+
+   class OrderRecorder
+   {
+   public:
+      OrderRecorder(MessagePump& pump) : mPump(&pump) {}
+
+      void A(const Message&) { mCalls.push_back(1); }
+      void B(const Message&) { mCalls.push_back(2); }
+      void C(const Message&) { mCalls.push_back(3); }
+
+      // unregisters B and registers C while message is emitted
+      void Modify(const Message&)
+      {
+         mCalls.push_back(4);
+         MessageFunctor b(this, &OrderRecorder::B);
+         mPump->UnregisterForMessages(EndOfFrameMessage::TYPE, b);
+         mPump->RegisterForMessages(EndOfFrameMessage::TYPE, MessageFunctor(this, &OrderRecorder::C), FilterOptions::PRIORITY_HIGHEST);
+      }
+
+      MessagePump* mPump;
+      std::vector<int> mCalls;
+   };
+
+   //------------------------------------------------------------------
+   TEST(EmitMessagePriorityAndSingleShot)
+   {
+      MessagePump pump;
+      OrderRecorder rec(pump);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::A), FilterOptions::PRIORITY_LOWEST);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::B),
+         FilterOptions::PRIORITY_HIGHEST | FilterOptions::SINGLE_SHOT);
+
+      EndOfFrameMessage msg;
+      pump.EmitMessage(msg);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(3u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(2, rec.mCalls[0]);
+      CHECK_EQUAL(1, rec.mCalls[1]);
+      CHECK_EQUAL(1, rec.mCalls[2]);
+      CHECK_EQUAL(false, pump.IsRegistered(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::B)));
+   }
+
+   //------------------------------------------------------------------
+   TEST(EmitMessageModifyWhileEmitting)
+   {
+      MessagePump pump;
+      OrderRecorder rec(pump);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::Modify),
+         FilterOptions::PRIORITY_HIGHEST | FilterOptions::SINGLE_SHOT);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::B), FilterOptions::PRIORITY_DEFAULT);
+
+      EndOfFrameMessage msg;
+      pump.EmitMessage(msg);
+
+      // B was unregistered before its turn, C is called from next emit on
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(4, rec.mCalls[0]);
+      CHECK(pump.IsRegistered(EndOfFrameMessage::TYPE, MessageFunctor(&rec, &OrderRecorder::C)));
+
+      rec.mCalls.clear();
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(3, rec.mCalls[0]);
+   }
+
+   //------------------------------------------------------------------
+   TEST(MessagePoolRecycles)
+   {
+      MessagePump pump;
+      MessagePool& pool = pump.GetMessagePool();
+
+      TickMessage tick;
+      tick.SetDeltaSimTime(0.5f);
+      pump.EnqueueMessage(tick);
+      pump.EmitQueuedMessages(0);
+      CHECK_EQUAL(0u, pool.GetNumHits());
+      CHECK_EQUAL(1u, pool.GetNumMisses());
+
+      // second message reuses the first one, values are copied
+      tick.SetDeltaSimTime(0.25f);
+      Message* recycled = pool.Acquire(tick);
+      CHECK_EQUAL(1u, pool.GetNumHits());
+      CHECK_EQUAL(0.25f, static_cast<TickMessage*>(recycled)->GetDeltaSimTime());
+
+      // pooled message of other class is not used
+      EndOfFrameMessage eof;
+      Message* cloned = pool.Acquire(eof);
+      CHECK_EQUAL(2u, pool.GetNumMisses());
+      CHECK_EQUAL(EndOfFrameMessage::TYPE, cloned->GetType());
+
+      pool.Release(recycled);
+      pool.Release(cloned);
+      pool.ResetCounters();
+      CHECK_EQUAL(0u, pool.GetNumHits());
+   }
+
+   //------------------------------------------------------------------
+   TEST(MessageSchedulerOrder)
+   {
+      MessageScheduler scheduler;
+      double times[] = { 5, 1, 3, 3, 9, 0.5, 7, 3 };
+      for(unsigned int i = 0; i < 8; ++i)
+      {
+         FutureMessageEntry e;
+         e.mTimeToPost = times[i];
+         e.mMessage = NULL;
+         e.mId = i + 1;
+         scheduler.Insert(e);
+      }
+
+      FutureMessageEntry removed;
+      CHECK(scheduler.Remove(5, removed));
+      CHECK_EQUAL(9.0, removed.mTimeToPost);
+      CHECK_EQUAL(false, scheduler.Remove(5, removed));
+
+      FutureMessageEntry e;
+      CHECK_EQUAL(false, scheduler.PopDue(0.1, e));
+
+      // entries with same time come in id order
+      unsigned int expected[] = { 6, 2, 3, 4, 8, 1, 7 };
+      for(unsigned int i = 0; i < 7; ++i)
+      {
+         CHECK(scheduler.PopDue(100, e));
+         CHECK_EQUAL(expected[i], e.mId);
+      }
+      CHECK(scheduler.Empty());
+   }
+
+   //------------------------------------------------------------------
+   TEST(MessageSchedulerRemoveById)
+   {
+      // enough entries to grow the id table several times, ids with gaps
+      // so that probe sequences wrap and collide
+      MessageScheduler scheduler;
+      const unsigned int num = 500;
+      for(unsigned int i = 0; i < num; ++i)
+      {
+         FutureMessageEntry e;
+         e.mTimeToPost = (i * 7919) % num;
+         e.mMessage = NULL;
+         e.mId = i * 3 + 1;
+         scheduler.Insert(e);
+      }
+
+      FutureMessageEntry removed;
+      for(unsigned int i = 0; i < num; i += 2)
+      {
+         CHECK(scheduler.Remove(i * 3 + 1, removed));
+         CHECK_EQUAL(i * 3 + 1, removed.mId);
+      }
+      CHECK_EQUAL(false, scheduler.Remove(1, removed));
+      CHECK_EQUAL(false, scheduler.Remove(2, removed));
+      CHECK_EQUAL(num / 2, scheduler.GetSize());
+
+      // remaining entries are found by id and come out in time order
+      CHECK(scheduler.Remove(3 * 3 + 1, removed));
+      double last = -1;
+      unsigned int count = 0;
+      FutureMessageEntry e;
+      while(scheduler.PopDue(num, e))
+      {
+         CHECK(e.mTimeToPost >= last);
+         CHECK(e.mId % 6 == 4);
+         last = e.mTimeToPost;
+         ++count;
+      }
+      CHECK_EQUAL(num / 2 - 1, count);
+   }
+
+   //------------------------------------------------------------------
+   TEST(CancelFutureMessage)
+   {
+      MessagePump pump;
+      MessageCounter counter(pump);
+      MessageFunctor ftr(&counter, &MessageCounter::OnEndOfFrame);
+      pump.RegisterForMessages(EndOfFrameMessage::TYPE, ftr);
+
+      EndOfFrameMessage msg;
+      CHECK_EQUAL(0u, pump.EnqueueMessage(msg, 0));
+      unsigned int first = pump.EnqueueMessage(msg, 5.0);
+      unsigned int second = pump.EnqueueMessage(msg, 6.0);
+      CHECK(first != 0 && second != 0 && first != second);
+      CHECK_EQUAL(2u, pump.GetNumFutureMessages());
+
+      CHECK(pump.CancelMessage(first));
+      CHECK_EQUAL(false, pump.CancelMessage(first));
+      CHECK_EQUAL(1u, pump.GetNumFutureMessages());
+
+      // immediate message and the one it enqueues are emitted
+      pump.EmitQueuedMessages(10.0);
+      CHECK_EQUAL(3u, counter.mCount);
+      CHECK_EQUAL(false, pump.CancelMessage(second));
+   }
+
+   class TypedRecorder
+   {
+   public:
+      TypedRecorder() : mLastDelta(0) {}
+
+      void OnTyped(const TickData& msg)
+      {
+         mCalls.push_back(1);
+         mLastDelta = msg.mDeltaSimTime;
+      }
+
+      void OnProperty(const Message& msg)
+      {
+         mCalls.push_back(2);
+         mLastDelta = static_cast<const TickMessage&>(msg).GetDeltaSimTime();
+      }
+
+      void OnAnyClass(const Message& msg)
+      {
+         mCalls.push_back(3);
+      }
+
+      std::vector<int> mCalls;
+      float mLastDelta;
+   };
+
+   //------------------------------------------------------------------
+   TEST(EmitTypedMessage)
+   {
+      MessagePump pump;
+      TypedRecorder rec;
+      TypedMessageFunctor<TickData>::type typedftr(&rec, &TypedRecorder::OnTyped);
+      pump.RegisterForTypedMessages<TickData>(typedftr, FilterOptions::PRIORITY_HIGHEST);
+      CHECK(pump.IsRegisteredForTypedMessages<TickData>(typedftr));
+
+      TickData tick;
+      tick.mDeltaSimTime = 0.5f;
+      pump.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_CLOSE(0.5f, rec.mLastDelta, 0.0001f);
+
+      // other typed messages with same data struct base are not delivered
+      EndOfFrameData eof;
+      pump.EmitTypedMessage(eof);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+
+      CHECK(pump.UnregisterForTypedMessages<TickData>(typedftr));
+      pump.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+   }
+
+   //------------------------------------------------------------------
+   TEST(TypedAndPropertyHandlersShareList)
+   {
+      MessagePump pump;
+      TypedRecorder rec;
+      pump.RegisterForMessages(TickMessage::TYPE, MessageFunctor(&rec, &TypedRecorder::OnProperty), FilterOptions::PRIORITY_LOWEST);
+      pump.RegisterForTypedMessages<TickData>(TypedMessageFunctor<TickData>::type(&rec, &TypedRecorder::OnTyped),
+         FilterOptions::PRIORITY_HIGHEST);
+
+      // typed emit reaches property handler through reflected message
+      TickData tick;
+      tick.mDeltaSimTime = 0.25f;
+      pump.EmitTypedMessage(tick);
+      CHECK_EQUAL(2u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(1, rec.mCalls[0]);
+      CHECK_EQUAL(2, rec.mCalls[1]);
+      CHECK_CLOSE(0.25f, rec.mLastDelta, 0.0001f);
+
+      // property emit (scripts, network) reaches typed handler
+      rec.mCalls.clear();
+      TickMessage msg;
+      msg.SetDeltaSimTime(0.75f);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(2u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(1, rec.mCalls[0]);
+      CHECK_EQUAL(2, rec.mCalls[1]);
+
+      // queued property messages too
+      rec.mCalls.clear();
+      pump.EnqueueMessage(msg);
+      pump.EmitQueuedMessages(0);
+      CHECK_EQUAL(2u, (unsigned int)rec.mCalls.size());
+   }
+
+   //------------------------------------------------------------------
+   TEST(WrongMessageClassReachesPropertyHandlers)
+   {
+      MessagePump pump;
+      TypedRecorder rec;
+      pump.RegisterForMessages(TickMessage::TYPE, MessageFunctor(&rec, &TypedRecorder::OnAnyClass));
+      pump.RegisterForTypedMessages<TickData>(TypedMessageFunctor<TickData>::type(&rec, &TypedRecorder::OnTyped));
+
+      // message of right type but not of class TickMessage cannot be converted to TickData
+      Message msg(TickMessage::TYPE);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(3, rec.mCalls[0]);
+   }
+
+   //------------------------------------------------------------------
+   TEST(TypedSingleShot)
+   {
+      MessagePump pump;
+      TypedRecorder rec;
+      TypedMessageFunctor<TickData>::type typedftr(&rec, &TypedRecorder::OnTyped);
+      pump.RegisterForTypedMessages<TickData>(typedftr, FilterOptions::DEFAULT | FilterOptions::SINGLE_SHOT);
+
+      TickData tick;
+      pump.EmitTypedMessage(tick);
+      pump.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(false, pump.IsRegisteredForTypedMessages<TickData>(typedftr));
+   }
+
+   class EntityMessageRecorder
+   {
+   public:
+      EntityMessageRecorder(MessagePump& pump) : mPump(&pump) {}
+
+      void OnBroadcast(const Message& msg) { mCalls.push_back(0); }
+
+      void OnEntity(const Message& msg)
+      {
+         mCalls.push_back(static_cast<const EntityAddedToSceneMessage&>(msg).GetAboutEntityId());
+      }
+
+      // unregisters itself while being emitted
+      void OnEntityOnce(const Message& msg)
+      {
+         OnEntity(msg);
+         MessageFunctor self(this, &EntityMessageRecorder::OnEntityOnce);
+         mPump->UnregisterForMessages(EntityAddedToSceneMessage::TYPE,
+            static_cast<const EntityAddedToSceneMessage&>(msg).GetAboutEntityId(), self);
+      }
+
+      MessagePump* mPump;
+      std::vector<EntityId> mCalls;
+   };
+
+   //------------------------------------------------------------------
+   TEST(EntityTargetedMessages)
+   {
+      MessagePump pump;
+      EntityMessageRecorder rec(pump);
+      MessageFunctor entityftr(&rec, &EntityMessageRecorder::OnEntity);
+      pump.RegisterForMessages(EntityAddedToSceneMessage::TYPE, MessageFunctor(&rec, &EntityMessageRecorder::OnBroadcast));
+      pump.RegisterForMessages(EntityAddedToSceneMessage::TYPE, 5, entityftr);
+      pump.RegisterForMessages(EntityAddedToSceneMessage::TYPE, 6, entityftr);
+      CHECK(pump.IsRegistered(EntityAddedToSceneMessage::TYPE, 5, entityftr));
+      CHECK_EQUAL(false, pump.IsRegistered(EntityAddedToSceneMessage::TYPE, entityftr));
+
+      // broadcast functors first, then functors of the entity only
+      EntityAddedToSceneMessage msg;
+      msg.SetAboutEntityId(5);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(2u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(0u, rec.mCalls[0]);
+      CHECK_EQUAL(5u, rec.mCalls[1]);
+
+      rec.mCalls.clear();
+      msg.SetAboutEntityId(7);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+
+      rec.mCalls.clear();
+      CHECK(pump.UnregisterForMessages(EntityAddedToSceneMessage::TYPE, 6, entityftr));
+      CHECK_EQUAL(false, pump.UnregisterForMessages(EntityAddedToSceneMessage::TYPE, 6, entityftr));
+      msg.SetAboutEntityId(6);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+
+      pump.UnregisterForEntity(5);
+      CHECK_EQUAL(false, pump.IsRegistered(EntityAddedToSceneMessage::TYPE, 5, entityftr));
+   }
+
+   //------------------------------------------------------------------
+   TEST(EntityTargetedUnregisterWhileEmitting)
+   {
+      MessagePump pump;
+      EntityMessageRecorder rec(pump);
+      MessageFunctor onceftr(&rec, &EntityMessageRecorder::OnEntityOnce);
+      pump.RegisterForMessages(EntityAddedToSceneMessage::TYPE, 3, onceftr);
+
+      EntityAddedToSceneMessage msg;
+      msg.SetAboutEntityId(3);
+      pump.EmitMessage(msg);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(1u, (unsigned int)rec.mCalls.size());
+      CHECK_EQUAL(false, pump.IsRegistered(EntityAddedToSceneMessage::TYPE, 3, onceftr));
+
+      // can register again after list was released
+      pump.RegisterForMessages(EntityAddedToSceneMessage::TYPE, 3, onceftr);
+      pump.EmitMessage(msg);
+      CHECK_EQUAL(2u, (unsigned int)rec.mCalls.size());
+   }
+
+   class NameRecorder
+   {
+   public:
+      void OnNameUpdated(const Message& msg)
+      {
+         const EntityNameUpdatedMessage& m = static_cast<const EntityNameUpdatedMessage&>(msg);
+         mNames.push_back(m.GetEntityName());
+      }
+
+      std::vector<std::string> mNames;
+   };
+
+   //------------------------------------------------------------------
+   TEST(EnqueueMessageCoalesced)
+   {
+      MessagePump pump;
+      NameRecorder rec;
+      MessageFunctor ftr(&rec, &NameRecorder::OnNameUpdated);
+      pump.RegisterForMessages(EntityNameUpdatedMessage::TYPE, ftr);
+
+      EntityNameUpdatedMessage msg;
+      msg.SetEntityName("first");
+      pump.EnqueueMessageCoalesced(msg, 1);
+      msg.SetEntityName("other");
+      pump.EnqueueMessageCoalesced(msg, 2);
+      msg.SetEntityName("second");
+      pump.EnqueueMessageCoalesced(msg, 1);
+      msg.SetEntityName("third");
+      pump.EnqueueMessageCoalesced(msg, 1);
+
+      // replaced message keeps its place in queue
+      pump.EmitQueuedMessages(0);
+      CHECK_EQUAL(2u, (unsigned int)rec.mNames.size());
+      CHECK_EQUAL("third", rec.mNames[0]);
+      CHECK_EQUAL("other", rec.mNames[1]);
+      CHECK_EQUAL(2u, pump.GetNumCoalescedDrops());
+      CHECK_EQUAL(2u, pump.GetNumCoalescedDrops(EntityNameUpdatedMessage::TYPE));
+      CHECK_EQUAL(0u, pump.GetNumCoalescedDrops(TickMessage::TYPE));
+
+      // emitted messages are not replaced anymore
+      rec.mNames.clear();
+      msg.SetEntityName("fourth");
+      pump.EnqueueMessageCoalesced(msg, 1);
+      pump.EmitQueuedMessages(0);
+      CHECK_EQUAL(1u, (unsigned int)rec.mNames.size());
+      CHECK_EQUAL(2u, pump.GetNumCoalescedDrops());
+
+      pump.ResetCoalescedDrops();
+      CHECK_EQUAL(0u, pump.GetNumCoalescedDrops());
+      CHECK_EQUAL(0u, pump.GetNumCoalescedDrops(EntityNameUpdatedMessage::TYPE));
+   }
+}
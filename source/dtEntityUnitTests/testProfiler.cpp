@@ -0,0 +1,225 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/messagepump.h>
+#include <dtEntity/profiler.h>
+#include <dtEntity/systemmessages.h>
+#include <OpenThreads/Thread>
+#include <UnitTest++.h>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <vector>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace ProfilerTest
+{
+   const Profiler::ZoneStats* FindZone(const std::vector<Profiler::ZoneStats>& stats, StringId name)
+   {
+      for(std::vector<Profiler::ZoneStats>::const_iterator i = stats.begin(); i != stats.end(); ++i)
+      {
+         if(i->mName == name)
+         {
+            return &*i;
+         }
+      }
+      return NULL;
+   }
+
+   class ZoneThread : public OpenThreads::Thread
+   {
+   public:
+      virtual void run()
+      {
+         Profiler::SetThreadName("ZoneThread");
+         for(unsigned int i = 0; i < 10; ++i)
+         {
+            ProfileScope zone(SID("ProfilerTestThreadZone"));
+         }
+      }
+   };
+
+   class Receiver
+   {
+   public:
+      void OnMessage(const Message&) {}
+   };
+
+   //------------------------------------------------------------------
+   TEST(ProfilerDisabledRecordsNothing)
+   {
+      Profiler::SetEnabled(false);
+      Profiler::EndFrame();
+      Profiler::ResetStats();
+      {
+         ProfileScope zone(SID("ProfilerTestDisabled"));
+      }
+      Profiler::EndFrame();
+      std::vector<Profiler::ZoneStats> stats;
+      Profiler::GetZoneStats(stats);
+      CHECK(stats.empty());
+      CHECK_EQUAL(1u, Profiler::GetNumFrames());
+   }
+
+   //------------------------------------------------------------------
+   TEST(ProfilerZoneStats)
+   {
+      Profiler::ResetStats();
+      Profiler::SetEnabled(true);
+      for(unsigned int i = 0; i < 100; ++i)
+      {
+         ProfileScope outer(SID("ProfilerTestOuter"));
+         ProfileScope inner(SID("ProfilerTestInner"));
+      }
+      Profiler::EndFrame();
+      Profiler::SetEnabled(false);
+
+      std::vector<Profiler::ZoneStats> stats;
+      Profiler::GetZoneStats(stats);
+      CHECK_EQUAL(2u, (unsigned int)stats.size());
+      const Profiler::ZoneStats* outer = FindZone(stats, SID("ProfilerTestOuter"));
+      const Profiler::ZoneStats* inner = FindZone(stats, SID("ProfilerTestInner"));
+      CHECK(outer != NULL && inner != NULL);
+      if(outer == NULL || inner == NULL) return;
+
+      CHECK_EQUAL(100u, outer->mNumCalls);
+      CHECK_EQUAL(100u, outer->mLastFrameCalls);
+      CHECK(outer->mMin <= outer->mAvg && outer->mAvg <= outer->mMax);
+      CHECK(outer->mP99 >= outer->mMin && outer->mP99 <= outer->mMax);
+      // inner zone is contained in outer zone
+      CHECK(inner->mLastFrameTime <= outer->mLastFrameTime);
+   }
+
+   //------------------------------------------------------------------
+   TEST(ProfilerCollectsOtherThreads)
+   {
+      Profiler::ResetStats();
+      Profiler::SetEnabled(true);
+      ZoneThread thread;
+      thread.start();
+      thread.join();
+      Profiler::EndFrame();
+      Profiler::SetEnabled(false);
+
+      std::vector<Profiler::ZoneStats> stats;
+      Profiler::GetZoneStats(stats);
+      const Profiler::ZoneStats* zone = FindZone(stats, SID("ProfilerTestThreadZone"));
+      CHECK(zone != NULL);
+      if(zone != NULL)
+      {
+         CHECK_EQUAL(10u, zone->mNumCalls);
+      }
+   }
+
+#if DTENTITY_PROFILING_ENABLED
+   //------------------------------------------------------------------
+   TEST(ProfilerRecordsMessageHandlers)
+   {
+      Profiler::ResetStats();
+      Profiler::SetEnabled(true);
+      MessagePump pump;
+      Receiver receiver;
+      MessageFunctor ftr(&receiver, &Receiver::OnMessage);
+      pump.RegisterForMessages(TickMessage::TYPE, ftr, FilterOptions::DEFAULT, "ProfilerTest::OnMessage");
+      TickMessage msg;
+      pump.EmitMessage(msg);
+      pump.EmitMessage(msg);
+      Profiler::EndFrame();
+      Profiler::SetEnabled(false);
+
+      std::vector<Profiler::ZoneStats> stats;
+      Profiler::GetZoneStats(stats);
+      const Profiler::ZoneStats* zone = FindZone(stats, SID("ProfilerTest::OnMessage"));
+      CHECK(zone != NULL);
+      if(zone != NULL)
+      {
+         CHECK_EQUAL(2u, zone->mNumCalls);
+      }
+   }
+#endif
+
+   //------------------------------------------------------------------
+   TEST(ProfilerChromeTrace)
+   {
+      Profiler::ResetStats();
+      Profiler::SetThreadName("ProfilerTestMain");
+      Profiler::StartTrace(3);
+      CHECK(Profiler::IsEnabled());
+      for(unsigned int i = 0; i < 5; ++i)
+      {
+         ProfileScope zone(SID("ProfilerTest\"Trace\""));
+      }
+      Profiler::EndFrame();
+      Profiler::StopTrace();
+      Profiler::SetEnabled(false);
+      CHECK_EQUAL(2u, Profiler::GetNumDroppedEvents());
+
+      const char* path = "testProfilerTrace.json";
+      CHECK(Profiler::WriteChromeTrace(path));
+
+      std::ifstream in(path);
+      std::ostringstream contents;
+      contents << in.rdbuf();
+      in.close();
+      remove(path);
+      std::string json = contents.str();
+
+      CHECK(json.find("\"traceEvents\":[") != std::string::npos);
+      CHECK(json.find("\"name\":\"ProfilerTest\\\"Trace\\\"\",\"ph\":\"X\"") != std::string::npos);
+      CHECK(json.find("\"thread_name\"") != std::string::npos);
+      CHECK(json.find("\"ProfilerTestMain\"") != std::string::npos);
+
+      unsigned int numEvents = 0;
+      for(std::string::size_type i = json.find("\"ph\":\"X\""); i != std::string::npos; i = json.find("\"ph\":\"X\"", i + 1))
+      {
+         ++numEvents;
+      }
+      CHECK_EQUAL(3u, numEvents);
+   }
+
+   //------------------------------------------------------------------
+   TEST(ProfilerTraceKeepsExitedThreadName)
+   {
+      Profiler::ResetStats();
+      Profiler::StartTrace();
+      ZoneThread thread;
+      thread.start();
+      thread.join();
+      // collects the events and deletes the buffer of the exited thread
+      Profiler::EndFrame();
+      Profiler::StopTrace();
+      Profiler::SetEnabled(false);
+
+      const char* path = "testProfilerTrace.json";
+      CHECK(Profiler::WriteChromeTrace(path));
+
+      std::ifstream in(path);
+      std::ostringstream contents;
+      contents << in.rdbuf();
+      in.close();
+      remove(path);
+      std::string json = contents.str();
+
+      CHECK(json.find("\"ZoneThread\"") != std::string::npos);
+      CHECK(json.find("\"ProfilerTestThreadZone\"") != std::string::npos);
+   }
+}
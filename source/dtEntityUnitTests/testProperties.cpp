@@ -20,7 +20,9 @@
 
 #include <UnitTest++.h>
 #include <dtEntity/property.h>
+#include <dtEntity/propertyvalue.h>
 #include <osg/Vec2>
+#include <sstream>
 
 using namespace UnitTest;
 using namespace dtEntity;
@@ -127,6 +129,138 @@ TEST(SetValuesPropertyGroup)
 }
 
 
+TEST(PropertyGroupFlatMap)
+{
+   // grow past the threshold so that the hash index is used
+   IntProperty props[40];
+   PropertyGroup pg;
+   for(int i = 39; i >= 0; --i)
+   {
+      props[i].Set(i);
+      std::ostringstream os;
+      os << "Prop" << i;
+      CHECK(pg.insert(std::make_pair(SID(os.str()), &props[i])).second);
+   }
+   CHECK_EQUAL(40u, (unsigned int)pg.size());
+   CHECK_EQUAL(false, pg.insert(std::make_pair(SID("Prop3"), &props[0])).second);
+
+   // iteration is ordered by key like std::map
+   for(PropertyGroup::const_iterator i = pg.begin(); i != pg.end(); ++i)
+   {
+      if(i != pg.begin())
+      {
+         CHECK((i - 1)->first < i->first);
+      }
+   }
+
+   CHECK(pg.find(SID("Prop17"))->second == &props[17]);
+   CHECK(pg.find(SID("NotThere")) == pg.end());
+   CHECK_EQUAL(1u, (unsigned int)pg.erase(SID("Prop17")));
+   CHECK(pg.find(SID("Prop17")) == pg.end());
+   CHECK(pg.find(SID("Prop18"))->second == &props[18]);
+
+   // shrink below threshold
+   for(int i = 0; i < 30; ++i)
+   {
+      std::ostringstream os;
+      os << "Prop" << i;
+      pg.erase(SID(os.str()));
+   }
+   CHECK_EQUAL(10u, (unsigned int)pg.size());
+   CHECK(pg[SID("Prop35")] == &props[35]);
+   CHECK_EQUAL(1u, (unsigned int)pg.count(SID("Prop30")));
+   CHECK_EQUAL(0u, (unsigned int)pg.count(SID("Prop29")));
+
+   PropertyGroup copy = pg;
+   CHECK(copy == pg);
+   copy[SID("Prop99")] = &props[0];
+   CHECK(copy != pg);
+}
+
+TEST(PropertyValueScalars)
+{
+   PropertyValue v;
+   CHECK_EQUAL(DataType::UNKNOWN_ID, v.GetDataType());
+
+   v.SetFloat(1.5f);
+   CHECK_EQUAL(1.5, v.DoubleValue());
+   CHECK_EQUAL(1, v.IntValue());
+   CHECK(v.IsConvertibleTo(DataType::INT));
+   CHECK_EQUAL(false, v.IsConvertibleTo(DataType::VEC2));
+
+   v.SetVec3(Vec3f(1, 2, 3));
+   CHECK(v.Vec3dValue() == Vec3d(1, 2, 3));
+
+   Matrix m(1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16);
+   v.SetMatrix(m);
+   PropertyValue copy(v);
+   CHECK(copy.MatrixValue() == m);
+   CHECK(copy == v);
+
+   // matrices are stored on the heap, inline payload is a Vec4d
+   copy.SetQuat(Quat(1, 2, 3, 4));
+   CHECK(copy.QuatValue() == Quat(1, 2, 3, 4));
+   copy = v;
+   CHECK(copy.MatrixValue() == m);
+   CHECK(sizeof(PropertyValue) <= 2 * sizeof(unsigned int) + 4 * sizeof(double));
+}
+
+TEST(PropertyValueStrings)
+{
+   PropertyValue shortstr;
+   shortstr.SetString("short");
+   std::string longtext(300, 'x');
+   PropertyValue longstr;
+   longstr.SetString(longtext);
+
+   PropertyValue copy = longstr;
+   CHECK_EQUAL(longtext, copy.StringValue());
+   CHECK_EQUAL(300u, (unsigned int)copy.StringSize());
+   copy = shortstr;
+   CHECK_EQUAL("short", copy.StringValue());
+   CHECK(copy != longstr);
+
+   copy.SetString(copy.CStringValue() + 1, 3);
+   CHECK_EQUAL("hor", copy.StringValue());
+
+   copy.SetStringId(SID("BLA"));
+   CHECK(copy.StringIdValue() == SID("BLA"));
+   CHECK_EQUAL("BLA", copy.StringValue());
+}
+
+TEST(PropertyValueGroup)
+{
+   GroupProperty grp;
+   grp.Add(SID("Int"), new IntProperty(3));
+   grp.Add(SID("String"), new StringProperty("test"));
+   ArrayProperty* arr = new ArrayProperty();
+   arr->Add(new FloatProperty(1));
+   arr->Add(new FloatProperty(2));
+   grp.Add(SID("Array"), arr);
+
+   PropertyValue v;
+   grp.GetValue(v);
+   CHECK_EQUAL(DataType::GROUP, v.GetDataType());
+   CHECK_EQUAL(3u, (unsigned int)v.GroupValue().size());
+   CHECK_EQUAL(3, v.GetGroupEntry(SID("Int"))->IntValue());
+   CHECK_EQUAL(2u, (unsigned int)v.GetGroupEntry(SID("Array"))->ArrayValue().size());
+   CHECK(v.GetGroupEntry(SID("NotThere")) == NULL);
+
+   v.GetOrAddGroupEntry(SID("Int")).SetInt(4);
+
+   GroupProperty grp2;
+   CHECK(grp2.SetValue(v));
+   CHECK_EQUAL(4, grp2.Get(SID("Int"))->IntValue());
+   CHECK_EQUAL("test", grp2.Get(SID("String"))->StringValue());
+   CHECK_EQUAL(2.0f, grp2.Get(SID("Array"))->ArrayValue()[1]->FloatValue());
+
+   Property* created = v.CreateProperty();
+   PropertyValue v2;
+   created->GetValue(v2);
+   CHECK(v == v2);
+   delete created;
+}
+
 TEST(SetValuesFloat)
 {
    FloatProperty fp(0.123f);
@@ -102,3 +102,129 @@ TEST(PropertyContainerString)
    container.SetString(sid, v);
    CHECK_EQUAL(container.GetString(sid), v);
 }
+
+class SchemaPropertyContainer : public PropertyContainer
+{
+public:
+   static PropertySchema sPropertySchema;
+
+   SchemaPropertyContainer()
+   {
+      Register(sPropertySchema, SID("mIntProp"), &mIntProp);
+      Register(sPropertySchema, SID("mFloatProp"), &mFloatProp);
+      Register(sPropertySchema, SID("mStringProp"), &mStringProp);
+   }
+
+   void AddDynamic(StringId name, Property* prop) { Register(name, prop); }
+
+   IntProperty mIntProp;
+   FloatProperty mFloatProp;
+   StringProperty mStringProp;
+};
+
+PropertySchema SchemaPropertyContainer::sPropertySchema;
+
+class DerivedSchemaPropertyContainer : public SchemaPropertyContainer
+{
+public:
+   static PropertySchema sPropertySchema;
+
+   DerivedSchemaPropertyContainer()
+   {
+      Register(sPropertySchema, SID("mBoolProp"), &mBoolProp);
+   }
+
+   BoolProperty mBoolProp;
+};
+
+PropertySchema DerivedSchemaPropertyContainer::sPropertySchema;
+
+TEST(PropertyContainerSchema)
+{
+   SchemaPropertyContainer* first = new SchemaPropertyContainer();
+   SchemaPropertyContainer second;
+   delete first;
+
+   CHECK(SchemaPropertyContainer::sPropertySchema.IsComplete());
+   CHECK_EQUAL(3u, (unsigned int)SchemaPropertyContainer::sPropertySchema.GetEntries().size());
+
+   // properties are found at the members of each instance
+   CHECK(second.Get(SID("mIntProp")) == &second.mIntProp);
+   CHECK(second.Get(SID("mStringProp")) == &second.mStringProp);
+   CHECK(second.Get(SID("mBoolProp")) == NULL);
+   second.SetInt(SID("mIntProp"), 42);
+   CHECK_EQUAL(42, second.mIntProp.Get());
+
+   // instance registered properties are combined with schema properties
+   IntProperty dynprop(7);
+   second.AddDynamic(SID("mDynamicProp"), &dynprop);
+   CHECK(second.Has(SID("mDynamicProp")));
+   CHECK(second.Has(SID("mFloatProp")));
+
+   const PropertyGroup& props = second.Get();
+   CHECK_EQUAL(4u, (unsigned int)props.size());
+   CHECK(props.find(SID("mFloatProp"))->second == &second.mFloatProp);
+}
+
+TEST(PropertyContainerSchemaDerived)
+{
+   DerivedSchemaPropertyContainer a;
+   DerivedSchemaPropertyContainer b;
+   CHECK(a.GetSchema() == &DerivedSchemaPropertyContainer::sPropertySchema);
+   CHECK(a.GetSchema()->GetParent() == &SchemaPropertyContainer::sPropertySchema);
+
+   b.SetInt(SID("mIntProp"), 3);
+   b.SetBool(SID("mBoolProp"), true);
+   b.SetString(SID("mStringProp"), "test");
+
+   a.InitFrom(b);
+   CHECK_EQUAL(3, a.mIntProp.Get());
+   CHECK_EQUAL(true, a.mBoolProp.Get());
+   CHECK_EQUAL("test", a.mStringProp.Get());
+   CHECK_EQUAL(4u, (unsigned int)a.Get().size());
+}
+
+TEST(PropertyContainerConstIterator)
+{
+   DerivedSchemaPropertyContainer container;
+   IntProperty dynprop(7);
+   container.AddDynamic(SID("mDynamicProp"), &dynprop);
+
+   // schema properties of derived and base class, then properties without schema
+   unsigned int numFound = 0;
+   bool foundDynamic = false;
+   for(PropertyContainer::ConstIterator i(container); !i.AtEnd(); i.Next())
+   {
+      CHECK(container.Get(i.GetName()) == i.GetProperty());
+      foundDynamic |= (i.GetName() == SID("mDynamicProp"));
+      ++numFound;
+   }
+   CHECK_EQUAL(5u, numFound);
+   CHECK(foundDynamic);
+   CHECK_EQUAL(5u, container.GetNumProperties());
+
+   // building the full group does not change iteration
+   CHECK_EQUAL(5u, (unsigned int)container.Get().size());
+   CHECK_EQUAL(5u, container.GetNumProperties());
+
+   // properties added later show up in both
+   IntProperty lateprop(8);
+   container.AddDynamic(SID("mLateProp"), &lateprop);
+   CHECK_EQUAL(6u, container.GetNumProperties());
+   CHECK_EQUAL(6u, (unsigned int)container.Get().size());
+}
+
+TEST(PropertyContainerConstIteratorOverGroup)
+{
+   GroupProperty group;
+   group.Add(SID("a"), new IntProperty(1));
+   group.Add(SID("b"), new IntProperty(2));
+
+   unsigned int numFound = 0;
+   for(PropertyContainer::ConstIterator i(group); !i.AtEnd(); i.Next())
+   {
+      CHECK(group.Get(i.GetName()) == i.GetProperty());
+      ++numFound;
+   }
+   CHECK_EQUAL(2u, numFound);
+}
@@ -0,0 +1,140 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/stringid.h>
+#include <dtEntity/stringidfile.h>
+#include <UnitTest++.h>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace StringIdTest
+{
+   //------------------------------------------------------------------
+   TEST(SIDLiteralMatchesSID)
+   {
+      // cover all tail lengths of the hash function
+      CHECK_EQUAL(SID(""), SID_LITERAL(""));
+      CHECK_EQUAL(SID("a"), SID_LITERAL("a"));
+      CHECK_EQUAL(SID("ab"), SID_LITERAL("ab"));
+      CHECK_EQUAL(SID("abc"), SID_LITERAL("abc"));
+      CHECK_EQUAL(SID("abcd"), SID_LITERAL("abcd"));
+      CHECK_EQUAL(SID("abcde"), SID_LITERAL("abcde"));
+      CHECK_EQUAL(SID("abcdef"), SID_LITERAL("abcdef"));
+      CHECK_EQUAL(SID("abcdefg"), SID_LITERAL("abcdefg"));
+      CHECK_EQUAL(SID("abcdefgh"), SID_LITERAL("abcdefgh"));
+      CHECK_EQUAL(SID("abcdefghi"), SID_LITERAL("abcdefghi"));
+      CHECK_EQUAL(SID("TransformComponent"), SID_LITERAL("TransformComponent"));
+      CHECK_EQUAL(SID("\xe4\xf6\xfc\xff"), SID_LITERAL("\xe4\xf6\xfc\xff"));
+   }
+
+   //------------------------------------------------------------------
+   TEST(SIDHashMatchesSIDHash)
+   {
+      CHECK_EQUAL(SIDHash("TickMessage"), SID_HASH("TickMessage"));
+      CHECK_EQUAL(SIDHash("x\x80y"), SID_HASH("x\x80y"));
+   }
+
+#if DTENTITY_CONSTEXPR_SIDS
+   //------------------------------------------------------------------
+   TEST(SIDHashIsConstant)
+   {
+      StringId id = SID("StringIdTestCase");
+      int result = 0;
+      switch(id)
+      {
+      case SID_HASH("StringIdTestOther"): result = 1; break;
+      case SID_HASH("StringIdTestCase"): result = 2; break;
+      default: break;
+      }
+      CHECK_EQUAL(2, result);
+   }
+#endif
+
+   //------------------------------------------------------------------
+   TEST(SIDLiteralReverseLookup)
+   {
+      StringId id = SID_LITERAL("StringIdTestOnlyUsedAsLiteral");
+      CHECK_EQUAL(std::string("StringIdTestOnlyUsedAsLiteral"), GetStringFromSID(id));
+   }
+
+   //------------------------------------------------------------------
+   TEST(SIDReverseLookupManyStrings)
+   {
+      // enough strings to grow the lookup tables a few times
+      std::vector<StringId> ids;
+      for(unsigned int i = 0; i < 20000; ++i)
+      {
+         std::ostringstream os;
+         os << "StringIdTest" << i;
+         ids.push_back(SID(os.str()));
+      }
+      CHECK_EQUAL(std::string("StringIdTest0"), GetStringFromSID(ids[0]));
+      CHECK_EQUAL(std::string("StringIdTest12345"), GetStringFromSID(ids[12345]));
+      CHECK_EQUAL(std::string("StringIdTest19999"), GetStringFromSID(ids[19999]));
+      CHECK_EQUAL(std::string(""), GetStringFromSID(SID("")));
+   }
+
+#if !DTENTITY_USE_STRINGS_AS_STRINGIDS
+   //------------------------------------------------------------------
+   TEST(LoadStringIdFile)
+   {
+      const char* path = "testStringIdFile.bin";
+      const char strings[] = "StringIdTestFromFileA\0StringIdTestFromFileB";
+
+      StringIdFileHeader header;
+      memcpy(header.mMagic, STRINGID_FILE_MAGIC, sizeof(header.mMagic));
+      header.mVersion = STRINGID_FILE_VERSION;
+      header.mNumEntries = 2;
+      header.mStringBytes = sizeof(strings);
+
+      StringIdFileEntry entries[2];
+      entries[0].mHash = SIDHash("StringIdTestFromFileA");
+      entries[0].mOffset = 0;
+      entries[1].mHash = SIDHash("StringIdTestFromFileB");
+      entries[1].mOffset = strlen(strings) + 1;
+      {
+         std::ofstream out(path, std::ios::binary);
+         out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+         out.write(reinterpret_cast<const char*>(entries), sizeof(entries));
+         out.write(strings, sizeof(strings));
+      }
+
+      CHECK(LoadStringIdFile(path));
+      CHECK_EQUAL(std::string("StringIdTestFromFileA"), GetStringFromSID(SIDHash("StringIdTestFromFileA")));
+      CHECK_EQUAL(std::string("StringIdTestFromFileB"), GetStringFromSID(SIDHash("StringIdTestFromFileB")));
+
+      // truncated file is rejected
+      {
+         std::ofstream out(path, std::ios::binary);
+         out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      }
+      CHECK(!LoadStringIdFile(path));
+      CHECK(!LoadStringIdFile("doesNotExist.bin"));
+      remove(path);
+   }
+#endif
+}
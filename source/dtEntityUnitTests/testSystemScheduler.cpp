@@ -0,0 +1,309 @@
+/*
+* dtEntity Game and Simulation Engine
+*
+* This library is free software; you can redistribute it and/or modify it under
+* the terms of the GNU Lesser General Public License as published by the Free
+* Software Foundation; either version 2.1 of the License, or (at your option)
+* any later version.
+*
+* This library is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+* details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*
+* Martin Scheffler
+*/
+
+#include <dtEntity/entitymanager.h>
+#include <dtEntity/entitysystem.h>
+#include <dtEntity/systemscheduler.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <UnitTest++.h>
+#include <algorithm>
+#include <vector>
+
+using namespace UnitTest;
+using namespace dtEntity;
+
+namespace SystemSchedulerTest
+{
+   // shared log of executed tasks
+   class ExecutionLog
+   {
+   public:
+      void Add(unsigned int index)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+         mOrder.push_back(index);
+      }
+
+      unsigned int Position(unsigned int index, unsigned int tick, unsigned int tasksPerTick) const
+      {
+         std::vector<unsigned int>::const_iterator begin = mOrder.begin() + tick * tasksPerTick;
+         return static_cast<unsigned int>(std::find(begin, begin + tasksPerTick, index) - begin);
+      }
+
+      OpenThreads::Mutex mMutex;
+      std::vector<unsigned int> mOrder;
+   };
+
+   class TestTask
+   {
+   public:
+      TestTask() : mIndex(0), mLog(NULL), mCount(0) {}
+
+      void Tick(const TickData& data)
+      {
+         ++mCount;
+         if(mLog != NULL)
+         {
+            mLog->Add(mIndex);
+         }
+      }
+
+      SystemScheduler::TickFunctor GetFunctor() { return SystemScheduler::TickFunctor(this, &TestTask::Tick); }
+
+      unsigned int mIndex;
+      ExecutionLog* mLog;
+      unsigned int mCount;
+   };
+
+   // system that declares access if mDeclare is set
+   class TestSystem : public EntitySystem
+   {
+   public:
+      TestSystem(EntityManager& em, bool declare)
+         : EntitySystem(em)
+         , mDeclare(declare)
+         , mCount(0)
+         , mEmitAllowed(false)
+      {
+      }
+
+      ComponentType GetComponentType() const { return SID("TestSystem"); }
+
+      bool GetComponentAccess(std::vector<ComponentType>& reads, std::vector<ComponentType>& writes) const
+      {
+         writes.push_back(SID("TestSystem"));
+         return mDeclare;
+      }
+
+      void Tick(const TickData& data)
+      {
+         ++mCount;
+         mEmitAllowed = GetEntityManager().GetMessagePump().IsEmitAllowed();
+      }
+
+      SystemScheduler::TickFunctor GetFunctor() { return SystemScheduler::TickFunctor(this, &TestSystem::Tick); }
+
+      bool mDeclare;
+      unsigned int mCount;
+      bool mEmitAllowed;
+   };
+
+   std::vector<ComponentType> Types(const char* a, const char* b = NULL)
+   {
+      std::vector<ComponentType> v;
+      v.push_back(SID(a));
+      if(b != NULL) v.push_back(SID(b));
+      return v;
+   }
+
+   //------------------------------------------------------------------
+   TEST(SchedulerRunsAllTasks)
+   {
+      SystemScheduler scheduler(4);
+      CHECK_EQUAL(4u, scheduler.GetNumThreads());
+
+      std::vector<TestTask> tasks(20);
+      std::vector<ComponentType> none;
+      for(unsigned int i = 0; i < tasks.size(); ++i)
+      {
+         std::vector<ComponentType> writes;
+         writes.push_back(SID("Type") + i);
+         scheduler.AddTask("Task", tasks[i].GetFunctor(), none, writes);
+      }
+      CHECK_EQUAL(1u, scheduler.GetCriticalPathLength());
+
+      TickData data;
+      for(unsigned int i = 0; i < 100; ++i)
+      {
+         scheduler.Tick(data);
+      }
+      for(unsigned int i = 0; i < tasks.size(); ++i)
+      {
+         CHECK_EQUAL(100u, tasks[i].mCount);
+      }
+   }
+
+   //------------------------------------------------------------------
+   TEST(SchedulerKeepsOrderOfConflictingTasks)
+   {
+      SystemScheduler scheduler(4);
+      ExecutionLog log;
+      std::vector<TestTask> tasks(6);
+      for(unsigned int i = 0; i < tasks.size(); ++i)
+      {
+         tasks[i].mIndex = i;
+         tasks[i].mLog = &log;
+      }
+
+      std::vector<ComponentType> none;
+      scheduler.AddTask("WriteA", tasks[0].GetFunctor(), none, Types("A"));
+      scheduler.AddTask("ReadA", tasks[1].GetFunctor(), Types("A"), none);
+      scheduler.AddTask("WriteB", tasks[2].GetFunctor(), none, Types("B"));
+      scheduler.AddTask("ReadAB", tasks[3].GetFunctor(), Types("A", "B"), none);
+      scheduler.AddExclusiveTask("Exclusive", tasks[4].GetFunctor());
+      scheduler.AddTask("ReadB", tasks[5].GetFunctor(), Types("B"), none);
+      CHECK_EQUAL(4u, scheduler.GetCriticalPathLength());
+
+      const unsigned int numTicks = 50;
+      TickData data;
+      for(unsigned int i = 0; i < numTicks; ++i)
+      {
+         scheduler.Tick(data);
+      }
+      CHECK_EQUAL(numTicks * 6, (unsigned int)log.mOrder.size());
+
+      for(unsigned int t = 0; t < numTicks; ++t)
+      {
+         CHECK(log.Position(0, t, 6) < log.Position(1, t, 6));
+         CHECK(log.Position(0, t, 6) < log.Position(3, t, 6));
+         CHECK(log.Position(2, t, 6) < log.Position(3, t, 6));
+         CHECK_EQUAL(4u, log.Position(4, t, 6));
+         CHECK_EQUAL(5u, log.Position(5, t, 6));
+      }
+   }
+
+   // records whether it ran on a pool worker thread
+   class ThreadCheckTask
+   {
+   public:
+      ThreadCheckTask() : mOnWorker(false) {}
+
+      void Tick(const TickData& data)
+      {
+         // worker threads are OpenThreads threads, the test thread is not
+         if(OpenThreads::Thread::CurrentThread() != NULL)
+         {
+            mOnWorker = true;
+         }
+      }
+
+      SystemScheduler::TickFunctor GetFunctor() { return SystemScheduler::TickFunctor(this, &ThreadCheckTask::Tick); }
+
+      bool mOnWorker;
+   };
+
+   //------------------------------------------------------------------
+   TEST(SchedulerRunsExclusiveTasksOnCallingThread)
+   {
+      SystemScheduler scheduler(4);
+      std::vector<TestTask> tasks(16);
+      ThreadCheckTask exclusive[3];
+      std::vector<ComponentType> none;
+      for(unsigned int i = 0; i < tasks.size(); ++i)
+      {
+         std::vector<ComponentType> writes;
+         writes.push_back(SID("Type") + i);
+         scheduler.AddTask("Task", tasks[i].GetFunctor(), none, writes);
+         if(i % 6 == 0)
+         {
+            scheduler.AddExclusiveTask("Exclusive", exclusive[i / 6].GetFunctor());
+         }
+      }
+      CHECK_EQUAL(7u, scheduler.GetCriticalPathLength());
+
+      TickData data;
+      for(unsigned int i = 0; i < 100; ++i)
+      {
+         scheduler.Tick(data);
+      }
+      for(unsigned int i = 0; i < tasks.size(); ++i)
+      {
+         CHECK_EQUAL(100u, tasks[i].mCount);
+      }
+      for(unsigned int i = 0; i < 3; ++i)
+      {
+         CHECK_EQUAL(false, exclusive[i].mOnWorker);
+      }
+   }
+
+   //------------------------------------------------------------------
+   TEST(SchedulerRemoveTaskAndAttach)
+   {
+      SystemScheduler scheduler(2);
+      TestTask writer, reader;
+      std::vector<ComponentType> none;
+      scheduler.AddTask("Write", writer.GetFunctor(), none, Types("A"));
+      scheduler.AddTask("Read", reader.GetFunctor(), Types("A"), none);
+      CHECK_EQUAL(2u, scheduler.GetCriticalPathLength());
+
+      CHECK(scheduler.RemoveTask(reader.GetFunctor()));
+      CHECK_EQUAL(false, scheduler.RemoveTask(reader.GetFunctor()));
+      CHECK_EQUAL(1u, scheduler.GetNumTasks());
+      CHECK_EQUAL(1u, scheduler.GetCriticalPathLength());
+
+      EntityManager em;
+      scheduler.Attach(em);
+      TickData tick;
+      em.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, writer.mCount);
+
+      scheduler.Detach();
+      em.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, writer.mCount);
+      CHECK_EQUAL(0u, reader.mCount);
+   }
+
+   //------------------------------------------------------------------
+   TEST(SchedulerRunsSystemTickHandlers)
+   {
+      EntityManager em;
+      TestSystem declared(em, true);
+      TestSystem undeclared(em, false);
+      em.RegisterForTick(declared, declared.GetFunctor(), "Declared");
+      em.RegisterForTick(undeclared, undeclared.GetFunctor(), "Undeclared");
+
+      // without scheduler handlers are called by message pump
+      TickData tick;
+      em.EmitTypedMessage(tick);
+      CHECK_EQUAL(1u, declared.mCount);
+      CHECK_EQUAL(1u, undeclared.mCount);
+      CHECK(declared.mEmitAllowed);
+
+      {
+         SystemScheduler scheduler(2);
+         scheduler.Attach(em);
+         CHECK(em.GetSystemScheduler() == &scheduler);
+         CHECK_EQUAL(2u, scheduler.GetNumTasks());
+         CHECK_EQUAL(2u, scheduler.GetCriticalPathLength());
+
+         em.EmitTypedMessage(tick);
+         CHECK_EQUAL(2u, declared.mCount);
+         CHECK_EQUAL(2u, undeclared.mCount);
+
+         // concurrent handler must not emit, exclusive one may
+         CHECK_EQUAL(false, declared.mEmitAllowed);
+         CHECK(undeclared.mEmitAllowed);
+         CHECK(em.GetMessagePump().IsEmitAllowed());
+
+         CHECK(em.UnregisterForTick(undeclared.GetFunctor()));
+         CHECK_EQUAL(1u, scheduler.GetNumTasks());
+      }
+
+      // destroyed scheduler returned handlers to message pump
+      CHECK(em.GetSystemScheduler() == NULL);
+      em.EmitTypedMessage(tick);
+      CHECK_EQUAL(3u, declared.mCount);
+      CHECK_EQUAL(2u, undeclared.mCount);
+      CHECK(em.UnregisterForTick(declared.GetFunctor()));
+      CHECK_EQUAL(false, em.UnregisterForTick(declared.GetFunctor()));
+   }
+}
@@ -36,7 +36,7 @@ using namespace v8;
 
 namespace dtEntityWrappers
 {
-   dtEntity::StringId s_componentWrapper = dtEntity::SID("ComponenttmWrapper");
+   dtEntity::StringId s_componentWrapper = SID_LITERAL("ComponenttmWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> COPropertyGetter(Local<String> propname, const AccessorInfo& info)
@@ -138,13 +138,10 @@ namespace dtEntityWrappers
       HandleScope scope;
       Handle<Object> obj = Object::New();
 
-      const dtEntity::PropertyGroup& props = component->Get();
-      dtEntity::PropertyGroup::const_iterator i;
-
-      for(i = props.begin(); i != props.end(); ++i)
+      for(dtEntity::PropertyContainer::ConstIterator i(*component); !i.AtEnd(); i.Next())
       {
-         std::string propname = dtEntity::GetStringFromSID(i->first);
-         const dtEntity::Property* prop = i->second;
+         std::string propname = dtEntity::GetStringFromSID(i.GetName());
+         const dtEntity::Property* prop = i.GetProperty();
          obj->Set(ToJSString(propname), ConvertPropertyToValue(args.This()->CreationContext(), prop));
       }
 
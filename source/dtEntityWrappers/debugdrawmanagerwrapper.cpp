@@ -35,7 +35,7 @@ using namespace v8;
 namespace dtEntityWrappers
 {
 
-   dtEntity::StringId s_debugDrawWrapper = dtEntity::SID("DebugDrawWrapper");
+   dtEntity::StringId s_debugDrawWrapper = SID_LITERAL("DebugDrawWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> DebugDrawManagerToString(const Arguments& args)
@@ -43,7 +43,7 @@ using namespace v8;
 namespace dtEntityWrappers
 {
 
-   dtEntity::StringId s_entityManagerWrapper = dtEntity::SID("EntityManagerWrapper");
+   dtEntity::StringId s_entityManagerWrapper = SID_LITERAL("EntityManagerWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    class StringCache
@@ -78,16 +78,13 @@ namespace dtEntityWrappers
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> ConvertMessageToJS(Handle<Context> context, const dtEntity::Message& msg)
    {
-      const dtEntity::PropertyGroup& params = msg.Get();
-
       HandleScope scope;
      
       Handle<Object> o = Object::New();
-      dtEntity::PropertyGroup::const_iterator i;
-      for(i = params.begin(); i != params.end(); ++i)
+      for(dtEntity::PropertyContainer::ConstIterator i(msg); !i.AtEnd(); i.Next())
       {
-         dtEntity::StringId n = i->first;
-         const dtEntity::Property* p = i->second;
+         dtEntity::StringId n = i.GetName();
+         const dtEntity::Property* p = i.GetProperty();
          Handle<Value> v = ConvertPropertyToValue(context, p);
          Handle<String> str = GetString(n);
          o->Set(str, v);
@@ -163,7 +160,7 @@ namespace dtEntityWrappers
       dtEntity::Entity* entity;
       bool success = em->CreateEntity(entity);
       if(!success) return Null();
-      return Integer::New(entity->GetId());
+      return Uint32::New(entity->GetId());
    }
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -179,7 +176,7 @@ namespace dtEntityWrappers
 
       for(unsigned int i = 0; i < ids.size(); ++i)
       {
-         arr->Set(Integer::New(i), Integer::New(ids[i]));
+         arr->Set(Integer::New(i), Uint32::New(ids[i]));
       }
       return scope.Close(arr);
    }
@@ -260,7 +257,7 @@ namespace dtEntityWrappers
    Handle<Value> EMKillEntity(const v8::Arguments& args)
    {  
       dtEntity::EntityManager* em = UnwrapEntityManager(args.This());
-      bool success = em->KillEntity(args[0]->Int32Value());
+      bool success = em->KillEntity(args[0]->Uint32Value());
       return success ? True() : False();
    }
 
@@ -288,7 +285,7 @@ namespace dtEntityWrappers
    {  
       dtEntity::EntityManager* em = UnwrapEntityManager(args.This());
       if(!args[0]->IsInt32()) return ThrowError("usage: addToScene(int32 entityId)");
-      bool success = em->AddToScene(args[0]->Int32Value());
+      bool success = em->AddToScene(args[0]->Uint32Value());
       return success ? True() : False();
    }
 
@@ -363,7 +360,7 @@ namespace dtEntityWrappers
    {  
       dtEntity::EntityManager* em = UnwrapEntityManager(args.This());
       if(!args[0]->IsInt32()) return ThrowError("usage: removeFromScene(int32 entityId)");
-      bool success = em->RemoveFromScene(args[0]->Int32Value());
+      bool success = em->RemoveFromScene(args[0]->Uint32Value());
       return success ? True() : False();
    }
 
@@ -21,6 +21,7 @@
 #include <dtEntityWrappers/entitysystemjs.h>
 
 #include <dtEntity/dtentity_config.h>
+#include <dtEntity/entity.h>
 #include <dtEntity/log.h>
 #include <dtEntity/property.h>
 #include <dtEntityWrappers/jsproperty.h>
@@ -436,7 +437,7 @@ namespace dtEntityWrappers
       HandleScope scope;
       Context::Scope context_scope(mSystem->CreationContext());
       TryCatch try_catch;
-      Handle<Value> argv[1] = { Integer::New(eid) };
+      Handle<Value> argv[1] = { Uint32::New(eid) };
       Handle<Value> ret = mHasCompFun->Call(mSystem, 1, argv);
 
       if(ret.IsEmpty()) 
@@ -457,7 +458,7 @@ namespace dtEntityWrappers
 
       TryCatch try_catch;
       
-      Handle<Value> argv[1] = { Integer::New(eid) };
+      Handle<Value> argv[1] = { Uint32::New(eid) };
       Handle<Value> ret = mGetCompFun->Call(mSystem, 1, argv);
 
       if(ret.IsEmpty()) 
@@ -484,7 +485,7 @@ namespace dtEntityWrappers
 
       TryCatch try_catch;
 
-      Handle<Value> argv[1] = { Integer::New(eid) };
+      Handle<Value> argv[1] = { Uint32::New(eid) };
       Handle<Value> ret = mGetCompFun->Call(mSystem, 1, argv);
 
       if(ret.IsEmpty() || !ret->IsObject()) 
@@ -510,7 +511,7 @@ namespace dtEntityWrappers
 
       TryCatch try_catch;
 
-      Handle<Value> argv[1] = { Integer::New(eid) };
+      Handle<Value> argv[1] = { Uint32::New(eid) };
       Handle<Value> ret = mCreateCompFun->Call(mSystem, 1, argv);
 
       if(ret.IsEmpty())
@@ -525,6 +526,12 @@ namespace dtEntityWrappers
       }
       Handle<Object> obj = Handle<Object>::Cast(ret);
       component = GetOrCreateComponentJS(GetComponentType(), obj);
+
+      dtEntity::Entity* entity;
+      if(GetEntityManager().GetEntity(eid, entity))
+      {
+         entity->AddComponentSystem(*this);
+      }
       return true;
    }
 
@@ -536,7 +543,7 @@ namespace dtEntityWrappers
 
       TryCatch try_catch;
 
-      Handle<Value> argv[1] = { Integer::New(eid) };
+      Handle<Value> argv[1] = { Uint32::New(eid) };
       Handle<Value> ret = mDelCompFun->Call(mSystem, 1, argv);
 
       if(ret.IsEmpty()) 
@@ -544,6 +551,12 @@ namespace dtEntityWrappers
          ReportException(&try_catch);
          return false;
       }
+
+      dtEntity::Entity* entity;
+      if(GetEntityManager().GetEntity(eid, entity))
+      {
+         entity->RemoveComponentSystem(*this);
+      }
       return ret->BooleanValue();
    }      
 
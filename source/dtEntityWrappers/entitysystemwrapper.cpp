@@ -41,7 +41,7 @@ namespace dtEntityWrappers
    typedef std::map<dtEntity::ComponentType, Persistent<FunctionTemplate> > SubWrapperMap;
    SubWrapperMap s_subWrapperMap;
 
-   dtEntity::StringId s_entitySystemWrapper = dtEntity::SID("EntitySystemWrapper");
+   dtEntity::StringId s_entitySystemWrapper = SID_LITERAL("EntitySystemWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> ESToString(const Arguments& args)
@@ -135,7 +135,7 @@ namespace dtEntityWrappers
       unsigned int count = 0;
       for(std::list<dtEntity::EntityId>::const_iterator i = eids.begin(); i != eids.end(); ++i)
       {         
-         arr->Set(Integer::New(count++), Integer::New(*i));         
+         arr->Set(Integer::New(count++), Uint32::New(*i));         
       }
       return scope.Close(arr);
    }   
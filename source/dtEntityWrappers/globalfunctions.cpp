@@ -22,7 +22,7 @@
 
 #include <dtEntity/core.h>
 #include <dtEntity/entitymanager.h>
-#include <dtEntity/profile.h>
+#include <dtEntity/profiler.h>
 #include <dtEntity/systeminterface.h>
 #include <dtEntityWrappers/entitymanagerwrapper.h>
 #include <dtEntityWrappers/v8helpers.h>
@@ -133,14 +133,17 @@ namespace dtEntityWrappers
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> StartProfile(const Arguments& args)
    {
-      CProfileManager::Start_Profile(dtEntity::SID(ToStdString(args[0])));
+      if(dtEntity::Profiler::IsEnabled())
+      {
+         dtEntity::Profiler::BeginZone(dtEntity::SID(ToStdString(args[0])));
+      }
       return Undefined();
    }
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> StopProfile(const Arguments& args)
    {
-      CProfileManager::Stop_Profile();
+      dtEntity::Profiler::EndZone();
       return Undefined();
    }
 
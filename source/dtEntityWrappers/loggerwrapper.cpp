@@ -32,7 +32,7 @@ using namespace v8;
 namespace dtEntityWrappers
 {
 
-   dtEntity::StringId s_loggerWrapper = dtEntity::SID("LoggerWrapper");
+   dtEntity::StringId s_loggerWrapper = SID_LITERAL("LoggerWrapper");
 
    ////////////////////////////////////////////////////////////////////////////////
    Handle<Value> LogDebug(const Arguments& args)
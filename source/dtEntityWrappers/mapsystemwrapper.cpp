@@ -82,7 +82,7 @@ namespace dtEntityWrappers
    {
       dtEntity::MapSystem* ms = UnwrapMapSystem(args.This());
       dtEntity::EntityId id = ms->GetEntityIdByUniqueId(ToStdString(args[0]));
-      return Integer::New(id);
+      return Uint32::New(id);
    }
 
 
@@ -190,7 +190,7 @@ namespace dtEntityWrappers
    {
       dtEntity::MapSystem* ms = UnwrapMapSystem(args.This());
       
-      int eid = args[1]->Int32Value();
+      dtEntity::EntityId eid = args[1]->Uint32Value();
       dtEntity::Entity* entity;
       bool success = ms->GetEntityManager().GetEntity(eid, entity);
       if(!success)
@@ -343,13 +343,10 @@ namespace dtEntityWrappers
          std::string compname = dtEntity::GetStringFromSID(i->first);
          Handle<Object> jscomp = Object::New();
 
-         const dtEntity::GroupProperty props = i->second;
-         dtEntity::PropertyGroup g = props.Get();
-
-         for(dtEntity::PropertyGroup::const_iterator j = g.begin(); j != g.end(); ++j)
+         for(dtEntity::PropertyContainer::ConstIterator j(i->second); !j.AtEnd(); j.Next())
          {
-            std::string propname = dtEntity::GetStringFromSID(j->first);
-            const dtEntity::Property* prop = j->second;
+            std::string propname = dtEntity::GetStringFromSID(j.GetName());
+            const dtEntity::Property* prop = j.GetProperty();
             jscomp->Set(ToJSString(propname), ConvertPropertyToValue(args.This()->CreationContext(), prop));
          }
          
@@ -385,13 +382,10 @@ namespace dtEntityWrappers
          std::string compname = dtEntity::GetStringFromSID(i->first);
          Handle<Object> jscomp = Object::New();
 
-         const dtEntity::GroupProperty props = i->second;
-         dtEntity::PropertyGroup g = props.Get();
-
-         for(dtEntity::PropertyGroup::const_iterator j = g.begin(); j != g.end(); ++j)
+         for(dtEntity::PropertyContainer::ConstIterator j(i->second); !j.AtEnd(); j.Next())
          {
-            std::string propname = dtEntity::GetStringFromSID(j->first);
-            const dtEntity::Property* prop = j->second;
+            std::string propname = dtEntity::GetStringFromSID(j.GetName());
+            const dtEntity::Property* prop = j.GetProperty();
             jscomp->Set(ToJSString(propname), ConvertPropertyToValue(args.This()->CreationContext(), prop));
          }
 
@@ -414,7 +408,7 @@ namespace dtEntityWrappers
       Handle<Array> arr = Array::New();
       for(unsigned int i = 0; i < ids.size(); ++i)
       {
-         arr->Set(i, Integer::New(ids[i]));
+         arr->Set(i, Uint32::New(ids[i]));
       }
       return scope.Close(arr);
    }
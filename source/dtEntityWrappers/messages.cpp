@@ -33,8 +33,8 @@ namespace dtEntityWrappers
       em.RegisterMessageType<ExecuteScriptMessage>(ExecuteScriptMessage::TYPE);
    }
 
-   const dtEntity::MessageType ExecuteScriptMessage::TYPE(dtEntity::SID("ExecuteScriptMessage"));
-   const dtEntity::StringId ExecuteScriptMessage::PathId(dtEntity::SID("Path"));
-   const dtEntity::StringId ExecuteScriptMessage::IncludeOnceId(dtEntity::SID("IncludeOnce"));
+   const dtEntity::MessageType ExecuteScriptMessage::TYPE(SID_LITERAL("ExecuteScriptMessage"));
+   const dtEntity::StringId ExecuteScriptMessage::PathId(SID_LITERAL("Path"));
+   const dtEntity::StringId ExecuteScriptMessage::IncludeOnceId(SID_LITERAL("IncludeOnce"));
   
 }
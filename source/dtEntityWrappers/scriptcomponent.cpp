@@ -67,10 +67,10 @@ namespace dtEntityWrappers
    };
 
    ////////////////////////////////////////////////////////////////////////////
-   const dtEntity::StringId ScriptSystem::TYPE(dtEntity::SID("Script")); 
-   const dtEntity::StringId ScriptSystem::ScriptsId(dtEntity::SID("Scripts"));
-   const dtEntity::StringId ScriptSystem::DebugPortId(dtEntity::SID("DebugPort"));
-   const dtEntity::StringId ScriptSystem::DebugEnabledId(dtEntity::SID("DebugEnabled"));
+   const dtEntity::StringId ScriptSystem::TYPE(SID_LITERAL("Script")); 
+   const dtEntity::StringId ScriptSystem::ScriptsId(SID_LITERAL("Scripts"));
+   const dtEntity::StringId ScriptSystem::DebugPortId(SID_LITERAL("DebugPort"));
+   const dtEntity::StringId ScriptSystem::DebugEnabledId(SID_LITERAL("DebugEnabled"));
 
    ScriptSystem::ScriptSystem(dtEntity::EntityManager& em)
       : dtEntity::EntitySystem(em)
@@ -89,8 +89,9 @@ namespace dtEntityWrappers
       mSceneLoadedFunctor = dtEntity::MessageFunctor(this, &ScriptSystem::OnSceneLoaded);
       GetEntityManager().RegisterForMessages(dtEntity::SceneLoadedMessage::TYPE, mSceneLoadedFunctor, "ScriptSystem::OnSceneLoaded");
 
-      mTickFunctor = dtEntity::MessageFunctor(this, &ScriptSystem::Tick);
-      em.RegisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor, "ScriptSystem::Tick");
+      mTickFunctor = dtEntity::TypedMessageFunctor<dtEntity::TickData>::type(this, &ScriptSystem::Tick);
+      // scripts can access anything, runs alone on a SystemScheduler
+      em.RegisterForTick(*this, mTickFunctor, "ScriptSystem::Tick");
 
       mLoadScriptFunctor = dtEntity::MessageFunctor(this, &ScriptSystem::OnLoadScript);
       em.RegisterForMessages(ExecuteScriptMessage::TYPE, mLoadScriptFunctor, "ScriptSystem::OnLoadScript");
@@ -121,7 +122,7 @@ namespace dtEntityWrappers
       mGlobalContext.Dispose();
 
       GetEntityManager().UnregisterForMessages(dtEntity::SceneLoadedMessage::TYPE, mSceneLoadedFunctor);
-      GetEntityManager().UnregisterForMessages(dtEntity::TickMessage::TYPE, mTickFunctor);
+      GetEntityManager().UnregisterForTick(mTickFunctor);
       GetEntityManager().UnregisterForMessages(ExecuteScriptMessage::TYPE, mLoadScriptFunctor);
 
    }
@@ -262,7 +263,7 @@ namespace dtEntityWrappers
    }
 
    ////////////////////////////////////////////////////////////////////////////
-   void ScriptSystem::Tick(const dtEntity::Message& m)
+   void ScriptSystem::Tick(const dtEntity::TickData& msg)
    {
       if(mGlobalTickFunction.IsEmpty())
       {
@@ -272,12 +273,10 @@ namespace dtEntityWrappers
       HandleScope scope;  
       Context::Scope context_scope(GetGlobalContext());
 
-      const dtEntity::TickMessage& msg = static_cast<const dtEntity::TickMessage&>(m);
-
       TryCatch try_catch;
       Handle<Value> argv[3] = {
-         Number::New(msg.GetDeltaSimTime()),
-         Number::New(msg.GetSimulationTime()),
+         Number::New(msg.mDeltaSimTime),
+         Number::New(msg.mSimulationTime),
          Uint32::New(osg::Timer::instance()->time_m())
       };
 
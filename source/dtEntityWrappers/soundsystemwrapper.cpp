@@ -53,7 +53,7 @@ namespace dtEntityWrappers
    Handle<Value> SSPlaySound(const Arguments& args)
    {
       dtEntityAudio::SoundSystem* ss = UnwrapSoundSystem(args.This());
-      ss->PlaySound(args[0]->Int32Value());
+      ss->PlaySound(args[0]->Uint32Value());
       return Undefined();
    }
 
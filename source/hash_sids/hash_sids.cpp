@@ -4,14 +4,52 @@
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <vector>
 #include <dtEntity/hash.h>
+#include <dtEntity/stringidfile.h>
 
 
+typedef std::map<unsigned int, std::string> HashMap;
+
+// write binary database that is memory mapped at startup, see dtEntity/stringidfile.h
+bool WriteBinaryDb(const char* path, const HashMap& hashed)
+{
+  std::string strings;
+  std::vector<dtEntity::StringIdFileEntry> entries;
+  for(HashMap::const_iterator i = hashed.begin(); i != hashed.end(); ++i)
+  {
+    dtEntity::StringIdFileEntry entry;
+    entry.mHash = i->first;
+    entry.mOffset = static_cast<unsigned int>(strings.size());
+    entries.push_back(entry);
+    strings.append(i->second.c_str(), i->second.size() + 1);
+  }
+
+  dtEntity::StringIdFileHeader header;
+  memcpy(header.mMagic, dtEntity::STRINGID_FILE_MAGIC, sizeof(header.mMagic));
+  header.mVersion = dtEntity::STRINGID_FILE_VERSION;
+  header.mNumEntries = static_cast<unsigned int>(entries.size());
+  header.mStringBytes = static_cast<unsigned int>(strings.size());
+
+  std::ofstream outstr(path, std::ios::binary);
+  if(outstr.fail())
+  {
+    return false;
+  }
+  outstr.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if(!entries.empty())
+  {
+    outstr.write(reinterpret_cast<const char*>(&entries[0]), entries.size() * sizeof(dtEntity::StringIdFileEntry));
+  }
+  outstr.write(strings.data(), strings.size());
+  return !outstr.fail();
+}
+
 int main (int argc, char *argv[])
 {  
   if (argc < 4) 
   {
-    printf("Usage: hash_sids infile outfile outfile_db");
+    printf("Usage: hash_sids infile outfile outfile_db [outfile_bin]");
     return 1;
   }
   
@@ -25,7 +63,6 @@ int main (int argc, char *argv[])
 
 
  
-  typedef std::map<unsigned int, std::string> HashMap;
   HashMap hashed;
 
   {
@@ -57,6 +94,7 @@ int main (int argc, char *argv[])
   std::cout << "CONVERTING " << argv[1] << " to " << argv[2] << "\n";
   const char* opentag = "dtEntity::SID(\"";
   const char* closetag = "\")";
+  const char* literaltag = "SID_LITERAL(\"";
   
   std::ostringstream os;
   char buffer[256];
@@ -112,6 +150,32 @@ int main (int argc, char *argv[])
          hashed[hash] = sidcontents;
       }   
     }
+
+    // SID_LITERAL is hashed by the compiler, only add its string to the database
+    const char* literal_ptr = buffer;
+    while(const char* find_ptr = strstr(literal_ptr, literaltag))
+    {
+      literal_ptr = find_ptr + strlen(literaltag);
+      const char* end_ptr = strstr(literal_ptr, closetag);
+      if(end_ptr == NULL)
+      {
+        break;
+      }
+      found_sid = true;
+      std::string text(literal_ptr, end_ptr);
+      unsigned int hash;
+      MurmurHash3_x86_32(text.c_str(), static_cast<int>(text.size()), 0, &hash);
+      HashMap::iterator found = hashed.find(hash);
+      if(found == hashed.end())
+      {
+         hashed[hash] = text;
+      }
+      else if(found->second != text)
+      {
+         std::cout << "Hash collision! " << text << " and " << found->second << std::endl;
+      }
+      literal_ptr = end_ptr + strlen(closetag);
+    }
     os << buff_ptr << std::endl;
   }
   
@@ -148,5 +212,11 @@ int main (int argc, char *argv[])
   }
   outdbstr.close();
 
+  if(argc > 4 && !WriteBinaryDb(argv[4], hashed))
+  {
+     std::cout << "Could not open output file " << argv[4] << std::endl;
+     return 1;
+  }
+
   return 0;
 }